@@ -14,6 +14,7 @@
 #include "../com/ecmcAsynDataItem.h"
 #include "../com/ecmcOctetIF.h"  //LOG macros
 #include "../com/ecmcAsynPortDriver.h"
+#include "../main/ecmcConfigArena.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h> 
@@ -34,6 +35,9 @@ static const char *driverName = "ecmcAsynPortDriver";
 
 extern double mcuFrequency;
 extern double mcuPeriod;
+// Set in threads not owning the asyn port lock (ecmcEcMasterThread)
+static __thread bool refreshRTBlocked = false;
+
 static int compar (const void* pkey, const void* pelem) {
   return ( *(int*)pkey - *(int*)pelem );
 };
@@ -63,6 +67,7 @@ ecmcAsynDataItem::ecmcAsynDataItem (ecmcAsynPortDriver *asynPortDriver,
   paramInfo_.asynType=asynParType;
   paramInfo_.dataIsArray = asynTypeIsArray(asynParType);
   addSupportedAsynType(asynParType);
+  initPublishVars();
 }
 
 ecmcAsynDataItem::ecmcAsynDataItem (ecmcAsynPortDriver *asynPortDriver,
@@ -88,6 +93,7 @@ ecmcAsynDataItem::ecmcAsynDataItem (ecmcAsynPortDriver *asynPortDriver,
   paramInfo_.asynType=asynParType;
   paramInfo_.dataIsArray = asynTypeIsArray(asynParType);
   addSupportedAsynType(asynParType);
+  initPublishVars();
 }
 
 ecmcAsynDataItem::ecmcAsynDataItem (ecmcAsynPortDriver *asynPortDriver) :
@@ -107,10 +113,12 @@ ecmcAsynDataItem::ecmcAsynDataItem (ecmcAsynPortDriver *asynPortDriver) :
   for(int i=0;i<ERROR_ASYN_MAX_SUPPORTED_TYPES_COUNT;i++) {
     supportedTypes_[i]=asynParamNotDefined;
   }
+  initPublishVars();
 }
 
 ecmcAsynDataItem::~ecmcAsynDataItem ()
 {
+  freeArrayBlocks();
   free(paramInfo_.recordName);
   paramInfo_.recordName = NULL;
   free(paramInfo_.recordType);
@@ -131,9 +139,25 @@ ecmcAsynDataItem::~ecmcAsynDataItem ()
   paramInfo_.name = NULL;
 }
 
+void* ecmcAsynDataItem::operator new(size_t bytes) {
+  return ecmcConfigArena::allocate(bytes, ECMC_CONFIG_ARENA_ASYN_DATA_ITEM);
+}
+
+void ecmcAsynDataItem::operator delete(void *ptr) {
+  ecmcConfigArena::deallocate(ptr);
+}
+
+void ecmcAsynDataItem::setRefreshRTBlocked(bool blocked) {
+  refreshRTBlocked = blocked;
+}
+
 int ecmcAsynDataItem::refreshParamRT(int force)
 {
-  if(!asynPortDriver_->getAllowRtThreadCom()){
+  if(!asynPortDriver_->getAllowRtThreadCom() || refreshRTBlocked){
+    return ERROR_ASYN_NOT_REFRESHED_RETURN;
+  }
+  if(!force && wheelOwnsRefresh()) {
+    wheelBytes_ = dataItem_.dataSize;
     return ERROR_ASYN_NOT_REFRESHED_RETURN;
   }
   return refreshParam(force,dataItem_.data,dataItem_.dataSize);
@@ -146,7 +170,12 @@ int ecmcAsynDataItem::refreshParam(int force)
 
 int ecmcAsynDataItem::refreshParamRT(int force, size_t bytes)
 {
-  if(!asynPortDriver_->getAllowRtThreadCom()){
+  if(!asynPortDriver_->getAllowRtThreadCom() || refreshRTBlocked){
+    return ERROR_ASYN_NOT_REFRESHED_RETURN;
+  }
+  if(!force && wheelOwnsRefresh()) {
+    // Published by the wheel when due (with the size of this refresh)
+    wheelBytes_ = bytes;
     return ERROR_ASYN_NOT_REFRESHED_RETURN;
   }
   return refreshParam(force,dataItem_.data,bytes);
@@ -159,12 +188,26 @@ int ecmcAsynDataItem::refreshParam(int force, size_t bytes)
 
 int ecmcAsynDataItem::refreshParamRT(int force,uint8_t *data, size_t bytes)
 {
-  if(!asynPortDriver_->getAllowRtThreadCom()){
+  if(!asynPortDriver_->getAllowRtThreadCom() || refreshRTBlocked){
+    return ERROR_ASYN_NOT_REFRESHED_RETURN;
+  }
+  if(!force && wheelOwnsRefresh()) {
+    dataItem_.data = data;
+    wheelBytes_    = bytes;
     return ERROR_ASYN_NOT_REFRESHED_RETURN;
   }
   return refreshParam(force,data,bytes);
 }
 
+/*
+* Non forced refresh of an item published by the refresh timing wheel is
+* only needed to serve data updated callbacks (the wheel publishes the
+* current value when due).
+*/
+bool ecmcAsynDataItem::wheelOwnsRefresh() {
+  return wheelScheduled_ && !hasDataUpdatedCallbacks();
+}
+
 void ecmcAsynDataItem::refresh() {
   // Call base class refresh
   ecmcDataItem::refresh();
@@ -179,6 +222,7 @@ int ecmcAsynDataItem::refreshParam(int force,uint8_t *data, size_t bytes)
   // set data pointer and size if param is not initialized (linked to record)
   dataItem_.data=data;
   dataItem_.dataSize=bytes;
+  wheelBytes_=bytes;
  
   /** Just asyn related below so call refresh() here 
   * (which calls baseclass::refresh) to update other data subscribers!
@@ -192,6 +236,11 @@ int ecmcAsynDataItem::refreshParam(int force,uint8_t *data, size_t bytes)
 
 
   if (!force) {
+    // Published by the refresh timing wheel in ecmcAsynPortDriver when due
+    if(wheelScheduled_) {
+      return ERROR_ASYN_NOT_REFRESHED_RETURN;
+    }
+
     if(paramInfo_.sampleTimeCycles < 0) {
       return ERROR_ASYN_NOT_REFRESHED_RETURN;
     }
@@ -201,17 +250,74 @@ int ecmcAsynDataItem::refreshParam(int force,uint8_t *data, size_t bytes)
       return ERROR_ASYN_NOT_REFRESHED_RETURN;  //Not refreshed
     }
   }
-  
+
+  // Forced publish replaces the next scheduled one
+  if(wheelScheduled_) {
+    wheelPublished_ = true;
+  }
+
+  return publishParam(force, data, bytes);
+}
+
+/*
+* Called by the refresh timing wheel when due. Publishes the current value
+* unless a forced publish was made since the last slot.
+*/
+int ecmcAsynDataItem::refreshScheduled()
+{
+  // Same conditions as refreshParamRT()
+  if(!asynPortDriver_->getAllowRtThreadCom() || refreshRTBlocked){
+    return ERROR_ASYN_NOT_REFRESHED_RETURN;
+  }
+
+  if(wheelPublished_) {
+    wheelPublished_ = false;
+    return ERROR_ASYN_NOT_REFRESHED_RETURN;
+  }
+
+  // Not refreshed by ecmc each cycle (see wheelOwnsRefresh())
+  if(!hasDataUpdatedCallbacks()) {
+    refresh();
+  }
+  return publishParam(0, dataItem_.data, wheelBytes_);
+}
+
+void ecmcAsynDataItem::setRefreshScheduling(bool allow)
+{
+  wheelAllowed_ = allow;
+}
+
+int ecmcAsynDataItem::publishParam(int force, uint8_t *data, size_t bytes)
+{
   if(data==0 || bytes<0){
     return ERROR_ASYN_DATA_NULL;
   }
 
+  // Deadband and on change (only scalars, never forced updates)
+  if(!force && !paramInfo_.dataIsArray && filterEnabled()) {
+    if(suppressUpdate(data, bytes)) {
+      asynUpdateCycleCounter_ = 0;
+      paramInfo_.suppressedCount++;
+      asynPortDriver_->incSuppressedCount();
+      return ERROR_ASYN_NOT_REFRESHED_RETURN;
+    }
+  }
+
   if(bytes > ecmcMaxSize_ && arrayCheckSize_) {
     bytes = ecmcMaxSize_;
   }
 
   dataItem_.dataSize = bytes;
 
+  // Publish arrays through a free block (data in block is not changed
+  // until overwritten by a later refresh)
+  if(arrayBlocks_ && paramInfo_.dataIsArray) {
+    data = publishArrayBlock(data, &bytes);
+    if(!data) {
+      return ERROR_ASYN_NOT_REFRESHED_RETURN;
+    }
+  }
+
   asynStatus stat=asynError;
   switch(paramInfo_.asynType){
     case asynParamUInt32Digital:
@@ -276,7 +382,15 @@ int ecmcAsynDataItem::refreshParam(int force,uint8_t *data, size_t bytes)
       break;
   }
 
-  asynUpdateCycleCounter_=0;    
+  asynUpdateCycleCounter_=0;
+  paramInfo_.publishedCount++;
+  asynPortDriver_->incPublishedCount();
+
+  // Sequence number after array callback (same time stamp)
+  if(arraySeqParam_ && paramInfo_.dataIsArray) {
+    arraySeqParam_->refreshParam(1);
+  }
+
   if(stat!=asynSuccess) {
     asynPrint(asynPortDriver_->getTraceAsynUser(), ASYN_TRACE_ERROR, "ecmcAsynDataItem::refreshParam: ERROR: Refresh failed for parameter %s, bytes %zu, force %d, sample time %d (0x%x).\n",
     getName(),bytes,force,paramInfo_.sampleTimeCycles,ERROR_ASYN_REFRESH_FAIL);
@@ -429,6 +543,11 @@ asynParamType ecmcAsynDataItem::getSupportedAsynType(int index) {
 }
 
 bool ecmcAsynDataItem::willRefreshNext() {
+  // Due in the slot the refresh timing wheel executes next cycle
+  if(wheelScheduled_) {
+    return wheelRounds_ == 0 &&
+           wheelSlot_ == asynPortDriver_->getRefreshWheelNextSlot();
+  }
   return asynUpdateCycleCounter_>= paramInfo_.sampleTimeCycles-1;
 }
 
@@ -622,6 +741,30 @@ asynStatus ecmcAsynDataItem::readGeneric(uint8_t *data, size_t bytesToRead, asyn
     }
   }
   
+  // Read latest published block (protected from being overwritten)
+  if(arrayBlocks_ && asynTypeIsArray(type)) {
+    int latest = __atomic_load_n(&arrayBlockLatest_, __ATOMIC_SEQ_CST);
+    while(latest >= 0) {
+      ecmcAsynArrayBlock *block = &arrayBlocks_[latest];
+      __atomic_add_fetch(&block->readers, 1, __ATOMIC_SEQ_CST);
+      // Block may have been reused before readers was incremented:
+      // only safe if still latest (latest is never overwritten)
+      int check = __atomic_load_n(&arrayBlockLatest_, __ATOMIC_SEQ_CST);
+      if(check != latest) {
+        __atomic_sub_fetch(&block->readers, 1, __ATOMIC_SEQ_CST);
+        latest = check;
+        continue;
+      }
+      if(bytes > block->bytes) {
+        bytes = block->bytes;
+      }
+      memcpy(data, block->data, bytes);
+      __atomic_sub_fetch(&block->readers, 1, __ATOMIC_SEQ_CST);
+      *readBytes = bytes;
+      return asynSuccess;
+    }
+  }
+
   // Read function in  ecmcDataItem
   read(data,bytes);
   *readBytes = bytes;
@@ -1362,6 +1505,29 @@ asynStatus ecmcAsynDataItem::parseInfofromDrvInfo(const char* drvInfo)
     }
   }
 
+  //Check DB_ABS, DB_REL and ON_CHG options (publish filter)
+  paramInfo_.deadbandAbs = 0;
+  paramInfo_.deadbandRel = 0;
+  paramInfo_.onChange    = false;
+  lastPublishedValid_    = false;
+
+  if(parseDoubleOption(drvInfo, ECMC_OPTION_DEADBAND_ABS,
+                       &paramInfo_.deadbandAbs) != asynSuccess) {
+    return asynError;
+  }
+
+  if(parseDoubleOption(drvInfo, ECMC_OPTION_DEADBAND_REL,
+                       &paramInfo_.deadbandRel) != asynSuccess) {
+    return asynError;
+  }
+
+  double onChange = 0;
+  if(parseDoubleOption(drvInfo, ECMC_OPTION_ON_CHANGE,
+                       &onChange) != asynSuccess) {
+    return asynError;
+  }
+  paramInfo_.onChange = onChange != 0;
+
   return asynSuccess;
 }
 
@@ -1398,3 +1564,284 @@ asynStatus ecmcAsynDataItem::setExeCmdFunctPtr(ecmcExeCmdFcn func, void* userObj
   useExeCmdFunc_ = true;
   return asynSuccess;
 }
+
+/*
+* Parse "<option>=<value>/" from drvInfo. Value unchanged if option missing.
+*/
+asynStatus ecmcAsynDataItem::parseDoubleOption(const char *drvInfo,
+                                               const char *option,
+                                               double     *value) {
+  const char* functionName = "parseDoubleOption";
+  const char *isThere=strstr(drvInfo,option);
+  if(!isThere){
+    return asynSuccess;
+  }
+
+  if(strlen(isThere)<(strlen(option)+strlen("=0/"))){
+    asynPrint(asynPortDriver_->getTraceAsynUser(), ASYN_TRACE_ERROR,
+              "%s:%s: Failed to parse %s option from drvInfo (%s). String to short.\n",
+              driverName,
+              functionName,
+              option,
+              drvInfo);
+    return asynError;
+  }
+
+  double temp = 0;
+  int nvals = sscanf(isThere+strlen(option),"=%lf/",&temp);
+  if(nvals!=1 || temp < 0) {
+    asynPrint(asynPortDriver_->getTraceAsynUser(), ASYN_TRACE_ERROR,
+              "%s:%s: Failed to parse %s option from drvInfo (%s). Wrong format.\n",
+              driverName,
+              functionName,
+              option,
+              drvInfo);
+    return asynError;
+  }
+  *value = temp;
+  return asynSuccess;
+}
+
+bool ecmcAsynDataItem::filterEnabled() {
+  return paramInfo_.onChange || paramInfo_.deadbandAbs > 0 ||
+         paramInfo_.deadbandRel > 0;
+}
+
+double ecmcAsynDataItem::getScalarAsDouble(uint8_t *data, size_t bytes) {
+  switch(paramInfo_.asynType){
+    case asynParamUInt32Digital:
+    case asynParamInt32:
+      return (double)*((epicsInt32*)data);
+      break;
+    case asynParamFloat64:
+      if(paramInfo_.cmdInt64ToFloat64 && bytes == sizeof(int64_t)) {
+        return (double)*((int64_t*)data);
+      }
+      if(paramInfo_.cmdUint64ToFloat64 && bytes == sizeof(uint64_t)) {
+        return (double)*((uint64_t*)data);
+      }
+      if(dataItem_.dataType == ECMC_EC_F32) {
+        return (double)*((float*)data);
+      }
+      return *((epicsFloat64*)data);
+      break;
+#ifdef ECMC_ASYN_ASYNPARAMINT64
+    case asynParamInt64:
+      return (double)*((epicsInt64*)data);
+      break;
+#endif // ECMC_ASYN_ASYNPARAMINT64
+    default:
+      break;
+  }
+  return 0;
+}
+
+/*
+* Returns true if the value should not be published. Deadbands are
+* only used for the value (not alarms). Relative and absolute deadband:
+* published if the change exceeds any of the enabled deadbands.
+*/
+bool ecmcAsynDataItem::suppressUpdate(uint8_t *data, size_t bytes) {
+  uint64_t raw = 0;
+  memcpy(&raw, data, bytes < sizeof(raw) ? bytes : sizeof(raw));
+  double value = getScalarAsDouble(data, bytes);
+
+  if(!lastPublishedValid_) {
+    lastPublishedValid_ = true;
+    lastPublishedRaw_   = raw;
+    lastPublishedValue_ = value;
+    return false;
+  }
+
+  bool suppress = false;
+
+  if(paramInfo_.onChange && raw == lastPublishedRaw_) {
+    suppress = true;
+  }
+
+  if(!suppress && (paramInfo_.deadbandAbs > 0 || paramInfo_.deadbandRel > 0)) {
+    double diff = std::fabs(value - lastPublishedValue_);
+    bool outside = false;
+    if(paramInfo_.deadbandAbs > 0 && diff > paramInfo_.deadbandAbs) {
+      outside = true;
+    }
+    if(paramInfo_.deadbandRel > 0 &&
+       diff > paramInfo_.deadbandRel * std::fabs(lastPublishedValue_)) {
+      outside = true;
+    }
+    suppress = !outside;
+  }
+
+  if(!suppress) {
+    lastPublishedRaw_   = raw;
+    lastPublishedValue_ = value;
+  }
+  return suppress;
+}
+
+void ecmcAsynDataItem::initPublishVars() {
+  wheelAllowed_       = true;
+  wheelScheduled_     = false;
+  wheelPublished_     = false;
+  wheelNext_          = NULL;
+  wheelRounds_        = 0;
+  wheelSlot_          = 0;
+  wheelPeriod_        = 1;
+  wheelBytes_         = 0;
+  lastPublishedValue_ = 0;
+  lastPublishedRaw_   = 0;
+  lastPublishedValid_ = false;
+  arrayBlocks_        = NULL;
+  arrayBlockCount_    = 0;
+  arrayBlockSize_     = 0;
+  arrayBlockLatest_   = -1;
+  arraySequence_      = 0;
+  arrayBlocksDropped_ = 0;
+  arraySeqParam_      = NULL;
+}
+
+void ecmcAsynDataItem::freeArrayBlocks() {
+  if(!arrayBlocks_) {
+    return;
+  }
+  for(int i = 0; i < arrayBlockCount_; i++) {
+    delete[] arrayBlocks_[i].data;
+  }
+  delete[] arrayBlocks_;
+  arrayBlocks_      = NULL;
+  arrayBlockCount_  = 0;
+  arrayBlockSize_   = 0;
+  arrayBlockLatest_ = -1;
+}
+
+int ecmcAsynDataItem::setArrayBlockCount(int count) {
+  if(count < 0 || count > ECMC_ASYN_ARRAY_BLOCKS_MAX || count == 1) {
+    LOGERR(
+      "%s/%s:%d: ERROR: %s: Array block count out of range (0 or 2..%d) (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      getName(),
+      ECMC_ASYN_ARRAY_BLOCKS_MAX,
+      ERROR_ASYN_ARRAY_BLOCK_COUNT_OUT_OF_RANGE);
+    return ERROR_ASYN_ARRAY_BLOCK_COUNT_OUT_OF_RANGE;
+  }
+
+  freeArrayBlocks();
+
+  if(count == 0 || !paramInfo_.dataIsArray) {
+    return 0;
+  }
+
+  size_t size = ecmcMaxSize_ > dataItem_.dataSize ? ecmcMaxSize_ :
+                                                    dataItem_.dataSize;
+  arrayBlocks_ = new ecmcAsynArrayBlock[count];
+  memset(arrayBlocks_, 0, sizeof(ecmcAsynArrayBlock) * count);
+  for(int i = 0; i < count; i++) {
+    arrayBlocks_[i].data = new uint8_t[size];
+    memset(arrayBlocks_[i].data, 0, size);
+  }
+  arrayBlockCount_ = count;
+  arrayBlockSize_  = size;
+
+  if(!arraySeqParam_) {
+    return createArraySeqParam();
+  }
+  return 0;
+}
+
+int ecmcAsynDataItem::getArrayBlockCount() {
+  return arrayBlockCount_;
+}
+
+uint32_t ecmcAsynDataItem::getArraySequence() {
+  return arraySequence_;
+}
+
+uint32_t ecmcAsynDataItem::getArrayBlocksDropped() {
+  return arrayBlocksDropped_;
+}
+
+ecmcAsynArrayBlock *ecmcAsynDataItem::getLatestArrayBlock() {
+  int latest = __atomic_load_n(&arrayBlockLatest_, __ATOMIC_ACQUIRE);
+  if(!arrayBlocks_ || latest < 0) {
+    return NULL;
+  }
+  return &arrayBlocks_[latest];
+}
+
+/*
+* Copy data to next free block. Blocks with active readers and the latest
+* published block are skipped. Returns pointer to block data or NULL if no
+* free block (sequence number is still incremented so the gap is visible).
+*/
+uint8_t *ecmcAsynDataItem::publishArrayBlock(uint8_t *data, size_t *bytes) {
+  arraySequence_++;
+
+  int next = -1;
+  for(int i = 1; i <= arrayBlockCount_; i++) {
+    int candidate = (arrayBlockLatest_ + i + arrayBlockCount_) % arrayBlockCount_;
+    if(candidate == arrayBlockLatest_) {
+      continue;
+    }
+    if(__atomic_load_n(&arrayBlocks_[candidate].readers, __ATOMIC_SEQ_CST) == 0) {
+      next = candidate;
+      break;
+    }
+  }
+
+  if(next < 0) {
+    arrayBlocksDropped_++;
+    return NULL;
+  }
+
+  ecmcAsynArrayBlock *block = &arrayBlocks_[next];
+  if(*bytes > arrayBlockSize_) {
+    *bytes = arrayBlockSize_;
+  }
+  memcpy(block->data, data, *bytes);
+  block->bytes    = *bytes;
+  block->sequence = arraySequence_;
+  asynPortDriver_->getTimeStamp(&block->timeStamp);
+  // Sequentially consistent with readers (see readGeneric())
+  __atomic_store_n(&arrayBlockLatest_, next, __ATOMIC_SEQ_CST);
+
+  return block->data;
+}
+
+int ecmcAsynDataItem::createArraySeqParam() {
+  char name[EC_MAX_OBJECT_PATH_CHAR_LENGTH];
+  unsigned int charCount = snprintf(name,
+                                    sizeof(name),
+                                    "%s" ECMC_ASYN_ARRAY_BLOCK_SEQ_SUFFIX,
+                                    getName());
+  if (charCount >= sizeof(name) - 1) {
+    LOGERR(
+      "%s/%s:%d: ERROR: %s: Failed to generate sequence parameter name (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      getName(),
+      ERROR_ASYN_CREATE_PARAM_FAIL);
+    return ERROR_ASYN_CREATE_PARAM_FAIL;
+  }
+
+  arraySeqParam_ = asynPortDriver_->addNewAvailParam(name,
+                                                     asynParamInt32,
+                                                     (uint8_t *)&arraySequence_,
+                                                     sizeof(arraySequence_),
+                                                     ECMC_EC_U32,
+                                                     0);
+  if(!arraySeqParam_) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      name);
+    return ERROR_ASYN_CREATE_PARAM_FAIL;
+  }
+  arraySeqParam_->setAllowWriteToEcmc(false);
+  arraySeqParam_->refreshParam(1);
+  return 0;
+}
@@ -47,14 +47,29 @@
 #define ERROR_ASYN_WRITE_VALUE_OUT_OF_RANGE 0x220007
 #define ERROR_ASYN_REFRESH_FAIL 0x220008
 #define ERROR_ASYN_CMD_FAIL 0x220009
+#define ERROR_ASYN_ARRAY_BLOCK_COUNT_OUT_OF_RANGE 0x22000A
 
 #define ERROR_ASYN_MAX_SUPPORTED_TYPES_COUNT 10
 #define ERROR_ASYN_NOT_REFRESHED_RETURN -1
 
+// Array publication with multiple buffers (blocks)
+#define ECMC_ASYN_ARRAY_BLOCKS_MAX 16
+#define ECMC_ASYN_ARRAY_BLOCKS_DEFAULT 4
+#define ECMC_ASYN_ARRAY_BLOCK_SEQ_SUFFIX ".seq"
+
 typedef asynStatus(*ecmcExeCmdFcn)(void*,size_t,asynParamType,void*);
 
 class ecmcAsynPortDriver;  //Include in cpp
 
+// Published array block. Not written by ecmc while readers > 0.
+typedef struct ecmcAsynArrayBlock{
+  uint8_t        *data;
+  size_t          bytes;
+  uint32_t        sequence;
+  epicsTimeStamp  timeStamp;  // Port time stamp (EtherCAT DC time)
+  int             readers;
+}ecmcAsynArrayBlock;
+
 // Asyn Parameter informtaion
 typedef struct ecmcParamInfo{
   char           *recordName;
@@ -81,6 +96,11 @@ typedef struct ecmcParamInfo{
   bool           cmdUint64ToFloat64;
   bool           cmdInt64ToFloat64;
   bool           cmdFloat64ToInt32;
+  double         deadbandAbs;       // Publish if change > deadbandAbs
+  double         deadbandRel;       // Publish if change > deadbandRel*|last|
+  bool           onChange;          // Publish only if value changed
+  uint64_t       publishedCount;
+  uint64_t       suppressedCount;
 }ecmcParamInfo;
 
 /**
@@ -102,6 +122,13 @@ public:
   ecmcAsynDataItem (ecmcAsynPortDriver *asynPortDriver);
   ~ecmcAsynDataItem ();
 
+  // Placed in ecmcConfigArena during configuration
+  static void* operator new(size_t bytes);
+  static void  operator delete(void *ptr);
+
+  // Block refreshParamRT() in calling thread (no asyn port lock)
+  static void  setRefreshRTBlocked(bool blocked);
+
   int refreshParam(int force);
   int refreshParam(int force, size_t bytes);
   int refreshParam(int force, uint8_t *data, size_t bytes);
@@ -188,11 +215,42 @@ public:
 
   asynStatus setExeCmdFunctPtr(ecmcExeCmdFcn func, void* userObj);
 
+  /** Publish arrays through a pool of blocks (0 = disable).
+  *   Each refresh copies the data to a free block (never to a block being
+  *   read), increments a sequence number and also refreshes the
+  *   "<name>.seq" parameter. Gaps in the sequence are lost updates.
+  *   Allocates memory, call at configuration. */
+  int setArrayBlockCount(int count);
+  int getArrayBlockCount();
+  uint32_t getArraySequence();
+  uint32_t getArrayBlocksDropped();
+  ecmcAsynArrayBlock *getLatestArrayBlock();
+
+  // Publish when due in refresh timing wheel (see ecmcAsynPortDriver)
+  int refreshScheduled();
+  // Allow refresh by timing wheel (default true). Disable if the return
+  // value of refreshParamRT(0) is used.
+  void setRefreshScheduling(bool allow);
+  // Refresh timing wheel publishes this item (no need to refresh each cycle)
+  bool wheelOwnsRefresh();
+
 private:
+  friend class ecmcAsynPortDriver;  // Timing wheel links
   asynStatus validateDrvInfo(const char *drvInfo);
   asynStatus getRecordInfoFromDrvInfo(const char *drvInfo);
   asynStatus parseInfofromDrvInfo(const char* drvInfo);
   int asynTypeIsArray(asynParamType asynParType);
+  bool filterEnabled();
+  bool suppressUpdate(uint8_t *data, size_t bytes);
+  double getScalarAsDouble(uint8_t *data, size_t bytes);
+  asynStatus parseDoubleOption(const char *drvInfo,
+                               const char *option,
+                               double     *value);
+  void initPublishVars();
+  int publishParam(int force, uint8_t *data, size_t bytes);
+  void freeArrayBlocks();
+  uint8_t *publishArrayBlock(uint8_t *data, size_t *bytes);
+  int createArraySeqParam();
 
   asynStatus readGeneric(uint8_t *data,
                          size_t bytesToRead,
@@ -216,6 +274,30 @@ private:
   bool useExeCmdFunc_;
   void* exeCmdUserObj_;
 
+  // Refresh timing wheel (intrusive list in ecmcAsynPortDriver)
+  bool wheelAllowed_;
+  bool wheelScheduled_;
+  bool wheelPublished_;
+  ecmcAsynDataItem *wheelNext_;
+  int32_t wheelRounds_;
+  int32_t wheelSlot_;
+  int32_t wheelPeriod_;
+  size_t wheelBytes_;  // Size of the last refresh (published when due)
+
+  // Last published scalar value (deadband and on change)
+  double lastPublishedValue_;
+  uint64_t lastPublishedRaw_;
+  bool lastPublishedValid_;
+
+  // Array publication blocks
+  ecmcAsynArrayBlock *arrayBlocks_;
+  int arrayBlockCount_;
+  size_t arrayBlockSize_;
+  int arrayBlockLatest_;
+  uint32_t arraySequence_;
+  uint32_t arrayBlocksDropped_;
+  ecmcAsynDataItem *arraySeqParam_;
+
   // Baseclass virtuals from ecmcDataItem class
   void refresh();
 
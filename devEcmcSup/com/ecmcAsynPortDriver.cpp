@@ -13,6 +13,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <string>
+#include <list>
+#include <map>
+#include <vector>
+#include <fstream>
+#include <ctype.h>
+#include <sys/stat.h>
 #include <stdio.h>
 #include <errno.h>
 #include <math.h>
@@ -45,6 +51,7 @@
 #include "../ethercat/ecmcEthercat.h"
 #include "../main/ecmcGeneral.h"
 #include "ecmcCom.h"
+#include "ecmcCfgSnapshot.h"
 
 #include "exprtkWrap.h"  //Other module
 
@@ -56,6 +63,7 @@ extern double mcuPeriod;
 static int allowCallbackEpicsState=0;
 static initHookState currentEpicsState=initHookAtIocBuild;
 static ecmcAsynPortDriver *ecmcAsynPortObj=NULL;
+static ecmcCfgSnapshot    *ecmcCfgSnapshotObj=NULL;
 
 /** Callback hook for EPICS state.
  * \param[in] state EPICS state
@@ -78,6 +86,7 @@ static void getEpicsState(initHookState state)
     case initHookAfterIocRunning:
       allowCallbackEpicsState=1;
       ecmcAsynPortObj->calcFastestUpdateRate();      
+      ecmcAsynPortObj->buildRefreshWheel();
       /** Make all callbacks if data arrived from callback before interrupts 
         were registered (before allowCallbackEpicsState==1)
         */
@@ -244,6 +253,13 @@ void ecmcAsynPortDriver::initVars() {
   paramTableSize_        = 0;
   defaultSampleTimeMS_   = 0;
   defaultMaxDelayTimeMS_ = 0;
+  defaultArrayBlockCount_ = ECMC_ASYN_ARRAY_BLOCKS_DEFAULT;
+  publishedCount_        = 0;
+  suppressedCount_       = 0;
+  refreshWheelIndex_     = 0;
+  refreshWheelValid_     = false;
+  refreshWheelParamCount_ = 0;
+  memset(refreshWheel_, 0, sizeof(refreshWheel_));
   defaultTimeSource_     = ECMC_TIME_BASE_ECMC;
   autoConnect_           = 0;
   priority_              = 0;
@@ -1079,6 +1095,97 @@ void ecmcAsynPortDriver::refreshAllInUseParamsRT() {
   }
 }
 
+/** Build timing wheel for refresh of all linked parameters with a
+  * sample time (sampleTimeCycles >= 0).\n
+  * Parameters are placed in the slot they are due (sample time in realtime
+  * cycles). Within one sample time
+  * the parameters are spread over the cycles (phase = param index modulo
+  * sample time cycles) to avoid all parameters refreshing in the same
+  * cycle.\n
+  * Parameters with a sample time longer than the wheel wrap around
+  * (rounds).\n
+  * */
+void ecmcAsynPortDriver::buildRefreshWheel() {
+  lock();
+  refreshWheelValid_      = false;
+  refreshWheelParamCount_ = 0;
+  memset(refreshWheel_, 0, sizeof(refreshWheel_));
+  refreshWheelIndex_ = 0;
+
+  for(int i=0;i<ecmcParamInUseCount_;i++) {
+    ecmcAsynDataItem *param = pEcmcParamInUseArray_[i];
+    if(!param) {
+      continue;
+    }
+    param->wheelScheduled_ = false;
+    param->wheelNext_      = NULL;
+    if(!param->linkedToAsynClient() || param->getSampleTimeCycles() < 0 ||
+       !param->wheelAllowed_) {
+      continue;
+    }
+    // Sample time in realtime cycles (param sample cycles are in data
+    // update cycles, for instance plc scan rate)
+    int32_t period = (int32_t)(param->getSampleTimeMs() / (mcuPeriod / 1E6));
+    if(period < 1) {
+      period = 1;
+    }
+    param->wheelPeriod_    = period;
+    param->wheelScheduled_ = true;
+    param->wheelPublished_ = false;
+    param->wheelBytes_     = param->dataItem_.dataSize;
+    wheelInsert(param, 1 + param->getParamInfo()->index % period);
+    refreshWheelParamCount_++;
+  }
+
+  refreshWheelValid_ = true;
+  unlock();
+}
+
+void ecmcAsynPortDriver::wheelInsert(ecmcAsynDataItem *param,
+                                     int32_t delayCycles) {
+  int slot = (refreshWheelIndex_ + delayCycles) &
+             (ECMC_ASYN_REFRESH_WHEEL_SIZE - 1);
+  param->wheelRounds_ = (delayCycles - 1) / ECMC_ASYN_REFRESH_WHEEL_SIZE;
+  param->wheelSlot_   = slot;
+  param->wheelNext_   = refreshWheel_[slot];
+  refreshWheel_[slot] = param;
+}
+
+/** Slot executed by the timing wheel next realtime cycle.\n
+  * */
+int ecmcAsynPortDriver::getRefreshWheelNextSlot() {
+  return (refreshWheelIndex_ + 1) & (ECMC_ASYN_REFRESH_WHEEL_SIZE - 1);
+}
+
+/** Advance timing wheel one cycle and refresh parameters that are due.\n
+  * Called once per realtime cycle.\n
+  * */
+void ecmcAsynPortDriver::executeRefreshWheel() {
+  if(!refreshWheelValid_) {
+    return;
+  }
+
+  refreshWheelIndex_ = (refreshWheelIndex_ + 1) &
+                       (ECMC_ASYN_REFRESH_WHEEL_SIZE - 1);
+
+  // Detach slot (re-inserted params can end up in the same slot)
+  ecmcAsynDataItem *param = refreshWheel_[refreshWheelIndex_];
+  refreshWheel_[refreshWheelIndex_] = NULL;
+
+  while(param) {
+    ecmcAsynDataItem *next = param->wheelNext_;
+    if(param->wheelRounds_ > 0) {
+      param->wheelRounds_--;
+      param->wheelNext_ = refreshWheel_[refreshWheelIndex_];
+      refreshWheel_[refreshWheelIndex_] = param;
+    } else {
+      param->refreshScheduled();
+      wheelInsert(param, param->wheelPeriod_);
+    }
+    param = next;
+  }
+}
+
 void ecmcAsynPortDriver::reportParamInfo(FILE *fp, ecmcAsynDataItem *param,int listIndex) {
 
   if(!param) {
@@ -1115,6 +1222,11 @@ void ecmcAsynPortDriver::reportParamInfo(FILE *fp, ecmcAsynDataItem *param,int l
   fprintf(fp,"    Param sample time [ms]:    %.0lf\n",paramInfo->sampleTimeMS);
   fprintf(fp,"    Param sample cycles []:    %d\n",paramInfo->sampleTimeCycles);
   fprintf(fp,"    Param isIOIntr:            %s\n",paramInfo->isIOIntr ? "true" : "false");
+  if(paramInfo->onChange || paramInfo->deadbandAbs > 0 || paramInfo->deadbandRel > 0) {
+    fprintf(fp,"    Param deadband abs/rel:    %lf/%lf\n",paramInfo->deadbandAbs,paramInfo->deadbandRel);
+    fprintf(fp,"    Param on change:           %s\n",paramInfo->onChange ? "true" : "false");
+  }
+  fprintf(fp,"    Param published/suppressed: %" PRIu64 "/%" PRIu64 "\n",paramInfo->publishedCount,paramInfo->suppressedCount);
   fprintf(fp,"    Param asyn addr:           %d\n",paramInfo->asynAddr);
   fprintf(fp,"    Param alarm:               %d\n",paramInfo->alarmStatus);
   fprintf(fp,"    Param severity:            %d\n",paramInfo->alarmSeverity);
@@ -1172,6 +1284,9 @@ void ecmcAsynPortDriver::report(FILE *fp, int details)
     fprintf(fp, "  Fastest update rate [cycles]:   %d\n",fastestParamUpdateCycles_);
     fprintf(fp, "  Realtime loop rate [Hz]:        %lf\n",mcuFrequency);
     fprintf(fp, "  Realtime loop sample time [ms]: %lf\n",mcuPeriod/1E6);
+    fprintf(fp, "  Published updates:              %u\n",publishedCount_);
+    fprintf(fp, "  Suppressed updates:             %u\n",suppressedCount_);
+    fprintf(fp, "  Refresh wheel params:           %d\n",refreshWheelParamCount_);
     fprintf(fp,"\n");
   }
 
@@ -1267,6 +1382,34 @@ void ecmcAsynPortDriver::grepRecord(FILE *fp, const char *pattern) {
 int ecmcAsynPortDriver::getDefaultSampleTimeMs() {
   return defaultSampleTimeMS_;
 }
+
+/** Number of blocks used for array parameters published with multiple
+  * buffers (memmaps and data storages created after this call).\n
+  * 0 disables (array published directly from ecmc buffer).\n
+  * */
+int ecmcAsynPortDriver::setDefaultArrayBlockCount(int count) {
+  if(count < 0 || count > ECMC_ASYN_ARRAY_BLOCKS_MAX || count == 1) {
+    return ERROR_ASYN_ARRAY_BLOCK_COUNT_OUT_OF_RANGE;
+  }
+  defaultArrayBlockCount_ = count;
+  return 0;
+}
+
+int ecmcAsynPortDriver::getDefaultArrayBlockCount() {
+  return defaultArrayBlockCount_;
+}
+
+int ecmcAsynPortDriver::getAvailParamCount() {
+  return ecmcParamAvailCount_;
+}
+
+uint32_t ecmcAsynPortDriver::getPublishedCount() {
+  return publishedCount_;
+}
+
+uint32_t ecmcAsynPortDriver::getSuppressedCount() {
+  return suppressedCount_;
+}
 /* Configuration routine.  Called directly, or from the iocsh function below */
 
 extern "C" {
@@ -1413,6 +1556,21 @@ static void initCallFunc_2(const iocshArgBuf *args) {
                                  args[3].ival);
 }
 
+/* Record successful config command in snapshot (if recording)*/
+static void addToCfgSnapshot(const char *ecmcCommand) {
+  if (!ecmcCfgSnapshotObj || !ecmcCfgSnapshotObj->getRecording()) {
+    return;
+  }
+
+  int errorCode = ecmcCfgSnapshotObj->addCommand(ecmcCommand);
+
+  if (errorCode) {
+    printf("WARNING: Configuration snapshot failed: %s (0x%x)\n",
+            getErrorString(errorCode),
+            errorCode);
+  }
+}
+
 /* EPICS iocsh shell command:  ecmcConfigOrDie*/
 static ecmcOutputBufferType ecmcConfigBuffer;
 int ecmcConfigOrDie(const char *ecmcCommand) {
@@ -1463,7 +1621,9 @@ int ecmcConfigOrDie(const char *ecmcCommand) {
   printf("%s\n", ecmcConfigBuffer.buffer);
   // Set return variable
   epicsEnvSet(ECMC_IOCSH_CFG_CMD_RETURN_VAR_NAME,ecmcConfigBuffer.buffer);
-  
+
+  addToCfgSnapshot(ecmcCommand);
+
   return 0;
 }
 
@@ -1507,6 +1667,12 @@ int ecmcConfig(const char *ecmcCommand) {
   printf("%s\n", ecmcConfigBuffer.buffer);
   // Set return variable
   epicsEnvSet(ECMC_IOCSH_CFG_CMD_RETURN_VAR_NAME,ecmcConfigBuffer.buffer);
+
+  if (!errorCode && strncmp(ecmcConfigBuffer.buffer,
+                            ECMC_RETURN_ERROR_STRING,
+                            strlen(ECMC_RETURN_ERROR_STRING))) {
+    addToCfgSnapshot(ecmcCommand);
+  }
   
   return 0;
 }
@@ -1661,43 +1827,110 @@ int formatIsDouble(const char* format) {
   return -1; //invalid
 }
 
-asynStatus evalExprTK(const char* expression, double *result) {
-
-  // Evaluate expression
-  exprtkWrap *exprtk = new exprtkWrap();
-  if(!exprtk) {
-     printf ("Failed allocation of exprtk expression parser.\n");
-    return asynError;
+/* Compiled expressions of ecmcEpicsEnvSetCalc*() (LRU cache).
+ * Startup scripts evaluate the same expressions many times, so the
+ * expressions are only compiled once. Each entry has its own result
+ * variable since exprtk binds variables by reference.*/
+typedef struct {
+  std::string key;
+  exprtkWrap *exprtk;
+  double      result;
+} ecmcCalcCacheEntry;
+
+static std::list<ecmcCalcCacheEntry*> calcCacheList;  // Most recent first
+static std::map<std::string, std::list<ecmcCalcCacheEntry*>::iterator> calcCacheMap;
+
+// Collapse whitespace (outside strings) so equal expressions share entry
+static std::string normalizeExpr(const char* expression) {
+  std::string normalized;
+  bool inString = false;
+  bool space    = false;
+
+  for (const char *c = expression; *c; c++) {
+    if (*c == '\'') {
+      inString = !inString;
+    }
+    if (!inString && isspace((unsigned char)*c)) {
+      space = true;
+      continue;
+    }
+    if (space && normalized.length() > 0) {
+      normalized += ' ';
+    }
+    space = false;
+    normalized += *c;
   }
-  double resultDouble = 0;
-
-  exprtk->addVariable(ECMC_ENVSETCALC_RESULT_VAR, resultDouble);
+  return normalized;
+}
 
-  std::string exprStr="";
+static ecmcCalcCacheEntry* calcCacheGet(const std::string &key) {
+  std::map<std::string, std::list<ecmcCalcCacheEntry*>::iterator>::iterator it =
+    calcCacheMap.find(key);
 
-  // Check if "RESULT" variable in str. If not then simple expression.. Add in beginning
-  if(strstr(expression,ECMC_ENVSETCALC_RESULT_VAR)) {
-    exprStr = expression;   
-  }
-  else {
-    exprStr = ECMC_ENVSETCALC_RESULT_VAR;   
-    exprStr += ":=";
-    exprStr += expression;       
+  if (it == calcCacheMap.end()) {
+    return NULL;
   }
+  // Move to front (most recently used)
+  calcCacheList.splice(calcCacheList.begin(), calcCacheList, it->second);
+  return *(it->second);
+}
 
-  //Check if need to add ";" last
-  if(exprStr.c_str()[strlen(exprStr.c_str())-1] != ';') {
-    exprStr += ";";
+static void calcCacheAdd(ecmcCalcCacheEntry *entry) {
+  if (calcCacheList.size() >= ECMC_ENVSETCALC_CACHE_SIZE) {
+    ecmcCalcCacheEntry *oldest = calcCacheList.back();
+    calcCacheMap.erase(oldest->key);
+    calcCacheList.pop_back();
+    delete oldest->exprtk;
+    delete oldest;
   }
-  
-  if(exprtk->compile(exprStr)) {
-    printf ("Failed compile of expression with error message: %s.\n", exprtk->getParserError().c_str());
-    return asynError;
+  calcCacheList.push_front(entry);
+  calcCacheMap[entry->key] = calcCacheList.begin();
+}
+
+asynStatus evalExprTK(const char* expression, double *result) {
+
+  std::string key = normalizeExpr(expression);
+  ecmcCalcCacheEntry *entry = calcCacheGet(key);
+
+  if(!entry) {
+    std::string exprStr="";
+
+    // Check if "RESULT" variable in str. If not then simple expression.. Add in beginning
+    if(strstr(key.c_str(),ECMC_ENVSETCALC_RESULT_VAR)) {
+      exprStr = key;
+    }
+    else {
+      exprStr = ECMC_ENVSETCALC_RESULT_VAR;   
+      exprStr += ":=";
+      exprStr += key;
+    }
+
+    //Check if need to add ";" last
+    if(exprStr.length() == 0 || exprStr[exprStr.length()-1] != ';') {
+      exprStr += ";";
+    }
+
+    entry = new ecmcCalcCacheEntry;
+    entry->key    = key;
+    entry->result = 0;
+    entry->exprtk = new exprtkWrap();
+
+    entry->exprtk->addVariable(ECMC_ENVSETCALC_RESULT_VAR, entry->result);
+
+    if(entry->exprtk->compile(exprStr)) {
+      printf ("Failed compile of expression with error message: %s.\n", entry->exprtk->getParserError().c_str());
+      delete entry->exprtk;
+      delete entry;
+      return asynError;
+    }
+    calcCacheAdd(entry);
   }
-  exprtk->refresh();
-  delete exprtk;  // not needed anymore (result in "resultDouble")
 
-  *result = resultDouble;
+  // Result is not assigned by all expressions (if/else), default 0
+  entry->result = 0;
+  entry->exprtk->refresh();
+
+  *result = entry->result;
   return asynSuccess;
 }
 
@@ -1990,14 +2223,61 @@ void ecmcForLoopPrintHelp() {
   printf("\n");
 }
 
-int forLoopStep(const char* filename, const char* macros, const char *loopvar, int i) {
+/* Loop body files of ecmcForLoop (read once, reloaded if modified)*/
+typedef struct {
+  struct timespec          mtime;  // st_mtime only has 1s resolution
+  off_t                    size;
+  ino_t                    inode;
+  std::vector<std::string> lines;
+} ecmcForLoopFile;
+
+static std::map<std::string, ecmcForLoopFile> forLoopFileCache;
+
+static ecmcForLoopFile* forLoopGetFile(const char* filename) {
+  struct stat fileStat;
+  if(stat(filename, &fileStat) != 0) {
+    return NULL;
+  }
+
+  std::map<std::string, ecmcForLoopFile>::iterator it = forLoopFileCache.find(filename);
+  if(it != forLoopFileCache.end() &&
+     it->second.mtime.tv_sec  == fileStat.st_mtim.tv_sec &&
+     it->second.mtime.tv_nsec == fileStat.st_mtim.tv_nsec &&
+     it->second.size  == fileStat.st_size &&
+     it->second.inode == fileStat.st_ino) {
+    return &it->second;
+  }
+
+  std::ifstream file(filename);
+  if(!file.good()) {
+    return NULL;
+  }
+
+  ecmcForLoopFile &cached = forLoopFileCache[filename];
+  cached.mtime = fileStat.st_mtim;
+  cached.size  = fileStat.st_size;
+  cached.inode = fileStat.st_ino;
+  cached.lines.clear();
+
+  std::string line;
+  while(std::getline(file, line)) {
+    if(line.find_first_not_of(" \t\r") != std::string::npos) {
+      cached.lines.push_back(line);
+    }
+  }
+  return &cached;
+}
+
+int forLoopStep(ecmcForLoopFile *file, const char* macros, const char *loopvar, int i) {
   char buffer[256];
   memset(buffer,0,sizeof(buffer));
   // Set loop variable
   snprintf(buffer,sizeof(buffer),"%d",i);  
   epicsEnvSet(loopvar,buffer);
-  //Execute file in iocsh
-  iocshLoad(filename,macros);
+  //Execute cached file lines in iocsh (macros expanded for each iteration)
+  for(size_t line = 0; line < file->lines.size(); line++) {
+    iocshRun(file->lines[line].c_str(),macros);
+  }
   return 0;
 }
 
@@ -2029,9 +2309,9 @@ int ecmcForLoop(const char *filename, const char* macros, const char *loopvar, i
   }
 
   // Check filename
-  int fileExist  = access( filename, 0 ) == 0;
+  ecmcForLoopFile *file = forLoopGetFile(filename);
 
-  if(!fileExist){
+  if(!file){
     printf("Error: File \"%s\" not found.\n",filename);
     return asynError;
   }
@@ -2049,11 +2329,11 @@ int ecmcForLoop(const char *filename, const char* macros, const char *loopvar, i
   // Start loop
   if(from<=to){
     for(int i= from; i <= to; i+=step){
-      forLoopStep(filename, macros, loopvar, i);
+      forLoopStep(file, macros, loopvar, i);
     }
   }else {
     for(int i= from; i >= to; i-=step){
-      forLoopStep(filename, macros, loopvar, i);
+      forLoopStep(file, macros, loopvar, i);
     }
   }
   return asynSuccess;
@@ -2110,6 +2390,103 @@ static void initCallFunc_12(const iocshArgBuf *args) {
   ecmcExit(args[0].sval);
 }
 
+/** 
+ * EPICS iocsh shell command: ecmcCfgSnapshotRecord
+*/
+int ecmcCfgSnapshotRecord(const char *filename) {
+  if(!filename || strcmp(filename,"-h") == 0 || strcmp(filename,"--help") == 0 ) {
+    printf("\n");
+    printf("       Use \"ecmcCfgSnapshotRecord(<filename>)\" to record the configuration to a snapshot file.\n");
+    printf("          <filename> : Snapshot file (written when Cfg.SetAppMode(1) succeeds).\n");
+    printf("\n");
+    return asynSuccess;
+  }
+
+  if(!ecmcAsynPortObj) {
+    printf("Error: No ecmcAsynPortDriver object found (ecmcAsynPortObj==NULL).\n");
+    printf("       Use ecmcAsynPortDriverConfigure() to create object.\n");
+    return asynError;
+  }
+
+  if(!ecmcCfgSnapshotObj) {
+    ecmcCfgSnapshotObj = new ecmcCfgSnapshot(ecmcAsynPortObj);
+  }
+
+  return ecmcCfgSnapshotObj->startRecord(filename);
+}
+
+static const iocshArg initArg0_13 =
+{ "Filename", iocshArgString };
+
+static const iocshArg *const initArgs_13[]  = { &initArg0_13};
+static const iocshFuncDef    initFuncDef_13 = { "ecmcCfgSnapshotRecord", 1, initArgs_13 };
+static void initCallFunc_13(const iocshArgBuf *args) {
+  ecmcCfgSnapshotRecord(args[0].sval);
+}
+
+/** 
+ * EPICS iocsh shell command: ecmcCfgSnapshotLoad
+*/
+int ecmcCfgSnapshotLoad(const char *filename) {
+  if(!filename || strcmp(filename,"-h") == 0 || strcmp(filename,"--help") == 0 ) {
+    printf("\n");
+    printf("       Use \"ecmcCfgSnapshotLoad(<filename>)\" to load configuration from a snapshot file.\n");
+    printf("          <filename> : Snapshot file (see ecmcCfgSnapshotRecord).\n");
+    printf("       The snapshot is only loaded if the EtherCAT bus and ecmc version match.\n");
+    printf("       The EtherCAT master must be set (Cfg.EcSetMaster()) before load.\n");
+    printf("       Result in environment variable \"%s\" (1 if loaded, 0 if the normal configuration is needed).\n",
+           ECMC_IOCSH_CFG_SNAPSHOT_RETURN_VAR_NAME);
+    printf("       If the snapshot fails after it was partly applied, the IOC start is aborted.\n");
+    printf("\n");
+    return asynSuccess;
+  }
+
+  epicsEnvSet(ECMC_IOCSH_CFG_SNAPSHOT_RETURN_VAR_NAME,"0");
+
+  if(!ecmcAsynPortObj) {
+    printf("Error: No ecmcAsynPortDriver object found (ecmcAsynPortObj==NULL).\n");
+    printf("       Use ecmcAsynPortDriverConfigure() to create object.\n");
+    return asynError;
+  }
+
+  if(!ecmcCfgSnapshotObj) {
+    ecmcCfgSnapshotObj = new ecmcCfgSnapshot(ecmcAsynPortObj);
+  }
+
+  if(ecmcCfgSnapshotObj->getRecording()) {
+    printf("Error: Snapshot recording in progress.\n");
+    return asynError;
+  }
+
+  int errorCode = ecmcCfgSnapshotObj->load(filename);
+
+  if(errorCode == ERROR_CFG_SNAPSHOT_REPLAY_FAIL) {
+    // Configuration partly applied (can not be rolled back), the normal
+    // configuration can not be applied on top of it
+    printf("ecmc: ERROR: Snapshot partly applied, IOC start aborted.\n");
+    return asynError;
+  }
+
+  if(errorCode) {
+    printf("ecmc: Snapshot not used, normal configuration needed.\n");
+    return asynSuccess;
+  }
+
+  epicsEnvSet(ECMC_IOCSH_CFG_SNAPSHOT_RETURN_VAR_NAME,"1");
+  return asynSuccess;
+}
+
+static const iocshArg initArg0_14 =
+{ "Filename", iocshArgString };
+
+static const iocshArg *const initArgs_14[]  = { &initArg0_14};
+static const iocshFuncDef    initFuncDef_14 = { "ecmcCfgSnapshotLoad", 1, initArgs_14 };
+static void initCallFunc_14(const iocshArgBuf *args) {
+  if(ecmcCfgSnapshotLoad(args[0].sval) != asynSuccess) {
+    exit(EXIT_FAILURE);
+  }
+}
+
 void ecmcAsynPortDriverRegister(void) {
   iocshRegister(&initFuncDef,    initCallFunc);
   iocshRegister(&initFuncDef_2,  initCallFunc_2);
@@ -2123,6 +2500,8 @@ void ecmcAsynPortDriverRegister(void) {
   iocshRegister(&initFuncDef_10, initCallFunc_10);
   iocshRegister(&initFuncDef_11, initCallFunc_11);
   iocshRegister(&initFuncDef_12, initCallFunc_12);
+  iocshRegister(&initFuncDef_13, initCallFunc_13);
+  iocshRegister(&initFuncDef_14, initCallFunc_14);
 }
 
 epicsExportRegistrar(ecmcAsynPortDriverRegister);
@@ -37,6 +37,9 @@
 #include "ecmcDefinitions.h"
 #endif
 
+// Slots in refresh timing wheel (power of 2)
+#define ECMC_ASYN_REFRESH_WHEEL_SIZE 1024
+
 class ecmcAsynPortDriver : public asynPortDriver {
  public:
   ecmcAsynPortDriver(const char *portName,
@@ -146,7 +149,19 @@ class ecmcAsynPortDriver : public asynPortDriver {
    int32_t getFastestUpdateRate();   
    int32_t calcFastestUpdateRate();
    int     getDefaultSampleTimeMs();
+   int     setDefaultArrayBlockCount(int count);
+   int     getDefaultArrayBlockCount();
+   int     getAvailParamCount();
+
+   // Statistics of published and suppressed (deadband/on change) updates
+   void    incPublishedCount() {publishedCount_++;};
+   void    incSuppressedCount() {suppressedCount_++;};
+   uint32_t getPublishedCount();
+   uint32_t getSuppressedCount();
    void    refreshAllInUseParamsRT();
+   void    buildRefreshWheel();
+   void    executeRefreshWheel();
+   int     getRefreshWheelNextSlot();
    int     getEpicsState();
    void    setEpicsState(int state);
 
@@ -171,6 +186,16 @@ class ecmcAsynPortDriver : public asynPortDriver {
   int paramTableSize_;
   int defaultSampleTimeMS_;
   int defaultMaxDelayTimeMS_;
+  int defaultArrayBlockCount_;
+  uint32_t publishedCount_;
+  uint32_t suppressedCount_;
+
+  // Refresh timing wheel (one slot per realtime cycle)
+  void wheelInsert(ecmcAsynDataItem *param, int32_t delayCycles);
+  ecmcAsynDataItem *refreshWheel_[ECMC_ASYN_REFRESH_WHEEL_SIZE];
+  int refreshWheelIndex_;
+  bool refreshWheelValid_;
+  int refreshWheelParamCount_;
   ECMCTIMESOURCE defaultTimeSource_;
   int autoConnect_;
   unsigned int priority_;
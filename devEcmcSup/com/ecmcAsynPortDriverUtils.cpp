@@ -268,6 +268,14 @@ int getAxMainFuncType(char *objPath,
       *objectFunction = ECMC_AXIS_ENTRY_INDEX_HEALTH;
       return 0;
     }
+
+    // Position compare output
+    nvals = strcmp(objectFunctionStr, ECMC_AX_POS_CMP_STR);
+
+    if (nvals == 0) {
+      *objectFunction = ECMC_AXIS_ENTRY_INDEX_POS_CMP;
+      return 0;
+    }
   }
   return ERROR_MAIN_ECMC_COMMAND_FORMAT_ERROR;
 }
@@ -440,6 +448,14 @@ int getAxEncFuncType(char *objPath,
         return 0;
       }
 
+      // Latch time (DC)
+      nvals = strcmp(objectFunctionStr, ECMC_ENC_LATCH_TIME_STR);
+
+      if (nvals == 0) {
+        *objectFunction = ECMC_ENCODER_ENTRY_INDEX_LATCH_TIME;
+        return 0;
+      }
+
       // Reset alarm
       nvals = strcmp(objectFunctionStr,ECMC_ENC_RESET_STR);
 
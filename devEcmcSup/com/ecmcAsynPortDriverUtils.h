@@ -43,6 +43,9 @@
 #define ECMC_OPTION_TIMEBASE_ECMC "ECMC"
 #define ECMC_OPTION_TYPE "TYPE"
 #define ECMC_OPTION_CMD "CMD"
+#define ECMC_OPTION_DEADBAND_ABS "DB_ABS"   // Absolute deadband
+#define ECMC_OPTION_DEADBAND_REL "DB_REL"   // Relative deadband (fraction)
+#define ECMC_OPTION_ON_CHANGE "ON_CHG"      // Only publish changed values
 
 #define ECMC_OPTION_CMD_UINT_TO_FLOAT64 "UINT64TOFLOAT64"
 #define ECMC_OPTION_CMD_INT_TO_FLOAT64 "INT64TOFLOAT64"
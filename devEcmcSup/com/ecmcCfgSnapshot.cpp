@@ -0,0 +1,474 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcCfgSnapshot.cpp
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#include "ecmcCfgSnapshot.h"
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+#include "ecmcCmdParser.h"
+#include "../main/gitversion.h"
+#include "../main/ecmcErrorsList.h"
+#include "../ethercat/ecmcEthercat.h"
+#include "../plc/ecmcPLC.h"
+
+#define ECMC_CFG_SNAPSHOT_FNV_OFFSET 2166136261u
+#define ECMC_CFG_SNAPSHOT_FNV_PRIME 16777619u
+
+// Helpers for serialization
+static void putU32(std::string *buffer, uint32_t value) {
+  buffer->append((const char *)&value, sizeof(value));
+}
+
+static int getU32(const std::string &buffer, size_t *pos, uint32_t *value) {
+  if (*pos + sizeof(*value) > buffer.size()) {
+    return ERROR_CFG_SNAPSHOT_FILE_CORRUPT;
+  }
+  memcpy(value, buffer.data() + *pos, sizeof(*value));
+  *pos += sizeof(*value);
+  return 0;
+}
+
+ecmcCfgSnapshot::ecmcCfgSnapshot(ecmcAsynPortDriver *asynPortDriver) {
+  initVars();
+  asynPortDriver_ = asynPortDriver;
+}
+
+ecmcCfgSnapshot::~ecmcCfgSnapshot() {}
+
+void ecmcCfgSnapshot::initVars() {
+  errorReset();
+  asynPortDriver_ = NULL;
+  recording_      = false;
+  asynParamCount_ = 0;
+  memset(&replayBuffer_, 0, sizeof(replayBuffer_));
+  replayBuffer_.bufferSize = ECMC_CMD_BUFFER_SIZE;
+}
+
+int ecmcCfgSnapshot::startRecord(const char *fileName) {
+  fileName_  = fileName;
+  recording_ = true;
+  entries_.clear();
+  slaves_.clear();
+  return 0;
+}
+
+bool ecmcCfgSnapshot::getRecording() {
+  return recording_;
+}
+
+int ecmcCfgSnapshot::addCommand(const char *command) {
+  if (!recording_) {
+    return 0;
+  }
+
+  // Only configuration commands
+  if (strncmp(command, "Cfg.", 4) != 0) {
+    return 0;
+  }
+
+  int  iValue = 0;
+  char fileName[ECMC_CMD_MAX_SINGLE_CMD_LENGTH];
+
+  // Validated configuration, write snapshot
+  if ((sscanf(command, "Cfg.SetAppMode(%d)", &iValue) == 1) &&
+      (iValue == ECMC_MODE_RUNTIME)) {
+    return save();
+  }
+
+  // Embed PLC code so the snapshot does not depend on (temporary) files
+  if (sscanf(command, "Cfg.LoadPLCFile(%d,%[^)])", &iValue,
+             fileName) == 2) {
+    return addPLCFile(iValue, fileName);
+  }
+
+  if (sscanf(command, "Cfg.LoadAxisPLCFile(%d,%[^)])", &iValue,
+             fileName) == 2) {
+    return addPLCFile(iValue + ECMC_MAX_PLCS, fileName);
+  }
+
+  ecmcCfgSnapshotEntry entry;
+  entry.type  = ECMC_CFG_SNAPSHOT_ENTRY_CMD;
+  entry.index = 0;
+  entry.data  = command;
+  entries_.push_back(entry);
+  return 0;
+}
+
+int ecmcCfgSnapshot::addPLCFile(int plcIndex, const char *fileName) {
+  std::ifstream plcFile(fileName);
+
+  if (!plcFile.good()) {
+    LOGERR("%s/%s:%d: ERROR: Snapshot: Failed to read PLC file %s (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           fileName,
+           ERROR_CFG_SNAPSHOT_PLC_FILE_FAIL);
+    recording_ = false;
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_CFG_SNAPSHOT_PLC_FILE_FAIL);
+  }
+
+  std::stringstream source;
+  source << plcFile.rdbuf();
+
+  ecmcCfgSnapshotEntry entry;
+  entry.type  = ECMC_CFG_SNAPSHOT_ENTRY_PLC;
+  entry.index = plcIndex;
+  entry.data  = source.str();
+  entries_.push_back(entry);
+  return 0;
+}
+
+int ecmcCfgSnapshot::readBusSlaves(
+  std::vector<ecmcCfgSnapshotSlave> *slaves) {
+  int count     = 0;
+  int errorCode = ecGetBusSlaveCount(&count);
+
+  slaves->clear();
+
+  if (errorCode) {
+    return errorCode;
+  }
+
+  for (int i = 0; i < count; i++) {
+    ecmcCfgSnapshotSlave slave;
+    errorCode = ecGetBusSlaveIdentity(i,
+                                      &slave.vendorId,
+                                      &slave.productCode,
+                                      &slave.revisionNum);
+
+    if (errorCode) {
+      return errorCode;
+    }
+    slaves->push_back(slave);
+  }
+  return 0;
+}
+
+/* Cfg.EcSetMaster() is executed before load (not replayed) */
+bool ecmcCfgSnapshot::isSetMasterCmd(const ecmcCfgSnapshotEntry &entry,
+                                     int                        *masterIndex) {
+  return entry.type == ECMC_CFG_SNAPSHOT_ENTRY_CMD &&
+         sscanf(entry.data.c_str(), "Cfg.EcSetMaster(%d)", masterIndex) == 1;
+}
+
+uint32_t ecmcCfgSnapshot::checksum(uint32_t       hash,
+                                   const uint8_t *data,
+                                   size_t         bytes) {
+  for (size_t i = 0; i < bytes; i++) {
+    hash ^= data[i];
+    hash *= ECMC_CFG_SNAPSHOT_FNV_PRIME;
+  }
+  return hash;
+}
+
+int ecmcCfgSnapshot::save() {
+  recording_ = false;
+
+  int errorCode = readBusSlaves(&slaves_);
+
+  if (errorCode) {
+    LOGERR("%s/%s:%d: ERROR: Snapshot: Failed to read bus (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           errorCode);
+    return setErrorID(__FILE__, __FUNCTION__, __LINE__, errorCode);
+  }
+
+  asynParamCount_ = asynPortDriver_->getAvailParamCount();
+
+  // Body (slaves and entries)
+  std::string body;
+
+  for (size_t i = 0; i < slaves_.size(); i++) {
+    putU32(&body, slaves_[i].vendorId);
+    putU32(&body, slaves_[i].productCode);
+    putU32(&body, slaves_[i].revisionNum);
+  }
+
+  for (size_t i = 0; i < entries_.size(); i++) {
+    putU32(&body, entries_[i].type);
+    putU32(&body, (uint32_t)entries_[i].index);
+    putU32(&body, entries_[i].data.size());
+    body.append(entries_[i].data);
+  }
+
+  // Header
+  std::string header(ECMC_CFG_SNAPSHOT_MAGIC, ECMC_CFG_SNAPSHOT_MAGIC_LENGTH);
+  char version[ECMC_CFG_SNAPSHOT_ECMC_VERSION_LENGTH];
+  memset(version, 0, sizeof(version));
+  strncpy(version, git_version_str, sizeof(version) - 1);
+
+  putU32(&header, ECMC_CFG_SNAPSHOT_FORMAT_VERSION);
+  header.append(version, sizeof(version));
+  putU32(&header, asynParamCount_);
+  putU32(&header, slaves_.size());
+  putU32(&header, entries_.size());
+  putU32(&header,
+         checksum(ECMC_CFG_SNAPSHOT_FNV_OFFSET,
+                  (const uint8_t *)body.data(),
+                  body.size()));
+
+  FILE *file = fopen(fileName_.c_str(), "wb");
+
+  if (!file) {
+    LOGERR("%s/%s:%d: ERROR: Snapshot: Failed to open file %s (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           fileName_.c_str(),
+           ERROR_CFG_SNAPSHOT_FILE_OPEN_FAIL);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_CFG_SNAPSHOT_FILE_OPEN_FAIL);
+  }
+
+  bool ok = fwrite(header.data(), 1, header.size(), file) == header.size();
+  ok = ok && fwrite(body.data(), 1, body.size(), file) == body.size();
+  ok = (fclose(file) == 0) && ok;
+
+  if (!ok) {
+    LOGERR("%s/%s:%d: ERROR: Snapshot: Failed to write file %s (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           fileName_.c_str(),
+           ERROR_CFG_SNAPSHOT_FILE_WRITE_FAIL);
+    remove(fileName_.c_str());
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_CFG_SNAPSHOT_FILE_WRITE_FAIL);
+  }
+
+  printf("ecmc: Configuration snapshot written to %s (%d entries, %d slaves).\n",
+         fileName_.c_str(),
+         (int)entries_.size(),
+         (int)slaves_.size());
+  return 0;
+}
+
+int ecmcCfgSnapshot::load(const char *fileName) {
+  // Bus is read through the master
+  int masterIndex = 0;
+
+  if (ecGetMasterIndex(&masterIndex)) {
+    printf("ecmc: Configuration snapshot %s: EtherCAT master not set "
+           "(Cfg.EcSetMaster() needed before load).\n",
+           fileName);
+    return ERROR_MAIN_EC_NOT_INITIALIZED;
+  }
+
+  std::ifstream file(fileName, std::ios::binary);
+
+  if (!file.good()) {
+    printf("ecmc: Configuration snapshot %s not found.\n", fileName);
+    return ERROR_CFG_SNAPSHOT_FILE_OPEN_FAIL;
+  }
+
+  std::stringstream content;
+  content << file.rdbuf();
+  std::string data = content.str();
+  size_t pos       = ECMC_CFG_SNAPSHOT_MAGIC_LENGTH;
+
+  if ((data.size() < pos) ||
+      (data.compare(0, pos, ECMC_CFG_SNAPSHOT_MAGIC) != 0)) {
+    printf("ecmc: Configuration snapshot %s: Invalid file.\n", fileName);
+    return ERROR_CFG_SNAPSHOT_FILE_CORRUPT;
+  }
+
+  // Header
+  uint32_t formatVersion = 0;
+  uint32_t slaveCount    = 0;
+  uint32_t entryCount    = 0;
+  uint32_t sum           = 0;
+  int errorCode          = getU32(data, &pos, &formatVersion);
+
+  if (errorCode || (formatVersion != ECMC_CFG_SNAPSHOT_FORMAT_VERSION)) {
+    printf("ecmc: Configuration snapshot %s: Format version mismatch.\n",
+           fileName);
+    return ERROR_CFG_SNAPSHOT_VERSION_MISMATCH;
+  }
+
+  char version[ECMC_CFG_SNAPSHOT_ECMC_VERSION_LENGTH];
+  memset(version, 0, sizeof(version));
+  strncpy(version, git_version_str, sizeof(version) - 1);
+
+  if ((pos + sizeof(version) > data.size()) ||
+      (memcmp(data.data() + pos, version, sizeof(version)) != 0)) {
+    printf("ecmc: Configuration snapshot %s: ecmc version mismatch.\n",
+           fileName);
+    return ERROR_CFG_SNAPSHOT_VERSION_MISMATCH;
+  }
+  pos += sizeof(version);
+
+  errorCode = getU32(data, &pos, &asynParamCount_);
+  errorCode = errorCode ? errorCode : getU32(data, &pos, &slaveCount);
+  errorCode = errorCode ? errorCode : getU32(data, &pos, &entryCount);
+  errorCode = errorCode ? errorCode : getU32(data, &pos, &sum);
+
+  if (errorCode ||
+      (checksum(ECMC_CFG_SNAPSHOT_FNV_OFFSET,
+                (const uint8_t *)data.data() + pos,
+                data.size() - pos) != sum)) {
+    printf("ecmc: Configuration snapshot %s: Checksum error.\n", fileName);
+    return ERROR_CFG_SNAPSHOT_FILE_CORRUPT;
+  }
+
+  // Slaves
+  slaves_.clear();
+
+  for (uint32_t i = 0; i < slaveCount; i++) {
+    ecmcCfgSnapshotSlave slave;
+    errorCode = getU32(data, &pos, &slave.vendorId);
+    errorCode = errorCode ? errorCode : getU32(data, &pos, &slave.productCode);
+    errorCode = errorCode ? errorCode : getU32(data, &pos, &slave.revisionNum);
+
+    if (errorCode) {
+      return errorCode;
+    }
+    slaves_.push_back(slave);
+  }
+
+  // Entries
+  entries_.clear();
+
+  for (uint32_t i = 0; i < entryCount; i++) {
+    uint32_t type   = 0;
+    uint32_t index  = 0;
+    uint32_t length = 0;
+    errorCode = getU32(data, &pos, &type);
+    errorCode = errorCode ? errorCode : getU32(data, &pos, &index);
+    errorCode = errorCode ? errorCode : getU32(data, &pos, &length);
+
+    if (errorCode || (pos + length > data.size())) {
+      return ERROR_CFG_SNAPSHOT_FILE_CORRUPT;
+    }
+
+    ecmcCfgSnapshotEntry entry;
+    entry.type  = type;
+    entry.index = (int32_t)index;
+    entry.data  = data.substr(pos, length);
+    entries_.push_back(entry);
+    pos += length;
+  }
+
+  // Recorded master must be the selected master
+  for (size_t i = 0; i < entries_.size(); i++) {
+    int recordedIndex = 0;
+
+    if (isSetMasterCmd(entries_[i], &recordedIndex) &&
+        (recordedIndex != masterIndex)) {
+      printf("ecmc: Configuration snapshot %s: Master mismatch (%d, snapshot %d).\n",
+             fileName,
+             masterIndex,
+             recordedIndex);
+      return ERROR_CFG_SNAPSHOT_HW_MISMATCH;
+    }
+  }
+
+  // Hardware must be identical
+  std::vector<ecmcCfgSnapshotSlave> busSlaves;
+  errorCode = readBusSlaves(&busSlaves);
+
+  if (errorCode || (busSlaves.size() != slaves_.size())) {
+    printf("ecmc: Configuration snapshot %s: Bus mismatch (%d slaves, snapshot %d slaves).\n",
+           fileName,
+           (int)busSlaves.size(),
+           (int)slaves_.size());
+    return ERROR_CFG_SNAPSHOT_HW_MISMATCH;
+  }
+
+  for (size_t i = 0; i < slaves_.size(); i++) {
+    if ((busSlaves[i].vendorId != slaves_[i].vendorId) ||
+        (busSlaves[i].productCode != slaves_[i].productCode) ||
+        (busSlaves[i].revisionNum != slaves_[i].revisionNum)) {
+      printf("ecmc: Configuration snapshot %s: Slave %d mismatch (0x%x,0x%x,0x%x != 0x%x,0x%x,0x%x).\n",
+             fileName,
+             (int)i,
+             busSlaves[i].vendorId,
+             busSlaves[i].productCode,
+             busSlaves[i].revisionNum,
+             slaves_[i].vendorId,
+             slaves_[i].productCode,
+             slaves_[i].revisionNum);
+      return ERROR_CFG_SNAPSHOT_HW_MISMATCH;
+    }
+  }
+
+  errorCode = replay();
+
+  if (errorCode) {
+    return errorCode;
+  }
+
+  if ((uint32_t)asynPortDriver_->getAvailParamCount() != asynParamCount_) {
+    printf("ecmc: WARNING: Configuration snapshot %s: Asyn parameter count %d != %d.\n",
+           fileName,
+           asynPortDriver_->getAvailParamCount(),
+           asynParamCount_);
+  }
+
+  printf("ecmc: Configuration snapshot %s loaded (%d entries, %d slaves).\n",
+         fileName,
+         (int)entries_.size(),
+         (int)slaves_.size());
+  return 0;
+}
+
+int ecmcCfgSnapshot::replay() {
+  for (size_t i = 0; i < entries_.size(); i++) {
+    int errorCode   = 0;
+    int masterIndex = 0;
+
+    // Verified in load()
+    if (isSetMasterCmd(entries_[i], &masterIndex)) {
+      continue;
+    }
+
+    asynPortDriver_->lock();
+    clearBuffer(&replayBuffer_);
+
+    if (entries_[i].type == ECMC_CFG_SNAPSHOT_ENTRY_PLC) {
+      errorCode = loadPLCSource(entries_[i].index, entries_[i].data.c_str());
+    } else {
+      errorCode = motorHandleOneArg(entries_[i].data.c_str(), &replayBuffer_);
+
+      if (!errorCode &&
+          (strncmp(replayBuffer_.buffer, ECMC_RETURN_ERROR_STRING,
+                   strlen(ECMC_RETURN_ERROR_STRING)) == 0)) {
+        errorCode = ERROR_CFG_SNAPSHOT_REPLAY_FAIL;
+      }
+    }
+
+    asynPortDriver_->unlock();
+
+    if (errorCode) {
+      printf("ecmc: ERROR: Configuration snapshot entry %d failed (%s): %s\n",
+             (int)i,
+             entries_[i].type == ECMC_CFG_SNAPSHOT_ENTRY_PLC ? "PLC code" :
+             entries_[i].data.c_str(),
+             replayBuffer_.buffer);
+      return setErrorID(__FILE__,
+                        __FUNCTION__,
+                        __LINE__,
+                        ERROR_CFG_SNAPSHOT_REPLAY_FAIL);
+    }
+  }
+  return 0;
+}
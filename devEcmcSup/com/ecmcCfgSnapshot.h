@@ -0,0 +1,113 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcCfgSnapshot.h
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#ifndef ECMCCFGSNAPSHOT_H_
+#define ECMCCFGSNAPSHOT_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "../main/ecmcDefinitions.h"
+#include "../main/ecmcError.h"
+#include "ecmcOctetIF.h"
+#include "ecmcAsynPortDriver.h"
+
+#define ERROR_CFG_SNAPSHOT_FILE_OPEN_FAIL 0x20900
+#define ERROR_CFG_SNAPSHOT_FILE_WRITE_FAIL 0x20901
+#define ERROR_CFG_SNAPSHOT_FILE_CORRUPT 0x20902
+#define ERROR_CFG_SNAPSHOT_VERSION_MISMATCH 0x20903
+#define ERROR_CFG_SNAPSHOT_HW_MISMATCH 0x20904
+#define ERROR_CFG_SNAPSHOT_REPLAY_FAIL 0x20905
+#define ERROR_CFG_SNAPSHOT_PLC_FILE_FAIL 0x20906
+
+#define ECMC_CFG_SNAPSHOT_MAGIC "ECMCSNAP"
+#define ECMC_CFG_SNAPSHOT_MAGIC_LENGTH 8
+#define ECMC_CFG_SNAPSHOT_FORMAT_VERSION 1
+#define ECMC_CFG_SNAPSHOT_ECMC_VERSION_LENGTH 64
+
+enum ecmcCfgSnapshotEntryType {
+  ECMC_CFG_SNAPSHOT_ENTRY_CMD = 0,  // Config command
+  ECMC_CFG_SNAPSHOT_ENTRY_PLC = 1,  // PLC code of a loaded PLC file
+};
+
+typedef struct {
+  uint8_t     type;
+  int32_t     index;  // PLC index (only PLC entries)
+  std::string data;
+} ecmcCfgSnapshotEntry;
+
+typedef struct {
+  uint32_t vendorId;
+  uint32_t productCode;
+  uint32_t revisionNum;
+} ecmcCfgSnapshotSlave;
+
+/**
+ * \class ecmcCfgSnapshot
+ *
+ * \ingroup ecmc
+ *
+ * \brief Binary snapshot of a validated configuration
+ *
+ * While recording, all successful "Cfg." commands are stored in execution
+ * order and the code of loaded PLC files is embedded. The snapshot is
+ * written when the application successfully enters runtime
+ * (Cfg.SetAppMode(1)), that is when the configuration is validated.
+ *
+ * File layout (little endian):
+ *   magic[8], format version, ecmc version[64], asyn parameter count,
+ *   slave count, entry count, checksum (FNV-1a of the rest),
+ *   slaves (vendor id, product code, revision),
+ *   entries (type, index, length, data).
+ *
+ * At load the format and ecmc version and the bus (vendor/product/revision
+ * of each slave) are verified before any command is executed. On mismatch
+ * nothing is executed and the normal startup scripts must be used.
+ * The master must be set (Cfg.EcSetMaster()) before load since the bus is
+ * read through it. The recorded Cfg.EcSetMaster() is therefore only
+ * verified against the selected master and not replayed.
+ */
+class ecmcCfgSnapshot : public ecmcError {
+ public:
+  explicit ecmcCfgSnapshot(ecmcAsynPortDriver *asynPortDriver);
+  ~ecmcCfgSnapshot();
+  int  startRecord(const char *fileName);
+  bool getRecording();
+
+  // Called after each successful config command
+  int  addCommand(const char *command);
+  int  save();
+
+  // Verify and replay snapshot (returns error if fallback to scripts needed)
+  int  load(const char *fileName);
+
+ private:
+  void     initVars();
+  int      addPLCFile(int         plcIndex,
+                      const char *fileName);
+  int      readBusSlaves(std::vector<ecmcCfgSnapshotSlave> *slaves);
+  static bool isSetMasterCmd(const ecmcCfgSnapshotEntry &entry,
+                             int                        *masterIndex);
+  int      replay();
+  static uint32_t checksum(uint32_t       hash,
+                           const uint8_t *data,
+                           size_t         bytes);
+  ecmcAsynPortDriver *asynPortDriver_;
+  ecmcOutputBufferType replayBuffer_;
+  std::string fileName_;
+  bool recording_;
+  std::vector<ecmcCfgSnapshotEntry> entries_;
+  std::vector<ecmcCfgSnapshotSlave> slaves_;
+  uint32_t asynParamCount_;
+};
+
+#endif  /* ECMCCFGSNAPSHOT_H_ */
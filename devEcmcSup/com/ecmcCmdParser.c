@@ -107,7 +107,7 @@ static char cOneCommand[ECMC_CMD_MAX_SINGLE_CMD_LENGTH];
       cmd_buf_printf(buffer, "Error: %d", iRet);         \
       return 0;                                          \
     }                                                    \
-    cmd_buf_printf(buffer, "%u", u64Value);              \
+    cmd_buf_printf(buffer, "%" PRIu64, u64Value);        \
     return 0;                                            \
   }                                                      \
   while (0)
@@ -653,10 +653,12 @@ static int handleCfgCommand(const char *myarg_1) {
   int iValue9       = 0;
   int iValue10      = 0;
   uint64_t u64Value = 0;
+  int64_t  i64Value = 0;
 
   int nvals      = 0;
   double dValue  = 0;
   double dValue2 = 0;
+  double dValue3 = 0;
   
   /// "Cfg.SetAppMode(mode)"
   nvals = sscanf(myarg_1, "SetAppMode(%d)", &iValue);
@@ -693,6 +695,62 @@ static int handleCfgCommand(const char *myarg_1) {
     return setSamplePeriodMs(dValue);
   }
 
+  /// "Cfg.SetRtGuardMode(int mode)"
+  nvals = sscanf(myarg_1, "SetRtGuardMode(%d)", &iValue);
+
+  if (nvals == 1) {
+    return setRtGuardMode(iValue);
+  }
+
+  /// "Cfg.ClearRtGuard()"
+  nvals = strcmp(myarg_1, "ClearRtGuard()");
+
+  if (nvals == 0) {
+    return clearRtGuard();
+  }
+
+  /// "Cfg.ReportRtGuard()"
+  nvals = strcmp(myarg_1, "ReportRtGuard()");
+
+  if (nvals == 0) {
+    return reportRtGuard();
+  }
+
+  /// "Cfg.SetEnableConfigArena(int enable)"
+  nvals = sscanf(myarg_1, "SetEnableConfigArena(%d)", &iValue);
+
+  if (nvals == 1) {
+    return setEnableConfigArena(iValue);
+  }
+
+  /// "Cfg.ReportConfigArena()"
+  nvals = strcmp(myarg_1, "ReportConfigArena()");
+
+  if (nvals == 0) {
+    return reportConfigArena();
+  }
+
+  /// "Cfg.SetEnableAxisMonitorBatch(int enable)"
+  nvals = sscanf(myarg_1, "SetEnableAxisMonitorBatch(%d)", &iValue);
+
+  if (nvals == 1) {
+    return setEnableAxisMonitorBatch(iValue);
+  }
+
+  /// "Cfg.SetMaxEventObjects(int count)"
+  nvals = sscanf(myarg_1, "SetMaxEventObjects(%d)", &iValue);
+
+  if (nvals == 1) {
+    return setMaxEventObjects(iValue);
+  }
+
+  /// "Cfg.SetMaxDataStorageObjects(int count)"
+  nvals = sscanf(myarg_1, "SetMaxDataStorageObjects(%d)", &iValue);
+
+  if (nvals == 1) {
+    return setMaxDataStorageObjects(iValue);
+  }
+
   /// "Cfg.CreateAxis(axisIndex, axisType, drvType,trajType)"
   nvals = sscanf(myarg_1, "CreateAxis(%d,%d,%d,%d)", &iValue, &iValue2,&iValue3, &iValue4);
 
@@ -872,6 +930,21 @@ static int handleCfgCommand(const char *myarg_1) {
     return linkEcEntryToAxisStatusOutput(iValue, cIdBuffer, iValue2);
   }
 
+  /// "Cfg.LinkEcEntryToAxisPosCompareOutput(slaveBusPosition,entryIdString,axisIndex,bitIndex)"
+  nvals = sscanf(myarg_1,
+                 "LinkEcEntryToAxisPosCompareOutput(%d,%[^,],%d,%d)",
+                 &iValue,
+                 cIdBuffer,
+                 &iValue2,
+                 &iValue3);
+
+  if (nvals == 4) {
+    return linkEcEntryToAxisPosCompareOutput(iValue,
+                                             cIdBuffer,
+                                             iValue2,
+                                             iValue3);
+  }
+
   /// "Cfg.WriteEcEntryIDString(slaveBusPosition,entryIdString,value)"
   nvals = sscanf(myarg_1,
                  "WriteEcEntryIDString(%d,%[^,],%d)",
@@ -1267,6 +1340,13 @@ static int handleCfgCommand(const char *myarg_1) {
     return ecSelectReferenceDC(iValue, iValue2);
   }
 
+  /*Cfg.EcSetMaxMemMaps(int count)*/
+  nvals = sscanf(myarg_1, "EcSetMaxMemMaps(%d)", &iValue);
+
+  if (nvals == 1) {
+    return ecSetMaxMemMaps(iValue);
+  }
+
   /*Cfg.EcUseClockRealtime(int useClcRT)*/  
   nvals = sscanf(myarg_1, "EcUseClockRealtime(%d)", &iValue);
 
@@ -1274,6 +1354,13 @@ static int handleCfgCommand(const char *myarg_1) {
     return ecUseClockRealtime(iValue);
   }
 
+  /*Cfg.EcSetDcTimeEpochOffset(int64_t offsetNs)*/
+  nvals = sscanf(myarg_1, "EcSetDcTimeEpochOffset(%" SCNd64 ")", &i64Value);
+
+  if (nvals == 1) {
+    return ecSetDcTimeEpochOffset(i64Value);
+  }
+
   /*Cfg.EcSetEntryUpdateInRealtime(
       uint16_t slavePosition,
       char *entryIDString,
@@ -1480,6 +1567,116 @@ static int handleCfgCommand(const char *myarg_1) {
     return ecSetDiagnostics(iValue);
   }
 
+  /*Cfg.EcSetDiagThread(int enable, double periodMs)*/
+  nvals = sscanf(myarg_1, "EcSetDiagThread(%d,%lf)", &iValue, &dValue);
+
+  if (nvals == 2) {
+    return ecSetDiagThread(iValue, dValue);
+  }
+
+  /*Cfg.EcSetDcPll(int mode, int offsetNs)*/
+  nvals = sscanf(myarg_1, "EcSetDcPll(%d,%d)", &iValue, &iValue2);
+
+  if (nvals == 2) {
+    return ecSetDcPll(iValue, iValue2);
+  }
+
+  /*Cfg.EcSetDcPllGains(double kp, double ki)*/
+  nvals = sscanf(myarg_1, "EcSetDcPllGains(%lf,%lf)", &dValue, &dValue2);
+
+  if (nvals == 2) {
+    return ecSetDcPllGains(dValue, dValue2);
+  }
+
+  /*Cfg.EcSetDcPllLockWindow(int windowNs)*/
+  nvals = sscanf(myarg_1, "EcSetDcPllLockWindow(%d)", &iValue);
+
+  if (nvals == 1) {
+    return ecSetDcPllLockWindow(iValue);
+  }
+
+  /*Cfg.EcSetDcPllMock(double driftPpm, int initOffsetNs)*/
+  nvals = sscanf(myarg_1, "EcSetDcPllMock(%lf,%d)", &dValue, &iValue);
+
+  if (nvals == 2) {
+    return ecSetDcPllMock(dValue, iValue);
+  }
+
+  /*Cfg.EcAddMemMapPipe(char *memMapIDString, int dataStorageIndex,
+      double scale, double offset, int decimation)*/
+  cIdBuffer[0] = '\0';
+  nvals = sscanf(myarg_1,
+                 "EcAddMemMapPipe(%[^,],%d,%lf,%lf,%d)",
+                 cIdBuffer,
+                 &iValue,
+                 &dValue,
+                 &dValue2,
+                 &iValue2);
+
+  if (nvals == 5) {
+    return ecAddMemMapPipe(cIdBuffer, iValue, dValue, dValue2, iValue2);
+  }
+
+  /*Cfg.EcSetMemMapPipeFir(int index, double tap0, double tap1, ...)*/
+  cIdBuffer[0] = '\0';
+  nvals = sscanf(myarg_1, "EcSetMemMapPipeFir(%d,%[^)])", &iValue, cIdBuffer);
+
+  if (nvals == 2) {
+    return ecSetMemMapPipeFir(iValue, cIdBuffer);
+  }
+
+  /*Cfg.EcAddSdoQueue(int slavePosition, int poolSize)*/
+  nvals = sscanf(myarg_1, "EcAddSdoQueue(%d,%d)", &iValue, &iValue2);
+
+  if (nvals == 2) {
+    return ecAddSdoQueue(iValue, iValue2);
+  }
+
+  /*Cfg.EcAddMaster(int masterIndex)*/
+  nvals = sscanf(myarg_1, "EcAddMaster(%d)", &iValue);
+
+  if (nvals == 1) {
+    return ecAddMaster(iValue);
+  }
+
+  /*Cfg.EcSelectMaster(int masterIndex)*/
+  nvals = sscanf(myarg_1, "EcSelectMaster(%d)", &iValue);
+
+  if (nvals == 1) {
+    return ecSelectMaster(iValue);
+  }
+
+  /*Cfg.EcSetMasterThread(int masterIndex, double sampleRateHz, int priority,
+      int cpu)*/
+  nvals = sscanf(myarg_1,
+                 "EcSetMasterThread(%d,%lf,%d,%d)",
+                 &iValue,
+                 &dValue,
+                 &iValue2,
+                 &iValue3);
+
+  if (nvals == 4) {
+    return ecSetMasterThread(iValue, dValue, iValue2, iValue3);
+  }
+
+  /*Cfg.EcAddMailbox(int srcMaster, int srcSlave, char *srcEntry,
+      int dstMaster, int dstSlave, char *dstEntry)*/
+  cIdBuffer[0]  = '\0';
+  cIdBuffer2[0] = '\0';
+  nvals = sscanf(myarg_1,
+                 "EcAddMailbox(%d,%d,%[^,],%d,%d,%[^)])",
+                 &iValue,
+                 &iValue2,
+                 cIdBuffer,
+                 &iValue3,
+                 &iValue4,
+                 cIdBuffer2);
+
+  if (nvals == 6) {
+    return ecAddMailbox(iValue, iValue2, cIdBuffer, iValue3, iValue4,
+                        cIdBuffer2);
+  }
+
   /*Cfg.EcEnablePrintouts(int enable)*/
   nvals = sscanf(myarg_1, "EcEnablePrintouts(%d)", &iValue);
 
@@ -2116,6 +2313,13 @@ static int handleCfgCommand(const char *myarg_1) {
     return setEnableFunctionCallDiag(iValue);
   }
 
+  /*int Cfg.SetAsynArrayBlockCount(int count);*/
+  nvals = sscanf(myarg_1, "SetAsynArrayBlockCount(%d)", &iValue);
+
+  if (nvals == 1) {
+    return setAsynArrayBlockCount(iValue);
+  }
+
   /*int Cfg.SetTraceMask(int mask);*/  
   nvals = sscanf(myarg_1, "SetTraceMask(%d)", &iValue);
 
@@ -2160,6 +2364,243 @@ static int handleCfgCommand(const char *myarg_1) {
     return setAxisJerk(iValue, dValue);
   }
 
+  /*int Cfg.SetAxisTrajPreCalc(int axis_no, int enable);*/
+  nvals = sscanf(myarg_1, "SetAxisTrajPreCalc(%d,%d)", &iValue, &iValue2);
+
+  if (nvals == 2) {
+    return setAxisTrajPreCalc(iValue, iValue2);
+  }
+
+  /*int Cfg.CreateAxisGroup(int group_no);*/
+  nvals = sscanf(myarg_1, "CreateAxisGroup(%d)", &iValue);
+
+  if (nvals == 1) {
+    return createAxisGroup(iValue);
+  }
+
+  /*int Cfg.AddAxisToGroup(int group_no, int axis_no, double velo, double acc, double jerk);*/
+  nvals = sscanf(myarg_1,
+                 "AddAxisToGroup(%d,%d,%lf,%lf,%lf)",
+                 &iValue,
+                 &iValue2,
+                 &dValue,
+                 &dValue2,
+                 &dValue3);
+
+  if (nvals == 5) {
+    return addAxisToGroup(iValue, iValue2, dValue, dValue2, dValue3);
+  }
+
+  /*int Cfg.SetAxisGroupSyncType(int group_no, int sync_type);*/
+  nvals = sscanf(myarg_1, "SetAxisGroupSyncType(%d,%d)", &iValue, &iValue2);
+
+  if (nvals == 2) {
+    return setAxisGroupSyncType(iValue, iValue2);
+  }
+
+  /*int Cfg.SetAxisGroupTargetPos(int group_no, int axis_no, double position);*/
+  nvals = sscanf(myarg_1,
+                 "SetAxisGroupTargetPos(%d,%d,%lf)",
+                 &iValue,
+                 &iValue2,
+                 &dValue);
+
+  if (nvals == 3) {
+    return setAxisGroupTargetPos(iValue, iValue2, dValue);
+  }
+
+  /*int Cfg.SetAxisGroupExecute(int group_no, int execute);*/
+  nvals = sscanf(myarg_1, "SetAxisGroupExecute(%d,%d)", &iValue, &iValue2);
+
+  if (nvals == 2) {
+    return setAxisGroupExecute(iValue, iValue2);
+  }
+
+  /*int Cfg.SetAxisSyncMaster(int axis_no, int master_axis_no, int source);*/
+  nvals = sscanf(myarg_1,
+                 "SetAxisSyncMaster(%d,%d,%d)",
+                 &iValue,
+                 &iValue2,
+                 &iValue3);
+
+  if (nvals == 3) {
+    return setAxisSyncMaster(iValue, iValue2, iValue3);
+  }
+
+  /*int Cfg.SetAxisSyncMode(int axis_no, int mode);*/
+  nvals = sscanf(myarg_1, "SetAxisSyncMode(%d,%d)", &iValue, &iValue2);
+
+  if (nvals == 2) {
+    return setAxisSyncMode(iValue, iValue2);
+  }
+
+  /*int Cfg.SetAxisSyncGear(int axis_no, double ratio, double offset);*/
+  nvals = sscanf(myarg_1,
+                 "SetAxisSyncGear(%d,%lf,%lf)",
+                 &iValue,
+                 &dValue,
+                 &dValue2);
+
+  if (nvals == 3) {
+    return setAxisSyncGear(iValue, dValue, dValue2);
+  }
+
+  /*int Cfg.SetAxisSyncEngageTime(int axis_no, double time);*/
+  nvals = sscanf(myarg_1, "SetAxisSyncEngageTime(%d,%lf)", &iValue, &dValue);
+
+  if (nvals == 2) {
+    return setAxisSyncEngageTime(iValue, dValue);
+  }
+
+  /*int Cfg.SetAxisSyncCamModulo(int axis_no, int enable);*/
+  nvals = sscanf(myarg_1, "SetAxisSyncCamModulo(%d,%d)", &iValue, &iValue2);
+
+  if (nvals == 2) {
+    return setAxisSyncCamModulo(iValue, iValue2);
+  }
+
+  /*int Cfg.ClearAxisSyncCam(int axis_no);*/
+  nvals = sscanf(myarg_1, "ClearAxisSyncCam(%d)", &iValue);
+
+  if (nvals == 1) {
+    return clearAxisSyncCam(iValue);
+  }
+
+  /*int Cfg.AppendAxisSyncCamPoint(int axis_no, double master, double slave);*/
+  nvals = sscanf(myarg_1,
+                 "AppendAxisSyncCamPoint(%d,%lf,%lf)",
+                 &iValue,
+                 &dValue,
+                 &dValue2);
+
+  if (nvals == 3) {
+    return appendAxisSyncCamPoint(iValue, dValue, dValue2);
+  }
+
+  /*int Cfg.ActivateAxisSyncCam(int axis_no);*/
+  nvals = sscanf(myarg_1, "ActivateAxisSyncCam(%d)", &iValue);
+
+  if (nvals == 1) {
+    return activateAxisSyncCam(iValue);
+  }
+
+  /*int Cfg.SetAxisSyncEnable(int axis_no, int enable);*/
+  nvals = sscanf(myarg_1, "SetAxisSyncEnable(%d,%d)", &iValue, &iValue2);
+
+  if (nvals == 2) {
+    return setAxisSyncEnable(iValue, iValue2);
+  }
+
+  /*int Cfg.CreateAxisPvt(int axis_no, int size);*/
+  nvals = sscanf(myarg_1, "CreateAxisPvt(%d,%d)", &iValue, &iValue2);
+
+  if (nvals == 2) {
+    return createAxisPvt(iValue, iValue2);
+  }
+
+  /*int Cfg.AppendAxisPvtPoint(int axis_no, double time, double pos, double vel);*/
+  nvals = sscanf(myarg_1,
+                 "AppendAxisPvtPoint(%d,%lf,%lf,%lf)",
+                 &iValue,
+                 &dValue,
+                 &dValue2,
+                 &dValue3);
+
+  if (nvals == 4) {
+    return appendAxisPvtPoint(iValue, dValue, dValue2, dValue3);
+  }
+
+  /*int Cfg.ClearAxisPvt(int axis_no);*/
+  nvals = sscanf(myarg_1, "ClearAxisPvt(%d)", &iValue);
+
+  if (nvals == 1) {
+    return clearAxisPvt(iValue);
+  }
+
+  /*int Cfg.SetAxisPvtEnable(int axis_no, int enable);*/
+  nvals = sscanf(myarg_1, "SetAxisPvtEnable(%d,%d)", &iValue, &iValue2);
+
+  if (nvals == 2) {
+    return setAxisPvtEnable(iValue, iValue2);
+  }
+
+  /*int Cfg.CreateAxisEncLatchCapture(int axis_no, int size, int mode);*/
+  nvals = sscanf(myarg_1,
+                 "CreateAxisEncLatchCapture(%d,%d,%d)",
+                 &iValue,
+                 &iValue2,
+                 &iValue3);
+
+  if (nvals == 3) {
+    return createAxisEncLatchCapture(iValue, iValue2, iValue3);
+  }
+
+  /*int Cfg.CreateAxisPosCompare(int axis_no, int table_size);*/
+  nvals = sscanf(myarg_1, "CreateAxisPosCompare(%d,%d)", &iValue, &iValue2);
+
+  if (nvals == 2) {
+    return createAxisPosCompare(iValue, iValue2);
+  }
+
+  /*int Cfg.SetAxisPosCompareEquidistant(int axis_no, double start, double step, int count);*/
+  nvals = sscanf(myarg_1,
+                 "SetAxisPosCompareEquidistant(%d,%lf,%lf,%d)",
+                 &iValue,
+                 &dValue,
+                 &dValue2,
+                 &iValue2);
+
+  if (nvals == 4) {
+    return setAxisPosCompareEquidistant(iValue, dValue, dValue2, iValue2);
+  }
+
+  /*int Cfg.AppendAxisPosCompareTablePos(int axis_no, double pos);*/
+  nvals = sscanf(myarg_1,
+                 "AppendAxisPosCompareTablePos(%d,%lf)",
+                 &iValue,
+                 &dValue);
+
+  if (nvals == 2) {
+    return appendAxisPosCompareTablePos(iValue, dValue);
+  }
+
+  /*int Cfg.ClearAxisPosCompare(int axis_no);*/
+  nvals = sscanf(myarg_1, "ClearAxisPosCompare(%d)", &iValue);
+
+  if (nvals == 1) {
+    return clearAxisPosCompare(iValue);
+  }
+
+  /*int Cfg.SetAxisPosCompareDirection(int axis_no, int direction);*/
+  nvals = sscanf(myarg_1,
+                 "SetAxisPosCompareDirection(%d,%d)",
+                 &iValue,
+                 &iValue2);
+
+  if (nvals == 2) {
+    return setAxisPosCompareDirection(iValue, iValue2);
+  }
+
+  /*int Cfg.SetAxisPosComparePulseWidth(int axis_no, double seconds);*/
+  nvals = sscanf(myarg_1,
+                 "SetAxisPosComparePulseWidth(%d,%lf)",
+                 &iValue,
+                 &dValue);
+
+  if (nvals == 2) {
+    return setAxisPosComparePulseWidth(iValue, dValue);
+  }
+
+  /*int Cfg.SetAxisPosCompareEnable(int axis_no, int enable);*/
+  nvals = sscanf(myarg_1,
+                 "SetAxisPosCompareEnable(%d,%d)",
+                 &iValue,
+                 &iValue2);
+
+  if (nvals == 2) {
+    return setAxisPosCompareEnable(iValue, iValue2);
+  }
+
   /*int Cfg.SetAxisAcc(int axis_no, double value);*/
   nvals = sscanf(myarg_1, "SetAxisAcc(%d,%lf)", &iValue, &dValue);
 
@@ -2287,6 +2728,69 @@ static int handleCfgCommand(const char *myarg_1) {
     return setAxisEncPosFilterEnable(iValue, iValue2);
   }
 
+  /*int Cfg.SetAxisEncVelFilterType(int axis_no, int type);*/
+  nvals = sscanf(myarg_1,
+                 "SetAxisEncVelFilterType(%d,%d)",
+                 &iValue,
+                 &iValue2);
+
+  if (nvals == 2) {
+    return setAxisEncVelFilterType(iValue, iValue2);
+  }
+
+  /*int Cfg.SetAxisPLCTrajVelFilterType(int axis_no, int type);*/
+  nvals = sscanf(myarg_1,
+                 "SetAxisPLCTrajVelFilterType(%d,%d)",
+                 &iValue,
+                 &iValue2);
+
+  if (nvals == 2) {
+    return setAxisPLCTrajVelFilterType(iValue, iValue2);
+  }
+
+  /*int Cfg.SetAxisPLCEncVelFilterType(int axis_no, int type);*/
+  nvals = sscanf(myarg_1,
+                 "SetAxisPLCEncVelFilterType(%d,%d)",
+                 &iValue,
+                 &iValue2);
+
+  if (nvals == 2) {
+    return setAxisPLCEncVelFilterType(iValue, iValue2);
+  }
+
+  /*int Cfg.SetAxisEncVelFilterLowPass(int axis_no, double freq, int order);*/
+  nvals = sscanf(myarg_1,
+                 "SetAxisEncVelFilterLowPass(%d,%lf,%d)",
+                 &iValue,
+                 &dValue,
+                 &iValue2);
+
+  if (nvals == 3) {
+    return setAxisEncVelFilterLowPass(iValue, dValue, iValue2);
+  }
+
+  /*int Cfg.SetAxisPLCTrajVelFilterLowPass(int axis_no, double freq, int order);*/
+  nvals = sscanf(myarg_1,
+                 "SetAxisPLCTrajVelFilterLowPass(%d,%lf,%d)",
+                 &iValue,
+                 &dValue,
+                 &iValue2);
+
+  if (nvals == 3) {
+    return setAxisPLCTrajVelFilterLowPass(iValue, dValue, iValue2);
+  }
+
+  /*int Cfg.SetAxisPLCEncVelFilterLowPass(int axis_no, double freq, int order);*/
+  nvals = sscanf(myarg_1,
+                 "SetAxisPLCEncVelFilterLowPass(%d,%lf,%d)",
+                 &iValue,
+                 &dValue,
+                 &iValue2);
+
+  if (nvals == 3) {
+    return setAxisPLCEncVelFilterLowPass(iValue, dValue, iValue2);
+  }
+
   /*int Cfg.AppendAxisPLCExpr(int axis_no,char *cExpr); */
   nvals = sscanf(myarg_1,
                  "AppendAxisPLCExpr(%d)=%[^\n]",
@@ -2613,6 +3117,13 @@ static int handleCfgCommand(const char *myarg_1) {
     return linkStorageToRecorder(iValue, iValue2);
   }
 
+  /*int Cfg.LinkTimeStorageToRecorder(int indexStorage, int indexRecorder);*/
+  nvals = sscanf(myarg_1, "LinkTimeStorageToRecorder(%d,%d)", &iValue, &iValue2);
+
+  if (nvals == 2) {
+    return linkTimeStorageToRecorder(iValue, iValue2);
+  }
+
   /*Cfg.LinkEcEntryToRecorder(int indexRecorder,int recorderEntryIndex,
   int Slave, char *ecEntryIdString, int bitIndex)*/
   nvals = sscanf(myarg_1,
@@ -2728,6 +3239,21 @@ static int handleCfgCommand(const char *myarg_1) {
     return triggerCommandList(iValue);
   }
 
+  /*int Cfg.CreateDataGroup(int indexDataGroup, double publishPeriodMs);*/
+  nvals = sscanf(myarg_1, "CreateDataGroup(%d,%lf)", &iValue, &dValue);
+
+  if (nvals == 2) {
+    return createDataGroup(iValue, dValue);
+  }
+
+  /*int Cfg.AddDataGroupItem(int indexDataGroup, char *itemName);*/
+  cIdBuffer[0] = '\0';
+  nvals = sscanf(myarg_1, "AddDataGroupItem(%d,%[^)])", &iValue, cIdBuffer);
+
+  if (nvals == 2) {
+    return addDataGroupItem(iValue, cIdBuffer);
+  }
+
   /*int Cfg.IocshCmd=<command string>*/
   nvals = sscanf(myarg_1, "IocshCmd=%[^\n]",cExprBuffer);
   if (nvals == 1) {
@@ -3190,6 +3716,11 @@ int motorHandleOneArg(const char *myarg_1, ecmcOutputBufferType *buffer) {
     return 0;
   }
 
+  /* GetRtGuardCount()*/
+  if (!strcmp(myarg_1, "GetRtGuardCount()")) {
+    SEND_RESULT_OR_ERROR_AND_RETURN_INT(getRtGuardCount(&iValue));
+  }
+
   /* ControllerErrorReset()*/
   if (!strcmp(myarg_1, "ControllerErrorReset()")) {
     SEND_OK_OR_ERROR_AND_RETURN(controllerErrorReset());
@@ -3279,6 +3810,79 @@ int motorHandleOneArg(const char *myarg_1, ecmcOutputBufferType *buffer) {
                                                    iValue5, &u32Value));
   }
 
+  /*EcSdoQueueRead(int slavePosition, int sdoIndex, int sdoSubIndex,
+  int byteSize, int prio)*/
+  nvals = sscanf(myarg_1,
+                 "EcSdoQueueRead(%d,0x%x,0x%x,%d,%d)",
+                 &iValue2,
+                 &iValue3,
+                 &iValue4,
+                 &iValue5,
+                 &iValue);
+
+  if (nvals == 5) {
+    SEND_RESULT_OR_ERROR_AND_RETURN_INT(ecSdoQueueRead(iValue2, iValue3,
+                                                       iValue4, iValue5,
+                                                       iValue, &iValue));
+  }
+
+  /*EcSdoQueueReadBatch(int slavePosition, int prio,
+  index:subIndex:byteSize, ...)*/
+  cIdBuffer[0]  = '\0';
+  cIdBuffer2[0] = '\0';
+  nvals         = sscanf(myarg_1,
+                         "EcSdoQueueReadBatch(%d,%d,%[^)])",
+                         &iValue2,
+                         &iValue3,
+                         cIdBuffer);
+
+  if (nvals == 3) {
+    int iRet = ecSdoQueueReadBatch(iValue2, iValue3, cIdBuffer, cIdBuffer2,
+                                   sizeof(cIdBuffer2));
+
+    if (iRet) {
+      cmd_buf_printf(buffer, "Error: %d", iRet);
+      return 0;
+    }
+    cmd_buf_printf(buffer, "%s", cIdBuffer2);
+    return 0;
+  }
+
+  /*EcSdoQueueWrite(int slavePosition, int sdoIndex, int sdoSubIndex,
+  uint64_t value, int byteSize, int prio)*/
+  nvals = sscanf(myarg_1,
+                 "EcSdoQueueWrite(%d,0x%x,0x%x,%" SCNu64 ",%d,%d)",
+                 &iValue2,
+                 &iValue3,
+                 &iValue4,
+                 &u64Value,
+                 &iValue5,
+                 &iValue);
+
+  if (nvals == 6) {
+    SEND_RESULT_OR_ERROR_AND_RETURN_INT(ecSdoQueueWrite(iValue2, iValue3,
+                                                        iValue4, u64Value,
+                                                        iValue5, iValue,
+                                                        &iValue));
+  }
+
+  /*EcSdoQueueGetState(int slavePosition, int handle)*/
+  nvals = sscanf(myarg_1, "EcSdoQueueGetState(%d,%d)", &iValue2, &iValue3);
+
+  if (nvals == 2) {
+    SEND_RESULT_OR_ERROR_AND_RETURN_INT(ecSdoQueueGetState(iValue2, iValue3,
+                                                           &iValue));
+  }
+
+  /*EcSdoQueueGetValue(int slavePosition, int handle)*/
+  nvals = sscanf(myarg_1, "EcSdoQueueGetValue(%d,%d)", &iValue2, &iValue3);
+
+  if (nvals == 2) {
+    SEND_RESULT_OR_ERROR_AND_RETURN_UINT64(ecSdoQueueGetValue(iValue2,
+                                                              iValue3,
+                                                              &u64Value));
+  }
+
   /*EcReadSoE(uint16_t  slavePosition,
               uint8_t   driveNo,
               uint16_t  idn, 
@@ -3402,6 +4006,46 @@ int motorHandleOneArg(const char *myarg_1, ecmcOutputBufferType *buffer) {
     SEND_RESULT_OR_ERROR_AND_RETURN_INT(getAxisMonLatchLimit(motor_axis_no, &iValue));
   }
 
+  /*int GetAxisPvtFillLevel(int axis_no);*/
+  nvals = sscanf(myarg_1, "GetAxisPvtFillLevel(%d)", &motor_axis_no);
+
+  if (nvals == 1) {
+    SEND_RESULT_OR_ERROR_AND_RETURN_INT(getAxisPvtFillLevel(motor_axis_no,
+                                                            &iValue));
+  }
+
+  /*int GetAxisPvtUnderruns(int axis_no);*/
+  nvals = sscanf(myarg_1, "GetAxisPvtUnderruns(%d)", &motor_axis_no);
+
+  if (nvals == 1) {
+    SEND_RESULT_OR_ERROR_AND_RETURN_INT(getAxisPvtUnderruns(motor_axis_no,
+                                                            &iValue));
+  }
+
+  /*int GetAxisPvtState(int axis_no);*/
+  nvals = sscanf(myarg_1, "GetAxisPvtState(%d)", &motor_axis_no);
+
+  if (nvals == 1) {
+    SEND_RESULT_OR_ERROR_AND_RETURN_INT(getAxisPvtState(motor_axis_no,
+                                                        &iValue));
+  }
+
+  /*int GetAxisEncLatchCount(int axis_no);*/
+  nvals = sscanf(myarg_1, "GetAxisEncLatchCount(%d)", &motor_axis_no);
+
+  if (nvals == 1) {
+    SEND_RESULT_OR_ERROR_AND_RETURN_INT(getAxisEncLatchCount(motor_axis_no,
+                                                             &iValue));
+  }
+
+  /*int GetAxisPosCompareCount(int axis_no);*/
+  nvals = sscanf(myarg_1, "GetAxisPosCompareCount(%d)", &motor_axis_no);
+
+  if (nvals == 1) {
+    SEND_RESULT_OR_ERROR_AND_RETURN_INT(getAxisPosCompareCount(motor_axis_no,
+                                                               &iValue));
+  }
+
   /*int GetAxisEnableAlarmAtHardLimits(int axis_no);*/
   nvals =
     sscanf(myarg_1, "GetAxisEnableAlarmAtHardLimits(%d)", &motor_axis_no);
@@ -3676,6 +4320,14 @@ int motorHandleOneArg(const char *myarg_1, ecmcOutputBufferType *buffer) {
                                                         &iValue));
   }
 
+  /*int GetEventTriggerDcTime(int axis_no)*/
+  nvals = sscanf(myarg_1, "GetEventTriggerDcTime(%d)", &motor_axis_no);
+
+  if (nvals == 1) {
+    SEND_RESULT_OR_ERROR_AND_RETURN_UINT64(getEventTriggerDcTime(motor_axis_no,
+                                                                 &u64Value));
+  }
+
   /*int ReadDataStorage(int storageIndex);*/
   nvals = sscanf(myarg_1, "ReadDataStorage(%d)", &iValue);
 
@@ -16,6 +16,7 @@
 #include "../main/ecmcErrorsList.h"
 #include "../main/ecmcDefinitions.h"
 #include "../main/ecmcMainThread.h"
+#include "../main/ecmcConfigArena.h"
 
 //Below for asyn version and 64 bit ints
 #include "asynPortDriver.h"
@@ -47,6 +48,7 @@ int ecmcInit(void *asynPortObject) {
 
   asynPort = reinterpret_cast<ecmcAsynPortDriver *>(asynPortObject);  
   ec = new ecmcEc(asynPort);
+  ecCfg = ec;
 
   if(!ec) {
     LOGERR("ERROR: Fail allocate ec master (0x%x)",ERROR_MAIN_EC_NULL);
@@ -261,7 +263,12 @@ void ecmcCleanup() {
   delete plcs;
   plcs = NULL;
   
-  for(int i = 0; i < ECMC_MAX_EVENT_OBJECTS; i++) {
+  for(int i = 0; i < ECMC_MAX_AXIS_GROUPS; i++) {
+    delete axisGroups[i];
+    axisGroups[i] = NULL;
+  }
+
+  for(int i = 0; i < ecmcMaxEventObjects; i++) {
     delete events[i];
     events[i] = NULL;
   }
@@ -271,7 +278,7 @@ void ecmcCleanup() {
     dataRecorders[i] = NULL;
   }
 
-  for(int i = 0; i < ECMC_MAX_DATA_STORAGE_OBJECTS; i++) {
+  for(int i = 0; i < ecmcMaxDataStorageObjects; i++) {
     delete dataStorages[i];
     dataStorages[i] = NULL;
   }
@@ -281,6 +288,11 @@ void ecmcCleanup() {
     commandLists[i] = NULL;
   }
 
+  for(int i = 0;i < ECMC_MAX_DATA_GROUPS; i++) {
+    delete dataGroups[i];
+    dataGroups[i] = NULL;
+  }
+
   for(int i = 0;i < ECMC_MAX_PLUGINS; i++) {
     if(plugins[i]) {
       plugins[i]->exeDestructFunc();      
@@ -289,8 +301,18 @@ void ecmcCleanup() {
     plugins[i] = NULL;
   }
 
+  // Additional masters (stops threads)
+  for(int i = 1; i < ECMC_MAX_EC_MASTERS; i++) {
+    delete ecMasterThreads[i];
+    ecMasterThreads[i] = NULL;
+  }
+
   delete ec;
   ec = NULL;
+  ecCfg = NULL;
+
+  // Slaves, entries and asyn data items placed during configuration
+  ecmcConfigArena::release();
 }
 
 /**
@@ -352,6 +374,7 @@ int ecmcAddDefaultAsynParams() {
   }
   paramTemp->setAllowWriteToEcmc(false);
   paramTemp->refreshParam(1);
+  paramTemp->setRefreshScheduling(false);  // Reset on refresh
   mainAsynParams[ECMC_ASYN_MAIN_PAR_LATENCY_MIN_ID] = paramTemp;
 
   // ECMC_ASYN_MAIN_PAR_LATENCY_MAX_NAME
@@ -373,6 +396,7 @@ int ecmcAddDefaultAsynParams() {
   }
   paramTemp->setAllowWriteToEcmc(false);
   paramTemp->refreshParam(1);
+  paramTemp->setRefreshScheduling(false);  // Reset on refresh
   mainAsynParams[ECMC_ASYN_MAIN_PAR_LATENCY_MAX_ID] = paramTemp;
 
   // ECMC_ASYN_MAIN_PAR_PERIOD_MIN_NAME
@@ -394,6 +418,7 @@ int ecmcAddDefaultAsynParams() {
   }
   paramTemp->setAllowWriteToEcmc(false);
   paramTemp->refreshParam(1);
+  paramTemp->setRefreshScheduling(false);  // Reset on refresh
   mainAsynParams[ECMC_ASYN_MAIN_PAR_PERIOD_MIN_ID] = paramTemp;
 
   // ECMC_ASYN_MAIN_PAR_PERIOD_MAX_NAME
@@ -415,6 +440,7 @@ int ecmcAddDefaultAsynParams() {
   }
   paramTemp->setAllowWriteToEcmc(false);
   paramTemp->refreshParam(1);
+  paramTemp->setRefreshScheduling(false);  // Reset on refresh
   mainAsynParams[ECMC_ASYN_MAIN_PAR_PERIOD_MAX_ID] = paramTemp;
 
   // ECMC_ASYN_MAIN_PAR_EXECUTE_MIN_NAME
@@ -436,6 +462,7 @@ int ecmcAddDefaultAsynParams() {
   }
   paramTemp->setAllowWriteToEcmc(false);
   paramTemp->refreshParam(1);
+  paramTemp->setRefreshScheduling(false);  // Reset on refresh
   mainAsynParams[ECMC_ASYN_MAIN_PAR_EXECUTE_MIN_ID] = paramTemp;
 
   // ECMC_ASYN_MAIN_PAR_EXECUTE_MAX_NAME
@@ -457,6 +484,7 @@ int ecmcAddDefaultAsynParams() {
   }
   paramTemp->setAllowWriteToEcmc(false);
   paramTemp->refreshParam(1);
+  paramTemp->setRefreshScheduling(false);  // Reset on refresh
   mainAsynParams[ECMC_ASYN_MAIN_PAR_EXECUTE_MAX_ID] = paramTemp;
 
   // ECMC_ASYN_MAIN_PAR_SEND_MIN_NAME
@@ -478,6 +506,7 @@ int ecmcAddDefaultAsynParams() {
   }
   paramTemp->setAllowWriteToEcmc(false);
   paramTemp->refreshParam(1);
+  paramTemp->setRefreshScheduling(false);  // Reset on refresh
   mainAsynParams[ECMC_ASYN_MAIN_PAR_SEND_MIN_ID] = paramTemp;
 
   // ECMC_ASYN_MAIN_PAR_SEND_MAX_NAME
@@ -499,6 +528,7 @@ int ecmcAddDefaultAsynParams() {
   }
   paramTemp->setAllowWriteToEcmc(false);
   paramTemp->refreshParam(1);
+  paramTemp->setRefreshScheduling(false);  // Reset on refresh
   mainAsynParams[ECMC_ASYN_MAIN_PAR_SEND_MAX_ID] = paramTemp;
 
   // ECMC_ASYN_MAIN_PAR_APP_MODE_NAME
@@ -643,5 +673,112 @@ int ecmcAddDefaultAsynParams() {
   paramTemp->refreshParam(1);
   mainAsynParams[ECMC_ASYN_MAIN_PAR_STATUS_ID] = paramTemp;
 
+  // ECMC_ASYN_MAIN_PAR_ERROR_JOURNAL_NAME
+  // (ECMC_ERROR_JOURNAL_ENTRY_INTS int32 per entry, oldest first)
+  name = ECMC_ASYN_MAIN_PAR_ERROR_JOURNAL_NAME;
+  paramTemp = asynPort->addNewAvailParam(name,
+                                         asynParamInt32Array,
+                                         (uint8_t *)errorJournal,
+                                         sizeof(errorJournal),
+                                         ECMC_EC_S32,
+                                         0);
+  if(!paramTemp) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      name);
+    return ERROR_MAIN_ASYN_CREATE_PARAM_FAIL;
+  }
+  paramTemp->setAllowWriteToEcmc(false);
+  paramTemp->setArrayCheckSize(false);
+  paramTemp->refreshParam(1, (uint8_t *)errorJournal, 0);
+  mainAsynParams[ECMC_ASYN_MAIN_PAR_ERROR_JOURNAL_ID] = paramTemp;
+
+  // ECMC_ASYN_MAIN_PAR_ERROR_COUNT_NAME
+  name = ECMC_ASYN_MAIN_PAR_ERROR_COUNT_NAME;
+  paramTemp = asynPort->addNewAvailParam(name,
+                                         asynParamInt32,
+                                         (uint8_t *)&errorActiveCount,
+                                         sizeof(errorActiveCount),
+                                         ECMC_EC_S32,
+                                         0);
+  if(!paramTemp) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      name);
+    return ERROR_MAIN_ASYN_CREATE_PARAM_FAIL;
+  }
+  paramTemp->setAllowWriteToEcmc(false);
+  paramTemp->refreshParam(1);
+  mainAsynParams[ECMC_ASYN_MAIN_PAR_ERROR_COUNT_ID] = paramTemp;
+
+  // ECMC_ASYN_MAIN_PAR_PUBLISHED_NAME
+  name = ECMC_ASYN_MAIN_PAR_PUBLISHED_NAME;
+  paramTemp = asynPort->addNewAvailParam(name,
+                                         asynParamInt32,
+                                         (uint8_t *)&asynPublishedCount,
+                                         sizeof(asynPublishedCount),
+                                         ECMC_EC_U32,
+                                         0);
+  if(!paramTemp) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      name);
+    return ERROR_MAIN_ASYN_CREATE_PARAM_FAIL;
+  }
+  paramTemp->setAllowWriteToEcmc(false);
+  paramTemp->refreshParam(1);
+  mainAsynParams[ECMC_ASYN_MAIN_PAR_PUBLISHED_ID] = paramTemp;
+
+  // ECMC_ASYN_MAIN_PAR_SUPPRESSED_NAME
+  name = ECMC_ASYN_MAIN_PAR_SUPPRESSED_NAME;
+  paramTemp = asynPort->addNewAvailParam(name,
+                                         asynParamInt32,
+                                         (uint8_t *)&asynSuppressedCount,
+                                         sizeof(asynSuppressedCount),
+                                         ECMC_EC_U32,
+                                         0);
+  if(!paramTemp) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      name);
+    return ERROR_MAIN_ASYN_CREATE_PARAM_FAIL;
+  }
+  paramTemp->setAllowWriteToEcmc(false);
+  paramTemp->refreshParam(1);
+  mainAsynParams[ECMC_ASYN_MAIN_PAR_SUPPRESSED_ID] = paramTemp;
+
+  // ECMC_ASYN_MAIN_PAR_RT_GUARD_COUNT_NAME
+  name = ECMC_ASYN_MAIN_PAR_RT_GUARD_COUNT_NAME;
+  paramTemp = asynPort->addNewAvailParam(name,
+                                         asynParamInt32,
+                                         (uint8_t *)&rtGuardCount,
+                                         sizeof(rtGuardCount),
+                                         ECMC_EC_U32,
+                                         0);
+  if(!paramTemp) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      name);
+    return ERROR_MAIN_ASYN_CREATE_PARAM_FAIL;
+  }
+  paramTemp->setAllowWriteToEcmc(false);
+  paramTemp->refreshParam(1);
+  mainAsynParams[ECMC_ASYN_MAIN_PAR_RT_GUARD_COUNT_ID] = paramTemp;
+
   return 0;
 }
@@ -13,6 +13,9 @@
 #include "ecmcDataItem.h"
 #include "string.h"
 
+// Set by realtime threads (main thread and ecmcEcMasterThread)
+static __thread const uint64_t *cycleDcTimeNsSource = NULL;
+
 ecmcDataItem::ecmcDataItem(const char *name) {
   memset(&dataItem_,0,sizeof(dataItem_));
   for(int i = 0; i < ECMC_DATA_ITEM_MAX_CALLBACK_FUNCS; ++i) {
@@ -124,7 +127,24 @@ size_t ecmcDataItem::getEcmcDataMaxSize() {
   return ecmcMaxSize_;
 }
 
+void ecmcDataItem::setCycleDcTimeSource(const uint64_t *dcTimeNs) {
+  cycleDcTimeNsSource = dcTimeNs;
+}
+
+const uint64_t * ecmcDataItem::getCycleDcTimeSource() {
+  return cycleDcTimeNsSource;
+}
+
+uint64_t ecmcDataItem::getEcmcDataDcTimeNs() {
+  return dataItem_.dataDcTimeNs;
+}
+
 void ecmcDataItem::refresh() {
+  // Updates from non realtime threads keep the time of last cycle update
+  if (cycleDcTimeNsSource) {
+    dataItem_.dataDcTimeNs = *cycleDcTimeNsSource;
+  }
+
    //call callbacks to subscribers here
   for(int i = 0; i <= callbackFuncsMaxIndex_; ++i) {
     if(callbackFuncs_[i]) {
@@ -190,3 +210,12 @@ void ecmcDataItem::deregDataUpdatedCallback(int handle) {
     }    
   }
 }
+
+bool ecmcDataItem::hasDataUpdatedCallbacks() {
+  for(int i = 0; i <= callbackFuncsMaxIndex_; ++i) {
+    if(callbackFuncs_[i]) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -37,6 +37,7 @@ struct ecmcDataItemInfo{
   ecmcDataDir    dataDirection;
   double         dataUpdateRateMs;
   int            dataPointerValid;  
+  uint64_t       dataDcTimeNs;  // DC time of cycle of last update (ns since 2000)
 };
 
 /**  
@@ -75,6 +76,12 @@ class ecmcDataItem {
   void    setEcmcDataMaxSize(size_t bytes);
   size_t  getEcmcDataMaxSize();
   char *  getName();
+  uint64_t getEcmcDataDcTimeNs();
+
+  /** DC time of the cycle executed by the calling thread
+      (refresh() stamps data items with it) */
+  static void setCycleDcTimeSource(const uint64_t *dcTimeNs);
+  static const uint64_t *getCycleDcTimeSource();
 
   ecmcDataItemInfo *getDataItemInfo();
 
@@ -94,6 +101,9 @@ class ecmcDataItem {
   *   (retuned by regDataUpdatedCallback()) */
   void deregDataUpdatedCallback(int handle);
 
+  /** True if any data updated callback is registered */
+  bool hasDataUpdatedCallbacks();
+
  protected:
   virtual void refresh();
 
@@ -14,13 +14,17 @@
 #include <cmath>
 #include <time.h>
 #include <string>
+#include "epicsThread.h"
 #include "../main/ecmcErrorsList.h"
 
-ecmcEc::ecmcEc(ecmcAsynPortDriver *asynPortDriver) {
+ecmcEc::ecmcEc(ecmcAsynPortDriver *asynPortDriver, int masterSlot) {
   initVars();
+  registerErrorObject(ECMC_ERROR_OBJ_EC, masterSlot);
   setErrorID(ERROR_EC_STATUS_NOT_OK);
   asynPortDriver_ = asynPortDriver;
-  simSlave_ = new ecmcEcSlave(asynPortDriver_,0 ,NULL, NULL,0, -1, 0, 0);  
+  masterSlot_     = masterSlot;
+  // Slot used as master id of simulation entries (unique asyn names)
+  simSlave_ = new ecmcEcSlave(asynPortDriver_,masterSlot ,NULL, NULL,0, -1, 0, 0);  
 }
 
 void ecmcEc::initVars() {
@@ -72,13 +76,51 @@ void ecmcEc::initVars() {
   memset(&masterState_, 0, sizeof(masterState_));
   memset(&domainStateOld_,0,sizeof(domainStateOld_));
   memset(&masterStateOld_,0,sizeof(masterStateOld_));
+  memset(&masterStateRead_,0,sizeof(masterStateRead_));
+  memset(slaveStates_,0,sizeof(slaveStates_));
+  diagThreadEnable_   = false;
+  diagThreadPeriodMs_ = ECMC_EC_DIAG_THREAD_PERIOD_MS;
+  diagThreadRun_      = false;
+  diagThreadRunning_  = false;
+  diagThreadExit_     = NULL;
+  diagStateSeq_        = 0;
+  diagStateSeqApplied_ = 0;
+  memset(&diagMasterStatePoll_,0,sizeof(diagMasterStatePoll_));
+  memset(diagSlaveStatesPoll_,0,sizeof(diagSlaveStatesPoll_));
+  memset(&diagMasterState_,0,sizeof(diagMasterState_));
+  memset(diagSlaveStates_,0,sizeof(diagSlaveStates_));
+  dcPll_              = NULL;
+  dcAppTimeNs_        = 0;
+  lastAppTimeNs_      = 0;
+  cycleDcTimeNs_      = 0;
+  dcTimeEpochOffsetNs_ = 0;
+  asynDcTimeNs_       = 0;
+  asynSnapshot_       = false;
+  asynSnapshotSeq_    = 0;
+  asynSnapshotSeqLoaded_ = 0;
+  asynSnapshotDcTimeNs_ = 0;
+  memset(asynWriteQueue_,0,sizeof(asynWriteQueue_));
+  asynWriteHead_      = 0;
+  asynWriteTail_      = 0;
+  masterSlot_         = 0;
+  dcSendTimeNs_       = 0;
+  sdoQueuesActiveCount_ = 0;
+  memset(sdoQueuesActive_,0,sizeof(sdoQueuesActive_));
+  memMapPipeCounter_    = 0;
+  memset(memMapPipes_,0,sizeof(memMapPipes_));
+  mailboxOutCounter_    = 0;
+  memset(mailboxesOut_,0,sizeof(mailboxesOut_));
+  mailboxInCounter_     = 0;
+  memset(mailboxesIn_,0,sizeof(mailboxesIn_));
   
   inStartupPhase_ = true;
   asynPortDriver_ = NULL;
 
   ecMemMapArrayCounter_ = 0;
+  ecMemMapArraySize_    = EC_MAX_MEM_MAPS;
+  ecMemMapArray_        = new ecmcEcMemMap*[ecMemMapArraySize_];
 
-  for (int i = 0; i < EC_MAX_MEM_MAPS; i++) {
+  for (int i = 0; i < ecMemMapArraySize_; i++) {
     ecMemMapArray_[i] = NULL;
   }
   domainSize_        = 0;
@@ -129,6 +171,11 @@ int ecmcEc::init(int nMasterIndex) {
 ecmcEc::~ecmcEc() {
   LOGINFO5("%s/%s:%d: INFO: Deleting Ec.\n", __FILE__, __FUNCTION__, __LINE__);
 
+  stopDiagThread();
+
+  delete dcPll_;
+  dcPll_ = NULL;
+
   for (int i = 0; i < slaveCounter_; i++) {
     delete slaveArray_[i];
     slaveArray_[i] = NULL;
@@ -139,10 +186,23 @@ ecmcEc::~ecmcEc() {
     simSlave_ = NULL;
   }
 
-  for (int i = 0; i < EC_MAX_MEM_MAPS; i++) {
+  for (int i = 0; i < mailboxOutCounter_; i++) {
+    delete mailboxesOut_[i];
+    mailboxesOut_[i] = NULL;
+  }
+
+  // Pipes refer to memmaps
+  for (int i = 0; i < EC_MAX_MEM_MAP_PIPES; i++) {
+    delete memMapPipes_[i];
+    memMapPipes_[i] = NULL;
+  }
+
+  for (int i = 0; i < ecMemMapArraySize_; i++) {
     delete ecMemMapArray_[i];
     ecMemMapArray_[i] = NULL;
   }
+  delete[] ecMemMapArray_;
+  ecMemMapArray_ = NULL;
 
   for (int i = 0; i < ECMC_ASYN_EC_PAR_COUNT; i++) {
     delete ecAsynParams_[i];
@@ -318,7 +378,12 @@ int ecmcEc::activate() {
     }
   }
 
-  return validate();
+  int errorCode = validate();
+  if (errorCode) {
+    return errorCode;
+  }
+
+  return startDiagThread();
 }
 
 int ecmcEc::compileRegInfo() {
@@ -421,7 +486,7 @@ void ecmcEc::checkDomainState(void) {
   ecStatOk_= domainState_.wc_state ==  EC_WC_COMPLETE;
 }
 
-bool ecmcEc::checkSlavesConfState() {
+bool ecmcEc::checkSlavesConfState(bool readState) {
 
   if (!diag_) {
     slavesOK_ = true;
@@ -432,7 +497,7 @@ bool ecmcEc::checkSlavesConfState() {
   int retVal = 0;
 
   for (int i = 0; i < slaveCounter_; i++) {
-    retVal = checkSlaveConfState(i);
+    retVal = checkSlaveConfState(i, readState);
     if (retVal && !getErrorID()) {
       LOGERR(
         "%s/%s:%d: ERROR: Slave with bus position %d reports error (0x%x).\n",
@@ -455,7 +520,7 @@ bool ecmcEc::checkSlavesConfState() {
   return slavesOK_;
 }
 
-int ecmcEc::checkSlaveConfState(int slaveIndex) {
+int ecmcEc::checkSlaveConfState(int slaveIndex, bool readState) {
   if (!diag_) {
     return 0;
   }
@@ -484,22 +549,25 @@ int ecmcEc::checkSlaveConfState(int slaveIndex) {
                       ERROR_EC_MAIN_SLAVE_NULL);
   }
 
-  return slaveArray_[slaveIndex]->checkConfigState();
+  return slaveArray_[slaveIndex]->checkConfigState(readState);
 }
 
-bool ecmcEc::checkState(void) {
+bool ecmcEc::checkState(bool readState) {
   if (!diag_) {
     masterOK_ = true;
     return true;
   }
 
-  bool slavesUp = checkSlavesConfState();
+  bool slavesUp = checkSlavesConfState(readState);
 
   if (!slavesUp) {
     return slavesUp;
   }
 
-  ecrt_master_state(master_, &masterState_);
+  if (readState) {
+    ecrt_master_state(master_, &masterStateRead_);
+  }
+  masterState_ = masterStateRead_;
  
   //Build master status word
   statusWordMaster_ = 0;
@@ -594,20 +662,21 @@ bool ecmcEc::checkState(void) {
 void ecmcEc::receive() {
   ecrt_master_receive(master_);
   ecrt_domain_process(domain_);
-  
-  // struct timespec timeRel, timeAbs;
-  // epicsTimeStamp epicsTime;
-  // if (useClockRealtime_) {    
-    // clock_gettime(CLOCK_REALTIME, &timeAbs);
-  // } else {
-    // clock_gettime(CLOCK_MONOTONIC, &timeRel);
-    // timeAbs = timespecAdd(timeRel, timeOffset_);
-  // }
-
-  //epicsTimeFromTimespec (&epicsTime,&timeAbs);
-  //asynPortDriver_->setTimeStamp(&epicsTime);
-  
+
+  // Inputs in this cycle were sampled relative to the last sent frame
+  cycleDcTimeNs_ = lastAppTimeNs_;
+
+  // Asyn time of all data updated in this cycle (only the primary master,
+  // masters in own threads do not hold the asyn port lock)
+  if (masterSlot_ == 0 && cycleDcTimeNs_ > 0) {
+    dcTimeToEpicsTime(cycleDcTimeNs_, &epicsTime_);
+    asynPortDriver_->setTimeStamp(&epicsTime_);
+  }
+
   updateInputProcessImage();
+  publishMailboxes();
+  executeMemMapPipes();
+  executeSdoQueues();
 }
 
 void ecmcEc::send(timespec timeOffset) {
@@ -617,6 +686,7 @@ void ecmcEc::send(timespec timeOffset) {
     statusOutputEntry_->writeValue((uint64_t)(getErrorID() == 0));
   }
 
+  consumeMailboxes();
   updateOutProcessImage();
 
   ecrt_domain_queue(domain_);
@@ -627,17 +697,37 @@ void ecmcEc::send(timespec timeOffset) {
     clock_gettime(CLOCK_MONOTONIC, &timeRel_);
     timeAbs_= timespecAdd(timeRel_, timeOffset_);
   }
-  
-  ecrt_master_application_time(master_, TIMESPEC2NS(timeAbs_));
-  ecrt_master_sync_reference_clock(master_);
+
+  if (dcPll_ && dcPll_->getEnable()) {
+    // Application time on nominal grid (remove wakeup shift)
+    uint64_t sendTimeNs = TIMESPEC2NS(timeAbs_);
+    uint64_t appTimeNs  = sendTimeNs - dcPll_->getShiftNs();
+    uint32_t refTimeNs  = 0;
+    bool     refValid   = false;
+
+    if (dcPll_->getMode() == ECMC_EC_DC_PLL_MODE_REF_CLOCK) {
+      // Reference clock time latched by last frame
+      refValid = ecrt_master_reference_clock_time(master_, &refTimeNs) == 0;
+    }
+    dcPll_->execute(dcAppTimeNs_, dcSendTimeNs_, refTimeNs, refValid);
+    dcAppTimeNs_  = appTimeNs;
+    dcSendTimeNs_ = sendTimeNs;
+    lastAppTimeNs_ = appTimeNs;
+    ecrt_master_application_time(master_, appTimeNs);
+
+    // Reference clock is master (no sync of reference clock to master)
+    if (dcPll_->getMode() != ECMC_EC_DC_PLL_MODE_REF_CLOCK) {
+      ecrt_master_sync_reference_clock(master_);
+    }
+  } else {
+    lastAppTimeNs_ = TIMESPEC2NS(timeAbs_);
+    ecrt_master_application_time(master_, lastAppTimeNs_);
+    ecrt_master_sync_reference_clock(master_);
+  }
   ecrt_master_sync_slave_clocks(master_);
   
   ecrt_master_send(master_);
 
-  //Update asyn time
-  epicsTimeFromTimespec (&epicsTime_,&timeAbs_);
-  asynPortDriver_->setTimeStamp(&epicsTime_);
-
   // Delay ecOK at startup for delayEcOKCycles_ after ecOK
   if(inStartupPhase_) {
     if(slavesOK_ && domainOK_ && masterOK_) {
@@ -1077,7 +1167,11 @@ void ecmcEc::slowExecute() {
     domainNotOKCyclesLimit_,
     getErrorID());
 
-  checkState();
+  // State is checked in diagnostics thread if running
+  if (!diagThreadRunning_) {
+    checkState();
+    updateSlaveStates();
+  }
 
   domainNotOKCounterMax_ = 0;
 }
@@ -1121,7 +1215,7 @@ int ecmcEc::addMemMap(uint16_t       startEntryBusPosition,
                       ERROR_EC_MAIN_SLAVE_NULL);
   }
 
-  if (ecMemMapArrayCounter_ >= EC_MAX_MEM_MAPS) {
+  if (ecMemMapArrayCounter_ >= ecMemMapArraySize_) {
     LOGERR("%s/%s:%d: ERROR: Adding ecMemMap failed. Array full (0x%x).\n",
            __FILE__,
            __FUNCTION__,
@@ -1210,6 +1304,43 @@ ecmcEcMemMap * ecmcEc::getMemMap(int index) {
   return ecMemMapArray_[index];
 }
 
+int ecmcEc::setMaxMemMaps(int count) {
+  if (count <= 0 || count > ECMC_MAX_OBJECTS_LIMIT) {
+    LOGERR("%s/%s:%d: ERROR: Max memmap count out of range 1..%d (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           ECMC_MAX_OBJECTS_LIMIT,
+           ERROR_EC_MEM_MAP_MAX_COUNT_OUT_OF_RANGE);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MEM_MAP_MAX_COUNT_OUT_OF_RANGE);
+  }
+
+  if (ecMemMapArrayCounter_ > 0) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Max memmap count can only be changed prior memmap creation (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      ERROR_EC_MEM_MAP_MAX_COUNT_CHANGE_NOT_ALLOWED);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MEM_MAP_MAX_COUNT_CHANGE_NOT_ALLOWED);
+  }
+
+  delete[] ecMemMapArray_;
+  ecMemMapArraySize_ = count;
+  ecMemMapArray_     = new ecmcEcMemMap*[ecMemMapArraySize_];
+
+  for (int i = 0; i < ecMemMapArraySize_; i++) {
+    ecMemMapArray_[i] = NULL;
+  }
+  return 0;
+}
+
 int ecmcEc::setEcStatusOutputEntry(ecmcEcEntry *entry) {
   statusOutputEntry_ = entry;
   return 0;
@@ -1466,6 +1597,41 @@ int ecmcEc::initAsyn(ecmcAsynPortDriver *asynPortDriver) {
   paramTemp->refreshParam(1);
   ecAsynParams_[ECMC_ASYN_EC_STAT_OK_ID] = paramTemp;
 
+  // ec<id>.slavestates
+  charCount = snprintf(buffer,
+                       sizeof(buffer),
+                       ECMC_EC_STR "%d." ECMC_ASYN_EC_PAR_SLAVE_STATES_NAME,
+                       masterIndex_);
+  if (charCount >= sizeof(buffer) - 1) {
+    LOGERR(
+      "%s/%s:%d: Error: Failed to generate alias. Buffer to small (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      ERROR_EC_REG_ASYN_PAR_BUFFER_OVERFLOW);
+    return ERROR_EC_REG_ASYN_PAR_BUFFER_OVERFLOW;
+  }
+  name = buffer;
+  paramTemp = asynPortDriver_->addNewAvailParam(name,
+                                         asynParamInt8Array,
+                                         slaveStates_,
+                                         sizeof(slaveStates_),
+                                         ECMC_EC_U8,
+                                         0);
+  if(!paramTemp) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      name);
+    return ERROR_MAIN_ASYN_CREATE_PARAM_FAIL;
+  }
+  paramTemp->setAllowWriteToEcmc(false);
+  paramTemp->setArrayCheckSize(false);
+  paramTemp->refreshParam(1, slaveStates_, slaveCounter_);
+  ecAsynParams_[ECMC_ASYN_EC_PAR_SLAVE_STATES_ID] = paramTemp;
+
   asynPortDriver_->callParamCallbacks(ECMC_ASYN_DEFAULT_LIST, ECMC_ASYN_DEFAULT_ADDR);
 
   return 0;
@@ -2003,6 +2169,36 @@ int ecmcEc::checkReadyForRuntime() {
   return 0;
 }
 
+uint64_t ecmcEc::getCycleDcTimeNs() {
+  return cycleDcTimeNs_;
+}
+
+const uint64_t * ecmcEc::getCycleDcTimeNsPtr() {
+  return &cycleDcTimeNs_;
+}
+
+int ecmcEc::setDcTimeEpochOffset(int64_t offsetNs) {
+  dcTimeEpochOffsetNs_ = offsetNs;
+  return 0;
+}
+
+int64_t ecmcEc::getDcTimeEpochOffset() {
+  return dcTimeEpochOffsetNs_;
+}
+
+void ecmcEc::dcTimeToEpicsTime(uint64_t        dcTimeNs,
+                               epicsTimeStamp *epicsTime) {
+  int64_t timeNs = (int64_t)dcTimeNs + dcTimeEpochOffsetNs_;
+
+  if (timeNs < 0) {
+    timeNs = 0;
+  }
+
+  epicsTime->secPastEpoch = (epicsUInt32)(timeNs / MCU_NSEC_PER_SEC +
+                                          ECMC_DC_EPOCH_SEC_PAST_EPICS_EPOCH);
+  epicsTime->nsec         = (epicsUInt32)(timeNs % MCU_NSEC_PER_SEC);
+}
+
 uint64_t ecmcEc::getTimeNs() {
   struct timespec timeRel, timeAbs;
 
@@ -2285,3 +2481,798 @@ int ecmcEc::addSDOAsync(uint16_t slaveBusPosition,
                             dt,
                             idString);
 }
+
+int ecmcEc::setDiagThread(int enable, double periodMs) {
+  if (diagThreadRunning_) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Diagnostics thread already running. Change not allowed (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      ERROR_EC_DIAG_THREAD_CHANGE_NOT_ALLOWED);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_DIAG_THREAD_CHANGE_NOT_ALLOWED);
+  }
+
+  if (periodMs < ECMC_EC_DIAG_THREAD_PERIOD_MIN_MS) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Diagnostics thread period out of range (min %d ms) (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      ECMC_EC_DIAG_THREAD_PERIOD_MIN_MS,
+      ERROR_EC_DIAG_THREAD_PERIOD_OUT_OF_RANGE);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_DIAG_THREAD_PERIOD_OUT_OF_RANGE);
+  }
+
+  diagThreadEnable_   = enable;
+  diagThreadPeriodMs_ = periodMs;
+  return 0;
+}
+
+bool ecmcEc::getDiagThreadRunning() {
+  return diagThreadRunning_;
+}
+
+static void ecmcEcDiagThread(void *arg) {
+  ecmcEc *ec = (ecmcEc *)arg;
+
+  ec->diagThreadExecute();
+}
+
+/* Called at activation (not realtime) */
+int ecmcEc::startDiagThread() {
+  if (!diagThreadEnable_ || !diag_ || diagThreadRunning_) {
+    return 0;
+  }
+
+  diagThreadExit_ = epicsEventCreate(epicsEventEmpty);
+  diagThreadRun_  = true;
+
+  if (epicsThreadCreate(ECMC_EC_DIAG_THREAD_NAME,
+                        epicsThreadPriorityLow,
+                        epicsThreadGetStackSize(epicsThreadStackMedium),
+                        ecmcEcDiagThread,
+                        this) == NULL) {
+    diagThreadRun_ = false;
+    LOGERR(
+      "%s/%s:%d: ERROR: Create of diagnostics thread failed (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      ERROR_EC_DIAG_THREAD_CREATE_FAIL);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_DIAG_THREAD_CREATE_FAIL);
+  }
+
+  // State checks are no longer made in realtime thread
+  diagThreadRunning_ = true;
+  LOGINFO4("%s/%s:%d: INFO: Created EtherCAT diagnostics thread (period %lf ms).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           diagThreadPeriodMs_);
+  return 0;
+}
+
+void ecmcEc::stopDiagThread() {
+  if (!diagThreadRunning_) {
+    return;
+  }
+
+  diagThreadRun_ = false;
+  epicsEventWaitWithTimeout(diagThreadExit_, diagThreadPeriodMs_ / 1000 * 5);
+  epicsEventDestroy(diagThreadExit_);
+  diagThreadExit_    = NULL;
+  diagThreadRunning_ = false;
+}
+
+/*
+ * Diagnostics thread (not realtime, no asyn port lock):
+ * 1. Poll slave and master states (ioctl calls).
+ * 2. Publish the states (sequence counted). The realtime thread evaluates
+ *    them in applyDiagState() (errors, entry com alarms, status words and
+ *    the summary bits read by statusOK()).
+ */
+void ecmcEc::diagThreadExecute() {
+  while (diagThreadRun_) {
+    epicsThreadSleep(diagThreadPeriodMs_ / 1000);
+
+    if (!diagThreadRun_) {
+      break;
+    }
+
+    for (int i = 0; i < slaveCounter_; i++) {
+      if (slaveArray_[i]) {
+        slaveArray_[i]->readConfigState(&diagSlaveStatesPoll_[i]);
+      }
+    }
+    ecrt_master_state(master_, &diagMasterStatePoll_);
+
+    // Publish (short copy, realtime thread skips if torn)
+    uint32_t seq = diagStateSeq_;
+    __atomic_store_n(&diagStateSeq_, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    diagMasterState_ = diagMasterStatePoll_;
+    memcpy(diagSlaveStates_, diagSlaveStatesPoll_,
+           sizeof(diagSlaveStates_[0]) * slaveCounter_);
+    __atomic_store_n(&diagStateSeq_, seq + 2, __ATOMIC_RELEASE);
+  }
+
+  epicsEventSignal(diagThreadExit_);
+}
+
+/* Realtime: evaluate states published by diagnostics thread.
+ * Nothing is done if no new states or if the states are being written
+ * (retried next cycle). */
+void ecmcEc::applyDiagState() {
+  uint32_t seq = __atomic_load_n(&diagStateSeq_, __ATOMIC_ACQUIRE);
+
+  if ((seq == diagStateSeqApplied_) || (seq & 1)) {
+    return;
+  }
+
+  ec_master_state_t masterState = diagMasterState_;
+
+  for (int i = 0; i < slaveCounter_; i++) {
+    if (slaveArray_[i]) {
+      slaveArray_[i]->setConfigStateRead(&diagSlaveStates_[i]);
+    }
+  }
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+  if (__atomic_load_n(&diagStateSeq_, __ATOMIC_RELAXED) != seq) {
+    return;
+  }
+  diagStateSeqApplied_ = seq;
+  masterStateRead_     = masterState;
+  checkState(false);
+  updateSlaveStates();
+}
+
+// Update compact state snapshot (ec<id>.slavestates)
+void ecmcEc::updateSlaveStates() {
+  bool changed = false;
+
+  for (int i = 0; i < slaveCounter_; i++) {
+    if (!slaveArray_[i]) {
+      continue;
+    }
+    uint8_t state = slaveArray_[i]->getStateSummary();
+
+    if (state != slaveStates_[i]) {
+      slaveStates_[i] = state;
+      changed         = true;
+    }
+  }
+
+  if (changed && ecAsynParams_[ECMC_ASYN_EC_PAR_SLAVE_STATES_ID]) {
+    ecAsynParams_[ECMC_ASYN_EC_PAR_SLAVE_STATES_ID]->refreshParamRT(
+      1,
+      slaveStates_,
+      slaveCounter_);
+  }
+}
+
+int ecmcEc::setDcPll(int mode, int32_t offsetNs, double periodNs) {
+  if (!dcPll_) {
+    dcPll_ = new ecmcEcDcPll(asynPortDriver_, masterIndex_);
+  }
+
+  int errorCode = dcPll_->setPeriod(periodNs);
+  if (errorCode) {
+    return setErrorID(__FILE__, __FUNCTION__, __LINE__, errorCode);
+  }
+
+  errorCode = dcPll_->setMode(mode);
+  if (errorCode) {
+    return setErrorID(__FILE__, __FUNCTION__, __LINE__, errorCode);
+  }
+
+  return dcPll_->setTargetOffset(offsetNs);
+}
+
+int ecmcEc::setDcPllGains(double kp, double ki) {
+  if (!dcPll_) {
+    LOGERR("%s/%s:%d: ERROR: DC PLL not configured (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           ERROR_EC_DC_PLL_NOT_CONFIGURED);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_DC_PLL_NOT_CONFIGURED);
+  }
+  return dcPll_->setGains(kp, ki);
+}
+
+int ecmcEc::setDcPllLockWindow(int32_t windowNs) {
+  if (!dcPll_) {
+    LOGERR("%s/%s:%d: ERROR: DC PLL not configured (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           ERROR_EC_DC_PLL_NOT_CONFIGURED);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_DC_PLL_NOT_CONFIGURED);
+  }
+  return dcPll_->setLockWindow(windowNs);
+}
+
+int ecmcEc::setDcPllMock(double driftPpm, int32_t initOffsetNs) {
+  if (!dcPll_) {
+    LOGERR("%s/%s:%d: ERROR: DC PLL not configured (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           ERROR_EC_DC_PLL_NOT_CONFIGURED);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_DC_PLL_NOT_CONFIGURED);
+  }
+  return dcPll_->setMock(driftPpm, initOffsetNs);
+}
+
+// Adjustment of next realtime thread wakeup
+int64_t ecmcEc::getDcPllAdjustNs() {
+  if (!dcPll_) {
+    return 0;
+  }
+  return dcPll_->getAdjustNs();
+}
+
+int ecmcEc::addSdoQueue(uint16_t slavePosition, int poolSize) {
+  ecmcEcSlave *slave = findSlave(slavePosition);
+
+  if (slave == NULL) {
+    LOGERR("%s/%s:%d: ERROR: Slave %d not found (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           slavePosition,
+           ERROR_EC_MAIN_SLAVE_NULL);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MAIN_SLAVE_NULL);
+  }
+
+  return slave->addSdoQueue(poolSize);
+}
+
+ecmcEcSdoQueue * ecmcEc::getSdoQueue(uint16_t slavePosition) {
+  ecmcEcSlave *slave = findSlave(slavePosition);
+
+  if (slave == NULL) {
+    return NULL;
+  }
+  return slave->getSdoQueue();
+}
+
+// Add queue to list of queues executed in realtime
+void ecmcEc::activateSdoQueue(ecmcEcSdoQueue *queue) {
+  if (queue->getInActiveList() || (sdoQueuesActiveCount_ >= EC_MAX_SLAVES)) {
+    return;
+  }
+  queue->setInActiveList(true);
+  sdoQueuesActive_[sdoQueuesActiveCount_++] = queue;
+}
+
+// Realtime: only slaves with requests in queue or in process
+void ecmcEc::executeSdoQueues() {
+  int i = 0;
+
+  while (i < sdoQueuesActiveCount_) {
+    ecmcEcSdoQueue *queue = sdoQueuesActive_[i];
+    queue->execute();
+
+    if (queue->getActive()) {
+      i++;
+      continue;
+    }
+
+    // Idle, remove from list
+    queue->setInActiveList(false);
+    sdoQueuesActive_[i] = sdoQueuesActive_[--sdoQueuesActiveCount_];
+  }
+}
+
+int ecmcEc::sdoQueueRead(uint16_t             slavePosition,
+                         uint16_t             sdoIndex,
+                         uint8_t              sdoSubIndex,
+                         int                  byteSize,
+                         int                  prio,
+                         ecmcSdoQueueCallback callback,
+                         void                *userObj,
+                         int                 *handle) {
+  return sdoQueueReadBatch(slavePosition,
+                           1,
+                           &sdoIndex,
+                           &sdoSubIndex,
+                           &byteSize,
+                           prio,
+                           callback,
+                           userObj,
+                           handle);
+}
+
+int ecmcEc::sdoQueueReadBatch(uint16_t             slavePosition,
+                              int                  count,
+                              const uint16_t      *sdoIndices,
+                              const uint8_t       *sdoSubIndices,
+                              const int           *byteSizes,
+                              int                  prio,
+                              ecmcSdoQueueCallback callback,
+                              void                *userObj,
+                              int                 *handles) {
+  ecmcEcSdoQueue *queue = getSdoQueue(slavePosition);
+
+  if (queue == NULL) {
+    LOGERR("%s/%s:%d: ERROR: Slave %d: SDO queue not configured (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           slavePosition,
+           ERROR_EC_SDO_QUEUE_NOT_CONFIGURED);
+    return ERROR_EC_SDO_QUEUE_NOT_CONFIGURED;
+  }
+
+  for (int i = 0; i < count; i++) {
+    handles[i] = -1;
+  }
+
+  // All or none of the reads are queued
+  int errorCode = queue->addReadBatch(count,
+                                      sdoIndices,
+                                      sdoSubIndices,
+                                      byteSizes,
+                                      prio,
+                                      callback,
+                                      userObj,
+                                      handles);
+
+  if (errorCode) {
+    return errorCode;
+  }
+  activateSdoQueue(queue);
+
+  return 0;
+}
+
+int ecmcEc::sdoQueueWrite(uint16_t             slavePosition,
+                          uint16_t             sdoIndex,
+                          uint8_t              sdoSubIndex,
+                          uint64_t             value,
+                          int                  byteSize,
+                          int                  prio,
+                          ecmcSdoQueueCallback callback,
+                          void                *userObj,
+                          int                 *handle) {
+  ecmcEcSdoQueue *queue = getSdoQueue(slavePosition);
+
+  if (queue == NULL) {
+    LOGERR("%s/%s:%d: ERROR: Slave %d: SDO queue not configured (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           slavePosition,
+           ERROR_EC_SDO_QUEUE_NOT_CONFIGURED);
+    return ERROR_EC_SDO_QUEUE_NOT_CONFIGURED;
+  }
+
+  int errorCode = queue->addWrite(sdoIndex,
+                                  sdoSubIndex,
+                                  value,
+                                  byteSize,
+                                  prio,
+                                  callback,
+                                  userObj,
+                                  handle);
+  if (errorCode) {
+    return errorCode;
+  }
+  activateSdoQueue(queue);
+
+  return 0;
+}
+
+int ecmcEc::sdoQueueGetResult(uint16_t  slavePosition,
+                              int       handle,
+                              int      *state,
+                              uint64_t *value) {
+  ecmcEcSdoQueue *queue = getSdoQueue(slavePosition);
+
+  if (queue == NULL) {
+    return ERROR_EC_SDO_QUEUE_NOT_CONFIGURED;
+  }
+  return queue->getResult(handle, state, value);
+}
+
+int ecmcEc::sdoQueueRelease(uint16_t slavePosition, int handle) {
+  ecmcEcSdoQueue *queue = getSdoQueue(slavePosition);
+
+  if (queue == NULL) {
+    return ERROR_EC_SDO_QUEUE_NOT_CONFIGURED;
+  }
+  return queue->release(handle);
+}
+
+int ecmcEc::getBusSlaveCount(int *count) {
+  ec_master_info_t masterInfo;
+
+  if (!master_) {
+    return setErrorID(__FILE__, __FUNCTION__, __LINE__, ERROR_EC_MASTER_NULL);
+  }
+
+  int errorCode = ecrt_master(master_, &masterInfo);
+
+  if (errorCode) {
+    LOGERR(
+      "%s/%s:%d: Error: Function ecrt_master() failed with error code 0x%x.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      errorCode);
+    return setErrorID(__FILE__, __FUNCTION__, __LINE__, ERROR_EC_MASTER_NULL);
+  }
+
+  *count = masterInfo.slave_count;
+  return 0;
+}
+
+int ecmcEc::getBusSlaveIdentity(uint16_t  slavePos,
+                                uint32_t *vendorId,
+                                uint32_t *productCode,
+                                uint32_t *revisionNum) {
+  ec_slave_info_t slaveInfo;
+
+  if (!master_) {
+    return setErrorID(__FILE__, __FUNCTION__, __LINE__, ERROR_EC_MASTER_NULL);
+  }
+
+  int errorCode = ecrt_master_get_slave(master_, slavePos, &slaveInfo);
+
+  if (errorCode) {
+    LOGERR(
+      "%s/%s:%d: Error: Function ecrt_master_get_slave() failed with error code 0x%x (ecmc error 0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      errorCode,
+      ERROR_EC_MAIN_GET_SLAVE_INFO_FAILED);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MAIN_GET_SLAVE_INFO_FAILED);
+  }
+
+  *vendorId    = slaveInfo.vendor_id;
+  *productCode = slaveInfo.product_code;
+  *revisionNum = slaveInfo.revision_number;
+  return 0;
+}
+
+int ecmcEc::addMemMapPipe(std::string      memMapIDString,
+                          ecmcDataStorage *dataStorage,
+                          double           scale,
+                          double           offset,
+                          int              decimation,
+                          int             *index) {
+  if (memMapPipeCounter_ >= EC_MAX_MEM_MAP_PIPES) {
+    LOGERR("%s/%s:%d: ERROR: Adding memmap pipe failed. Array full (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           ERROR_EC_MEM_MAP_PIPE_INDEX_OUT_OF_RANGE);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MEM_MAP_PIPE_INDEX_OUT_OF_RANGE);
+  }
+
+  ecmcEcMemMap *memMap = findMemMap(memMapIDString);
+
+  if (!memMap) {
+    LOGERR("%s/%s:%d: ERROR: Memmap %s not found (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           memMapIDString.c_str(),
+           ERROR_EC_MEM_MAP_NULL);
+    return setErrorID(__FILE__, __FUNCTION__, __LINE__, ERROR_EC_MEM_MAP_NULL);
+  }
+
+  ecmcEcMemMapPipe *pipe = new ecmcEcMemMapPipe(asynPortDriver_,
+                                                masterIndex_,
+                                                memMapPipeCounter_,
+                                                memMap,
+                                                dataStorage,
+                                                scale,
+                                                offset,
+                                                decimation);
+  int errorCode = pipe->getErrorID();
+
+  if (errorCode) {
+    delete pipe;
+    return setErrorID(__FILE__, __FUNCTION__, __LINE__, errorCode);
+  }
+
+  *index = memMapPipeCounter_;
+  memMapPipes_[memMapPipeCounter_++] = pipe;
+  return 0;
+}
+
+int ecmcEc::setMemMapPipeFir(int index, const double *taps, int count) {
+  if ((index < 0) || (index >= memMapPipeCounter_)) {
+    LOGERR("%s/%s:%d: ERROR: Memmap pipe index %d out of range (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           index,
+           ERROR_EC_MEM_MAP_PIPE_INDEX_OUT_OF_RANGE);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MEM_MAP_PIPE_INDEX_OUT_OF_RANGE);
+  }
+  return memMapPipes_[index]->setFir(taps, count);
+}
+
+// Realtime: directly after update of input process image
+void ecmcEc::executeMemMapPipes() {
+  for (int i = 0; i < memMapPipeCounter_; i++) {
+    memMapPipes_[i]->execute();
+  }
+}
+
+int ecmcEc::addMailboxPublisher(ecmcEcMailbox *mailbox) {
+  if (mailboxOutCounter_ >= EC_MAX_MAILBOXES) {
+    LOGERR("%s/%s:%d: ERROR: Adding mailbox failed. Array full (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           ERROR_EC_MAILBOX_ARRAY_FULL);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MAILBOX_ARRAY_FULL);
+  }
+  mailboxesOut_[mailboxOutCounter_++] = mailbox;
+  return 0;
+}
+
+int ecmcEc::addMailboxConsumer(ecmcEcMailbox *mailbox) {
+  if (mailboxInCounter_ >= EC_MAX_MAILBOXES) {
+    LOGERR("%s/%s:%d: ERROR: Adding mailbox failed. Array full (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           ERROR_EC_MAILBOX_ARRAY_FULL);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MAILBOX_ARRAY_FULL);
+  }
+  mailboxesIn_[mailboxInCounter_++] = mailbox;
+  return 0;
+}
+
+void ecmcEc::publishMailboxes() {
+  for (int i = 0; i < mailboxOutCounter_; i++) {
+    mailboxesOut_[i]->publish();
+  }
+}
+
+void ecmcEc::consumeMailboxes() {
+  for (int i = 0; i < mailboxInCounter_; i++) {
+    mailboxesIn_[i]->consume();
+  }
+}
+
+/* Refresh asyn parameters of entries, memmaps and master status. Only
+   needed when the master executes in an own thread where realtime asyn
+   refresh is blocked. Called by the main realtime thread (owns asyn). */
+int ecmcEc::updateAsyn() {
+  // Stamp with DC time of this master (restored for the calling master)
+  const uint64_t *dcTimeSource = ecmcDataItem::getCycleDcTimeSource();
+  epicsTimeStamp  portTime;
+
+  if (asynSnapshot_) {
+    // Nothing published while the snapshot is written (next cycle)
+    if (!loadAsynSnapshot()) {
+      return 0;
+    }
+  } else {
+    asynDcTimeNs_ = cycleDcTimeNs_;  // written by the master thread
+  }
+  ecmcDataItem::setCycleDcTimeSource(&asynDcTimeNs_);
+
+  if (asynPortDriver_) {
+    asynPortDriver_->getTimeStamp(&portTime);
+    if (asynDcTimeNs_ > 0) {
+      dcTimeToEpicsTime(asynDcTimeNs_, &epicsTime_);
+      asynPortDriver_->setTimeStamp(&epicsTime_);
+    }
+  }
+
+  for (int i = 0; i < slaveCounter_; i++) {
+    if (slaveArray_[i] != NULL) {
+      slaveArray_[i]->updateAsyn();
+    }
+  }
+
+  for (int i = 0; i < ecMemMapArrayCounter_; i++) {
+    if (ecMemMapArray_[i] != NULL) {
+      ecMemMapArray_[i]->updateAsyn(0);
+    }
+  }
+
+  if (asynPortDriver_) {
+    ecAsynParams_[ECMC_ASYN_EC_PAR_MASTER_STAT_ID]->refreshParamRT(0);
+    ecAsynParams_[ECMC_ASYN_EC_PAR_DOMAIN_STAT_ID]->refreshParamRT(0);
+    ecAsynParams_[ECMC_ASYN_EC_PAR_DOMAIN_FAIL_COUNTER_TOT_ID]->refreshParamRT(0);
+    ecAsynParams_[ECMC_ASYN_EC_STAT_OK_ID]->refreshParamRT(0);
+    asynPortDriver_->setTimeStamp(&portTime);
+  }
+  ecmcDataItem::setCycleDcTimeSource(dcTimeSource);
+  return 0;
+}
+
+int ecmcEc::enableAsynSnapshot() {
+  for (int i = 0; i < slaveCounter_; i++) {
+    if (slaveArray_[i] != NULL) {
+      slaveArray_[i]->enableAsynSnapshot(this);
+    }
+  }
+
+  for (int i = 0; i < ecMemMapArrayCounter_; i++) {
+    if (ecMemMapArray_[i] != NULL) {
+      ecMemMapArray_[i]->enableAsynSnapshot(this);
+    }
+  }
+  asynSnapshotDcTimeNs_ = cycleDcTimeNs_;
+  asynSnapshot_         = true;
+  return 0;
+}
+
+// Master thread: copy of entries and memmaps published by updateAsyn()
+void ecmcEc::storeAsynSnapshot() {
+  if (!asynSnapshot_) {
+    return;
+  }
+
+  uint32_t seq = asynSnapshotSeq_;
+  __atomic_store_n(&asynSnapshotSeq_, seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  asynSnapshotDcTimeNs_ = cycleDcTimeNs_;
+
+  for (int i = 0; i < slaveCounter_; i++) {
+    if (slaveArray_[i] != NULL) {
+      slaveArray_[i]->storeAsynSnapshot();
+    }
+  }
+
+  for (int i = 0; i < ecMemMapArrayCounter_; i++) {
+    if (ecMemMapArray_[i] != NULL) {
+      ecMemMapArray_[i]->storeAsynSnapshot();
+    }
+  }
+  __atomic_store_n(&asynSnapshotSeq_, seq + 2, __ATOMIC_RELEASE);
+}
+
+/* Main realtime thread: load snapshot to the asyn buffers not published
+ * and swap if the snapshot was not written meanwhile. Returns false if
+ * nothing to publish. */
+bool ecmcEc::loadAsynSnapshot() {
+  uint32_t seq = __atomic_load_n(&asynSnapshotSeq_, __ATOMIC_ACQUIRE);
+
+  if (seq & 1) {
+    return false;
+  }
+
+  // No new snapshot (master thread slower), publish last
+  if (seq == asynSnapshotSeqLoaded_) {
+    return true;
+  }
+
+  uint64_t dcTimeNs = asynSnapshotDcTimeNs_;
+
+  for (int i = 0; i < slaveCounter_; i++) {
+    if (slaveArray_[i] != NULL) {
+      slaveArray_[i]->loadAsynSnapshot();
+    }
+  }
+
+  for (int i = 0; i < ecMemMapArrayCounter_; i++) {
+    if (ecMemMapArray_[i] != NULL) {
+      ecMemMapArray_[i]->loadAsynSnapshot();
+    }
+  }
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+  if (__atomic_load_n(&asynSnapshotSeq_, __ATOMIC_RELAXED) != seq) {
+    return false;
+  }
+  asynSnapshotSeqLoaded_ = seq;
+  asynDcTimeNs_          = dcTimeNs;
+
+  for (int i = 0; i < slaveCounter_; i++) {
+    if (slaveArray_[i] != NULL) {
+      slaveArray_[i]->commitAsynSnapshot();
+    }
+  }
+
+  for (int i = 0; i < ecMemMapArrayCounter_; i++) {
+    if (ecMemMapArray_[i] != NULL) {
+      ecMemMapArray_[i]->commitAsynSnapshot();
+    }
+  }
+  return true;
+}
+
+int ecmcEc::queueAsynWrite(ecmcEcEntry *entry,
+                           uint64_t     value,
+                           size_t       bytes) {
+  return pushAsynWrite(entry, NULL, value, bytes);
+}
+
+int ecmcEc::queueAsynWrite(ecmcEcMemMap *memMap) {
+  return pushAsynWrite(NULL, memMap, 0, 0);
+}
+
+/* Asyn (port locked, so one producer at a time). Error state of the master
+ * is owned by the master thread, only logged here. */
+int ecmcEc::pushAsynWrite(ecmcEcEntry  *entry,
+                          ecmcEcMemMap *memMap,
+                          uint64_t      value,
+                          size_t        bytes) {
+  uint32_t tail = asynWriteTail_;
+  uint32_t head = __atomic_load_n(&asynWriteHead_, __ATOMIC_ACQUIRE);
+
+  if (tail - head >= ECMC_EC_ASYN_WRITE_QUEUE_SIZE) {
+    LOGERR("%s/%s:%d: ERROR: Master %d: asyn write queue full (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           masterIndex_,
+           ERROR_EC_ASYN_WRITE_QUEUE_FULL);
+    return ERROR_EC_ASYN_WRITE_QUEUE_FULL;
+  }
+
+  ecmcEcAsynWrite *write = &asynWriteQueue_[tail % ECMC_EC_ASYN_WRITE_QUEUE_SIZE];
+  write->entry  = entry;
+  write->memMap = memMap;
+  write->value  = value;
+  write->bytes  = bytes;
+  __atomic_store_n(&asynWriteTail_, tail + 1, __ATOMIC_RELEASE);
+  return 0;
+}
+
+// Master thread: apply queued asyn writes in order
+void ecmcEc::executeAsynWrites() {
+  uint32_t head = asynWriteHead_;
+  uint32_t tail = __atomic_load_n(&asynWriteTail_, __ATOMIC_ACQUIRE);
+
+  while (head != tail) {
+    ecmcEcAsynWrite *write = &asynWriteQueue_[head % ECMC_EC_ASYN_WRITE_QUEUE_SIZE];
+
+    if (write->entry) {
+      write->entry->applyAsynWrite(write->value, write->bytes);
+    } else if (write->memMap) {
+      write->memMap->applyAsynWrite();
+    }
+    head++;
+  }
+  __atomic_store_n(&asynWriteHead_, head, __ATOMIC_RELEASE);
+}
@@ -16,6 +16,7 @@
 #include <string>
 #include "stdio.h"
 #include "ecrt.h"
+#include "epicsEvent.h"
 #include "../main/ecmcDefinitions.h"
 #include "../main/ecmcError.h"
 #include "../com/ecmcOctetIF.h"  // Logging macros
@@ -24,6 +25,9 @@
 #include "ecmcEcSDO.h"
 #include "ecmcEcSlave.h"
 #include "ecmcEcMemMap.h"
+#include "ecmcEcDcPll.h"
+#include "ecmcEcMemMapPipe.h"
+#include "ecmcEcMailbox.h"
 
 // EC ERRORS
 #define ERROR_EC_MAIN_REQUEST_FAILED 0x26000
@@ -68,10 +72,31 @@
 #define ERROR_EC_SLAVE_VERIFICATION_FAIL 0x26026
 #define ERROR_EC_NO_VALID_CONFIG 0x26027
 #define ERROR_EC_DATATYPE_NOT_VALID 0x26028
+#define ERROR_EC_MEM_MAP_MAX_COUNT_OUT_OF_RANGE 0x26029
+#define ERROR_EC_MEM_MAP_MAX_COUNT_CHANGE_NOT_ALLOWED 0x2602A
+#define ERROR_EC_DIAG_THREAD_PERIOD_OUT_OF_RANGE 0x2602B
+#define ERROR_EC_DIAG_THREAD_CREATE_FAIL 0x2602C
+#define ERROR_EC_DIAG_THREAD_CHANGE_NOT_ALLOWED 0x2602D
+#define ERROR_EC_DC_PLL_NOT_CONFIGURED 0x2602E
+#define ERROR_EC_SDO_QUEUE_NOT_CONFIGURED 0x2602F
+#define ERROR_EC_MEM_MAP_PIPE_INDEX_OUT_OF_RANGE 0x26030
+#define ERROR_EC_ASYN_WRITE_QUEUE_FULL 0x26031
+
+// Asyn writes queued to a master executing in an own thread
+#define ECMC_EC_ASYN_WRITE_QUEUE_SIZE 256
+
+typedef struct {
+  ecmcEcEntry  *entry;   // entry write (value, bytes)
+  ecmcEcMemMap *memMap;  // memmap write (data in memmap write buffer)
+  uint64_t      value;
+  size_t        bytes;
+} ecmcEcAsynWrite;
 
 class ecmcEc : public ecmcError {
  public:
-  ecmcEc(ecmcAsynPortDriver *asynPortDriver);
+  // masterSlot: 0 for primary master, 1.. for masters in own threads
+  ecmcEc(ecmcAsynPortDriver *asynPortDriver,
+         int                 masterSlot = 0);
   ~ecmcEc();
   int init(int nMasterIndex);
   int addSlave(
@@ -88,9 +113,11 @@ class ecmcEc : public ecmcError {
   void         send(timespec timeOffset);
   int          compileRegInfo();
   void         checkDomainState();
-  int          checkSlaveConfState(int slave);
-  bool         checkSlavesConfState();
-  bool         checkState();
+  // readState=false: evaluate state polled by diagnostics thread
+  int          checkSlaveConfState(int  slave,
+                                   bool readState = true);
+  bool         checkSlavesConfState(bool readState = true);
+  bool         checkState(bool readState = true);
   int          activate();
   int          setDiagnostics(bool diag);
   int          addSDOWrite(uint16_t slavePosition,
@@ -157,6 +184,17 @@ class ecmcEc : public ecmcError {
   ecmcEcMemMap* findMemMap(std::string name);
   int           findMemMapId(std::string name);
   ecmcEcMemMap* getMemMap(int index);
+  int           setMaxMemMaps(int count);
+  // Memmap to data storage pipeline (executed in realtime, no PLC)
+  int           addMemMapPipe(std::string      memMapIDString,
+                              ecmcDataStorage *dataStorage,
+                              double           scale,
+                              double           offset,
+                              int              decimation,
+                              int             *index);
+  int           setMemMapPipeFir(int           index,
+                                 const double *taps,
+                                 int           count);
   ecmcEcSlave * findSlave(int busPosition);
 
   int           findSlaveIndex(int  busPosition,
@@ -177,7 +215,21 @@ class ecmcEc : public ecmcError {
                             uint32_t revisionNum  /**< Revision number*/);
 
   int           checkReadyForRuntime();
+  // Identity of slaves on bus (for configuration snapshot)
+  int           getBusSlaveCount(int *count);
+  int           getBusSlaveIdentity(uint16_t  slavePos,
+                                    uint32_t *vendorId,
+                                    uint32_t *productCode,
+                                    uint32_t *revisionNum);
   uint64_t      getTimeNs();
+  // Application time of the frame processed in this cycle (set in receive())
+  uint64_t      getCycleDcTimeNs();
+  const uint64_t* getCycleDcTimeNsPtr();
+  // Offset added to DC time before conversion to EPICS (asyn) time
+  int           setDcTimeEpochOffset(int64_t offsetNs);
+  int64_t       getDcTimeEpochOffset();
+  void          dcTimeToEpicsTime(uint64_t        dcTimeNs,
+                                  epicsTimeStamp *epicsTime);
     
   uint32_t      getSlaveVendorId(uint16_t alias,  /**< Slave alias. */
                                  uint16_t slavePos   /**< Slave position. */);
@@ -191,20 +243,105 @@ class ecmcEc : public ecmcError {
   bool          getScanBusyNotRT();
   // Some slaves report OP but still not returning valid data for some seconds then use this command.
   int           setEcOkDelayCycles(int cycles);
+  // Poll master and slave states in a separate non realtime thread
+  int           setDiagThread(int    enable,
+                              double periodMs);
+  bool          getDiagThreadRunning();
+  void          diagThreadExecute();
+  // Realtime: evaluate states published by diagnostics thread (if new)
+  void          applyDiagState();
+  // Lock realtime cycle to DC reference clock
+  int           setDcPll(int     mode,
+                         int32_t offsetNs,
+                         double  periodNs);
+  int           setDcPllGains(double kp,
+                              double ki);
+  int           setDcPllLockWindow(int32_t windowNs);
+  int           setDcPllMock(double  driftPpm,
+                             int32_t initOffsetNs);
+  int64_t       getDcPllAdjustNs();
+  // Non blocking SDO access (queue per slave, see ecmcEcSdoQueue)
+  int           addSdoQueue(uint16_t slavePosition,
+                            int      poolSize);
+  int           sdoQueueRead(uint16_t             slavePosition,
+                             uint16_t             sdoIndex,
+                             uint8_t              sdoSubIndex,
+                             int                  byteSize,
+                             int                  prio,
+                             ecmcSdoQueueCallback callback,
+                             void                *userObj,
+                             int                 *handle);
+  int           sdoQueueWrite(uint16_t             slavePosition,
+                              uint16_t             sdoIndex,
+                              uint8_t              sdoSubIndex,
+                              uint64_t             value,
+                              int                  byteSize,
+                              int                  prio,
+                              ecmcSdoQueueCallback callback,
+                              void                *userObj,
+                              int                 *handle);
+  // Queue a list of reads for one slave (handles[count] returned)
+  int           sdoQueueReadBatch(uint16_t             slavePosition,
+                                  int                  count,
+                                  const uint16_t      *sdoIndices,
+                                  const uint8_t       *sdoSubIndices,
+                                  const int           *byteSizes,
+                                  int                  prio,
+                                  ecmcSdoQueueCallback callback,
+                                  void                *userObj,
+                                  int                 *handles);
+  int           sdoQueueGetResult(uint16_t  slavePosition,
+                                  int       handle,
+                                  int      *state,
+                                  uint64_t *value);
+  int           sdoQueueRelease(uint16_t slavePosition,
+                                int      handle);
+  // Lock free exchange of entries with other masters (see ecmcEcMailbox)
+  int           addMailboxPublisher(ecmcEcMailbox *mailbox);
+  int           addMailboxConsumer(ecmcEcMailbox *mailbox);
+  // Asyn refresh when executed in another thread (see ecmcEcMasterThread)
+  int           updateAsyn();
+  // Publish entries and memmaps to asyn from a per cycle snapshot and queue
+  // asyn writes to the master thread (not realtime, before thread start)
+  int           enableAsynSnapshot();
+  // Master thread: apply queued asyn writes (before send())
+  void          executeAsynWrites();
+  // Master thread: store snapshot (after send())
+  void          storeAsynSnapshot();
+  // Asyn write (port locked)
+  int           queueAsynWrite(ecmcEcEntry *entry,
+                               uint64_t     value,
+                               size_t       bytes);
+  int           queueAsynWrite(ecmcEcMemMap *memMap);
 
 private:
   void     initVars();
   int      updateInputProcessImage();
   int      updateOutProcessImage();
+  bool     loadAsynSnapshot();
+  int      pushAsynWrite(ecmcEcEntry  *entry,
+                         ecmcEcMemMap *memMap,
+                         uint64_t      value,
+                         size_t        bytes);
   timespec timespecAdd(timespec time1,
                        timespec time2);
   bool     validEntryType(ecmcEcDataType dt);
+  int      startDiagThread();
+  void     stopDiagThread();
+  void     updateSlaveStates();
+  ecmcEcSdoQueue* getSdoQueue(uint16_t slavePosition);
+  void     activateSdoQueue(ecmcEcSdoQueue *queue);
+  void     executeSdoQueues();
+  void     executeMemMapPipes();
+  void     publishMailboxes();
+  void     consumeMailboxes();
   ec_master_t *master_;
   ec_domain_t *domain_;
   ec_domain_state_t domainStateOld_;
   ec_domain_state_t domainState_;
   ec_master_state_t masterStateOld_;
   ec_master_state_t masterState_;
+  ec_master_state_t masterStateRead_;
   uint8_t *domainPd_;
   int slaveCounter_;
   int entryCounter_;
@@ -225,8 +362,9 @@ private:
   int domainNotOKCyclesLimit_;
   bool inStartupPhase_;
 
-  ecmcEcMemMap *ecMemMapArray_[EC_MAX_MEM_MAPS];
+  ecmcEcMemMap **ecMemMapArray_;
   int ecMemMapArrayCounter_;
+  int ecMemMapArraySize_;
   size_t domainSize_;
   ecmcEcEntry *statusOutputEntry_;
   int masterIndex_;
@@ -244,5 +382,57 @@ private:
   struct timespec timeAbs_;
   int delayEcOKCycles_;
   int startupCounter_;
+
+  // Diagnostics thread
+  bool diagThreadEnable_;
+  double diagThreadPeriodMs_;
+  volatile bool diagThreadRun_;
+  volatile bool diagThreadRunning_;
+  epicsEventId diagThreadExit_;
+  // States polled by diagnostics thread (thread private)
+  ec_master_state_t diagMasterStatePoll_;
+  ec_slave_config_state_t diagSlaveStatesPoll_[EC_MAX_SLAVES];
+  // States published to realtime thread (sequence counted, odd while written)
+  uint32_t diagStateSeq_;
+  uint32_t diagStateSeqApplied_;
+  ec_master_state_t diagMasterState_;
+  ec_slave_config_state_t diagSlaveStates_[EC_MAX_SLAVES];
+  // Compact slave state snapshot (one byte per slave, see getStateSummary())
+  uint8_t slaveStates_[EC_MAX_SLAVES];
+
+  // DC PLL (times of last sent frame)
+  ecmcEcDcPll *dcPll_;
+  uint64_t dcAppTimeNs_;
+  uint64_t dcSendTimeNs_;
+
+  // Application time of last sent frame and of frame received this cycle
+  uint64_t lastAppTimeNs_;
+  uint64_t cycleDcTimeNs_;
+  int64_t dcTimeEpochOffsetNs_;
+  uint64_t asynDcTimeNs_;  // Snapshot used in updateAsyn()
+
+  // Asyn snapshot stored by master thread (sequence counted, odd while written)
+  bool asynSnapshot_;
+  uint32_t asynSnapshotSeq_;
+  uint32_t asynSnapshotSeqLoaded_;
+  uint64_t asynSnapshotDcTimeNs_;
+  // Asyn writes to master thread (single producer, port locked)
+  ecmcEcAsynWrite asynWriteQueue_[ECMC_EC_ASYN_WRITE_QUEUE_SIZE];
+  uint32_t asynWriteHead_;  // consumer (master thread)
+  uint32_t asynWriteTail_;  // producer (asyn)
+  int masterSlot_;
+
+  // SDO queues with requests (only these are executed in realtime)
+  ecmcEcSdoQueue *sdoQueuesActive_[EC_MAX_SLAVES];
+  int sdoQueuesActiveCount_;
+
+  ecmcEcMemMapPipe *memMapPipes_[EC_MAX_MEM_MAP_PIPES];
+  int memMapPipeCounter_;
+
+  // Mailboxes published by this master are owned by this master
+  ecmcEcMailbox *mailboxesOut_[EC_MAX_MAILBOXES];
+  int mailboxOutCounter_;
+  ecmcEcMailbox *mailboxesIn_[EC_MAX_MAILBOXES];
+  int mailboxInCounter_;
 };
 #endif  /* ECMCEC_H_ */
@@ -41,7 +41,8 @@ ecmcEcAsyncSDO::ecmcEcAsyncSDO(ecmcAsynPortDriver *asynDriver,
                                uint16_t sdoIndex, /**< SDO index. */
                                uint8_t sdoSubindex, /**< SDO subindex. */
                                ecmcEcDataType dt,
-                               std::string alias)
+                               std::string alias,
+                               int *activeCounter)
 {
   masterId_       = masterId;
   slaveId_        = slaveId;
@@ -70,6 +71,7 @@ ecmcEcAsyncSDO::ecmcEcAsyncSDO(ecmcAsynPortDriver *asynDriver,
   idString_       = alias;
   idStringChar_   = strdup(idString_.c_str());
   stateOld_       = EC_REQUEST_UNUSED;
+  activeCounter_  = activeCounter;
   int8Ptr_        = (int8_t*)&buffer_;
   uint8Ptr_       = (uint8_t*)&buffer_;
   int16Ptr_       = (int16_t*)&buffer_;
@@ -166,6 +168,9 @@ asynStatus ecmcEcAsyncSDO::asynWriteSDO(void* data,
     return asynError;
   }
 
+  if(!readCmdInProcess_ && !writeCmdInProcess_) {
+    (*activeCounter_)++;
+  }
   busy_ = 1;
   asynParamBusy_->refreshParam(1);
   writeCmdInProcess_ = true;
@@ -226,6 +231,9 @@ asynStatus ecmcEcAsyncSDO::asynReadSDO(void* data,
     return asynError;
   }
 
+  if(!readCmdInProcess_ && !writeCmdInProcess_) {
+    (*activeCounter_)++;
+  }
   busy_ = 1;
   asynParamBusy_->refreshParam(1);
   
@@ -257,6 +265,7 @@ int ecmcEcAsyncSDO::execute() {
       } 
       readCmdInProcess_ = 0;
       writeCmdInProcess_ = 0;
+      (*activeCounter_)--;
       busy_ = 0;
       asynParamBusy_->refreshParamRT(1);
       break;
@@ -265,6 +274,7 @@ int ecmcEcAsyncSDO::execute() {
       asynParamError_->refreshParamRT(1);
       readCmdInProcess_ = 0;
       writeCmdInProcess_ = 0;
+      (*activeCounter_)--;
       busy_ = 0;
       asynParamBusy_->refreshParamRT(1);
       break;
@@ -36,7 +36,8 @@ class ecmcEcAsyncSDO : public ecmcError {
                  uint16_t sdoIndex, /**< SDO index. */
                  uint8_t sdoSubIndex, /**< SDO subindex. */
                  ecmcEcDataType dt,
-                 std::string alias);
+                 std::string alias,
+                 int *activeCounter /**< Requests in process (of slave). */);
   ~ecmcEcAsyncSDO();
 
   asynStatus asynWriteSDO(void* data,
@@ -91,5 +92,6 @@ private:
   ec_request_state_t  stateOld_;
   int                 readTrigg_;
   int                 writeTrigg_;
+  int                *activeCounter_;
 };
 #endif  /* ECMCECASYNCSDO_H_ */
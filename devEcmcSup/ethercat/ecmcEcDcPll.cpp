@@ -0,0 +1,307 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+*
+*  ecmcEcDcPll.cpp
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#include "ecmcEcDcPll.h"
+#include <cmath>
+#include <stdio.h>
+#include "../main/ecmcErrorsList.h"
+
+ecmcEcDcPll::ecmcEcDcPll(ecmcAsynPortDriver *asynPortDriver,
+                         int                 masterIndex) {
+  initVars();
+  asynPortDriver_ = asynPortDriver;
+  masterIndex_    = masterIndex;
+  initAsyn();
+}
+
+ecmcEcDcPll::~ecmcEcDcPll() {}
+
+void ecmcEcDcPll::initVars() {
+  errorReset();
+  asynPortDriver_   = NULL;
+  masterIndex_      = 0;
+  mode_             = ECMC_EC_DC_PLL_MODE_OFF;
+  periodNs_         = MCU_PERIOD_NS;
+  targetOffsetNs_   = 0;
+  kp_               = ECMC_EC_DC_PLL_DEFAULT_KP;
+  ki_               = ECMC_EC_DC_PLL_DEFAULT_KI;
+  lockWindowNs_     = ECMC_EC_DC_PLL_DEFAULT_LOCK_WINDOW_NS;
+  lockCounter_      = 0;
+  started_          = false;
+  integral_         = 0;
+  adjustNs_         = 0;
+  shiftNs_          = 0;
+  mockDriftPpm_     = 0;
+  mockInitOffsetNs_ = 0;
+  mockStarted_      = false;
+  mockStartNs_      = 0;
+  offsetNs_         = 0;
+  driftPpm_         = 0;
+  locked_           = 0;
+  offsetAsynParam_  = NULL;
+  driftAsynParam_   = NULL;
+  lockedAsynParam_  = NULL;
+}
+
+ecmcAsynDataItem * ecmcEcDcPll::addParam(const char    *suffix,
+                                         asynParamType  type,
+                                         uint8_t       *data,
+                                         size_t         bytes,
+                                         ecmcEcDataType dt) {
+  char buffer[EC_MAX_OBJECT_PATH_CHAR_LENGTH];
+
+  // "ec%d.dc.<suffix>"
+  unsigned int charCount = snprintf(buffer,
+                                    sizeof(buffer),
+                                    ECMC_EC_STR "%d." ECMC_EC_DC_STR ".%s",
+                                    masterIndex_,
+                                    suffix);
+
+  if (charCount >= sizeof(buffer) - 1) {
+    LOGERR(
+      "%s/%s:%d: Error: Failed to generate alias. Buffer to small (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      ERROR_EC_DC_PLL_ASYN_PARAM_FAIL);
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_EC_DC_PLL_ASYN_PARAM_FAIL);
+    return NULL;
+  }
+
+  ecmcAsynDataItem *param = asynPortDriver_->addNewAvailParam(buffer,
+                                                              type,
+                                                              data,
+                                                              bytes,
+                                                              dt,
+                                                              0);
+
+  if (!param) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      buffer);
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_MAIN_ASYN_CREATE_PARAM_FAIL);
+    return NULL;
+  }
+  param->setAllowWriteToEcmc(false);
+  param->refreshParam(1);
+  return param;
+}
+
+int ecmcEcDcPll::initAsyn() {
+  if (!asynPortDriver_) {
+    return 0;
+  }
+
+  offsetAsynParam_ = addParam("offset",
+                              asynParamInt32,
+                              (uint8_t *)&offsetNs_,
+                              sizeof(offsetNs_),
+                              ECMC_EC_S32);
+  driftAsynParam_ = addParam("drift",
+                             asynParamFloat64,
+                             (uint8_t *)&driftPpm_,
+                             sizeof(driftPpm_),
+                             ECMC_EC_F64);
+  lockedAsynParam_ = addParam("locked",
+                              asynParamInt32,
+                              (uint8_t *)&locked_,
+                              sizeof(locked_),
+                              ECMC_EC_S32);
+
+  if (!offsetAsynParam_ || !driftAsynParam_ || !lockedAsynParam_) {
+    return getErrorID();
+  }
+  lockedAsynParam_->addSupportedAsynType(asynParamUInt32Digital);
+  return 0;
+}
+
+int ecmcEcDcPll::setMode(int mode) {
+  if ((mode < ECMC_EC_DC_PLL_MODE_OFF) || (mode > ECMC_EC_DC_PLL_MODE_MOCK)) {
+    LOGERR("%s/%s:%d: ERROR: DC PLL mode %d out of range (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           mode,
+           ERROR_EC_DC_PLL_MODE_OUT_OF_RANGE);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_DC_PLL_MODE_OUT_OF_RANGE);
+  }
+  mode_        = (ecmcEcDcPllMode)mode;
+  started_     = false;
+  mockStarted_ = false;
+  return 0;
+}
+
+ecmcEcDcPllMode ecmcEcDcPll::getMode() {
+  return mode_;
+}
+
+bool ecmcEcDcPll::getEnable() {
+  return mode_ != ECMC_EC_DC_PLL_MODE_OFF;
+}
+
+int ecmcEcDcPll::setPeriod(double periodNs) {
+  if (periodNs <= 0) {
+    LOGERR("%s/%s:%d: ERROR: DC PLL period out of range (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           ERROR_EC_DC_PLL_PERIOD_OUT_OF_RANGE);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_DC_PLL_PERIOD_OUT_OF_RANGE);
+  }
+  periodNs_ = periodNs;
+  return 0;
+}
+
+int ecmcEcDcPll::setTargetOffset(int32_t offsetNs) {
+  targetOffsetNs_ = offsetNs;
+  return 0;
+}
+
+int ecmcEcDcPll::setGains(double kp, double ki) {
+  if ((kp < 0) || (ki < 0) || (kp > 1) || (ki > 1)) {
+    LOGERR("%s/%s:%d: ERROR: DC PLL gains out of range 0..1 (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           ERROR_EC_DC_PLL_GAIN_OUT_OF_RANGE);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_DC_PLL_GAIN_OUT_OF_RANGE);
+  }
+  kp_ = kp;
+  ki_ = ki;
+  return 0;
+}
+
+int ecmcEcDcPll::setLockWindow(int32_t windowNs) {
+  lockWindowNs_ = std::abs(windowNs);
+  return 0;
+}
+
+int ecmcEcDcPll::setMock(double driftPpm, int32_t initOffsetNs) {
+  mockDriftPpm_     = driftPpm;
+  mockInitOffsetNs_ = initOffsetNs;
+  mockStarted_      = false;
+  return 0;
+}
+
+int64_t ecmcEcDcPll::execute(uint64_t appTimeNs,
+                             uint64_t sendTimeNs,
+                             uint32_t refTimeNs,
+                             bool     refTimeValid) {
+  adjustNs_ = 0;
+
+  if ((mode_ == ECMC_EC_DC_PLL_MODE_OFF) || (appTimeNs == 0)) {
+    return 0;
+  }
+
+  // Simulated reference clock: drifts relative to the physical send time
+  if (mode_ == ECMC_EC_DC_PLL_MODE_MOCK) {
+    if (!mockStarted_) {
+      mockStartNs_ = sendTimeNs;
+      mockStarted_ = true;
+    }
+    int64_t elapsed = (int64_t)(sendTimeNs - mockStartNs_);
+    refTimeNs = (uint32_t)(mockStartNs_ + mockInitOffsetNs_ + elapsed +
+                           (int64_t)(elapsed * mockDriftPpm_ * 1E-6));
+    refTimeValid = true;
+  }
+
+  if (!refTimeValid) {
+    lockCounter_ = 0;
+    locked_      = 0;
+    refreshAsyn();
+    return 0;
+  }
+
+  // Phase error normalized to +-period/2 (32 bit wrap of reference time)
+  int64_t period = (int64_t)periodNs_;
+  int64_t error  = (int32_t)((uint32_t)appTimeNs - refTimeNs) -
+                   (int64_t)targetOffsetNs_;
+  error = ((error % period) + period + period / 2) % period - period / 2;
+
+  double maxAdjust = periodNs_ * ECMC_EC_DC_PLL_MAX_ADJUST;
+
+  if (!started_) {
+    integral_ = 0;
+    started_  = true;
+  }
+
+  integral_ += ki_ * error;
+
+  if (integral_ > maxAdjust) {
+    integral_ = maxAdjust;
+  } else if (integral_ < -maxAdjust) {
+    integral_ = -maxAdjust;
+  }
+
+  double adjust = kp_ * error + integral_;
+
+  if (adjust > maxAdjust) {
+    adjust = maxAdjust;
+  } else if (adjust < -maxAdjust) {
+    adjust = -maxAdjust;
+  }
+
+  adjustNs_  = (int64_t)adjust;
+  shiftNs_  += adjustNs_;
+
+  // Diagnostics (drift of reference clock relative master clock)
+  offsetNs_ = (int32_t)error;
+  driftPpm_ = -integral_ / periodNs_ * 1E6;
+
+  if (std::abs(error) <= lockWindowNs_) {
+    if (lockCounter_ < ECMC_EC_DC_PLL_LOCK_CYCLES) {
+      lockCounter_++;
+    }
+  } else {
+    lockCounter_ = 0;
+  }
+  locked_ = lockCounter_ >= ECMC_EC_DC_PLL_LOCK_CYCLES;
+
+  refreshAsyn();
+
+  return adjustNs_;
+}
+
+void ecmcEcDcPll::refreshAsyn() {
+  if (!offsetAsynParam_ || !driftAsynParam_ || !lockedAsynParam_) {
+    return;
+  }
+  offsetAsynParam_->refreshParamRT(0);
+  driftAsynParam_->refreshParamRT(0);
+  lockedAsynParam_->refreshParamRT(0);
+}
+
+int64_t ecmcEcDcPll::getShiftNs() {
+  return shiftNs_;
+}
+
+int64_t ecmcEcDcPll::getAdjustNs() {
+  return adjustNs_;
+}
@@ -0,0 +1,126 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcEcDcPll.h
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#ifndef ECMCECDCPLL_H_
+#define ECMCECDCPLL_H_
+
+#include <stdint.h>
+#include "../main/ecmcDefinitions.h"
+#include "../main/ecmcError.h"
+#include "../com/ecmcAsynPortDriver.h"
+
+#define ERROR_EC_DC_PLL_MODE_OUT_OF_RANGE 0x26100
+#define ERROR_EC_DC_PLL_PERIOD_OUT_OF_RANGE 0x26101
+#define ERROR_EC_DC_PLL_GAIN_OUT_OF_RANGE 0x26102
+#define ERROR_EC_DC_PLL_ASYN_PARAM_FAIL 0x26103
+
+#define ECMC_EC_DC_PLL_DEFAULT_KP 0.1
+#define ECMC_EC_DC_PLL_DEFAULT_KI 0.005
+#define ECMC_EC_DC_PLL_DEFAULT_LOCK_WINDOW_NS 1000
+// Consecutive cycles within lock window before locked
+#define ECMC_EC_DC_PLL_LOCK_CYCLES 100
+// Max wakeup adjustment per cycle (fraction of period)
+#define ECMC_EC_DC_PLL_MAX_ADJUST 0.001
+
+enum ecmcEcDcPllMode {
+  ECMC_EC_DC_PLL_MODE_OFF       = 0,
+  ECMC_EC_DC_PLL_MODE_REF_CLOCK = 1,
+  ECMC_EC_DC_PLL_MODE_MOCK      = 2,
+};
+
+/**
+ * \class ecmcEcDcPll
+ *
+ * \ingroup ecmc
+ *
+ * \brief Lock realtime cycle to the DC reference clock (master shift)
+ *
+ * The application time is kept on a nominal grid (one period per cycle)
+ * while the wakeup of the realtime thread is shifted. Each cycle the
+ * application time of the previous frame is compared to the reference
+ * clock time latched by the same frame:
+ *   offset = (appTime - refTime - targetOffset) normalized to +-period/2
+ * A PI controller calculates the adjustment of the next wakeup. The integral
+ * part converges to the drift between the master clock and the reference
+ * clock. The frames are then sent at a constant offset relative to SYNC0.
+ *
+ * In mock mode the reference clock is simulated (configurable drift and
+ * initial offset) for tests without DC slaves.
+ */
+class ecmcEcDcPll : public ecmcError {
+ public:
+  ecmcEcDcPll(ecmcAsynPortDriver *asynPortDriver,
+              int                 masterIndex);
+  ~ecmcEcDcPll();
+  int             setMode(int mode);
+  ecmcEcDcPllMode getMode();
+  bool            getEnable();
+  int             setPeriod(double periodNs);
+  int             setTargetOffset(int32_t offsetNs);
+  int             setGains(double kp,
+                           double ki);
+  int             setLockWindow(int32_t windowNs);
+  int             setMock(double  driftPpm,
+                          int32_t initOffsetNs);
+
+  // Called each cycle with times of previous frame. Returns wakeup adjustment.
+  int64_t         execute(uint64_t appTimeNs,
+                          uint64_t sendTimeNs,
+                          uint32_t refTimeNs,
+                          bool     refTimeValid);
+
+  // Accumulated wakeup shift (subtract from clock to get application time)
+  int64_t         getShiftNs();
+
+  // Adjustment of next wakeup (from last execute())
+  int64_t         getAdjustNs();
+
+ private:
+  void            initVars();
+  int             initAsyn();
+  void            refreshAsyn();
+  ecmcAsynDataItem* addParam(const char    *suffix,
+                             asynParamType  type,
+                             uint8_t       *data,
+                             size_t         bytes,
+                             ecmcEcDataType dt);
+
+  ecmcAsynPortDriver *asynPortDriver_;
+  int masterIndex_;
+  ecmcEcDcPllMode mode_;
+  double periodNs_;
+  int32_t targetOffsetNs_;
+  double kp_;
+  double ki_;
+  int32_t lockWindowNs_;
+  int lockCounter_;
+  bool started_;
+  double integral_;
+  int64_t adjustNs_;
+  int64_t shiftNs_;
+
+  // Mock reference clock
+  double mockDriftPpm_;
+  int32_t mockInitOffsetNs_;
+  bool mockStarted_;
+  uint64_t mockStartNs_;
+
+  // Diagnostics
+  int32_t offsetNs_;
+  double driftPpm_;
+  int32_t locked_;
+  ecmcAsynDataItem *offsetAsynParam_;
+  ecmcAsynDataItem *driftAsynParam_;
+  ecmcAsynDataItem *lockedAsynParam_;
+};
+
+#endif  /* ECMCECDCPLL_H_ */
@@ -11,6 +11,8 @@
 \*************************************************************************/
 
 #include "ecmcEcEntry.h"
+#include "ecmcEc.h"
+#include "../main/ecmcConfigArena.h"
 #include <stdlib.h> 
 #include "../main/ecmcErrorsList.h"
 
@@ -42,6 +44,18 @@
 	    *((uint8_t *) (DATA)) |= (VAL & EC_MASK_B4); \
 	  } while (0)
 
+/**
+ * Callback function for asyn writes when the master executes in an own
+ * thread (value queued to the master thread)
+ * userObj = entry object
+ * */
+asynStatus asynWriteEntryCmd(void* data, size_t bytes, asynParamType asynParType,void *userObj) {
+  if (!userObj) {
+    return asynError;
+  }
+  return ((ecmcEcEntry*)userObj)->asynWrite((uint8_t*)data, bytes, asynParType);
+}
+
 ecmcEcEntry::ecmcEcEntry(ecmcAsynPortDriver *asynPortDriver,
                          int masterId,
                          int slaveId,                         
@@ -145,6 +159,11 @@ void ecmcEcEntry::initVars() {
   pdoIndex_               = 0;
   slave_                  = NULL;
   buffer_                  = 0;
+  asynMaster_             = NULL;
+  asynSnapshot_           = 0;
+  asynLoad_               = 0;
+  asynBuffer_             = 0;
+  asynData_               = (uint8_t*)&buffer_;
   dataType_               = ECMC_EC_NONE;
   bitLength_              = 0;
   int8Ptr_                = (int8_t*)&buffer_;
@@ -168,6 +187,14 @@ ecmcEcEntry::~ecmcEcEntry()
   entryAsynParam_ = NULL;
 }
 
+void* ecmcEcEntry::operator new(size_t bytes) {
+  return ecmcConfigArena::allocate(bytes, ECMC_CONFIG_ARENA_EC_ENTRY);
+}
+
+void ecmcEcEntry::operator delete(void *ptr) {
+  ecmcConfigArena::deallocate(ptr);
+}
+
 void ecmcEcEntry::setDomainAdr(uint8_t *domainAdr) {
   domainAdr_ = domainAdr;
 }
@@ -495,23 +522,23 @@ int ecmcEcEntry::updateAsyn(bool force) {
   switch (entryAsynParam_->getAsynParameterType()) {
     case asynParamInt32:
       
-      entryAsynParam_->refreshParamRT(force, (uint8_t *)&buffer_, usedSizeBytes_);
+      entryAsynParam_->refreshParamRT(force, asynData_, usedSizeBytes_);
       break;
     case asynParamUInt32Digital:
 
-      entryAsynParam_->refreshParamRT(force, (uint8_t *)&buffer_, usedSizeBytes_);      
+      entryAsynParam_->refreshParamRT(force, asynData_, usedSizeBytes_);      
       break;
 
     case asynParamFloat64:
 
-      entryAsynParam_->refreshParamRT(force, (uint8_t *)&buffer_, usedSizeBytes_);            
+      entryAsynParam_->refreshParamRT(force, asynData_, usedSizeBytes_);            
       break;
 
 #ifdef ECMC_ASYN_ASYNPARAMINT64
 
     case asynParamInt64:
 
-      entryAsynParam_->refreshParamRT(force, (uint8_t *)&buffer_, usedSizeBytes_);            
+      entryAsynParam_->refreshParamRT(force, asynData_, usedSizeBytes_);            
       break;
 #endif //ECMC_ASYN_ASYNPARAMINT64
 
@@ -827,4 +854,69 @@ ecmcEcDataType ecmcEcEntry::getDataType() {
 
 int ecmcEcEntry::getSlaveId() {
   return slaveId_;
-}
\ No newline at end of file
+}
+/*
+ * Master executing in an own thread: asyn publishes a copy of the value
+ * taken by the master thread once per cycle (see ecmcEc::storeAsynSnapshot())
+ * and asyn writes are queued to the master thread.
+ */
+int ecmcEcEntry::enableAsynSnapshot(ecmcEc *master) {
+  asynMaster_    = master;
+  asynSnapshot_  = buffer_;
+  asynLoad_      = buffer_;
+  asynBuffer_    = buffer_;
+  asynData_      = (uint8_t*)&asynBuffer_;
+
+  if (!entryAsynParam_) {
+    return 0;
+  }
+
+  entryAsynParam_->setEcmcDataPointer(asynData_, sizeof(asynBuffer_));
+  entryAsynParam_->setEcmcDataSize(usedSizeBytes_);
+
+  if (direction_ == EC_DIR_OUTPUT || sim_) {
+    entryAsynParam_->setExeCmdFunctPtr(asynWriteEntryCmd, this);
+  }
+  return 0;
+}
+
+void ecmcEcEntry::storeAsynSnapshot() {
+  asynSnapshot_ = buffer_;
+}
+
+void ecmcEcEntry::loadAsynSnapshot() {
+  asynLoad_ = asynSnapshot_;
+}
+
+void ecmcEcEntry::commitAsynSnapshot() {
+  asynBuffer_ = asynLoad_;
+}
+
+asynStatus ecmcEcEntry::asynWrite(uint8_t      *data,
+                                  size_t        bytes,
+                                  asynParamType asynParType) {
+  // Same checks as a direct write (ecmcAsynDataItem::writeGeneric())
+  if (!asynMaster_ || !entryAsynParam_->asynTypeSupported(asynParType) ||
+      (bytes == 0) || (bytes > sizeof(buffer_))) {
+    LOGERR("%s/%s:%d: ERROR: Entry %s: asyn write failed (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           idStringChar_,
+           ERROR_EC_ENTRY_WRITE_FAIL);
+    return asynError;
+  }
+
+  uint64_t value = 0;
+  memcpy(&value, data, bytes);
+
+  if (asynMaster_->queueAsynWrite(this, value, bytes)) {
+    return asynError;
+  }
+  return asynSuccess;
+}
+
+// Same as ecmcDataItem::write() (only written bytes are changed)
+void ecmcEcEntry::applyAsynWrite(uint64_t value, size_t bytes) {
+  memcpy(&buffer_, &value, bytes);
+}
@@ -52,6 +52,8 @@
 #define ERROR_EC_ENTRY_VALUE_OUT_OF_RANGE 0x2100C
 #define ERROR_EC_ENTRY_SET_ALARM_STATE_FAIL 0x2100D
 
+class ecmcEc;
+
 class ecmcEcEntry : public ecmcError {
  public:
   ecmcEcEntry(ecmcAsynPortDriver *asynPortDriver,
@@ -75,6 +77,10 @@ class ecmcEcEntry : public ecmcError {
               ecmcEcDataType     dt,
               std::string        id);
   ~ecmcEcEntry();
+
+  // Placed in ecmcConfigArena during configuration
+  static void* operator new(size_t bytes);
+  static void  operator delete(void *ptr);
   void        initVars();
   uint16_t    getEntryIndex();
   uint8_t     getEntrySubIndex();
@@ -105,6 +111,19 @@ class ecmcEcEntry : public ecmcError {
   int         validate();
   int         setComAlarm(bool alarm);
   int         getSlaveId();
+  // Asyn access when the master executes in an own thread (not realtime)
+  int         enableAsynSnapshot(ecmcEc *master);
+  // Master thread
+  void        storeAsynSnapshot();
+  void        applyAsynWrite(uint64_t value,
+                             size_t   bytes);
+  // Main realtime thread (asyn port locked)
+  void        loadAsynSnapshot();
+  void        commitAsynSnapshot();
+  // Asyn write (port locked), queued to master thread
+  asynStatus  asynWrite(uint8_t      *data,
+                        size_t        bytes,
+                        asynParamType asynParType);
   
  private:
   int                 initAsyn();
@@ -129,6 +148,12 @@ class ecmcEcEntry : public ecmcError {
   ec_domain_t        *domain_;
   ec_direction_t      direction_;
   uint64_t            buffer_;
+  // Asyn snapshot (master in own thread, see ecmcEc::enableAsynSnapshot())
+  ecmcEc             *asynMaster_;
+  uint64_t            asynSnapshot_;
+  uint64_t            asynLoad_;
+  uint64_t            asynBuffer_;
+  uint8_t            *asynData_;
   int8_t             *int8Ptr_;
   uint8_t            *uint8Ptr_;
   int16_t            *int16Ptr_;
@@ -0,0 +1,72 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcEcMailbox.cpp
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#include "ecmcEcMailbox.h"
+
+ecmcEcMailbox::ecmcEcMailbox(ecmcEcEntry *source,
+                             ecmcEcEntry *destination) {
+  source_           = source;
+  destination_      = destination;
+  sequence_         = 0;
+  value_            = 0;
+  consumedSequence_ = 0;
+  consumedCount_    = 0;
+  overwrittenCount_ = 0;
+}
+
+ecmcEcMailbox::~ecmcEcMailbox() {}
+
+void ecmcEcMailbox::publish() {
+  uint64_t value = 0;
+
+  source_->readValue(&value);
+
+  uint32_t seq = sequence_;
+  __atomic_store_n(&sequence_, seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  __atomic_store_n(&value_, value, __ATOMIC_RELAXED);
+  __atomic_store_n(&sequence_, seq + 2, __ATOMIC_RELEASE);
+}
+
+void ecmcEcMailbox::consume() {
+  uint32_t seqStart = __atomic_load_n(&sequence_, __ATOMIC_ACQUIRE);
+
+  // Nothing new or write in progress (take it next cycle)
+  if ((seqStart == consumedSequence_) || (seqStart & 1)) {
+    return;
+  }
+
+  uint64_t value = __atomic_load_n(&value_, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+  if (__atomic_load_n(&sequence_, __ATOMIC_RELAXED) != seqStart) {
+    return;
+  }
+
+  // Sequence increases by 2 per publish
+  overwrittenCount_ += (seqStart - consumedSequence_) / 2 - 1;
+  consumedSequence_  = seqStart;
+  consumedCount_++;
+  destination_->writeValue(value);
+}
+
+uint32_t ecmcEcMailbox::getPublishedCount() {
+  return __atomic_load_n(&sequence_, __ATOMIC_RELAXED) / 2;
+}
+
+uint32_t ecmcEcMailbox::getConsumedCount() {
+  return consumedCount_;
+}
+
+uint32_t ecmcEcMailbox::getOverwrittenCount() {
+  return overwrittenCount_;
+}
@@ -0,0 +1,66 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcEcMailbox.h
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#ifndef ECMCECMAILBOX_H_
+#define ECMCECMAILBOX_H_
+
+#include <stdint.h>
+#include "ecmcEcEntry.h"
+
+#define ERROR_EC_MAILBOX_ENTRY_NULL 0x26300
+#define ERROR_EC_MAILBOX_ARRAY_FULL 0x26301
+#define ERROR_EC_MAILBOX_SAME_MASTER 0x26302
+
+/**
+ * \class ecmcEcMailbox
+ *
+ * \brief Lock free exchange of one entry value between two EtherCAT masters
+ *
+ * The source master publishes the value of the source entry after its
+ * input process image is updated (ecmcEc::receive()). The destination
+ * master writes the latest published value to the destination entry
+ * before its output process image is updated (ecmcEc::send()). The masters
+ * may execute in different threads with different cycle times. Only the
+ * latest value is kept (sequence lock, one writer and one reader), values
+ * published faster than consumed are counted as overwritten.
+ */
+class ecmcEcMailbox {
+ public:
+  ecmcEcMailbox(ecmcEcEntry *source,
+                ecmcEcEntry *destination);
+  ~ecmcEcMailbox();
+
+  // Source master thread
+  void     publish();
+
+  // Destination master thread
+  void     consume();
+
+  uint32_t getPublishedCount();
+  uint32_t getConsumedCount();
+  uint32_t getOverwrittenCount();
+
+ private:
+  ecmcEcEntry *source_;
+  ecmcEcEntry *destination_;
+
+  // Odd while written
+  uint32_t sequence_;
+  uint64_t value_;
+
+  // Owned by destination
+  uint32_t consumedSequence_;
+  uint32_t consumedCount_;
+  uint32_t overwrittenCount_;
+};
+
+#endif  /* ECMCECMAILBOX_H_ */
@@ -0,0 +1,325 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcEcMasterThread.cpp
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#include "ecmcEcMasterThread.h"
+#include <sched.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include "../com/ecmcOctetIF.h"
+#include "../com/ecmcAsynDataItem.h"
+#include "../main/ecmcRtGuard.h"
+
+// State checks when no diagnostics thread (as axis diag rate in main thread).
+// With diagnostics thread the published states are evaluated in this thread.
+#define ECMC_EC_MASTER_THREAD_STATE_CHECK_HZ 10
+
+static struct timespec addNs(struct timespec time, int64_t ns) {
+  int64_t total = (int64_t)time.tv_nsec + ns;
+
+  time.tv_sec += total / MCU_NSEC_PER_SEC;
+  total        = total % MCU_NSEC_PER_SEC;
+
+  if (total < 0) {
+    time.tv_sec--;
+    total += MCU_NSEC_PER_SEC;
+  }
+  time.tv_nsec = total;
+  return time;
+}
+
+static void* ecmcEcMasterThreadRoutine(void *arg) {
+  ecmcEcMasterThread *thread = (ecmcEcMasterThread *)arg;
+
+  thread->execute();
+  return NULL;
+}
+
+ecmcEcMasterThread::ecmcEcMasterThread(ecmcAsynPortDriver *asynPortDriver,
+                                       int                 masterSlot) {
+  masterSlot_   = masterSlot;
+  sampleRateHz_ = ECMC_EC_MASTER_THREAD_RATE_HZ;
+  priority_     = ECMC_EC_MASTER_THREAD_PRIO;
+  cpu_          = -1;
+  run_          = false;
+  running_      = false;
+  memset(&thread_, 0, sizeof(thread_));
+  memset(&activationTimeMonotonic_, 0, sizeof(activationTimeMonotonic_));
+  memset(&activationTimeOffset_, 0, sizeof(activationTimeOffset_));
+  ec_ = new ecmcEc(asynPortDriver, masterSlot);
+}
+
+ecmcEcMasterThread::~ecmcEcMasterThread() {
+  stop();
+  delete ec_;
+  ec_ = NULL;
+}
+
+ecmcEc * ecmcEcMasterThread::getEc() {
+  return ec_;
+}
+
+int ecmcEcMasterThread::getMasterSlot() {
+  return masterSlot_;
+}
+
+int ecmcEcMasterThread::setSampleRate(double sampleRateHz) {
+  if (running_) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MASTER_THREAD_RUNNING);
+  }
+
+  if ((sampleRateHz < 1) || (sampleRateHz > MCU_NSEC_PER_SEC / 1000)) {
+    LOGERR("%s/%s:%d: ERROR: Sample rate %lf Hz out of range (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           sampleRateHz,
+           ERROR_EC_MASTER_THREAD_RATE_OUT_OF_RANGE);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MASTER_THREAD_RATE_OUT_OF_RANGE);
+  }
+  sampleRateHz_ = sampleRateHz;
+  return 0;
+}
+
+double ecmcEcMasterThread::getSampleRate() {
+  return sampleRateHz_;
+}
+
+double ecmcEcMasterThread::getPeriodNs() {
+  return MCU_NSEC_PER_SEC / sampleRateHz_;
+}
+
+int ecmcEcMasterThread::setPriority(int priority) {
+  if (running_) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MASTER_THREAD_RUNNING);
+  }
+
+  if ((priority < sched_get_priority_min(SCHED_FIFO)) ||
+      (priority > sched_get_priority_max(SCHED_FIFO))) {
+    LOGERR("%s/%s:%d: ERROR: Priority %d out of range (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           priority,
+           ERROR_EC_MASTER_THREAD_PRIO_OUT_OF_RANGE);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MASTER_THREAD_PRIO_OUT_OF_RANGE);
+  }
+  priority_ = priority;
+  return 0;
+}
+
+int ecmcEcMasterThread::setCpu(int cpu) {
+  if (running_) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MASTER_THREAD_RUNNING);
+  }
+
+  if ((cpu >= CPU_SETSIZE) || (cpu >= sysconf(_SC_NPROCESSORS_CONF))) {
+    LOGERR("%s/%s:%d: ERROR: Cpu %d out of range (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           cpu,
+           ERROR_EC_MASTER_THREAD_CPU_OUT_OF_RANGE);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MASTER_THREAD_CPU_OUT_OF_RANGE);
+  }
+  cpu_ = cpu < 0 ? -1 : cpu;
+  return 0;
+}
+
+int ecmcEcMasterThread::start() {
+  if (running_) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MASTER_THREAD_RUNNING);
+  }
+
+  if (!ec_->getInitDone()) {
+    LOGERR("WARNING: EtherCAT master slot %d not initialized. Not started.\n",
+           masterSlot_);
+    return 0;
+  }
+
+  struct timespec activationTimeRealtime;
+  clock_gettime(CLOCK_MONOTONIC, &activationTimeMonotonic_);
+  clock_gettime(CLOCK_REALTIME,  &activationTimeRealtime);
+  activationTimeOffset_ = addNs(activationTimeRealtime,
+                                -((int64_t)activationTimeMonotonic_.tv_sec *
+                                  MCU_NSEC_PER_SEC +
+                                  activationTimeMonotonic_.tv_nsec));
+
+  ecrt_master_application_time(ec_->getMaster(),
+                               TIMESPEC2NS(activationTimeRealtime));
+
+  if (ec_->activate()) {
+    LOGERR("%s/%s:%d: ERROR: Activation of master slot %d failed (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           masterSlot_,
+           ERROR_EC_MASTER_THREAD_ACTIVATE_FAIL);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MASTER_THREAD_ACTIVATE_FAIL);
+  }
+
+  // Asyn is served by the main realtime thread from a per cycle snapshot
+  ec_->enableAsynSnapshot();
+
+  pthread_attr_t     attr;
+  struct sched_param sched;
+  memset(&sched, 0, sizeof(sched));
+  sched.sched_priority = priority_;
+
+  pthread_attr_init(&attr);
+  pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+  pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+  pthread_attr_setschedparam(&attr, &sched);
+  pthread_attr_setstacksize(&attr, PTHREAD_STACK_MIN + ECMC_STACK_SIZE);
+
+  if (cpu_ >= 0) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu_, &cpus);
+    pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+  }
+
+  run_ = true;
+  int result = pthread_create(&thread_,
+                              &attr,
+                              ecmcEcMasterThreadRoutine,
+                              this);
+  pthread_attr_destroy(&attr);
+
+  if (result != 0) {
+    run_ = false;
+    LOGERR(
+      "%s/%s:%d: ERROR: Create of thread for master slot %d failed (error %d) (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      masterSlot_,
+      result,
+      ERROR_EC_MASTER_THREAD_CREATE_FAIL);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MASTER_THREAD_CREATE_FAIL);
+  }
+
+  char name[16];
+  snprintf(name, sizeof(name), "%s%d", ECMC_EC_MASTER_THREAD_NAME,
+           ec_->getMasterIndex());
+  pthread_setname_np(thread_, name);
+  running_ = true;
+
+  LOGINFO4(
+    "%s/%s:%d: INFO: Started thread for master %d (%lf Hz, prio %d, cpu %d).\n",
+    __FILE__,
+    __FUNCTION__,
+    __LINE__,
+    ec_->getMasterIndex(),
+    sampleRateHz_,
+    priority_,
+    cpu_);
+  return 0;
+}
+
+void ecmcEcMasterThread::stop() {
+  if (!running_) {
+    return;
+  }
+  run_ = false;
+  pthread_join(thread_, NULL);
+  running_ = false;
+}
+
+bool ecmcEcMasterThread::getRunning() {
+  return running_;
+}
+
+void ecmcEcMasterThread::updateAsyn() {
+  if (running_) {
+    ec_->updateAsyn();
+  }
+}
+
+/*
+ * Realtime loop (process data only):
+ * 1. receive (entries, mailbox publish, memmap pipes, sdo queues)
+ * 2. domain and (low rate) master and slave state checks
+ * 3. queued asyn writes
+ * 4. send (mailbox consume, entries, dc application time)
+ * 5. asyn snapshot (published by main realtime thread in updateAsyn())
+ */
+void ecmcEcMasterThread::execute() {
+  const int64_t periodNs = (int64_t)getPeriodNs();
+  int stateCheckCycles   = (int)(sampleRateHz_ /
+                                 ECMC_EC_MASTER_THREAD_STATE_CHECK_HZ);
+  int counter   = 0;
+  uint64_t cycle = 0;
+
+  // No asyn port lock in this thread (refreshed by main thread)
+  ecmcAsynDataItem::setRefreshRTBlocked(true);
+  ecmcDataItem::setCycleDcTimeSource(ec_->getCycleDcTimeNsPtr());
+
+  // start 100ms after activation (same as main thread)
+  struct timespec wakeupTime = addNs(activationTimeMonotonic_,
+                                     MCU_NSEC_PER_SEC / 10);
+
+  while (run_) {
+    wakeupTime = addNs(wakeupTime, periodNs + ec_->getDcPllAdjustNs());
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeupTime, NULL);
+
+    if (!run_) {
+      break;
+    }
+
+    ecmcRtGuard::enterCycle(++cycle);
+    ec_->receive();
+    ec_->checkDomainState();
+
+    if (ec_->getDiagThreadRunning()) {
+      ec_->applyDiagState();
+    } else if (counter) {
+      counter--;
+    } else {
+      counter = stateCheckCycles;
+      ec_->checkState();
+      ec_->checkSlavesConfState();
+    }
+
+    ec_->executeAsynWrites();
+    ec_->send(activationTimeOffset_);
+    ec_->storeAsynSnapshot();
+    ecmcRtGuard::exitCycle();
+  }
+}
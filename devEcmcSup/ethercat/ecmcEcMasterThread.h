@@ -0,0 +1,88 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcEcMasterThread.h
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#ifndef ECMCECMASTERTHREAD_H_
+#define ECMCECMASTERTHREAD_H_
+
+#include <pthread.h>
+#include <time.h>
+#include "ecmcEc.h"
+#include "../main/ecmcError.h"
+
+#define ERROR_EC_MASTER_THREAD_CREATE_FAIL 0x26400
+#define ERROR_EC_MASTER_THREAD_RUNNING 0x26401
+#define ERROR_EC_MASTER_THREAD_RATE_OUT_OF_RANGE 0x26402
+#define ERROR_EC_MASTER_THREAD_PRIO_OUT_OF_RANGE 0x26403
+#define ERROR_EC_MASTER_THREAD_CPU_OUT_OF_RANGE 0x26404
+#define ERROR_EC_MASTER_THREAD_ACTIVATE_FAIL 0x26405
+
+// Defaults for additional masters
+#define ECMC_EC_MASTER_THREAD_RATE_HZ 1000
+#define ECMC_EC_MASTER_THREAD_PRIO 71
+
+/**
+ * \class ecmcEcMasterThread
+ *
+ * \brief Additional EtherCAT master executing in an own realtime thread
+ *
+ * The primary master (ec) is executed by the main realtime thread together
+ * with axes and PLCs. Additional masters only exchange process data:
+ * receive, domain check, memmap pipes, sdo queues, mailboxes and send, at
+ * an own rate and priority, optionally bound to one cpu.
+ *
+ * The thread does not hold the asyn port lock. Realtime asyn refresh is
+ * blocked in the thread. Entries and memmaps are copied to a snapshot at
+ * the end of each cycle (sequence counted) and the main realtime thread
+ * publishes the last complete snapshot in updateAsyn(). Asyn writes to
+ * entries and memmaps are queued and applied by the thread before send.
+ * Data is exchanged with other masters with mailboxes (ecmcEcMailbox).
+ */
+class ecmcEcMasterThread : public ecmcError {
+ public:
+  ecmcEcMasterThread(ecmcAsynPortDriver *asynPortDriver,
+                     int                 masterSlot);
+  ~ecmcEcMasterThread();
+
+  ecmcEc* getEc();
+  int     getMasterSlot();
+
+  int     setSampleRate(double sampleRateHz);
+  double  getSampleRate();
+  double  getPeriodNs();
+  int     setPriority(int priority);
+  // cpu < 0: any cpu
+  int     setCpu(int cpu);
+
+  // Activate master and start thread (not realtime)
+  int     start();
+  void    stop();
+  bool    getRunning();
+
+  // Main realtime thread (asyn port locked)
+  void    updateAsyn();
+
+  void    execute();
+
+ private:
+  ecmcEc *ec_;
+  int masterSlot_;
+  double sampleRateHz_;
+  int priority_;
+  int cpu_;
+  pthread_t thread_;
+  volatile bool run_;
+  bool running_;
+  struct timespec activationTimeMonotonic_;
+  struct timespec activationTimeOffset_;
+};
+
+#endif  /* ECMCECMASTERTHREAD_H_ */
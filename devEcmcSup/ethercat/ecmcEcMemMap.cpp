@@ -11,9 +11,22 @@
 \*************************************************************************/
 
 #include "ecmcEcMemMap.h"
+#include "ecmcEc.h"
 #include <stdlib.h>
 #include "../main/ecmcErrorsList.h"
 
+/**
+ * Callback function for asyn writes when the master executes in an own
+ * thread (data queued to the master thread)
+ * userObj = memmap object
+ * */
+asynStatus asynWriteMemMapCmd(void* data, size_t bytes, asynParamType asynParType,void *userObj) {
+  if (!userObj) {
+    return asynError;
+  }
+  return ((ecmcEcMemMap*)userObj)->asynWrite((uint8_t*)data, bytes, asynParType);
+}
+
 ecmcEcMemMap::ecmcEcMemMap(ecmcAsynPortDriver *asynPortDriver,
                            int masterId,
                            int slaveId,
@@ -66,11 +79,31 @@ void ecmcEcMemMap::initVars() {
   uint64Ptr_       = (uint64_t*)&buffer_;
   float32Ptr_      = (float*)&buffer_;
   float64Ptr_      = (double*)&buffer_;
+  asynMaster_      = NULL;
+  asynSnapshot_    = NULL;
+  asynBuffers_[0]  = NULL;
+  asynBuffers_[1]  = NULL;
+  asynBufferIndex_ = 0;
+  asynWriteBuffer_ = NULL;
+  asynWriteLoad_   = NULL;
+  asynWriteBytes_  = 0;
+  asynWriteSeq_    = 0;
+  asynWritePending_ = 0;
 }
 
 ecmcEcMemMap::~ecmcEcMemMap() {
   delete buffer_;
   buffer_ = NULL;
+  delete[] asynSnapshot_;
+  asynSnapshot_ = NULL;
+  delete[] asynBuffers_[0];
+  asynBuffers_[0] = NULL;
+  delete[] asynBuffers_[1];
+  asynBuffers_[1] = NULL;
+  delete[] asynWriteBuffer_;
+  asynWriteBuffer_ = NULL;
+  delete[] asynWriteLoad_;
+  asynWriteLoad_ = NULL;
   free(idStringChar_);
   idStringChar_ = NULL;
   delete memMapAsynParam_;
@@ -136,6 +169,113 @@ int ecmcEcMemMap::updateAsyn(bool force) {
   return 0;
 }
 
+/*
+ * Master executing in an own thread: asyn publishes a copy taken by the
+ * master thread once per cycle (see ecmcEc::storeAsynSnapshot()). The main
+ * thread loads into the buffer not published and swaps after the copy is
+ * validated, so a torn copy is never published. Asyn writes are stored in
+ * a write buffer and queued to the master thread.
+ */
+int ecmcEcMemMap::enableAsynSnapshot(ecmcEc *master) {
+  asynMaster_      = master;
+  asynSnapshot_    = new uint8_t[byteSize_];
+  asynBuffers_[0]  = new uint8_t[byteSize_];
+  asynBuffers_[1]  = new uint8_t[byteSize_];
+  asynBufferIndex_ = 0;
+  memcpy(asynSnapshot_, buffer_, byteSize_);
+  memcpy(asynBuffers_[0], buffer_, byteSize_);
+  memcpy(asynBuffers_[1], buffer_, byteSize_);
+
+  if (!memMapAsynParam_) {
+    return 0;
+  }
+
+  memMapAsynParam_->setEcmcDataPointer(asynBuffers_[asynBufferIndex_],
+                                       byteSize_);
+
+  if (direction_ == EC_DIR_OUTPUT) {
+    asynWriteBuffer_ = new uint8_t[byteSize_];
+    asynWriteLoad_   = new uint8_t[byteSize_];
+    memMapAsynParam_->setExeCmdFunctPtr(asynWriteMemMapCmd, this);
+  }
+  return 0;
+}
+
+void ecmcEcMemMap::storeAsynSnapshot() {
+  memcpy(asynSnapshot_, buffer_, byteSize_);
+}
+
+void ecmcEcMemMap::loadAsynSnapshot() {
+  memcpy(asynBuffers_[asynBufferIndex_ ^ 1], asynSnapshot_, byteSize_);
+}
+
+void ecmcEcMemMap::commitAsynSnapshot() {
+  asynBufferIndex_ ^= 1;
+  memMapAsynParam_->setEcmcDataPointer(asynBuffers_[asynBufferIndex_],
+                                       byteSize_);
+}
+
+/*
+ * Asyn thread (port locked). Only queued if not already pending, the
+ * master thread then applies the latest written data.
+ */
+asynStatus ecmcEcMemMap::asynWrite(uint8_t      *data,
+                                   size_t        bytes,
+                                   asynParamType asynParType) {
+  if (!asynMaster_ || !asynWriteBuffer_ ||
+      !memMapAsynParam_->asynTypeSupported(asynParType) || (bytes == 0)) {
+    return asynError;
+  }
+
+  size_t bytesToCopy = bytes;
+
+  if (bytes > byteSize_) {
+    bytesToCopy = byteSize_;
+  }
+
+  uint32_t seq = asynWriteSeq_;
+  __atomic_store_n(&asynWriteSeq_, seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  memcpy(asynWriteBuffer_, data, bytesToCopy);
+  asynWriteBytes_ = bytesToCopy;
+  __atomic_store_n(&asynWriteSeq_, seq + 2, __ATOMIC_RELEASE);
+
+  if (__atomic_exchange_n(&asynWritePending_, 1, __ATOMIC_ACQ_REL)) {
+    return asynSuccess;
+  }
+
+  if (asynMaster_->queueAsynWrite(this)) {
+    __atomic_store_n(&asynWritePending_, 0, __ATOMIC_RELEASE);
+    return asynError;
+  }
+  return asynSuccess;
+}
+
+/*
+ * Master thread. If the write buffer is being written the data is not
+ * applied, the ongoing write then queues again (pending cleared first).
+ */
+void ecmcEcMemMap::applyAsynWrite() {
+  __atomic_exchange_n(&asynWritePending_, 0, __ATOMIC_ACQ_REL);
+
+  uint32_t seq = __atomic_load_n(&asynWriteSeq_, __ATOMIC_ACQUIRE);
+
+  if (seq & 1) {
+    return;
+  }
+
+  size_t bytes = asynWriteBytes_;
+  memcpy(asynWriteLoad_, asynWriteBuffer_, bytes);
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+  if (__atomic_load_n(&asynWriteSeq_, __ATOMIC_RELAXED) != seq) {
+    return;
+  }
+
+  // Same as write() (only written bytes are changed)
+  memcpy(buffer_, asynWriteLoad_, bytes);
+}
+
 int ecmcEcMemMap::validate() {
   byteOffset_ = startEntry_->getByteOffset();
   domainAdr_  = startEntry_->getDomainAdr();
@@ -232,6 +372,10 @@ int ecmcEcMemMap::initAsyn() {
   memMapAsynParam_->addSupportedAsynType(asynParamFloat32Array);
   memMapAsynParam_->addSupportedAsynType(asynParamFloat64Array);
   memMapAsynParam_->setAllowWriteToEcmc(direction_ == EC_DIR_OUTPUT);
+  if(direction_ == EC_DIR_INPUT) {
+    memMapAsynParam_->setArrayBlockCount(
+      asynPortDriver_->getDefaultArrayBlockCount());
+  }
   memMapAsynParam_->refreshParam(1);
   asynPortDriver_->callParamCallbacks(ECMC_ASYN_DEFAULT_LIST, ECMC_ASYN_DEFAULT_ADDR);
 
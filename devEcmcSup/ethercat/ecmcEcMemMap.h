@@ -60,6 +60,18 @@ class ecmcEcMemMap : public ecmcError {
   size_t      getElementCount();
   size_t      getBytesPerElement();
   int         updateAsyn(bool force);
+  // Asyn access when the master executes in an own thread (not realtime)
+  int         enableAsynSnapshot(ecmcEc *master);
+  // Master thread
+  void        storeAsynSnapshot();
+  void        applyAsynWrite();
+  // Main realtime thread (asyn port locked)
+  void        loadAsynSnapshot();
+  void        commitAsynSnapshot();
+  // Asyn write (port locked), queued to master thread
+  asynStatus  asynWrite(uint8_t      *data,
+                        size_t        bytes,
+                        asynParamType asynParType);
 
  private:
   int                initAsyn();
@@ -90,5 +102,16 @@ class ecmcEcMemMap : public ecmcError {
   uint64_t           *uint64Ptr_;
   float              *float32Ptr_;
   double             *float64Ptr_;
+  // Asyn snapshot (master in own thread, see ecmcEc::enableAsynSnapshot())
+  ecmcEc             *asynMaster_;
+  uint8_t            *asynSnapshot_;
+  uint8_t            *asynBuffers_[2];
+  int                 asynBufferIndex_;
+  // Asyn write buffer (sequence counted, odd while written)
+  uint8_t            *asynWriteBuffer_;
+  uint8_t            *asynWriteLoad_;
+  size_t              asynWriteBytes_;
+  uint32_t            asynWriteSeq_;
+  uint32_t            asynWritePending_;
 };
 #endif  /* ECMCECMEMMAP_H_ */
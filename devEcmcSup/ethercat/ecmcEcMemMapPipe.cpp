@@ -0,0 +1,348 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcEcMemMapPipe.cpp
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#include "ecmcEcMemMapPipe.h"
+#include <string.h>
+#include "../main/ecmcErrorsList.h"
+
+// Typed conversion kernel (one loop per type, vectorizable)
+template<typename T>
+static void convertBlock(const uint8_t *src,
+                         double        *dst,
+                         size_t         count,
+                         double         scale,
+                         double         offset) {
+  const T *typedSrc = (const T *)src;
+
+  for (size_t i = 0; i < count; i++) {
+    dst[i] = (double)typedSrc[i] * scale + offset;
+  }
+}
+
+ecmcEcMemMapPipe::ecmcEcMemMapPipe(ecmcAsynPortDriver *asynPortDriver,
+                                   int                 masterIndex,
+                                   int                 index,
+                                   ecmcEcMemMap       *memMap,
+                                   ecmcDataStorage    *dataStorage,
+                                   double              scale,
+                                   double              offset,
+                                   int                 decimation) {
+  initVars();
+  asynPortDriver_ = asynPortDriver;
+  masterIndex_    = masterIndex;
+  index_          = index;
+  memMap_         = memMap;
+  dataStorage_    = dataStorage;
+  scale_          = scale;
+  offset_         = offset;
+  decimation_     = decimation;
+
+  if (!memMap_) {
+    LOGERR("%s/%s:%d: ERROR: Memmap NULL (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           ERROR_EC_MEM_MAP_PIPE_MEM_MAP_NULL);
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_EC_MEM_MAP_PIPE_MEM_MAP_NULL);
+    return;
+  }
+
+  if (!dataStorage_) {
+    LOGERR("%s/%s:%d: ERROR: Data storage NULL (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           ERROR_EC_MEM_MAP_PIPE_DATA_STORAGE_NULL);
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_EC_MEM_MAP_PIPE_DATA_STORAGE_NULL);
+    return;
+  }
+
+  if (decimation_ < 1) {
+    LOGERR("%s/%s:%d: ERROR: Decimation %d out of range (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           decimation_,
+           ERROR_EC_MEM_MAP_PIPE_DECIMATION_OUT_OF_RANGE);
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_EC_MEM_MAP_PIPE_DECIMATION_OUT_OF_RANGE);
+    return;
+  }
+
+  ecmcEcDataType dt = memMap_->getDataType();
+
+  // Bit types not supported
+  if ((dt < ECMC_EC_U8) || (dt > ECMC_EC_F64)) {
+    LOGERR("%s/%s:%d: ERROR: Memmap data type not supported (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           ERROR_EC_MEM_MAP_PIPE_DATA_TYPE_INVALID);
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_EC_MEM_MAP_PIPE_DATA_TYPE_INVALID);
+    return;
+  }
+
+  elements_ = memMap_->getElementCount();
+  work_     = new double[elements_ > 0 ? elements_ : 1];
+  memset(work_, 0, sizeof(double) * (elements_ > 0 ? elements_ : 1));
+  initAsyn();
+}
+
+ecmcEcMemMapPipe::~ecmcEcMemMapPipe() {
+  delete[] work_;
+  work_ = NULL;
+}
+
+void ecmcEcMemMapPipe::initVars() {
+  errorReset();
+  asynPortDriver_     = NULL;
+  masterIndex_        = 0;
+  index_              = 0;
+  memMap_             = NULL;
+  dataStorage_        = NULL;
+  scale_              = 1;
+  offset_             = 0;
+  decimation_         = 1;
+  decimationPhase_    = 0;
+  elements_           = 0;
+  work_               = NULL;
+  firTapCount_        = 0;
+  firHistoryIndex_    = 0;
+  convertedCount_     = 0;
+  filteredCount_      = 0;
+  storedCount_        = 0;
+  errorCount_         = 0;
+  convertedAsynParam_ = NULL;
+  filteredAsynParam_  = NULL;
+  storedAsynParam_    = NULL;
+  errorsAsynParam_    = NULL;
+  memset(firTaps_, 0, sizeof(firTaps_));
+  memset(firHistory_, 0, sizeof(firHistory_));
+}
+
+ecmcAsynDataItem * ecmcEcMemMapPipe::addParam(const char *suffix,
+                                              int32_t    *data) {
+  char buffer[EC_MAX_OBJECT_PATH_CHAR_LENGTH];
+
+  // "ec%d.mmpipe%d.<suffix>"
+  unsigned int charCount = snprintf(buffer,
+                                    sizeof(buffer),
+                                    ECMC_EC_STR "%d." ECMC_EC_MM_PIPE_STR "%d.%s",
+                                    masterIndex_,
+                                    index_,
+                                    suffix);
+
+  if (charCount >= sizeof(buffer) - 1) {
+    LOGERR(
+      "%s/%s:%d: Error: Failed to generate alias. Buffer to small (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      ERROR_EC_MEM_MAP_PIPE_ASYN_PARAM_FAIL);
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_EC_MEM_MAP_PIPE_ASYN_PARAM_FAIL);
+    return NULL;
+  }
+
+  ecmcAsynDataItem *param = asynPortDriver_->addNewAvailParam(buffer,
+                                                              asynParamInt32,
+                                                              (uint8_t *)data,
+                                                              sizeof(*data),
+                                                              ECMC_EC_S32,
+                                                              0);
+
+  if (!param) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      buffer);
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_MAIN_ASYN_CREATE_PARAM_FAIL);
+    return NULL;
+  }
+  param->setAllowWriteToEcmc(false);
+  param->refreshParam(1);
+  return param;
+}
+
+int ecmcEcMemMapPipe::initAsyn() {
+  if (!asynPortDriver_) {
+    return 0;
+  }
+
+  convertedAsynParam_ = addParam("converted", &convertedCount_);
+  filteredAsynParam_  = addParam("filtered", &filteredCount_);
+  storedAsynParam_    = addParam("stored", &storedCount_);
+  errorsAsynParam_    = addParam("errors", &errorCount_);
+  return getErrorID();
+}
+
+void ecmcEcMemMapPipe::refreshAsyn() {
+  if (!convertedAsynParam_ || !filteredAsynParam_ || !storedAsynParam_ ||
+      !errorsAsynParam_) {
+    return;
+  }
+  convertedAsynParam_->refreshParamRT(0);
+  filteredAsynParam_->refreshParamRT(0);
+  storedAsynParam_->refreshParamRT(0);
+  errorsAsynParam_->refreshParamRT(0);
+}
+
+int ecmcEcMemMapPipe::setFir(const double *taps, int count) {
+  if ((count < 0) || (count > ECMC_EC_MEM_MAP_PIPE_MAX_FIR_TAPS)) {
+    LOGERR("%s/%s:%d: ERROR: FIR taps %d out of range (max %d) (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           count,
+           ECMC_EC_MEM_MAP_PIPE_MAX_FIR_TAPS,
+           ERROR_EC_MEM_MAP_PIPE_FIR_TAPS_OUT_OF_RANGE);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_MEM_MAP_PIPE_FIR_TAPS_OUT_OF_RANGE);
+  }
+
+  memset(firTaps_, 0, sizeof(firTaps_));
+  memset(firHistory_, 0, sizeof(firHistory_));
+  for (int i = 0; i < count; i++) {
+    firTaps_[i] = taps[i];
+  }
+  firTapCount_     = count;
+  firHistoryIndex_ = 0;
+  return 0;
+}
+
+// Stage 1: conversion, scale and offset of all elements into work buffer
+void ecmcEcMemMapPipe::convert() {
+  const uint8_t *src = memMap_->getBufferPointer();
+
+  switch (memMap_->getDataType()) {
+  case ECMC_EC_U8:
+    convertBlock<uint8_t>(src, work_, elements_, scale_, offset_);
+    break;
+
+  case ECMC_EC_S8:
+    convertBlock<int8_t>(src, work_, elements_, scale_, offset_);
+    break;
+
+  case ECMC_EC_U16:
+    convertBlock<uint16_t>(src, work_, elements_, scale_, offset_);
+    break;
+
+  case ECMC_EC_S16:
+    convertBlock<int16_t>(src, work_, elements_, scale_, offset_);
+    break;
+
+  case ECMC_EC_U32:
+    convertBlock<uint32_t>(src, work_, elements_, scale_, offset_);
+    break;
+
+  case ECMC_EC_S32:
+    convertBlock<int32_t>(src, work_, elements_, scale_, offset_);
+    break;
+
+  case ECMC_EC_U64:
+    convertBlock<uint64_t>(src, work_, elements_, scale_, offset_);
+    break;
+
+  case ECMC_EC_S64:
+    convertBlock<int64_t>(src, work_, elements_, scale_, offset_);
+    break;
+
+  case ECMC_EC_F32:
+    convertBlock<float>(src, work_, elements_, scale_, offset_);
+    break;
+
+  case ECMC_EC_F64:
+    convertBlock<double>(src, work_, elements_, scale_, offset_);
+    break;
+
+  default:
+    break;
+  }
+}
+
+/* Stage 2 and 3: FIR and decimation (in place, output index <= input index).
+ * Returns number of output samples.*/
+int ecmcEcMemMapPipe::filterAndDecimate() {
+  int outCount = 0;
+
+  for (size_t i = 0; i < elements_; i++) {
+    double sample = work_[i];
+
+    if (firTapCount_ > 0) {
+      firHistoryIndex_ = (firHistoryIndex_ + 1) % firTapCount_;
+      firHistory_[firHistoryIndex_] = sample;
+    }
+
+    // Keep every decimation_:th sample
+    if (++decimationPhase_ < decimation_) {
+      continue;
+    }
+    decimationPhase_ = 0;
+
+    // Only calculate filter output for kept samples
+    if (firTapCount_ > 0) {
+      double sum = 0;
+      int    h   = firHistoryIndex_;
+
+      for (int k = 0; k < firTapCount_; k++) {
+        sum += firTaps_[k] * firHistory_[h];
+        h    = (h == 0) ? firTapCount_ - 1 : h - 1;
+      }
+      sample = sum;
+    }
+    work_[outCount++] = sample;
+  }
+  return outCount;
+}
+
+int ecmcEcMemMapPipe::execute() {
+  if (!work_ || (elements_ == 0)) {
+    return 0;
+  }
+
+  convert();
+  convertedCount_ += elements_;
+
+  int outCount = filterAndDecimate();
+  filteredCount_ += outCount;
+
+  if (outCount > 0) {
+    if (dataStorage_->appendData(work_, outCount, true)) {
+      errorCount_++;
+    } else {
+      storedCount_ += outCount;
+    }
+  }
+
+  refreshAsyn();
+  return 0;
+}
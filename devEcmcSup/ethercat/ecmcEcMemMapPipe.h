@@ -0,0 +1,100 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcEcMemMapPipe.h
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#ifndef ECMCECMEMMAPPIPE_H_
+#define ECMCECMEMMAPPIPE_H_
+
+#include <stdint.h>
+#include "../main/ecmcDefinitions.h"
+#include "../main/ecmcError.h"
+#include "../com/ecmcAsynPortDriver.h"
+#include "../misc/ecmcDataStorage.h"
+#include "ecmcEcMemMap.h"
+
+#define ERROR_EC_MEM_MAP_PIPE_MEM_MAP_NULL 0x26200
+#define ERROR_EC_MEM_MAP_PIPE_DATA_STORAGE_NULL 0x26201
+#define ERROR_EC_MEM_MAP_PIPE_DECIMATION_OUT_OF_RANGE 0x26202
+#define ERROR_EC_MEM_MAP_PIPE_FIR_TAPS_OUT_OF_RANGE 0x26203
+#define ERROR_EC_MEM_MAP_PIPE_DATA_TYPE_INVALID 0x26204
+#define ERROR_EC_MEM_MAP_PIPE_ASYN_PARAM_FAIL 0x26205
+
+#define ECMC_EC_MEM_MAP_PIPE_MAX_FIR_TAPS 64
+
+/**
+ * \class ecmcEcMemMapPipe
+ *
+ * \brief Process data pipeline from memmap to data storage (no PLC)
+ *
+ * Executed in realtime directly after the input process image is updated:
+ *  1. Type conversion of all memmap elements to double, scale and offset.
+ *  2. Optional FIR filter (state kept between cycles).
+ *  3. Optional decimation (every n:th sample, phase kept between cycles).
+ *  4. Append of the result to the data storage (one block per cycle).
+ * The conversion is done in one typed loop per data type (vectorizable).
+ *
+ * Counters of processed samples per stage are available as asyn
+ * parameters (ec<id>.mmpipe<index>.converted/filtered/stored/errors).
+ */
+class ecmcEcMemMapPipe : public ecmcError {
+ public:
+  ecmcEcMemMapPipe(ecmcAsynPortDriver *asynPortDriver,
+                   int                 masterIndex,
+                   int                 index,
+                   ecmcEcMemMap       *memMap,
+                   ecmcDataStorage    *dataStorage,
+                   double              scale,
+                   double              offset,
+                   int                 decimation);
+  ~ecmcEcMemMapPipe();
+  int  setFir(const double *taps,
+              int           count);
+  int  execute();
+
+ private:
+  void initVars();
+  int  initAsyn();
+  void refreshAsyn();
+  ecmcAsynDataItem* addParam(const char *suffix,
+                             int32_t    *data);
+  void convert();
+  int  filterAndDecimate();
+
+  ecmcAsynPortDriver *asynPortDriver_;
+  int masterIndex_;
+  int index_;
+  ecmcEcMemMap *memMap_;
+  ecmcDataStorage *dataStorage_;
+  double scale_;
+  double offset_;
+  int decimation_;
+  int decimationPhase_;
+  size_t elements_;
+  double *work_;
+
+  // FIR (circular history of input samples)
+  double firTaps_[ECMC_EC_MEM_MAP_PIPE_MAX_FIR_TAPS];
+  double firHistory_[ECMC_EC_MEM_MAP_PIPE_MAX_FIR_TAPS];
+  int firTapCount_;
+  int firHistoryIndex_;
+
+  // Throughput counters (samples)
+  int32_t convertedCount_;
+  int32_t filteredCount_;
+  int32_t storedCount_;
+  int32_t errorCount_;
+  ecmcAsynDataItem *convertedAsynParam_;
+  ecmcAsynDataItem *filteredAsynParam_;
+  ecmcAsynDataItem *storedAsynParam_;
+  ecmcAsynDataItem *errorsAsynParam_;
+};
+
+#endif  /* ECMCECMEMMAPPIPE_H_ */
@@ -11,6 +11,7 @@
 \*************************************************************************/
 
 #include "ecmcEcPdo.h"
+#include "../main/ecmcConfigArena.h"
 
 ecmcEcPdo::ecmcEcPdo(ecmcAsynPortDriver *asynPortDriver,
                      int masterId,
@@ -76,6 +77,14 @@ ecmcEcPdo::~ecmcEcPdo() {
   }
 }
 
+void* ecmcEcPdo::operator new(size_t bytes) {
+  return ecmcConfigArena::allocate(bytes, ECMC_CONFIG_ARENA_EC_PDO);
+}
+
+void ecmcEcPdo::operator delete(void *ptr) {
+  ecmcConfigArena::deallocate(ptr);
+}
+
 ecmcEcEntry * ecmcEcPdo::addEntry(uint16_t       entryIndex,
                                   uint8_t        entrySubIndex,
                                   ecmcEcDataType dt,
@@ -37,6 +37,10 @@ class ecmcEcPdo : public ecmcError {
             uint16_t           pdoIndex,
             ec_direction_t     direction);
   ~ecmcEcPdo();
+
+  // Placed in ecmcConfigArena during configuration
+  static void* operator new(size_t bytes);
+  static void  operator delete(void *ptr);
   ecmcEcEntry* addEntry(uint16_t     entryIndex,
                         uint8_t      entrySubIndex,
                         ecmcEcDataType dt,
@@ -0,0 +1,442 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcEcSdoQueue.cpp
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#include <exception>
+#include <string.h>
+#include "ecmcEcSdoQueue.h"
+#include "../com/ecmcOctetIF.h"  // Logging macros
+
+// Data size of write request objects
+static const int writeSizes[ECMC_SDO_QUEUE_WRITE_SIZES] = { 1, 2, 4, 8 };
+
+ecmcEcSdoQueue::ecmcEcSdoQueue(ec_slave_config_t *sc,
+                               int                slavePosition,
+                               int                poolSize) {
+  initVars();
+  slavePosition_ = slavePosition;
+  readPoolSize_  = poolSize;
+
+  // Request objects must be created before master activation
+  for (int i = 0; i < readPoolSize_; i++) {
+    readPool_[i].req = ecrt_slave_config_create_sdo_request(
+      sc, 0, 0, ECMC_SDO_QUEUE_DATA_MAX_BYTES);
+
+    if (readPool_[i].req == NULL) {
+      LOGERR(
+        "%s/%s:%d: Error: Slave %d: Failed creation of SDO request object.\n",
+        __FILE__,
+        __FUNCTION__,
+        __LINE__,
+        slavePosition_);
+      throw std::bad_alloc();
+    }
+    ecrt_sdo_request_timeout(readPool_[i].req, ECMC_SDO_QUEUE_TIMEOUT_MS);
+  }
+
+  for (int i = 0; i < ECMC_SDO_QUEUE_WRITE_SIZES; i++) {
+    writePool_[i].req = ecrt_slave_config_create_sdo_request(sc,
+                                                             0,
+                                                             0,
+                                                             writeSizes[i]);
+
+    if (writePool_[i].req == NULL) {
+      LOGERR(
+        "%s/%s:%d: Error: Slave %d: Failed creation of SDO request object.\n",
+        __FILE__,
+        __FUNCTION__,
+        __LINE__,
+        slavePosition_);
+      throw std::bad_alloc();
+    }
+    ecrt_sdo_request_timeout(writePool_[i].req, ECMC_SDO_QUEUE_TIMEOUT_MS);
+  }
+}
+
+ecmcEcSdoQueue::~ecmcEcSdoQueue() {
+  // Request objects are owned by the master
+}
+
+void ecmcEcSdoQueue::initVars() {
+  errorReset();
+  slavePosition_ = 0;
+  readPoolSize_  = 0;
+  busyCount_     = 0;
+  generation_    = 0;
+  inActiveList_  = false;
+  freeCount_     = ECMC_SDO_QUEUE_SIZE;
+
+  memset(requests_, 0, sizeof(requests_));
+
+  for (int i = 0; i < ECMC_SDO_QUEUE_SIZE; i++) {
+    requests_[i].handle = -1;
+    // Lowest slot first
+    freeSlots_[i] = ECMC_SDO_QUEUE_SIZE - 1 - i;
+  }
+
+  for (int p = 0; p < ECMC_SDO_QUEUE_PRIO_COUNT; p++) {
+    fifoHead_[p]  = 0;
+    fifoCount_[p] = 0;
+  }
+
+  for (int i = 0; i < ECMC_SDO_QUEUE_POOL_MAX; i++) {
+    readPool_[i].req  = NULL;
+    readPool_[i].slot = -1;
+  }
+
+  for (int i = 0; i < ECMC_SDO_QUEUE_WRITE_SIZES; i++) {
+    writePool_[i].req  = NULL;
+    writePool_[i].slot = -1;
+  }
+}
+
+int ecmcEcSdoQueue::getWriteSizeIndex(int byteSize) {
+  for (int i = 0; i < ECMC_SDO_QUEUE_WRITE_SIZES; i++) {
+    if (writeSizes[i] == byteSize) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int ecmcEcSdoQueue::addRead(uint16_t             index,
+                            uint8_t              subIndex,
+                            int                  byteSize,
+                            int                  prio,
+                            ecmcSdoQueueCallback callback,
+                            void                *userObj,
+                            int                 *handle) {
+  return addRequest(index, subIndex, 0, byteSize, false, prio, callback,
+                    userObj, handle);
+}
+
+int ecmcEcSdoQueue::addReadBatch(int                  count,
+                                 const uint16_t      *indices,
+                                 const uint8_t       *subIndices,
+                                 const int           *byteSizes,
+                                 int                  prio,
+                                 ecmcSdoQueueCallback callback,
+                                 void                *userObj,
+                                 int                 *handles) {
+  if ((prio < 0) || (prio >= ECMC_SDO_QUEUE_PRIO_COUNT)) {
+    LOGERR("%s/%s:%d: ERROR: Slave %d: SDO priority out of range (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           slavePosition_,
+           ERROR_EC_SDO_QUEUE_PRIO_OUT_OF_RANGE);
+    return ERROR_EC_SDO_QUEUE_PRIO_OUT_OF_RANGE;
+  }
+
+  // Check all before queueing so a failed batch leaves no requests behind
+  for (int i = 0; i < count; i++) {
+    if ((byteSizes[i] <= 0) || (byteSizes[i] > ECMC_SDO_QUEUE_DATA_MAX_BYTES)) {
+      LOGERR("%s/%s:%d: ERROR: Slave %d: SDO byte size %d invalid (0x%x).\n",
+             __FILE__,
+             __FUNCTION__,
+             __LINE__,
+             slavePosition_,
+             byteSizes[i],
+             ERROR_EC_SDO_QUEUE_BYTE_SIZE_INVALID);
+      return ERROR_EC_SDO_QUEUE_BYTE_SIZE_INVALID;
+    }
+  }
+
+  if ((count > freeCount_) ||
+      (fifoCount_[prio] + count > ECMC_SDO_QUEUE_SIZE)) {
+    LOGERR("%s/%s:%d: ERROR: Slave %d: SDO queue full (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           slavePosition_,
+           ERROR_EC_SDO_QUEUE_FULL);
+    return ERROR_EC_SDO_QUEUE_FULL;
+  }
+
+  for (int i = 0; i < count; i++) {
+    int errorCode = addRequest(indices[i], subIndices[i], 0, byteSizes[i],
+                               false, prio, callback, userObj, &handles[i]);
+
+    if (errorCode) {
+      return errorCode;
+    }
+  }
+  return 0;
+}
+
+int ecmcEcSdoQueue::addWrite(uint16_t             index,
+                             uint8_t              subIndex,
+                             uint64_t             value,
+                             int                  byteSize,
+                             int                  prio,
+                             ecmcSdoQueueCallback callback,
+                             void                *userObj,
+                             int                 *handle) {
+  return addRequest(index, subIndex, value, byteSize, true, prio, callback,
+                    userObj, handle);
+}
+
+int ecmcEcSdoQueue::addRequest(uint16_t             index,
+                               uint8_t              subIndex,
+                               uint64_t             value,
+                               int                  byteSize,
+                               bool                 write,
+                               int                  prio,
+                               ecmcSdoQueueCallback callback,
+                               void                *userObj,
+                               int                 *handle) {
+  if ((prio < 0) || (prio >= ECMC_SDO_QUEUE_PRIO_COUNT)) {
+    LOGERR("%s/%s:%d: ERROR: Slave %d: SDO priority out of range (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           slavePosition_,
+           ERROR_EC_SDO_QUEUE_PRIO_OUT_OF_RANGE);
+    return ERROR_EC_SDO_QUEUE_PRIO_OUT_OF_RANGE;
+  }
+
+  if ((byteSize <= 0) || (byteSize > ECMC_SDO_QUEUE_DATA_MAX_BYTES) ||
+      (write && (getWriteSizeIndex(byteSize) < 0))) {
+    LOGERR("%s/%s:%d: ERROR: Slave %d: SDO byte size %d invalid (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           slavePosition_,
+           byteSize,
+           ERROR_EC_SDO_QUEUE_BYTE_SIZE_INVALID);
+    return ERROR_EC_SDO_QUEUE_BYTE_SIZE_INVALID;
+  }
+
+  // Results not released (getResult()/release()) occupy the queue
+  if ((freeCount_ == 0) || (fifoCount_[prio] >= ECMC_SDO_QUEUE_SIZE)) {
+    LOGERR("%s/%s:%d: ERROR: Slave %d: SDO queue full (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           slavePosition_,
+           ERROR_EC_SDO_QUEUE_FULL);
+    return ERROR_EC_SDO_QUEUE_FULL;
+  }
+
+  int slot = freeSlots_[--freeCount_];
+  generation_ = (generation_ + 1) % (INT32_MAX / ECMC_SDO_QUEUE_SIZE);
+
+  ecmcSdoQueueRequest *req = &requests_[slot];
+  req->handle   = generation_ * ECMC_SDO_QUEUE_SIZE + slot;
+  req->state    = ECMC_SDO_QUEUE_REQ_PENDING;
+  req->index    = index;
+  req->subIndex = subIndex;
+  req->byteSize = byteSize;
+  req->write    = write;
+  req->value    = value;
+  req->callback = callback;
+  req->userObj  = userObj;
+
+  int tail = (fifoHead_[prio] + fifoCount_[prio]) % ECMC_SDO_QUEUE_SIZE;
+  fifo_[prio][tail] = req->handle;
+  fifoCount_[prio]++;
+
+  if (handle) {
+    *handle = req->handle;
+  }
+  return 0;
+}
+
+ecmcSdoQueueRequest * ecmcEcSdoQueue::findRequest(int handle) {
+  if (handle < 0) {
+    return NULL;
+  }
+
+  ecmcSdoQueueRequest *req = &requests_[handle % ECMC_SDO_QUEUE_SIZE];
+
+  if (req->handle != handle) {
+    return NULL;
+  }
+  return req;
+}
+
+int ecmcEcSdoQueue::getResult(int handle, int *state, uint64_t *value) {
+  ecmcSdoQueueRequest *req = findRequest(handle);
+
+  if (!req) {
+    return ERROR_EC_SDO_QUEUE_HANDLE_INVALID;
+  }
+
+  *state = req->state;
+  *value = req->value;
+  return 0;
+}
+
+int ecmcEcSdoQueue::release(int handle) {
+  ecmcSdoQueueRequest *req = findRequest(handle);
+
+  if (!req) {
+    return ERROR_EC_SDO_QUEUE_HANDLE_INVALID;
+  }
+
+  if ((req->state != ECMC_SDO_QUEUE_REQ_DONE) &&
+      (req->state != ECMC_SDO_QUEUE_REQ_ERROR)) {
+    return ERROR_EC_SDO_QUEUE_NOT_DONE;
+  }
+
+  freeSlot(handle % ECMC_SDO_QUEUE_SIZE);
+  return 0;
+}
+
+void ecmcEcSdoQueue::freeSlot(int slot) {
+  requests_[slot].handle   = -1;
+  requests_[slot].state    = ECMC_SDO_QUEUE_REQ_FREE;
+  freeSlots_[freeCount_++] = slot;
+}
+
+bool ecmcEcSdoQueue::getActive() {
+  return busyCount_ > 0 ||
+         fifoCount_[ECMC_SDO_QUEUE_PRIO_HIGH] > 0 ||
+         fifoCount_[ECMC_SDO_QUEUE_PRIO_NORMAL] > 0;
+}
+
+bool ecmcEcSdoQueue::getInActiveList() {
+  return inActiveList_;
+}
+
+void ecmcEcSdoQueue::setInActiveList(bool inList) {
+  inActiveList_ = inList;
+}
+
+/* Start request in a free pool object (returns false if none free) */
+bool ecmcEcSdoQueue::dispatch(int handle) {
+  // Queued (pending) requests can not be released
+  ecmcSdoQueueRequest   *req   = &requests_[handle % ECMC_SDO_QUEUE_SIZE];
+  ecmcSdoQueuePoolEntry *entry = NULL;
+
+  if (req->write) {
+    entry = &writePool_[getWriteSizeIndex(req->byteSize)];
+    if (entry->slot >= 0) {
+      return false;
+    }
+  } else {
+    for (int i = 0; i < readPoolSize_; i++) {
+      if (readPool_[i].slot < 0) {
+        entry = &readPool_[i];
+        break;
+      }
+    }
+    if (!entry) {
+      return false;
+    }
+  }
+
+  ecrt_sdo_request_index(entry->req, req->index, req->subIndex);
+
+  if (req->write) {
+    memcpy(ecrt_sdo_request_data(entry->req), &req->value, req->byteSize);
+    ecrt_sdo_request_write(entry->req);
+  } else {
+    ecrt_sdo_request_read(entry->req);
+  }
+
+  entry->slot = handle % ECMC_SDO_QUEUE_SIZE;
+  req->state  = ECMC_SDO_QUEUE_REQ_BUSY;
+  busyCount_++;
+  return true;
+}
+
+void ecmcEcSdoQueue::complete(ecmcSdoQueuePoolEntry *entry, bool success) {
+  int                  slot = entry->slot;
+  ecmcSdoQueueRequest *req  = &requests_[slot];
+
+  if (success && !req->write) {
+    req->value = 0;
+    size_t bytes = ecrt_sdo_request_data_size(entry->req);
+    if (bytes > (size_t)req->byteSize) {
+      bytes = req->byteSize;
+    }
+    memcpy(&req->value, ecrt_sdo_request_data(entry->req), bytes);
+  }
+
+  req->state  = success ? ECMC_SDO_QUEUE_REQ_DONE : ECMC_SDO_QUEUE_REQ_ERROR;
+  entry->slot = -1;
+  busyCount_--;
+
+  if (!success) {
+    LOGERR("%s/%s:%d: ERROR: Slave %d: SDO 0x%x:0x%x %s failed (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           slavePosition_,
+           req->index,
+           req->subIndex,
+           req->write ? "write" : "read",
+           ERROR_EC_SDO_QUEUE_REQUEST_FAIL);
+  }
+
+  if (req->callback) {
+    req->callback(req->handle, req->state, req->value, req->userObj);
+    freeSlot(slot);
+  }
+}
+
+/* Realtime: work is proportional to the requests in process */
+void ecmcEcSdoQueue::execute() {
+  ecmcSdoQueuePoolEntry *entry = NULL;
+
+  // Poll requests in process
+  for (int i = 0; busyCount_ > 0 &&
+       i < readPoolSize_ + ECMC_SDO_QUEUE_WRITE_SIZES; i++) {
+    entry = i < readPoolSize_ ? &readPool_[i] :
+            &writePool_[i - readPoolSize_];
+
+    if (entry->slot < 0) {
+      continue;
+    }
+
+    switch (ecrt_sdo_request_state(entry->req)) {
+    case EC_REQUEST_BUSY:
+    case EC_REQUEST_UNUSED:
+      break;
+
+    case EC_REQUEST_SUCCESS:
+      complete(entry, true);
+      break;
+
+    case EC_REQUEST_ERROR:
+      complete(entry, false);
+      break;
+    }
+  }
+
+  // Start queued requests (high priority first, order kept per priority).
+  // A request waiting for its pool object (for instance a write waiting for
+  // the object of its size) is kept in the fifo and does not block the
+  // requests behind it.
+  int poolCount = readPoolSize_ + ECMC_SDO_QUEUE_WRITE_SIZES;
+
+  for (int p = 0; p < ECMC_SDO_QUEUE_PRIO_COUNT; p++) {
+    int count = fifoCount_[p];
+    int kept  = 0;
+
+    for (int i = 0; i < count; i++) {
+      // All pool objects busy and nothing removed: rest stays in place
+      if ((busyCount_ >= poolCount) && (kept == i)) {
+        kept = count;
+        break;
+      }
+
+      int handle = fifo_[p][(fifoHead_[p] + i) % ECMC_SDO_QUEUE_SIZE];
+
+      if ((busyCount_ >= poolCount) || !dispatch(handle)) {
+        fifo_[p][(fifoHead_[p] + kept) % ECMC_SDO_QUEUE_SIZE] = handle;
+        kept++;
+      }
+    }
+    fifoCount_[p] = kept;
+  }
+}
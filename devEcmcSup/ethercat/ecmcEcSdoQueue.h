@@ -0,0 +1,178 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcEcSdoQueue.h
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#ifndef ECMCECSDOQUEUE_H_
+#define ECMCECSDOQUEUE_H_
+
+#include <stdint.h>
+#include "ecrt.h"
+#include "../main/ecmcDefinitions.h"
+#include "../main/ecmcError.h"
+
+#define ERROR_EC_SDO_QUEUE_FULL 0x23600
+#define ERROR_EC_SDO_QUEUE_POOL_SIZE_OUT_OF_RANGE 0x23601
+#define ERROR_EC_SDO_QUEUE_REQ_CREATE_FAIL 0x23602
+#define ERROR_EC_SDO_QUEUE_BYTE_SIZE_INVALID 0x23603
+#define ERROR_EC_SDO_QUEUE_HANDLE_INVALID 0x23604
+#define ERROR_EC_SDO_QUEUE_NOT_DONE 0x23605
+#define ERROR_EC_SDO_QUEUE_REQUEST_FAIL 0x23606
+#define ERROR_EC_SDO_QUEUE_PRIO_OUT_OF_RANGE 0x23607
+#define ERROR_EC_SDO_QUEUE_BATCH_LIST_INVALID 0x23608
+
+// Max parallel read requests per slave
+#define ECMC_SDO_QUEUE_POOL_MAX 16
+#define ECMC_SDO_QUEUE_POOL_DEFAULT 4
+
+// Max queued or not collected requests per slave
+#define ECMC_SDO_QUEUE_SIZE 256
+
+// Write requests need a fixed size (one request object per size)
+#define ECMC_SDO_QUEUE_WRITE_SIZES 4
+#define ECMC_SDO_QUEUE_DATA_MAX_BYTES 8
+#define ECMC_SDO_QUEUE_TIMEOUT_MS 2000
+
+enum ecmcSdoQueuePrio {
+  ECMC_SDO_QUEUE_PRIO_HIGH   = 0,
+  ECMC_SDO_QUEUE_PRIO_NORMAL = 1,
+  ECMC_SDO_QUEUE_PRIO_COUNT  = 2,
+};
+
+enum ecmcSdoQueueReqState {
+  ECMC_SDO_QUEUE_REQ_FREE    = 0,
+  ECMC_SDO_QUEUE_REQ_PENDING = 1,
+  ECMC_SDO_QUEUE_REQ_BUSY    = 2,
+  ECMC_SDO_QUEUE_REQ_DONE    = 3,
+  ECMC_SDO_QUEUE_REQ_ERROR   = 4,
+};
+
+/* Completion callback (called in realtime thread, keep short).
+ * The request is released after the callback. */
+typedef void (*ecmcSdoQueueCallback)(int      handle,
+                                     int      state,
+                                     uint64_t value,
+                                     void    *userObj);
+
+typedef struct {
+  int                  handle;
+  int                  state;
+  uint16_t             index;
+  uint8_t              subIndex;
+  int                  byteSize;
+  bool                 write;
+  uint64_t             value;
+  ecmcSdoQueueCallback callback;
+  void                *userObj;
+} ecmcSdoQueueRequest;
+
+typedef struct {
+  ec_sdo_request_t *req;
+  int               slot;  // Request in process (-1 if idle)
+} ecmcSdoQueuePoolEntry;
+
+/**
+ * \class ecmcEcSdoQueue
+ *
+ * \ingroup ecmc
+ *
+ * \brief Non blocking SDO engine for one slave
+ *
+ * Requests are queued (two priorities) from non realtime threads and
+ * executed by a pool of ec_sdo_request_t objects. Reads can run in
+ * parallel (one pool object each). Writes use one object per data size
+ * since the size of an SDO request object is fixed at creation.
+ * Since each slave has its own queue, many slaves are serviced in parallel.
+ *
+ * A request is identified by a handle (future). The state and value are
+ * read with getResult() and the request is then released with release(),
+ * or a completion callback is used. Results that are never released
+ * occupy the queue, new requests are then rejected (queue full).
+ *
+ * Queue and realtime execution are synchronized by the asyn port lock.
+ */
+class ecmcEcSdoQueue : public ecmcError {
+ public:
+  ecmcEcSdoQueue(ec_slave_config_t *sc,
+                 int                slavePosition,
+                 int                poolSize);
+  ~ecmcEcSdoQueue();
+  int  addRead(uint16_t             index,
+               uint8_t              subIndex,
+               int                  byteSize,
+               int                  prio,
+               ecmcSdoQueueCallback callback,
+               void                *userObj,
+               int                 *handle);
+  // All requests are queued or none (handles must fit count entries)
+  int  addReadBatch(int                  count,
+                    const uint16_t      *indices,
+                    const uint8_t       *subIndices,
+                    const int           *byteSizes,
+                    int                  prio,
+                    ecmcSdoQueueCallback callback,
+                    void                *userObj,
+                    int                 *handles);
+  int  addWrite(uint16_t             index,
+                uint8_t              subIndex,
+                uint64_t             value,
+                int                  byteSize,
+                int                  prio,
+                ecmcSdoQueueCallback callback,
+                void                *userObj,
+                int                 *handle);
+  int  getResult(int       handle,
+                 int      *state,
+                 uint64_t *value);
+  int  release(int handle);
+
+  // Realtime: only queues with active requests need execution
+  void execute();
+  bool getActive();
+  bool getInActiveList();
+  void setInActiveList(bool inList);
+
+ private:
+  void initVars();
+  int  addRequest(uint16_t             index,
+                  uint8_t              subIndex,
+                  uint64_t             value,
+                  int                  byteSize,
+                  bool                 write,
+                  int                  prio,
+                  ecmcSdoQueueCallback callback,
+                  void                *userObj,
+                  int                 *handle);
+  ecmcSdoQueueRequest* findRequest(int handle);
+  int  getWriteSizeIndex(int byteSize);
+  bool dispatch(int handle);
+  void complete(ecmcSdoQueuePoolEntry *entry,
+                bool                   success);
+  void freeSlot(int slot);
+
+  int slavePosition_;
+  ecmcSdoQueueRequest requests_[ECMC_SDO_QUEUE_SIZE];
+  int freeSlots_[ECMC_SDO_QUEUE_SIZE];
+  int freeCount_;
+  int generation_;
+
+  // FIFO of handles per priority
+  int fifo_[ECMC_SDO_QUEUE_PRIO_COUNT][ECMC_SDO_QUEUE_SIZE];
+  int fifoHead_[ECMC_SDO_QUEUE_PRIO_COUNT];
+  int fifoCount_[ECMC_SDO_QUEUE_PRIO_COUNT];
+
+  ecmcSdoQueuePoolEntry readPool_[ECMC_SDO_QUEUE_POOL_MAX];
+  ecmcSdoQueuePoolEntry writePool_[ECMC_SDO_QUEUE_WRITE_SIZES];
+  int readPoolSize_;
+  int busyCount_;
+  bool inActiveList_;
+};
+
+#endif  /* ECMCECSDOQUEUE_H_ */
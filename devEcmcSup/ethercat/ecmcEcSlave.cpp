@@ -11,6 +11,7 @@
 \*************************************************************************/
 
 #include "ecmcEcSlave.h"
+#include "../main/ecmcConfigArena.h"
 #include "../main/ecmcErrorsList.h"
 
 ecmcEcSlave::ecmcEcSlave(
@@ -105,6 +106,8 @@ void ecmcEcSlave::initVars() {
   statusWord_        = 0;
   statusWordOld_     = 0;
   asyncSDOCounter_   = 0;
+  asyncSDOActive_    = 0;
+  sdoQueue_          = NULL;
 
   for (int i = 0; i < EC_MAX_SYNC_MANAGERS; i++) {
     syncManagerArray_[i] = NULL;
@@ -130,6 +133,7 @@ void ecmcEcSlave::initVars() {
   domain_ = NULL;
   memset(&slaveState_,    0, sizeof(slaveState_));
   memset(&slaveStateOld_, 0, sizeof(slaveStateOld_));
+  memset(&slaveStateRead_, 0, sizeof(slaveStateRead_));
 
   asynPortDriver_  = NULL;
 }
@@ -163,6 +167,17 @@ ecmcEcSlave::~ecmcEcSlave() {
   for(int i=0;i<asyncSDOCounter_;i++) {
     delete asyncSDOvector_[i];
   }
+
+  delete sdoQueue_;
+  sdoQueue_ = NULL;
+}
+
+void* ecmcEcSlave::operator new(size_t bytes) {
+  return ecmcConfigArena::allocate(bytes, ECMC_CONFIG_ARENA_EC_SLAVE);
+}
+
+void ecmcEcSlave::operator delete(void *ptr) {
+  ecmcConfigArena::deallocate(ptr);
 }
 
 int ecmcEcSlave::getEntryCount() {
@@ -274,7 +289,35 @@ int ecmcEcSlave::getSlaveInfo(mcu_ec_slave_info_light *info) {
   return 0;
 }
 
-int ecmcEcSlave::checkConfigState(void) {
+/* Read state from master only (no evaluation) */
+int ecmcEcSlave::readConfigState() {
+  return readConfigState(&slaveStateRead_);
+}
+
+/* Read state from master to buffer.
+ * Used by ec diagnostics thread without asyn port lock. */
+int ecmcEcSlave::readConfigState(ec_slave_config_state_t *state) {
+  if (simSlave_ || !slaveConfig_) {
+    return 0;
+  }
+
+  ecrt_slave_config_state(slaveConfig_, state);
+  return 0;
+}
+
+/* State evaluated by next checkConfigState(false) */
+void ecmcEcSlave::setConfigStateRead(const ec_slave_config_state_t *state) {
+  slaveStateRead_ = *state;
+}
+
+uint8_t ecmcEcSlave::getStateSummary() {
+  // bit 0..3 al_state, bit 4 online, bit 5 operational
+  return (uint8_t)((slaveState_.al_state & 0xF) |
+                   (slaveState_.online << 4) |
+                   (slaveState_.operational << 5));
+}
+
+int ecmcEcSlave::checkConfigState(bool readState) {
   if (simSlave_) {
     LOGERR(
       "%s/%s:%d: ERROR: Slave %d (0x%x,0x%x): Simulation slave: Functionality not supported (0x%x).\n",
@@ -291,8 +334,10 @@ int ecmcEcSlave::checkConfigState(void) {
                       ERROR_EC_SLAVE_CALL_NOT_ALLOWED_IN_SIM_MODE);
   }
 
-  memset(&slaveState_, 0, sizeof(slaveState_));
-  ecrt_slave_config_state(slaveConfig_, &slaveState_);
+  if (readState) {
+    readConfigState();
+  }
+  slaveState_ = slaveStateRead_;
   
   //Update status word
   //  lower 16  : status bits
@@ -540,7 +585,8 @@ int ecmcEcSlave::updateInputProcessImage() {
   }
   
   // Execute async SDOs
-  for(int i=0;i<asyncSDOCounter_;i++) {
+  // Only poll when requests are in process
+  for(int i=0;i<asyncSDOCounter_ && asyncSDOActive_ > 0;i++) {
     asyncSDOvector_[i]->execute();
   }
 
@@ -557,6 +603,53 @@ int ecmcEcSlave::updateOutProcessImage() {
   return 0;
 }
 
+// Entries and status (when executed outside the asyn owning thread)
+int ecmcEcSlave::updateAsyn() {
+  for (uint i = 0; i < entryCounterInUse_; i++) {
+    if (entryListInUse_[i] != NULL) {
+      entryListInUse_[i]->updateAsyn(0);
+    }
+  }
+
+  if (slaveAsynParams_[ECMC_ASYN_EC_SLAVE_PAR_STATUS_ID]) {
+    slaveAsynParams_[ECMC_ASYN_EC_SLAVE_PAR_STATUS_ID]->refreshParamRT(0);
+  }
+  return 0;
+}
+
+int ecmcEcSlave::enableAsynSnapshot(ecmcEc *master) {
+  for (uint i = 0; i < entryCounterInUse_; i++) {
+    if (entryListInUse_[i] != NULL) {
+      entryListInUse_[i]->enableAsynSnapshot(master);
+    }
+  }
+  return 0;
+}
+
+void ecmcEcSlave::storeAsynSnapshot() {
+  for (uint i = 0; i < entryCounterInUse_; i++) {
+    if (entryListInUse_[i] != NULL) {
+      entryListInUse_[i]->storeAsynSnapshot();
+    }
+  }
+}
+
+void ecmcEcSlave::loadAsynSnapshot() {
+  for (uint i = 0; i < entryCounterInUse_; i++) {
+    if (entryListInUse_[i] != NULL) {
+      entryListInUse_[i]->loadAsynSnapshot();
+    }
+  }
+}
+
+void ecmcEcSlave::commitAsynSnapshot() {
+  for (uint i = 0; i < entryCounterInUse_; i++) {
+    if (entryListInUse_[i] != NULL) {
+      entryListInUse_[i]->commitAsynSnapshot();
+    }
+  }
+}
+
 int ecmcEcSlave::getSlaveBusPosition() {
   return slavePosition_;
 }
@@ -918,7 +1011,8 @@ int ecmcEcSlave::addSDOAsync(uint16_t sdoIndex, /**< SDO index. */
                                               sdoIndex,
                                               sdoSubIndex,
                                               dt,
-                                              alias);
+                                              alias,
+                                              &asyncSDOActive_);
     asyncSDOvector_.push_back(temp);
   } 
   catch (std::exception& e) {
@@ -934,3 +1028,57 @@ int ecmcEcSlave::addSDOAsync(uint16_t sdoIndex, /**< SDO index. */
   asyncSDOCounter_++;
   return 0;
 }
+
+int ecmcEcSlave::addSdoQueue(int poolSize) {
+  if (sdoQueue_) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Slave %d: SDO queue already created (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      slavePosition_,
+      ERROR_EC_SLAVE_SDO_QUEUE_ALREADY_CREATED);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_SLAVE_SDO_QUEUE_ALREADY_CREATED);
+  }
+
+  if ((poolSize <= 0) || (poolSize > ECMC_SDO_QUEUE_POOL_MAX)) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Slave %d: SDO queue pool size out of range (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      slavePosition_,
+      ERROR_EC_SDO_QUEUE_POOL_SIZE_OUT_OF_RANGE);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_SDO_QUEUE_POOL_SIZE_OUT_OF_RANGE);
+  }
+
+  try {
+    sdoQueue_ = new ecmcEcSdoQueue(slaveConfig_, slavePosition_, poolSize);
+  }
+  catch (std::exception& e) {
+    delete sdoQueue_;
+    sdoQueue_ = NULL;
+    LOGERR(
+      "%s/%s:%d: ERROR: Slave %d: Failed to create SDO queue (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      slavePosition_,
+      ERROR_EC_SLAVE_SDO_QUEUE_CREATE_FAIL);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_EC_SLAVE_SDO_QUEUE_CREATE_FAIL);
+  }
+  return 0;
+}
+
+ecmcEcSdoQueue * ecmcEcSlave::getSdoQueue() {
+  return sdoQueue_;
+}
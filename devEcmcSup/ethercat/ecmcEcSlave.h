@@ -28,6 +28,7 @@
 #include "ecmcEcSyncManager.h"
 #include "ecmcEcSDO.h"
 #include "ecmcEcAsyncSDO.h"
+#include "ecmcEcSdoQueue.h"
 
 #define SIMULATION_ENTRIES 2
 
@@ -53,6 +54,8 @@
 #define ERROR_EC_SLAVE_NOT_ONLINE 0x24012
 #define ERROR_EC_SLAVE_REG_ASYN_PAR_BUFFER_OVERFLOW 0x24013
 #define ERROR_EC_SLAVE_SDO_ASYNC_CREATE_FAIL 0x24014
+#define ERROR_EC_SLAVE_SDO_QUEUE_CREATE_FAIL 0x24015
+#define ERROR_EC_SLAVE_SDO_QUEUE_ALREADY_CREATED 0x24016
 
 typedef struct {
   uint16_t position;   /**< Offset of the slave in the ring. */
@@ -73,16 +76,32 @@ class ecmcEcSlave : public ecmcError {
     uint32_t     vendorId, /**< Expected vendor ID. */
     uint32_t     productCode  /**< Expected product code. */);
   ~ecmcEcSlave();
+
+  // Placed in ecmcConfigArena during configuration
+  static void* operator new(size_t bytes);
+  static void  operator delete(void *ptr);
   int                addSyncManager(ec_direction_t direction,
                                     uint8_t        syncMangerIndex);
   ecmcEcSyncManager* getSyncManager(int syncManagerIndex);
   int                getSlaveInfo(mcu_ec_slave_info_light *info);
   int                getEntryCount();
   ecmcEcEntry      * getEntry(int entryIndex);
-  int                checkConfigState(void);
+  int                readConfigState();
+  // Read state to buffer (diagnostics thread) and set it (realtime thread)
+  int                readConfigState(ec_slave_config_state_t *state);
+  void               setConfigStateRead(const ec_slave_config_state_t *state);
+  // Evaluate state (readState=false: use state from last readConfigState())
+  int                checkConfigState(bool readState = true);
+  uint8_t            getStateSummary();
   void               setDomainBaseAdr(uint8_t *domainAdr);
   int                updateInputProcessImage();
   int                updateOutProcessImage();
+  int                updateAsyn();
+  // Asyn snapshot of entries in use (see ecmcEc::enableAsynSnapshot())
+  int                enableAsynSnapshot(ecmcEc *master);
+  void               storeAsynSnapshot();
+  void               loadAsynSnapshot();
+  void               commitAsynSnapshot();
   int                getSlaveBusPosition();
   int                addEntry(
                        ec_direction_t direction,
@@ -132,6 +151,8 @@ class ecmcEcSlave : public ecmcError {
                  uint8_t sdoSubIndex, /**< SDO subindex. */
                  ecmcEcDataType dt,
                  std::string alias);
+  int addSdoQueue(int poolSize);
+  ecmcEcSdoQueue* getSdoQueue();
 
  private:
   void  initVars();
@@ -155,6 +176,7 @@ class ecmcEcSlave : public ecmcError {
   int pdosInSMCount_;
   ec_slave_config_state_t slaveState_;
   ec_slave_config_state_t slaveStateOld_;
+  ec_slave_config_state_t slaveStateRead_;
   // used to simulate endswitches
   bool simSlave_;
   uint8_t simBuffer_[8 * SIMULATION_ENTRIES];    // Simulate endswitches
@@ -176,5 +198,7 @@ class ecmcEcSlave : public ecmcError {
 
   std::vector<ecmcEcAsyncSDO*> asyncSDOvector_;
   int                          asyncSDOCounter_;
+  int                          asyncSDOActive_;  // Requests in process
+  ecmcEcSdoQueue              *sdoQueue_;
 };
 #endif  /* ECMCECSLAVE_H_ */
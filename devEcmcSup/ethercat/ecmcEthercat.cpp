@@ -21,8 +21,46 @@
 #include "ecmcEcSyncManager.h"
 #include "ecmcEcEntry.h"
 
+#include "ecmcEcMailbox.h"
+#include "ecmcEcMasterThread.h"
+
 #include "ecmcGlobalsExtern.h"
 
+// Primary master or master with own thread (NULL if not found)
+static ecmcEc* findEcMaster(int masterIndex) {
+  if (ec->getInitDone() && (ec->getMasterIndex() == masterIndex)) {
+    return ec;
+  }
+
+  for (int i = 1; i < ECMC_MAX_EC_MASTERS; i++) {
+    if (ecMasterThreads[i] &&
+        (ecMasterThreads[i]->getEc()->getMasterIndex() == masterIndex)) {
+      return ecMasterThreads[i]->getEc();
+    }
+  }
+  return NULL;
+}
+
+static ecmcEcMasterThread* findEcMasterThread(int masterIndex) {
+  for (int i = 1; i < ECMC_MAX_EC_MASTERS; i++) {
+    if (ecMasterThreads[i] &&
+        (ecMasterThreads[i]->getEc()->getMasterIndex() == masterIndex)) {
+      return ecMasterThreads[i];
+    }
+  }
+  return NULL;
+}
+
+// Cycle time of the selected master
+static double getEcCfgPeriodNs() {
+  for (int i = 1; i < ECMC_MAX_EC_MASTERS; i++) {
+    if (ecMasterThreads[i] && (ecMasterThreads[i]->getEc() == ecCfg)) {
+      return ecMasterThreads[i]->getPeriodNs();
+    }
+  }
+  return mcuPeriod;
+}
+
 int ecSetMaster(int masterIndex) {
   LOGINFO4("%s/%s:%d masterIndex=%d \n",
            __FILE__,
@@ -32,6 +70,9 @@ int ecSetMaster(int masterIndex) {
   
   // Sample rate fixed
   sampleRateChangeAllowed = 0;
+
+  // Primary master (executed in main realtime thread)
+  ecCfg = ec;
   int errorCode = ec->init(masterIndex);
   if(errorCode) {
     return errorCode;
@@ -46,18 +87,19 @@ int ecResetMaster(int masterIndex) {
            __LINE__,
            masterIndex);
 
-  /// todo  master index not used. Only there for future use.
-  if(ec->getMasterIndex() != masterIndex) {
+  ecmcEc *master = findEcMaster(masterIndex);
+
+  if(!master) {
     return ERROR_MAIN_EC_INDEX_OUT_OF_RANGE;
   }
 
-  return ec->reset();
+  return master->reset();
 }
 
 int ecResetError() {
   LOGINFO4("%s/%s:%d\n", __FILE__, __FUNCTION__, __LINE__);
 
-  ec->errorReset();
+  ecCfg->errorReset();
   return 0;
 }
 
@@ -74,9 +116,9 @@ int ecAddSlave(uint16_t alias,
            vendorId,
            productCode);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
   
-  ec->addSlave(alias, position, vendorId, productCode);
+  ecCfg->addSlave(alias, position, vendorId, productCode);
   return 0;
 }
 
@@ -99,7 +141,7 @@ int ecSlaveConfigDC(
     sync1Cycle,
     sync1Shift);
 
-  ecmcEcSlave *slave = ec->findSlave(slaveBusPosition);
+  ecmcEcSlave *slave = ecCfg->findSlave(slaveBusPosition);
 
   if (slave == NULL) {
     return ERROR_EC_MAIN_SLAVE_NULL;
@@ -120,7 +162,7 @@ int ecSelectReferenceDC(int masterIndex, int slaveBusPosition) {
            masterIndex,
            slaveBusPosition);
 
-  ecmcEcSlave *slave = ec->findSlave(slaveBusPosition);
+  ecmcEcSlave *slave = ecCfg->findSlave(slaveBusPosition);
 
   if (slave == NULL) {
     return ERROR_EC_MAIN_SLAVE_NULL;
@@ -162,12 +204,12 @@ int ecAddEntryComplete(
     entryIDString,
     signedValue);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
   // Old syntax only vaid for integers use "Cfg.EcAddEntry()" for double, real
   ecmcEcDataType dataType = getEcDataType(bits,signedValue);
 
-  return ec->addEntry(position,
+  return ecCfg->addEntry(position,
                      vendorId,
                      productCode,
                      (ec_direction_t)direction,
@@ -213,11 +255,11 @@ int ecAddEntry(
     datatype,
     updateInRealtime);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
   ecmcEcDataType dt = getEcDataTypeFromStr(datatype);
 
-  return ec->addEntry(position,
+  return ecCfg->addEntry(position,
                      vendorId,
                      productCode,
                      (ec_direction_t)direction,
@@ -243,14 +285,14 @@ int ecSetEntryUpdateInRealtime(
            entryIDString,
            updateInRealtime);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
   ecmcEcSlave *slave = NULL;
 
   if (slavePosition >= 0) {
-    slave = ec->findSlave(slavePosition);
+    slave = ecCfg->findSlave(slavePosition);
   } else {    // simulation slave
-    slave = ec->getSlave(slavePosition);
+    slave = ecCfg->getSlave(slavePosition);
   }
 
   if (slave == NULL) return ERROR_MAIN_EC_SLAVE_NULL;
@@ -284,7 +326,7 @@ int ecAddMemMapDT(
     dataType,
     memMapIDString);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
   int  masterId   = -1;
   int  slaveIndex = -1;
@@ -301,7 +343,7 @@ int ecAddMemMapDT(
   std::string startEntryId = alias;
   ecmcEcDataType dt = getEcDataTypeFromStr(dataType);
 
-  return ec->addMemMap(slaveIndex, startEntryId, byteSize,
+  return ecCfg->addMemMap(slaveIndex, startEntryId, byteSize,
                       (ec_direction_t)direction, dt, memMapId);
 }
 
@@ -326,11 +368,11 @@ int ecAddSdoAsync(
     datatype,    
     idString);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
   ecmcEcDataType dt = getEcDataTypeFromStr(datatype);
 
-  return ec->addSDOAsync(slaveBusPosition,
+  return ecCfg->addSDOAsync(slaveBusPosition,
                          index,
                          subIndex,
                          dt,
@@ -361,9 +403,9 @@ int ecAddMemMap(
     direction,    
     memMapIDString);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
   
-    return ec->addMemMap(startEntryBusPosition, startEntryId, byteSize,
+    return ecCfg->addMemMap(startEntryBusPosition, startEntryId, byteSize,
                       (ec_direction_t)direction, ECMC_EC_NONE, memMapId);
 }
 
@@ -371,9 +413,9 @@ int  ecGetMemMapId(char* memMapIDString, int *id) {
   
   std::string memMapId = memMapIDString;
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
   
-  int idLocal = ec->findMemMapId(memMapId);
+  int idLocal = ecCfg->findMemMapId(memMapId);
   
   *id =  idLocal;
 
@@ -389,14 +431,14 @@ int ecAddPdo(int slaveIndex, int syncManager, uint16_t pdoIndex) {
            syncManager,
            pdoIndex);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
-  if (ec->getSlave(slaveIndex) == NULL) return ERROR_MAIN_EC_SLAVE_NULL;
+  if (ecCfg->getSlave(slaveIndex) == NULL) return ERROR_MAIN_EC_SLAVE_NULL;
 
-  if (ec->getSlave(slaveIndex)->getSyncManager(syncManager) ==
+  if (ecCfg->getSlave(slaveIndex)->getSyncManager(syncManager) ==
       NULL) return ERROR_MAIN_EC_SM_NULL;
 
-  return ec->getSlave(slaveIndex)->getSyncManager(syncManager)->addPdo(pdoIndex);
+  return ecCfg->getSlave(slaveIndex)->getSyncManager(syncManager)->addPdo(pdoIndex);
 }
 
 int ecAddSyncManager(int slaveIndex, int direction, uint8_t syncMangerIndex) {
@@ -408,11 +450,11 @@ int ecAddSyncManager(int slaveIndex, int direction, uint8_t syncMangerIndex) {
            direction,
            syncMangerIndex);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
-  if (ec->getSlave(slaveIndex) == NULL) return ERROR_MAIN_EC_SLAVE_NULL;
+  if (ecCfg->getSlave(slaveIndex) == NULL) return ERROR_MAIN_EC_SLAVE_NULL;
 
-  return ec->getSlave(slaveIndex)->addSyncManager((ec_direction_t)direction,
+  return ecCfg->getSlave(slaveIndex)->addSyncManager((ec_direction_t)direction,
                                                  syncMangerIndex);
 }
 
@@ -432,9 +474,9 @@ int ecAddSdo(uint16_t slavePosition,
     value,
     byteSize);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
-  return  ec->addSDOWrite(slavePosition,
+  return  ecCfg->addSDOWrite(slavePosition,
                          sdoIndex,
                          sdoSubIndex,
                          value,
@@ -456,9 +498,9 @@ int ecAddSdoComplete(uint16_t    slavePosition,
     valueBuffer,
     byteSize);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
-  return  ec->addSDOWriteComplete(slavePosition,
+  return  ecCfg->addSDOWriteComplete(slavePosition,
                                   sdoIndex,
                                   valueBuffer,
                                   byteSize);
@@ -480,9 +522,9 @@ int ecAddSdoBuffer(uint16_t    slavePosition,
     valueBuffer,
     byteSize);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
-  return  ec->addSDOWriteBuffer(slavePosition,
+  return  ecCfg->addSDOWriteBuffer(slavePosition,
                                 sdoIndex,
                                 sdoSubIndex,
                                 valueBuffer,
@@ -505,9 +547,9 @@ int ecWriteSdo(uint16_t slavePosition,
     value,
     byteSize);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
-  return ec->writeSDO(slavePosition, sdoIndex, sdoSubIndex, value, byteSize);
+  return ecCfg->writeSDO(slavePosition, sdoIndex, sdoSubIndex, value, byteSize);
 }
 
 /*int ecWriteSdoComplete(uint16_t slavePosition,
@@ -523,9 +565,9 @@ int ecWriteSdo(uint16_t slavePosition,
            value,
            byteSize);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
-  return ec->writeSDOComplete(slavePosition, sdoIndex, value, byteSize);
+  return ecCfg->writeSDOComplete(slavePosition, sdoIndex, value, byteSize);
 }*/
 
 int ecReadSdo(uint16_t  slavePosition,
@@ -543,9 +585,9 @@ int ecReadSdo(uint16_t  slavePosition,
     sdoSubIndex,
     byteSize);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
-  return ec->readSDO(slavePosition, sdoIndex, sdoSubIndex, byteSize, value);
+  return ecCfg->readSDO(slavePosition, sdoIndex, sdoSubIndex, byteSize, value);
 }
 
 int ecVerifySdo(uint16_t  slavePosition,
@@ -565,10 +607,10 @@ int ecVerifySdo(uint16_t  slavePosition,
     byteSize,
     verValue);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
   
   uint32_t readValue = 0;
-  int errorCode=ec->readSDO(slavePosition, sdoIndex, sdoSubIndex, byteSize, &readValue);
+  int errorCode=ecCfg->readSDO(slavePosition, sdoIndex, sdoSubIndex, byteSize, &readValue);
   if(errorCode) {
     return errorCode;
   }
@@ -603,9 +645,9 @@ int ecReadSoE(uint16_t  slavePosition, /**< Slave position. */
     idn,
     byteSize);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
-  return ec->readSoE(slavePosition, driveNo, idn, byteSize, value);
+  return ecCfg->readSoE(slavePosition, driveNo, idn, byteSize, value);
 }
 
 int ecWriteSoE(uint16_t  slavePosition, /**< Slave position. */
@@ -624,9 +666,9 @@ int ecWriteSoE(uint16_t  slavePosition, /**< Slave position. */
     idn,
     byteSize);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
-  return ec->writeSoE(slavePosition, driveNo, idn, byteSize, value);
+  return ecCfg->writeSoE(slavePosition, driveNo, idn, byteSize, value);
 }
 
 int ecSlaveConfigWatchDog(int slaveBusPosition,
@@ -640,7 +682,7 @@ int ecSlaveConfigWatchDog(int slaveBusPosition,
            watchdogDivider,
            watchdogIntervals);
 
-  ecmcEcSlave *slave = ec->findSlave(slaveBusPosition);
+  ecmcEcSlave *slave = ecCfg->findSlave(slaveBusPosition);
 
   if (slave == NULL) {
     return ERROR_EC_MAIN_SLAVE_NULL;
@@ -661,9 +703,9 @@ int readEcMemMap(const char *memMapIDString,
            memMapIDString,
            bytesToRead);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
-  ecmcEcMemMap *memMap = ec->findMemMap(memMapIDString);
+  ecmcEcMemMap *memMap = ecCfg->findMemMap(memMapIDString);
 
   if (!memMap) {
     return ERROR_MAIN_MEM_MAP_NULL;
@@ -681,14 +723,14 @@ int writeEcEntry(int slaveIndex, int entryIndex, uint64_t value) {
            entryIndex,
            value);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
-  if (ec->getSlave(slaveIndex) == NULL) return ERROR_MAIN_EC_SLAVE_NULL;
+  if (ecCfg->getSlave(slaveIndex) == NULL) return ERROR_MAIN_EC_SLAVE_NULL;
 
-  if (ec->getSlave(slaveIndex)->getEntry(entryIndex) ==
+  if (ecCfg->getSlave(slaveIndex)->getEntry(entryIndex) ==
       NULL) return ERROR_MAIN_EC_ENTRY_NULL;
 
-  return ec->getSlave(slaveIndex)->getEntry(entryIndex)->writeValueForce(value);
+  return ecCfg->getSlave(slaveIndex)->getEntry(entryIndex)->writeValueForce(value);
 }
 
 int writeEcEntryIDString(int slavePosition, char *entryIDString,
@@ -701,14 +743,14 @@ int writeEcEntryIDString(int slavePosition, char *entryIDString,
            entryIDString,
            value);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
   ecmcEcSlave *slave = NULL;
 
   if (slavePosition >= 0) {
-    slave = ec->findSlave(slavePosition);
+    slave = ecCfg->findSlave(slavePosition);
   } else {    // simulation slave
-    slave = ec->getSlave(slavePosition);
+    slave = ecCfg->getSlave(slavePosition);
   }
 
   if (slave == NULL) return ERROR_MAIN_EC_SLAVE_NULL;
@@ -730,14 +772,14 @@ int readEcEntry(int slaveIndex, int entryIndex, uint64_t *value) {
            slaveIndex,
            entryIndex);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
-  if (ec->getSlave(slaveIndex) == NULL) return ERROR_MAIN_EC_SLAVE_NULL;
+  if (ecCfg->getSlave(slaveIndex) == NULL) return ERROR_MAIN_EC_SLAVE_NULL;
 
-  if (ec->getSlave(slaveIndex)->getEntry(entryIndex) ==
+  if (ecCfg->getSlave(slaveIndex)->getEntry(entryIndex) ==
       NULL) return ERROR_MAIN_EC_ENTRY_NULL;
 
-  return ec->getSlave(slaveIndex)->getEntry(entryIndex)->readValue(value);
+  return ecCfg->getSlave(slaveIndex)->getEntry(entryIndex)->readValue(value);
 }
 
 int readEcEntryIDString(int slavePosition, char *entryIDString,
@@ -749,14 +791,14 @@ int readEcEntryIDString(int slavePosition, char *entryIDString,
            slavePosition,
            entryIDString);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
   ecmcEcSlave *slave = NULL;
 
   if (slavePosition >= 0) {
-    slave = ec->findSlave(slavePosition);
+    slave = ecCfg->findSlave(slavePosition);
   } else {    // simulation slave
-    slave = ec->getSlave(slavePosition);
+    slave = ecCfg->getSlave(slavePosition);
   }
 
   if (slave == NULL) return ERROR_MAIN_EC_SLAVE_NULL;
@@ -779,14 +821,14 @@ int readEcEntryIndexIDString(int slavePosition, char *entryIDString,
            slavePosition,
            entryIDString);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
   ecmcEcSlave *slave = NULL;
 
   if (slavePosition >= 0) {
-    slave = ec->findSlave(slavePosition);
+    slave = ecCfg->findSlave(slavePosition);
   } else {    // simulation slave
-    slave = ec->getSlave(slavePosition);
+    slave = ecCfg->getSlave(slavePosition);
   }
 
   if (slave == NULL) return ERROR_MAIN_EC_SLAVE_NULL;
@@ -808,9 +850,9 @@ int readEcSlaveIndex(int slavePosition, int *value) {
            __LINE__,
            slavePosition);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
-  return ec->findSlaveIndex(slavePosition, value);
+  return ecCfg->findSlaveIndex(slavePosition, value);
 }
 
 int ecApplyConfig(int masterIndex) {
@@ -820,7 +862,7 @@ int ecApplyConfig(int masterIndex) {
 
   int errorCode = 0;
 
-  if ((errorCode = ec->compileRegInfo())) {
+  if ((errorCode = ecCfg->compileRegInfo())) {
     LOGERR("ERROR:\tCompileRegInfo failed\n");
     return errorCode;
   }
@@ -830,13 +872,340 @@ int ecApplyConfig(int masterIndex) {
 int ecSetDiagnostics(int value) {  // Set diagnostics mode
   LOGINFO4("%s/%s:%d value=%d\n", __FILE__, __FUNCTION__, __LINE__, value);
 
-  return ec->setDiagnostics(value);
+  return ecCfg->setDiagnostics(value);
+}
+
+int ecSetDiagThread(int enable, double periodMs) {
+  LOGINFO4("%s/%s:%d enable=%d, periodMs=%lf\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           enable,
+           periodMs);
+
+  return ecCfg->setDiagThread(enable, periodMs);
+}
+
+int ecSetDcPll(int mode, int offsetNs) {
+  LOGINFO4("%s/%s:%d mode=%d, offsetNs=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           mode,
+           offsetNs);
+
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  return ecCfg->setDcPll(mode, offsetNs, getEcCfgPeriodNs());
+}
+
+int ecSetDcPllGains(double kp, double ki) {
+  LOGINFO4("%s/%s:%d kp=%lf, ki=%lf\n", __FILE__, __FUNCTION__, __LINE__, kp,
+           ki);
+
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  return ecCfg->setDcPllGains(kp, ki);
+}
+
+int ecSetDcPllLockWindow(int windowNs) {
+  LOGINFO4("%s/%s:%d windowNs=%d\n", __FILE__, __FUNCTION__, __LINE__,
+           windowNs);
+
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  return ecCfg->setDcPllLockWindow(windowNs);
+}
+
+int ecSetDcPllMock(double driftPpm, int initOffsetNs) {
+  LOGINFO4("%s/%s:%d driftPpm=%lf, initOffsetNs=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           driftPpm,
+           initOffsetNs);
+
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  return ecCfg->setDcPllMock(driftPpm, initOffsetNs);
+}
+
+int ecAddMemMapPipe(char  *memMapIDString,
+                    int    dataStorageIndex,
+                    double scale,
+                    double offset,
+                    int    decimation) {
+  LOGINFO4(
+    "%s/%s:%d memMapIDString=%s, dataStorageIndex=%d, scale=%lf, offset=%lf, decimation=%d\n",
+    __FILE__,
+    __FUNCTION__,
+    __LINE__,
+    memMapIDString,
+    dataStorageIndex,
+    scale,
+    offset,
+    decimation);
+
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  if ((dataStorageIndex < 0) ||
+      (dataStorageIndex >= ecmcMaxDataStorageObjects)) {
+    return ERROR_MAIN_DATA_STORAGE_INDEX_OUT_OF_RANGE;
+  }
+
+  if (!dataStorages[dataStorageIndex]) {
+    return ERROR_MAIN_DATA_STORAGE_NULL;
+  }
+
+  int index = 0;
+  return ecCfg->addMemMapPipe(memMapIDString,
+                           dataStorages[dataStorageIndex],
+                           scale,
+                           offset,
+                           decimation,
+                           &index);
+}
+
+int ecSetMemMapPipeFir(int index, char *taps) {
+  LOGINFO4("%s/%s:%d index=%d, taps=%s\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           index,
+           taps);
+
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  // Taps and history are used by the realtime thread
+  if (appModeStat == ECMC_MODE_RUNTIME) {
+    return ERROR_MAIN_APP_MODE_ALREADY_RUNTIME;
+  }
+
+  double tapValues[ECMC_EC_MEM_MAP_PIPE_MAX_FIR_TAPS + 1];
+  int    count = 0;
+  char  *pos   = taps;
+  char  *end   = NULL;
+
+  // Comma separated list of coefficients
+  while (count <= ECMC_EC_MEM_MAP_PIPE_MAX_FIR_TAPS) {
+    double value = strtod(pos, &end);
+
+    if (end == pos) {
+      break;
+    }
+    tapValues[count++] = value;
+    pos = end;
+
+    while (*pos == ',' || *pos == ' ') {
+      pos++;
+    }
+  }
+
+  return ecCfg->setMemMapPipeFir(index, tapValues, count);
+}
+
+int ecAddSdoQueue(int slavePosition, int poolSize) {
+  LOGINFO4("%s/%s:%d slavePosition=%d, poolSize=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           slavePosition,
+           poolSize);
+
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  return ecCfg->addSdoQueue(slavePosition, poolSize);
+}
+
+int ecSdoQueueRead(int slavePosition,
+                   int sdoIndex,
+                   int sdoSubIndex,
+                   int byteSize,
+                   int prio,
+                   int *handle) {
+  LOGINFO4(
+    "%s/%s:%d slavePosition=%d, sdoIndex=0x%x, sdoSubIndex=0x%x, byteSize=%d, prio=%d\n",
+    __FILE__,
+    __FUNCTION__,
+    __LINE__,
+    slavePosition,
+    sdoIndex,
+    sdoSubIndex,
+    byteSize,
+    prio);
+
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  return ecCfg->sdoQueueRead(slavePosition,
+                          sdoIndex,
+                          sdoSubIndex,
+                          byteSize,
+                          prio,
+                          NULL,
+                          NULL,
+                          handle);
+}
+
+int ecSdoQueueReadBatch(int   slavePosition,
+                        int   prio,
+                        char *sdoList,
+                        char *handles,
+                        int   handlesLength) {
+  LOGINFO4("%s/%s:%d slavePosition=%d, prio=%d, sdoList=%s\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           slavePosition,
+           prio,
+           sdoList);
+
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  uint16_t sdoIndices[ECMC_SDO_QUEUE_SIZE];
+  uint8_t  sdoSubIndices[ECMC_SDO_QUEUE_SIZE];
+  int      byteSizes[ECMC_SDO_QUEUE_SIZE];
+  int      handleList[ECMC_SDO_QUEUE_SIZE];
+  int      count = 0;
+  char    *pos   = sdoList;
+  char    *end   = NULL;
+
+  // Comma separated list of index:subIndex:byteSize
+  while (*pos != '\0') {
+    if (count >= ECMC_SDO_QUEUE_SIZE) {
+      return ERROR_EC_SDO_QUEUE_BATCH_LIST_INVALID;
+    }
+
+    long values[3];
+
+    for (int i = 0; i < 3; i++) {
+      values[i] = strtol(pos, &end, 0);
+
+      if ((end == pos) || ((i < 2) && (*end != ':'))) {
+        return ERROR_EC_SDO_QUEUE_BATCH_LIST_INVALID;
+      }
+      pos = i < 2 ? end + 1 : end;
+    }
+
+    sdoIndices[count]    = (uint16_t)values[0];
+    sdoSubIndices[count] = (uint8_t)values[1];
+    byteSizes[count]     = (int)values[2];
+    count++;
+
+    while (*pos == ',' || *pos == ' ') {
+      pos++;
+    }
+  }
+
+  if (count == 0) {
+    return ERROR_EC_SDO_QUEUE_BATCH_LIST_INVALID;
+  }
+
+  int errorCode = ecCfg->sdoQueueReadBatch(slavePosition,
+                                           count,
+                                           sdoIndices,
+                                           sdoSubIndices,
+                                           byteSizes,
+                                           prio,
+                                           NULL,
+                                           NULL,
+                                           handleList);
+
+  if (errorCode) {
+    return errorCode;
+  }
+
+  int length = 0;
+
+  for (int i = 0; i < count && length < handlesLength; i++) {
+    length += snprintf(handles + length,
+                       handlesLength - length,
+                       i == 0 ? "%d" : ",%d",
+                       handleList[i]);
+  }
+  return 0;
+}
+
+int ecSdoQueueWrite(int      slavePosition,
+                    int      sdoIndex,
+                    int      sdoSubIndex,
+                    uint64_t value,
+                    int      byteSize,
+                    int      prio,
+                    int     *handle) {
+  LOGINFO4(
+    "%s/%s:%d slavePosition=%d, sdoIndex=0x%x, sdoSubIndex=0x%x, value=%llu, byteSize=%d, prio=%d\n",
+    __FILE__,
+    __FUNCTION__,
+    __LINE__,
+    slavePosition,
+    sdoIndex,
+    sdoSubIndex,
+    (unsigned long long)value,
+    byteSize,
+    prio);
+
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  return ecCfg->sdoQueueWrite(slavePosition,
+                           sdoIndex,
+                           sdoSubIndex,
+                           value,
+                           byteSize,
+                           prio,
+                           NULL,
+                           NULL,
+                           handle);
+}
+
+int ecSdoQueueGetState(int slavePosition, int handle, int *state) {
+  LOGINFO4("%s/%s:%d slavePosition=%d, handle=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           slavePosition,
+           handle);
+
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  uint64_t value = 0;
+  return ecCfg->sdoQueueGetResult(slavePosition, handle, state, &value);
+}
+
+int ecSdoQueueGetValue(int slavePosition, int handle, uint64_t *value) {
+  LOGINFO4("%s/%s:%d slavePosition=%d, handle=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           slavePosition,
+           handle);
+
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  int state     = 0;
+  int errorCode = ecCfg->sdoQueueGetResult(slavePosition, handle, &state, value);
+
+  if (errorCode) {
+    return errorCode;
+  }
+
+  if ((state != ECMC_SDO_QUEUE_REQ_DONE) &&
+      (state != ECMC_SDO_QUEUE_REQ_ERROR)) {
+    return ERROR_EC_SDO_QUEUE_NOT_DONE;
+  }
+
+  // Finished, free the request
+  ecCfg->sdoQueueRelease(slavePosition, handle);
+
+  if (state == ECMC_SDO_QUEUE_REQ_ERROR) {
+    return ERROR_EC_SDO_QUEUE_REQUEST_FAIL;
+  }
+  return 0;
 }
 
 int ecSetDomainFailedCyclesLimit(int value) {
   LOGINFO4("%s/%s:%d value=%d\n", __FILE__, __FUNCTION__, __LINE__, value);
 
-  return ec->setDomainFailedCyclesLimitInterlock(value);
+  return ecCfg->setDomainFailedCyclesLimitInterlock(value);
 }
 
 int ecEnablePrintouts(int value) {
@@ -849,17 +1218,17 @@ int ecEnablePrintouts(int value) {
 
 int ecSetDelayECOkAtStartup(int milliseconds) {
   LOGINFO4("%s/%s:%d milliseconds=%d\n", __FILE__, __FUNCTION__, __LINE__, milliseconds);
-  return ec->setEcOkDelayCycles(milliseconds/((int)(mcuPeriod/1E6)));
+  return ecCfg->setEcOkDelayCycles(milliseconds/((int)(getEcCfgPeriodNs()/1E6)));
 }
 
 int ecPrintAllHardware() {
   LOGINFO4("%s/%s:%d\n", __FILE__, __FUNCTION__, __LINE__);
-  return ec->printAllConfig();
+  return ecCfg->printAllConfig();
 }
 
 int ecPrintSlaveConfig(int slaveIndex) {
   LOGINFO4("%s/%s:%d\n", __FILE__, __FUNCTION__, __LINE__);
-  return ec->printSlaveConfig(slaveIndex);
+  return ecCfg->printSlaveConfig(slaveIndex);
 }
 
 int linkEcEntryToEcStatusOutput(int slaveIndex, char *entryIDString) {
@@ -870,14 +1239,14 @@ int linkEcEntryToEcStatusOutput(int slaveIndex, char *entryIDString) {
            slaveIndex,
            entryIDString);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
   ecmcEcSlave *slave = NULL;
 
   if (slaveIndex >= 0) {
-    slave = ec->findSlave(slaveIndex);
+    slave = ecCfg->findSlave(slaveIndex);
   } else {
-    slave = ec->getSlave(slaveIndex);
+    slave = ecCfg->getSlave(slaveIndex);
   }
 
   if (slave == NULL) return ERROR_MAIN_EC_SLAVE_NULL;
@@ -891,7 +1260,7 @@ int linkEcEntryToEcStatusOutput(int slaveIndex, char *entryIDString) {
 
   if (entry == NULL) return ERROR_MAIN_EC_ENTRY_NULL;
 
-  return ec->setEcStatusOutputEntry(entry);
+  return ecCfg->setEcStatusOutputEntry(entry);
 }
 
 int ecVerifySlave(uint16_t alias,  /**< Slave alias. */                                 
@@ -910,54 +1279,244 @@ int ecVerifySlave(uint16_t alias,  /**< Slave alias. */
            productCode,
            revisionNum);
 
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
 
-  return ec->verifySlave(alias,slavePos,vendorId,productCode, revisionNum);
+  return ecCfg->verifySlave(alias,slavePos,vendorId,productCode, revisionNum);
 }
 
 int ecGetSlaveVendorId(uint16_t alias,  /**< Slave alias. */
                             uint16_t slavePos,   /**< Slave position. */
                             uint32_t *result) {
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
   
-  *result = ec->getSlaveVendorId(alias, slavePos);
+  *result = ecCfg->getSlaveVendorId(alias, slavePos);
   return 0;
 }
 
+int ecGetBusSlaveCount(int *count) {
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  return ecCfg->getBusSlaveCount(count);
+}
+
+int ecGetMasterIndex(int *index) {
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  *index = ecCfg->getMasterIndex();
+  return 0;
+}
+
+int ecGetBusSlaveIdentity(int       slavePos,
+                          uint32_t *vendorId,
+                          uint32_t *productCode,
+                          uint32_t *revisionNum) {
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  return ecCfg->getBusSlaveIdentity(slavePos, vendorId, productCode, revisionNum);
+}
+
 int ecGetSlaveProductCode(uint16_t alias,  /**< Slave alias. */
                                uint16_t slavePos,   /**< Slave position. */
                                uint32_t *result) {
-  if (!ec->getInitDone()) return 0;
+  if (!ecCfg->getInitDone()) return 0;
   
-  *result = ec->getSlaveProductCode(alias, slavePos);
+  *result = ecCfg->getSlaveProductCode(alias, slavePos);
   return 0;
 }
 
 int ecGetSlaveRevisionNum(uint16_t alias,  /**< Slave alias. */
                                uint16_t slavePos,   /**< Slave position. */
                                uint32_t *result) {
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
   
-  *result = ec->getSlaveRevisionNum(alias, slavePos);
+  *result = ecCfg->getSlaveRevisionNum(alias, slavePos);
   return 0;
 }
 
 int ecGetSlaveSerialNum(uint16_t alias,  /**< Slave alias. */
                              uint16_t slavePos,   /**< Slave position. */
                              uint32_t *result) {
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
   
-  *result = ec->getSlaveSerialNum(alias, slavePos);
+  *result = ecCfg->getSlaveSerialNum(alias, slavePos);
   return 0;
 }
 
+int ecSetMaxMemMaps(int count) {
+  LOGINFO4("%s/%s:%d count=%d \n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           count);
+  return ecCfg->setMaxMemMaps(count);
+}
+
 int ecUseClockRealtime(int useClkRT) {
   LOGINFO4("%s/%s:%d useClkRT=%d \n",
            __FILE__,
            __FUNCTION__,
            __LINE__,
            useClkRT);
-  if (!ec->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
+  if (!ecCfg->getInitDone()) return ERROR_MAIN_EC_NOT_INITIALIZED;
   
-  return ec->useClockRealtime(useClkRT);
+  return ecCfg->useClockRealtime(useClkRT);
+}
+
+int ecSetDcTimeEpochOffset(int64_t offsetNs) {
+  LOGINFO4("%s/%s:%d offsetNs=%" PRId64 " \n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           offsetNs);
+  if (!ecCfg) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  return ecCfg->setDcTimeEpochOffset(offsetNs);
+}
+
+int ecAddMaster(int masterIndex) {
+  LOGINFO4("%s/%s:%d masterIndex=%d \n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           masterIndex);
+
+  if (appModeStat == ECMC_MODE_RUNTIME) {
+    return ERROR_MAIN_APP_MODE_ALREADY_RUNTIME;
+  }
+
+  if (findEcMaster(masterIndex)) {
+    return ERROR_MAIN_EC_INDEX_OUT_OF_RANGE;
+  }
+
+  // Slot 0 is the primary master (ec)
+  int slot = -1;
+  for (int i = 1; i < ECMC_MAX_EC_MASTERS; i++) {
+    if (!ecMasterThreads[i]) {
+      slot = i;
+      break;
+    }
+  }
+
+  if (slot < 0) {
+    return ERROR_MAIN_EC_MASTERS_FULL;
+  }
+
+  ecmcEcMasterThread *thread = new ecmcEcMasterThread(asynPort, slot);
+  int errorCode = thread->getEc()->init(masterIndex);
+  if (errorCode) {
+    delete thread;
+    return errorCode;
+  }
+
+  ecMasterThreads[slot] = thread;
+  ecCfg = thread->getEc();
+  return 0;
+}
+
+int ecSelectMaster(int masterIndex) {
+  LOGINFO4("%s/%s:%d masterIndex=%d \n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           masterIndex);
+
+  ecmcEc *master = findEcMaster(masterIndex);
+
+  if (!master) {
+    return ERROR_MAIN_EC_INDEX_OUT_OF_RANGE;
+  }
+
+  ecCfg = master;
+  return 0;
+}
+
+int ecSetMasterThread(int    masterIndex,
+                      double sampleRateHz,
+                      int    priority,
+                      int    cpu) {
+  LOGINFO4(
+    "%s/%s:%d masterIndex=%d, sampleRateHz=%lf, priority=%d, cpu=%d\n",
+    __FILE__,
+    __FUNCTION__,
+    __LINE__,
+    masterIndex,
+    sampleRateHz,
+    priority,
+    cpu);
+
+  ecmcEcMasterThread *thread = findEcMasterThread(masterIndex);
+
+  if (!thread) {
+    return ERROR_MAIN_EC_INDEX_OUT_OF_RANGE;
+  }
+
+  int errorCode = thread->setSampleRate(sampleRateHz);
+  if (errorCode) {
+    return errorCode;
+  }
+
+  errorCode = thread->setPriority(priority);
+  if (errorCode) {
+    return errorCode;
+  }
+
+  return thread->setCpu(cpu);
+}
+
+int ecAddMailbox(int   sourceMasterIndex,
+                 int   sourceSlavePosition,
+                 char *sourceEntryIDString,
+                 int   destMasterIndex,
+                 int   destSlavePosition,
+                 char *destEntryIDString) {
+  LOGINFO4("%s/%s:%d source=%d,%d,%s, destination=%d,%d,%s\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           sourceMasterIndex,
+           sourceSlavePosition,
+           sourceEntryIDString,
+           destMasterIndex,
+           destSlavePosition,
+           destEntryIDString);
+
+  if (appModeStat == ECMC_MODE_RUNTIME) {
+    return ERROR_MAIN_APP_MODE_ALREADY_RUNTIME;
+  }
+
+  if (sourceMasterIndex == destMasterIndex) {
+    return ERROR_EC_MAILBOX_SAME_MASTER;
+  }
+
+  ecmcEc *source = findEcMaster(sourceMasterIndex);
+  ecmcEc *dest   = findEcMaster(destMasterIndex);
+
+  if (!source || !dest) {
+    return ERROR_MAIN_EC_INDEX_OUT_OF_RANGE;
+  }
+
+  ecmcEcSlave *sourceSlave = source->findSlave(sourceSlavePosition);
+  ecmcEcSlave *destSlave   = dest->findSlave(destSlavePosition);
+
+  if (!sourceSlave || !destSlave) {
+    return ERROR_MAIN_EC_SLAVE_NULL;
+  }
+
+  ecmcEcEntry *sourceEntry = sourceSlave->findEntry(sourceEntryIDString);
+  ecmcEcEntry *destEntry   = destSlave->findEntry(destEntryIDString);
+
+  if (!sourceEntry || !destEntry) {
+    return ERROR_EC_MAILBOX_ENTRY_NULL;
+  }
+
+  ecmcEcMailbox *mailbox = new ecmcEcMailbox(sourceEntry, destEntry);
+
+  // Owned by source master
+  int errorCode = source->addMailboxPublisher(mailbox);
+  if (errorCode) {
+    delete mailbox;
+    return errorCode;
+  }
+
+  return dest->addMailboxConsumer(mailbox);
 }
@@ -919,6 +919,262 @@ int ecSetEntryUpdateInRealtime(
   */
 int ecSetDiagnostics(int enable);
 
+/** \brief Check EtherCAT master and slave states in a non realtime thread.\n
+  *
+  * By default the master and slave states are polled in the realtime
+  * thread (at axisDiagFreq). For large systems this can cause latency
+  * spikes. If enabled, a separate low priority thread polls the states
+  * (without asyn port lock) and publishes them lock free. The realtime
+  * thread evaluates new states (errors, entry alarms and the slave state
+  * snapshot ec<masterid>.slavestates, one byte per slave: bit 0..3 AL
+  * state, bit 4 online, bit 5 operational) without any ioctl calls. The
+  * thread is started when the master is activated.\n
+  *
+  * \param[in] enable Enable diagnostics thread.\n
+  * \param[in] periodMs Poll period in ms (min 10ms).\n
+  * \return 0 if success or otherwise an error code.\n
+  *
+  * \note Example: Poll EtherCAT states every 100ms in a separate thread.\n
+  *  "Cfg.EcSetDiagThread(1,100)" //Command string to ecmcCmdParser.c\n
+  */
+int ecSetDiagThread(int    enable,
+                    double periodMs);
+
+/** \brief Lock realtime cycle to EtherCAT DC reference clock.\n
+  *
+  * Default the application time is written to the DC reference clock
+  * each cycle (master is the clock master). The master clock and the
+  * reference clock then drift apart and SYNC0 jitters relative to the frames.\n
+  *
+  * With the PLL enabled the reference clock is the clock master. The
+  * reference clock time latched by each frame is compared to the application
+  * time of that frame and the wakeup of the realtime thread is adjusted so
+  * that the frames are sent at a constant offset relative to SYNC0.\n
+  *
+  * Diagnostics: ec<masterid>.dc.offset (phase error [ns]),
+  * ec<masterid>.dc.drift (drift of reference clock [ppm]) and
+  * ec<masterid>.dc.locked.\n
+  *
+  * \param[in] mode 0 = off, 1 = lock to reference clock,
+  *                  2 = mock (simulated reference clock, see
+  *                  Cfg.EcSetDcPllMock()).\n
+  * \param[in] offsetNs Target offset between application time and
+  *                      reference clock time [ns].\n
+  * \return 0 if success or otherwise an error code.\n
+  *
+  * \note The sample rate must be set before this command.\n
+  *
+  * \note Example: Lock to reference clock with zero offset.\n
+  *  "Cfg.EcSetDcPll(1,0)" //Command string to ecmcCmdParser.c\n
+  */
+int ecSetDcPll(int mode,
+               int offsetNs);
+
+/** \brief Set gains of DC PLL.\n
+  *
+  * \param[in] kp Proportional gain (0..1, default 0.1).\n
+  * \param[in] ki Integral gain (0..1, default 0.005).\n
+  * \return 0 if success or otherwise an error code.\n
+  *
+  * \note Example: Set gains to 0.2 and 0.01.\n
+  *  "Cfg.EcSetDcPllGains(0.2,0.01)" //Command string to ecmcCmdParser.c\n
+  */
+int ecSetDcPllGains(double kp,
+                    double ki);
+
+/** \brief Set lock window of DC PLL.\n
+  *
+  * The PLL is locked when the offset stays within the window.\n
+  *
+  * \param[in] windowNs Lock window [ns] (default 1000ns).\n
+  * \return 0 if success or otherwise an error code.\n
+  *
+  * \note Example: Set lock window to 500ns.\n
+  *  "Cfg.EcSetDcPllLockWindow(500)" //Command string to ecmcCmdParser.c\n
+  */
+int ecSetDcPllLockWindow(int windowNs);
+
+/** \brief Set simulated reference clock of DC PLL (mock mode).\n
+  *
+  * For tests without DC capable slaves.\n
+  *
+  * \param[in] driftPpm Drift of simulated reference clock [ppm].\n
+  * \param[in] initOffsetNs Initial offset of simulated reference clock [ns].\n
+  * \return 0 if success or otherwise an error code.\n
+  *
+  * \note Example: Simulate a reference clock running 50ppm fast.\n
+  *  "Cfg.EcSetDcPllMock(50,20000)" //Command string to ecmcCmdParser.c\n
+  */
+int ecSetDcPllMock(double driftPpm,
+                   int    initOffsetNs);
+
+/** \brief Add a pipeline from a memmap to a data storage.\n
+ *
+ * Moves all data of an input memmap to a data storage each realtime cycle
+ * without PLC code: type conversion, scale and offset, optional FIR filter
+ * (see ecSetMemMapPipeFir()) and optional decimation.\n
+ * The pipes are numbered in order of creation (0..15).\n
+ *
+ * Counters of processed samples are available as asyn parameters:\n
+ *   ec<id>.mmpipe<index>.converted, .filtered, .stored and .errors\n
+ *
+ * \param[in] memMapIDString Name of memmap.\n
+ * \param[in] dataStorageIndex Index of data storage.\n
+ * \param[in] scale Scale factor.\n
+ * \param[in] offset Offset (added after scaling).\n
+ * \param[in] decimation Keep every n:th sample (1 = all samples).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Append data of memmap "ec0.s1.mm.CH1_ARRAY" to data storage 2,
+ * with scale 0.001 and offset 0, keep all samples.\n
+ *  "Cfg.EcAddMemMapPipe(ec0.s1.mm.CH1_ARRAY,2,0.001,0,1)" //Command string to ecmcCmdParser.c\n
+ */
+int ecAddMemMapPipe(char  *memMapIDString,
+                    int    dataStorageIndex,
+                    double scale,
+                    double offset,
+                    int    decimation);
+
+/** \brief Set FIR filter coefficients of a memmap pipeline.\n
+ *
+ * The filter is applied after scale and offset and before decimation.
+ * Only allowed in configuration mode.\n
+ *
+ * \param[in] index Index of memmap pipe.\n
+ * \param[in] taps Comma separated list of coefficients (max 64).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Moving average of 4 samples for memmap pipe 0.\n
+ *  "Cfg.EcSetMemMapPipeFir(0,0.25,0.25,0.25,0.25)" //Command string to ecmcCmdParser.c\n
+ */
+int ecSetMemMapPipeFir(int   index,
+                       char *taps);
+
+/** \brief Add a non blocking SDO queue to a slave.\n
+ *
+ * SDO requests in the queue are executed in the background by a pool of
+ * request objects (reads in parallel) without blocking the realtime or
+ * the calling thread. Each slave has its own queue.\n
+ *
+ * \param[in] slavePosition Position of the EtherCAT slave on the bus.\n
+ * \param[in] poolSize Number of parallel read requests (1..16).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Add SDO queue with 4 parallel reads to slave 3.\n
+ *  "Cfg.EcAddSdoQueue(3,4)" //Command string to ecmcCmdParser.c\n
+ */
+int ecAddSdoQueue(int slavePosition,
+                  int poolSize);
+
+/** \brief Queue a non blocking SDO read.\n
+ *
+ * Returns a handle that is used to read the state and the result
+ * (see ecSdoQueueGetState() and ecSdoQueueGetValue()).\n
+ *
+ * \param[in] slavePosition Position of the EtherCAT slave on the bus.\n
+ * \param[in] sdoIndex Index of SDO.\n
+ * \param[in] sdoSubIndex Sub index of SDO.\n
+ * \param[in] byteSize Size of SDO data in bytes (1..8).\n
+ * \param[in] prio Priority (0 = high, 1 = normal).\n
+ * \param[out] handle Handle of request.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Queue read of 0x8000:0x1 (2 bytes) of slave 3.\n
+ *  "EcSdoQueueRead(3,0x8000,0x1,2,1)" //Command string to ecmcCmdParser.c\n
+ */
+int ecSdoQueueRead(int  slavePosition,
+                   int  sdoIndex,
+                   int  sdoSubIndex,
+                   int  byteSize,
+                   int  prio,
+                   int *handle);
+
+/** \brief Queue a list of non blocking SDO reads of one slave.\n
+ *
+ * All reads in the list are queued or none (for instance if the queue
+ * is full). The handles are returned as a comma separated list in the
+ * same order as the list of SDOs.\n
+ *
+ * \param[in] slavePosition Position of the EtherCAT slave on the bus.\n
+ * \param[in] prio Priority (0 = high, 1 = normal).\n
+ * \param[in] sdoList Comma separated list of index:subIndex:byteSize.\n
+ * \param[out] handles Comma separated list of handles.\n
+ * \param[in] handlesLength Size of handles buffer.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Queue reads of 0x8000:0x1 (2 bytes) and 0x8010:0x2
+ * (4 bytes) of slave 3.\n
+ *  "EcSdoQueueReadBatch(3,1,0x8000:0x1:2,0x8010:0x2:4)" //Command string to ecmcCmdParser.c\n
+ */
+int ecSdoQueueReadBatch(int   slavePosition,
+                        int   prio,
+                        char *sdoList,
+                        char *handles,
+                        int   handlesLength);
+
+/** \brief Queue a non blocking SDO write.\n
+ *
+ * \param[in] slavePosition Position of the EtherCAT slave on the bus.\n
+ * \param[in] sdoIndex Index of SDO.\n
+ * \param[in] sdoSubIndex Sub index of SDO.\n
+ * \param[in] value Value to write.\n
+ * \param[in] byteSize Size of SDO data in bytes (1, 2, 4 or 8).\n
+ * \param[in] prio Priority (0 = high, 1 = normal).\n
+ * \param[out] handle Handle of request.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Queue write of 500 to 0x8010:0x1 (2 bytes) of slave 3.\n
+ *  "EcSdoQueueWrite(3,0x8010,0x1,500,2,1)" //Command string to ecmcCmdParser.c\n
+ */
+int ecSdoQueueWrite(int      slavePosition,
+                    int      sdoIndex,
+                    int      sdoSubIndex,
+                    uint64_t value,
+                    int      byteSize,
+                    int      prio,
+                    int     *handle);
+
+/** \brief Get state of a queued SDO request.\n
+ *
+ * States: 0 = free, 1 = pending, 2 = busy, 3 = done, 4 = error.\n
+ *
+ * \param[in] slavePosition Position of the EtherCAT slave on the bus.\n
+ * \param[in] handle Handle of request.\n
+ * \param[out] state State of request.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Get state of request 257 of slave 3.\n
+ *  "EcSdoQueueGetState(3,257)" //Command string to ecmcCmdParser.c\n
+ */
+int ecSdoQueueGetState(int  slavePosition,
+                       int  handle,
+                       int *state);
+
+/** \brief Get result of a queued SDO request.\n
+ *
+ * Returns an error if the request is not finished. A finished request
+ * (done or error) is released and the handle is no longer valid.\n
+ *
+ * \param[in] slavePosition Position of the EtherCAT slave on the bus.\n
+ * \param[in] handle Handle of request.\n
+ * \param[out] value Value read (or written).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Get value of request 257 of slave 3.\n
+ *  "EcSdoQueueGetValue(3,257)" //Command string to ecmcCmdParser.c\n
+ */
+int ecSdoQueueGetValue(int       slavePosition,
+                       int       handle,
+                       uint64_t *value);
+
 /** \brief Set allowed bus cycles in row of none complete domain
  * data transfer.\n
  *
@@ -1079,6 +1335,38 @@ int ecGetSlaveVendorId(uint16_t alias,  /**< Slave alias. */
                        uint16_t slavePos,   /**< Slave position. */
                        uint32_t *result);
 
+/** \brief Read number of slaves on the bus.\n
+ *
+ *  \param[out] count Number of slaves.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ */
+int ecGetBusSlaveCount(int *count);
+
+/** \brief Read index of the master selected for configuration.\n
+ *
+ *  \param[out] index Master index.\n
+ *
+ * \return 0 if success or otherwise an error code (master not set).\n
+ */
+int ecGetMasterIndex(int *index);
+
+/** \brief Read identity of slave on the bus.\n
+ *
+ * Used to verify that the hardware matches a configuration snapshot.\n
+ *
+ *  \param[in] slavePos Position of the EtherCAT slave on the bus.\n
+ *  \param[out] vendorId Vendor id.\n
+ *  \param[out] productCode Product code.\n
+ *  \param[out] revisionNum Revision number.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ */
+int ecGetBusSlaveIdentity(int       slavePos,
+                          uint32_t *vendorId,
+                          uint32_t *productCode,
+                          uint32_t *revisionNum);
+
 /** \brief Read product code of selected ethercat slave
  *
  *  \param[in] alias Alias of slave. Set to zero to disable.\n
@@ -1143,6 +1431,120 @@ int ecGetSlaveSerialNum(uint16_t alias,  /**< Slave alias. */
  */
 int ecUseClockRealtime(int useClkRT);
 
+/** \brief Set offset between DC time and EPICS time
+ *
+ *  Asyn time stamps of data updated in a cycle are derived from the DC\n
+ *  application time of the frame processed in that cycle. The offset is\n
+ *  added to the DC time before conversion, for instance to compensate for\n
+ *  a DC reference clock on another time scale (TAI).\n
+ *
+ *  \param[in]  offsetNs Offset [ns] (default 0).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: DC time is TAI, asyn time UTC (37s):\n
+ *   "Cfg.EcSetDcTimeEpochOffset(-37000000000)" //Command string to ecmcCmdParser.c\n
+ */
+int ecSetDcTimeEpochOffset(int64_t offsetNs);
+
+/** \brief Set max number of memmaps
+ *
+ *  Only allowed to be changed prior any memmap creation.\n
+ *
+ *  \param[in]  count Max number of memmaps (defaults to 64).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Allow 200 memmaps:\n
+ *   "Cfg.EcSetMaxMemMaps(200)" //Command string to ecmcCmdParser.c\n
+ */
+int ecSetMaxMemMaps(int count);
+
+/** \brief Add an EtherCAT master executing in an own realtime thread.\n
+ *
+ * The primary master (Cfg.EcSetMaster()) is executed in the main realtime
+ * thread together with axes and PLCs. Additional masters only exchange
+ * process data (entries, memmaps, memmap pipes, SDO queues and mailboxes)
+ * in an own thread (see Cfg.EcSetMasterThread()). The added master is
+ * selected for the following EtherCAT configuration commands
+ * (see Cfg.EcSelectMaster()).\n
+ *
+ * Axes, PLCs, events and data recorders can only link to entries of the
+ * primary master. Use mailboxes (Cfg.EcAddMailbox()) to exchange data
+ * with an additional master.\n
+ *
+ *  \param[in] masterIndex EtherCAT master index.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Add /dev/EtherCAT1.\n
+ *  "Cfg.EcAddMaster(1)" //Command string to ecmcCmdParser.c\n
+ */
+int ecAddMaster(int masterIndex);
+
+/** \brief Select EtherCAT master for configuration.\n
+ *
+ * All following EtherCAT configuration commands (slaves, entries, sdos,
+ * memmaps..) apply to the selected master.\n
+ *
+ *  \param[in] masterIndex EtherCAT master index.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Select primary master /dev/EtherCAT0.\n
+ *  "Cfg.EcSelectMaster(0)" //Command string to ecmcCmdParser.c\n
+ */
+int ecSelectMaster(int masterIndex);
+
+/** \brief Set thread of an additional EtherCAT master.\n
+ *
+ * Set before Cfg.EcSetDcPll() since the DC PLL uses the cycle time of the
+ * selected master.\n
+ *
+ *  \param[in] masterIndex EtherCAT master index (added with
+ *                          Cfg.EcAddMaster()).\n
+ *  \param[in] sampleRateHz Cycle rate (defaults to 1000 Hz).\n
+ *  \param[in] priority SCHED_FIFO priority (defaults to 71).\n
+ *  \param[in] cpu Cpu to bind thread to (-1 = any cpu).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Execute master 1 at 4kHz, priority 80, on cpu 3.\n
+ *  "Cfg.EcSetMasterThread(1,4000,80,3)" //Command string to ecmcCmdParser.c\n
+ */
+int ecSetMasterThread(int    masterIndex,
+                      double sampleRateHz,
+                      int    priority,
+                      int    cpu);
+
+/** \brief Add a mailbox copying an entry value between two masters.\n
+ *
+ * The value of the source entry is published (lock free) after each
+ * receive of the source master and written to the destination entry
+ * before each send of the destination master. Only the latest value is
+ * kept. The raw value is copied, the entries should have the same data
+ * type.\n
+ *
+ *  \param[in] sourceMasterIndex Master index of source.\n
+ *  \param[in] sourceSlavePosition Slave position of source.\n
+ *  \param[in] sourceEntryIDString Entry id of source.\n
+ *  \param[in] destMasterIndex Master index of destination.\n
+ *  \param[in] destSlavePosition Slave position of destination.\n
+ *  \param[in] destEntryIDString Entry id of destination.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Copy "ENC_POS" of slave 3 on master 1 to "DRV_POS" of
+ * slave 5 on master 0.\n
+ *  "Cfg.EcAddMailbox(1,3,ENC_POS,0,5,DRV_POS)" //Command string to ecmcCmdParser.c\n
+ */
+int ecAddMailbox(int   sourceMasterIndex,
+                 int   sourceSlavePosition,
+                 char *sourceEntryIDString,
+                 int   destMasterIndex,
+                 int   destSlavePosition,
+                 char *destEntryIDString);
+
 # ifdef __cplusplus
 }
 # endif  // ifdef __cplusplus
@@ -0,0 +1,188 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcConfigArena.cpp
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#include "ecmcConfigArena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+
+typedef struct {
+  uint8_t *base;
+  size_t   size;
+  size_t   used;
+  bool     released;  // Range kept so later deletes are still ignored
+} ecmcConfigArenaChunk;
+
+static ecmcConfigArenaChunk arenaChunks[ECMC_CONFIG_ARENA_MAX_CHUNKS] = {};
+static int    arenaChunkCount = 0;
+static int    arenaCurrent    = -1;  // Chunk used for small objects
+static bool   arenaEnable     = true;
+static bool   arenaSealed     = false;
+static size_t arenaHeapCount  = 0;   // Allocations outside arena
+
+static size_t arenaTypeCount[ECMC_CONFIG_ARENA_TYPE_COUNT] = {};
+static size_t arenaTypeBytes[ECMC_CONFIG_ARENA_TYPE_COUNT] = {};
+
+static const char *arenaTypeNames[ECMC_CONFIG_ARENA_TYPE_COUNT] = {
+  "ec slave",
+  "ec pdo",
+  "ec entry",
+  "asyn data item",
+};
+
+static size_t alignUp(size_t bytes) {
+  return (bytes + ECMC_CONFIG_ARENA_ALIGN - 1) &
+         ~((size_t)ECMC_CONFIG_ARENA_ALIGN - 1);
+}
+
+static ecmcConfigArenaChunk* newChunk(size_t bytes) {
+  if (arenaChunkCount >= ECMC_CONFIG_ARENA_MAX_CHUNKS) {
+    return NULL;
+  }
+
+  void *mem = NULL;
+
+  // Cache line aligned, touched (mapped) here instead of in realtime
+  if (posix_memalign(&mem, 64, bytes) != 0) {
+    return NULL;
+  }
+  memset(mem, 0, bytes);
+
+  ecmcConfigArenaChunk *chunk = &arenaChunks[arenaChunkCount];
+  chunk->base     = (uint8_t *)mem;
+  chunk->size     = bytes;
+  chunk->used     = 0;
+  chunk->released = false;
+  arenaChunkCount++;
+  return chunk;
+}
+
+void * ecmcConfigArena::allocate(size_t              bytes,
+                                 ecmcConfigArenaType type) {
+  if (!arenaEnable || arenaSealed) {
+    arenaHeapCount++;
+    return ::operator new(bytes);
+  }
+
+  size_t size = alignUp(bytes);
+  ecmcConfigArenaChunk *chunk = NULL;
+
+  if (size > ECMC_CONFIG_ARENA_CHUNK_SIZE) {
+    // Dedicated chunk (current chunk stays in use for small objects)
+    chunk = newChunk(size);
+  } else {
+    if (arenaCurrent >= 0) {
+      chunk = &arenaChunks[arenaCurrent];
+    }
+
+    if (!chunk || (chunk->size - chunk->used < size)) {
+      chunk = newChunk(ECMC_CONFIG_ARENA_CHUNK_SIZE);
+
+      if (chunk) {
+        arenaCurrent = arenaChunkCount - 1;
+      }
+    }
+  }
+
+  if (!chunk) {
+    arenaHeapCount++;
+    return ::operator new(bytes);
+  }
+
+  void *ptr = chunk->base + chunk->used;
+  chunk->used += size;
+  arenaTypeCount[type]++;
+  arenaTypeBytes[type] += size;
+  return ptr;
+}
+
+bool ecmcConfigArena::contains(const void *ptr) {
+  const uint8_t *p = (const uint8_t *)ptr;
+
+  for (int i = 0; i < arenaChunkCount; i++) {
+    if ((p >= arenaChunks[i].base) &&
+        (p < arenaChunks[i].base + arenaChunks[i].size)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ecmcConfigArena::deallocate(void *ptr) {
+  if (!ptr) {
+    return;
+  }
+
+  // Arena memory is released in release()
+  if (contains(ptr)) {
+    return;
+  }
+  ::operator delete(ptr);
+}
+
+void ecmcConfigArena::setEnable(bool enable) {
+  arenaEnable = enable;
+}
+
+/* Entering runtime: objects created from now on (for instance temporary
+   asyn data items in drvUserCreate()) are allocated on the heap */
+void ecmcConfigArena::seal() {
+  arenaSealed = true;
+}
+
+/* Exit: all objects in the arena are invalid after this */
+void ecmcConfigArena::release() {
+  for (int i = 0; i < arenaChunkCount; i++) {
+    if (!arenaChunks[i].released) {
+      free(arenaChunks[i].base);
+      arenaChunks[i].released = true;
+    }
+  }
+  arenaCurrent = -1;
+  arenaSealed  = true;
+}
+
+size_t ecmcConfigArena::getUsedBytes() {
+  size_t bytes = 0;
+
+  for (int i = 0; i < arenaChunkCount; i++) {
+    bytes += arenaChunks[i].used;
+  }
+  return bytes;
+}
+
+size_t ecmcConfigArena::getReservedBytes() {
+  size_t bytes = 0;
+
+  for (int i = 0; i < arenaChunkCount; i++) {
+    bytes += arenaChunks[i].size;
+  }
+  return bytes;
+}
+
+void ecmcConfigArena::report() {
+  printf("ecmcConfigArena: %s%s, %d chunks, %zu bytes used of %zu reserved.\n",
+         arenaEnable ? "enabled" : "disabled",
+         arenaSealed ? " (sealed)" : "",
+         arenaChunkCount,
+         getUsedBytes(),
+         getReservedBytes());
+
+  for (int i = 0; i < ECMC_CONFIG_ARENA_TYPE_COUNT; i++) {
+    printf("  %-16s %8zu objects %10zu bytes\n",
+           arenaTypeNames[i],
+           arenaTypeCount[i],
+           arenaTypeBytes[i]);
+  }
+  printf("  %-16s %8zu objects\n", "heap", arenaHeapCount);
+}
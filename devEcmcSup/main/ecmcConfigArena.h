@@ -0,0 +1,67 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcConfigArena.h
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#ifndef ECMCCONFIGARENA_H_
+#define ECMCCONFIGARENA_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Chunk size (objects larger than this get a chunk of their own)
+#define ECMC_CONFIG_ARENA_CHUNK_SIZE (256 * 1024)
+#define ECMC_CONFIG_ARENA_MAX_CHUNKS 1024
+#define ECMC_CONFIG_ARENA_ALIGN 16
+
+// Object types (for footprint report)
+enum ecmcConfigArenaType {
+  ECMC_CONFIG_ARENA_EC_SLAVE       = 0,
+  ECMC_CONFIG_ARENA_EC_PDO         = 1,
+  ECMC_CONFIG_ARENA_EC_ENTRY       = 2,
+  ECMC_CONFIG_ARENA_ASYN_DATA_ITEM = 3,
+  ECMC_CONFIG_ARENA_TYPE_COUNT     = 4,
+};
+
+/**
+ * \class ecmcConfigArena
+ *
+ * \brief Arena for objects created during configuration
+ *
+ * EtherCAT slaves, pdos, entries and asyn data items are placed in large
+ * chunks (class specific operator new) in the order they are created.
+ * Since the configuration creates them in the same order as the realtime
+ * loop walks them (slave by slave, entries followed by their asyn
+ * parameters) the per cycle state ends up contiguous in memory.
+ *
+ * Deleting an object placed in the arena only runs the destructor, the
+ * memory is released when ecmc exits (release()). Objects created after
+ * the arena is sealed (when entering runtime) or when the arena is
+ * disabled are allocated on the heap as before.
+ *
+ * Only used from the configuration thread (no locking).
+ */
+class ecmcConfigArena {
+ public:
+  static void* allocate(size_t              bytes,
+                        ecmcConfigArenaType type);
+  static void  deallocate(void *ptr);
+  static bool  contains(const void *ptr);
+
+  static void  setEnable(bool enable);
+  static void  seal();
+  static void  release();
+
+  static size_t getUsedBytes();
+  static size_t getReservedBytes();
+  static void   report();
+};
+
+#endif  /* ECMCCONFIGARENA_H_ */
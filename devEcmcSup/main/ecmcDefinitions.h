@@ -31,10 +31,15 @@
 
 #define ECMC_MAX_AXES 64
 #define ECMC_MAX_PLCS 16
+#define ECMC_MAX_AXIS_GROUPS 8
+#define ECMC_AXIS_GROUP_MAX_AXES 8
 
 #define ECMC_ASYN_DEFAULT_LIST 0
 #define ECMC_ASYN_DEFAULT_ADDR 0
 
+// DC time epoch (2000-01-01) in seconds past EPICS epoch (1990-01-01)
+#define ECMC_DC_EPOCH_SEC_PAST_EPICS_EPOCH 315532800LL
+
 #define TIMESPEC2NS(T) ((uint64_t)(((T).tv_sec - 946684800ULL) * \
                                    1000000000ULL) + (T).tv_nsec)
 
@@ -51,6 +56,10 @@
 #define ECMC_PRE_ALLOCATION_SIZE (10*1024*1024) /* 1MB pagefault free buffer */
 
 #define ECMC_RT_THREAD_NAME "ecmc_rt" 
+#define ECMC_EC_DIAG_THREAD_NAME "ecmc_ec_diag"
+#define ECMC_EC_MASTER_THREAD_NAME "ecmc_ec"
+#define ECMC_EC_DIAG_THREAD_PERIOD_MS 100
+#define ECMC_EC_DIAG_THREAD_PERIOD_MIN_MS 10
 
 // Buffer size
 #define EC_MAX_OBJECT_PATH_CHAR_LENGTH 256
@@ -63,7 +72,13 @@
 // EtherCAT
 #define EC_MAX_PDOS 1024
 #define EC_MAX_ENTRIES 8192
+// Default number of memmaps (see Cfg.EcSetMaxMemMaps())
 #define EC_MAX_MEM_MAPS 64
+#define EC_MAX_MEM_MAP_PIPES 16
+#define EC_MAX_MAILBOXES 64
+
+// Primary master (ec) and additional masters with own threads
+#define ECMC_MAX_EC_MASTERS 4
 #define EC_MAX_SLAVES 512
 #define EC_START_TIMEOUT_S 30
 
@@ -74,6 +89,7 @@
 
 // Axis entry links
 #define ECMC_AXIS_ENTRY_INDEX_HEALTH 0
+#define ECMC_AXIS_ENTRY_INDEX_POS_CMP 1
 
 // Drive entry links
 #define ECMC_DRIVEBASE_ENTRY_INDEX_CONTROL_WORD 0
@@ -98,6 +114,7 @@
 #define ECMC_ENCODER_ENTRY_INDEX_ALARM_0 6
 #define ECMC_ENCODER_ENTRY_INDEX_ALARM_1 7
 #define ECMC_ENCODER_ENTRY_INDEX_ALARM_2 8
+#define ECMC_ENCODER_ENTRY_INDEX_LATCH_TIME 9
 
 // Encoders
 #define ECMC_MAX_ENCODERS 8
@@ -111,10 +128,19 @@
 
 // Data recording
 #define ECMC_MAX_DATA_RECORDERS_OBJECTS 10
+// Default number of events (see Cfg.SetMaxEventObjects())
 #define ECMC_MAX_EVENT_OBJECTS 10
+// Default number of data storages (see Cfg.SetMaxDataStorageObjects())
 #define ECMC_MAX_DATA_STORAGE_OBJECTS 32
+// Upper limit for object counts configurable at startup
+#define ECMC_MAX_OBJECTS_LIMIT 10000
 #define ECMC_DEFAULT_DATA_STORAGE_SIZE 1000
 #define ECMC_MAX_EVENT_CONSUMERS 10
+
+// Data groups (bulk export of data items)
+#define ECMC_MAX_DATA_GROUPS 16
+#define ECMC_DATA_GROUP_MAX_ITEMS 512
+#define ECMC_DATA_GROUP_NAMES_SIZE (ECMC_DATA_GROUP_MAX_ITEMS * 64)
 #define ECMC_MAX_COMMANDS_LISTS 10
 #define ECMC_MAX_COMMANDS_IN_COMMANDS_LISTS 100
 
@@ -125,10 +151,12 @@
 #define ECMC_IOCSH_CFG_CMD "ecmcConfigOrDie"
 #define ECMC_IOCSH_CFG_CMD_RETURN_VAR_NAME "ECMC_CONFIG_RETURN_VAL"
 #define ECMC_IOCSH_FILE_EXIST_RETURN_VAR_NAME "ECMC_FILE_EXIST_RETURN_VAL"
+#define ECMC_IOCSH_CFG_SNAPSHOT_RETURN_VAR_NAME "ECMC_CFG_SNAPSHOT_LOADED"
 
 // ECMC ecmcEpicsEnvSetCalc
 #define ECMC_ENVSETCALC_DEF_FORMAT "%d"
 #define ECMC_ENVSETCALC_RESULT_VAR "RESULT"
+#define ECMC_ENVSETCALC_CACHE_SIZE 256
 
 // Asyn  parameters in main
 #define ECMC_ASYN_MAIN_PAR_LATENCY_MIN_ID 0
@@ -159,7 +187,17 @@
 #define ECMC_ASYN_MAIN_PAR_UPDATE_READY_NAME "ecmc.updated"
 #define ECMC_ASYN_MAIN_PAR_STATUS_ID 13
 #define ECMC_ASYN_MAIN_PAR_STATUS_NAME "ecmc.thread.status"
-#define ECMC_ASYN_MAIN_PAR_COUNT 14
+#define ECMC_ASYN_MAIN_PAR_ERROR_JOURNAL_ID 14
+#define ECMC_ASYN_MAIN_PAR_ERROR_JOURNAL_NAME "ecmc.error.journal"
+#define ECMC_ASYN_MAIN_PAR_ERROR_COUNT_ID 15
+#define ECMC_ASYN_MAIN_PAR_ERROR_COUNT_NAME "ecmc.error.count"
+#define ECMC_ASYN_MAIN_PAR_PUBLISHED_ID 16
+#define ECMC_ASYN_MAIN_PAR_PUBLISHED_NAME "ecmc.asyn.published"
+#define ECMC_ASYN_MAIN_PAR_SUPPRESSED_ID 17
+#define ECMC_ASYN_MAIN_PAR_SUPPRESSED_NAME "ecmc.asyn.suppressed"
+#define ECMC_ASYN_MAIN_PAR_RT_GUARD_COUNT_ID 18
+#define ECMC_ASYN_MAIN_PAR_RT_GUARD_COUNT_NAME "ecmc.thread.rtguard.count"
+#define ECMC_ASYN_MAIN_PAR_COUNT 19
 
 // Asyn  parameters in ec
 #define ECMC_ASYN_EC_PAR_MASTER_STAT_ID 0
@@ -176,7 +214,9 @@
 #define ECMC_ASYN_EC_PAR_SLAVE_COUNT_NAME "slavecounter"
 #define ECMC_ASYN_EC_STAT_OK_ID 6
 #define ECMC_ASYN_EC_STAT_OK_NAME "ok"
-#define ECMC_ASYN_EC_PAR_COUNT 7
+#define ECMC_ASYN_EC_PAR_SLAVE_STATES_ID 7
+#define ECMC_ASYN_EC_PAR_SLAVE_STATES_NAME "slavestates"
+#define ECMC_ASYN_EC_PAR_COUNT 8
 
 // Asyn  parameters in ec slave
 #define ECMC_ASYN_EC_SLAVE_PAR_STATUS_ID 0
@@ -211,13 +251,38 @@
 #define ECMC_ASYN_AX_WARNING_NAME "warningid"
 #define ECMC_ASYN_AX_SET_ENC_POS_ID 11
 #define ECMC_ASYN_AX_SET_ENC_POS_NAME "setencpos"
-#define ECMC_ASYN_AX_PAR_COUNT 12
+#define ECMC_ASYN_AX_MOVE_TIME_ID 12
+#define ECMC_ASYN_AX_MOVE_TIME_NAME "movetime"
+#define ECMC_ASYN_AX_DIST_TO_STOP_ID 13
+#define ECMC_ASYN_AX_DIST_TO_STOP_NAME "disttostop"
+#define ECMC_ASYN_AX_PAR_COUNT 14
+
+// Axis sync (only created if sync is configured)
+#define ECMC_ASYN_AX_CAM_TABLE_NAME "camtable"
+#define ECMC_ASYN_AX_SYNC_ENABLE_NAME "syncenable"
+#define ECMC_ASYN_AX_SYNC_STATE_NAME "syncstate"
+
+// Axis PVT streaming (only created if PVT is configured)
+#define ECMC_ASYN_AX_PVT_POINTS_NAME "pvtpoints"
+#define ECMC_ASYN_AX_PVT_ENABLE_NAME "pvtenable"
+#define ECMC_ASYN_AX_PVT_STATE_NAME "pvtstate"
+#define ECMC_ASYN_AX_PVT_FILL_NAME "pvtfill"
+#define ECMC_ASYN_AX_PVT_UNDERRUNS_NAME "pvtunderruns"
+
+// Axis position compare (only created if position compare is configured)
+#define ECMC_ASYN_AX_POS_CMP_ENABLE_NAME "poscmpenable"
+#define ECMC_ASYN_AX_POS_CMP_COUNT_NAME "poscmpcount"
+#define ECMC_ASYN_AX_POS_CMP_NEXT_NAME "poscmpnext"
 
 
 // Asyn params for encoder
 #define ECMC_ASYN_ENC_ACT_POS_NAME "actpos"
 #define ECMC_ASYN_ENC_ACT_VEL_NAME "actvel"
 
+// Encoder latch capture (only created if capture is configured)
+#define ECMC_ASYN_ENC_LATCH_EVENTS_NAME "latchevents"
+#define ECMC_ASYN_ENC_LATCH_COUNT_NAME "latchcount"
+
 // Asyn params for controller
 #define ECMC_ASYN_CNTRL_KP_NAME "ctrl.kp"
 #define ECMC_ASYN_CNTRL_KI_NAME "ctrl.ki"
@@ -389,16 +454,30 @@ enum axisSubObjectType {
 #define ECMC_DATA_STORAGE_DATA_FULL_STR "full"
 #define ECMC_DATA_STORAGE_STATUS_STR "status"
 
+#define ECMC_DATA_GROUP_STR "dg"
+#define ECMC_DATA_GROUP_VALUES_STR "values"
+#define ECMC_DATA_GROUP_NAMES_STR "names"
+#define ECMC_DATA_GROUP_COUNT_STR "count"
+
 #define ECMC_STATIC_VAR "static."
 #define ECMC_GLOBAL_VAR "global."
 
 #define ECMC_EC_STR "ec"
+#define ECMC_EC_DC_STR "dc"
+#define ECMC_EC_MM_PIPE_STR "mmpipe"
 #define ECMC_MEMMAP_STR "mm"
 #define ECMC_SLAVE_CHAR "s"
 #define ECMC_DUMMY_SLAVE_STR "ds"
 #define ECMC_EC_HEALTH_STR "health"
 #define ECMC_AX_STR "ax"
+#define ECMC_AXIS_GROUP_STR "grp"
+#define ECMC_AXIS_GROUP_TARG_POS_STR "targpos"
+#define ECMC_AXIS_GROUP_EXECUTE_STR "execute"
+#define ECMC_AXIS_GROUP_BUSY_STR "busy"
+#define ECMC_AXIS_GROUP_MOVE_TIME_STR "movetime"
+#define ECMC_AXIS_GROUP_ERROR_STR "error"
 #define ECMC_AX_HEALTH_STR "health"
+#define ECMC_AX_POS_CMP_STR "poscmp"
 #define ECMC_DRV_STR "drv"
 #define ECMC_DRV_ENABLE_STR "control"
 #define ECMC_DRV_VELOCITY_STR "velocity"
@@ -426,6 +505,7 @@ enum axisSubObjectType {
 #define ECMC_ENC_LATCHPOS_STR "latchpos"
 #define ECMC_ENC_LATCH_STATUS_STR "latchstatus"
 #define ECMC_ENC_LATCH_CONTROL_STR "latchcontrol"
+#define ECMC_ENC_LATCH_TIME_STR "latchtime"
 #define ECMC_ENC_RESET_STR "reset"
 #define ECMC_ENC_ALARM_0_STR "alarm0"
 #define ECMC_ENC_ALARM_1_STR "alarm1"
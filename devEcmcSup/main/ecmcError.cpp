@@ -11,6 +11,7 @@
 \*************************************************************************/
 
 #include "ecmcError.h"
+#include "ecmcErrorRegistry.h"
 
 ecmcError::ecmcError() {
   initVars();
@@ -23,7 +24,9 @@ ecmcError::ecmcError(int* errorPtr,int* warningPtr) {
 }
 
 ecmcError::~ecmcError()
-{}
+{
+  ecmcErrorRegistry::unregisterObject(regClass_, regIndex_);
+}
 
 void ecmcError::initVars() {
   errorId_        = 0;
@@ -35,6 +38,18 @@ void ecmcError::initVars() {
   memset(&errorPath_, 0, sizeof(errorPath_));
   warningPtr_ = NULL;
   errorPtr_ = NULL;
+  regClass_ = ECMC_ERROR_OBJ_NONE;
+  regIndex_ = -1;
+}
+
+void ecmcError::registerErrorObject(ecmcErrorObjClass objClass,
+                                    int               objIndex) {
+  regClass_ = objClass;
+  regIndex_ = objIndex;
+  ecmcErrorRegistry::registerObject(this, objClass, objIndex);
+  if (errorId_) {
+    ecmcErrorRegistry::update(regClass_, regIndex_, 0, errorId_);
+  }
 }
 
 int ecmcError::setErrorID(const char *fileName,
@@ -80,6 +95,10 @@ int ecmcError::setErrorID(const char       *fileName,
 }
 
 int ecmcError::setErrorID(int errorID) {
+  if (errorID != errorId_) {
+    ecmcErrorRegistry::update(regClass_, regIndex_, errorId_, errorID);
+  }
+
   if (errorID) {
     error_ = true;
   } else {
@@ -101,6 +120,10 @@ int ecmcError::setErrorID(int errorID, ecmcAlarmSeverity severity) {
   }
   currSeverity_ = severity;
 
+  if (errorID != errorId_) {
+    ecmcErrorRegistry::update(regClass_, regIndex_, errorId_, errorID);
+  }
+
   if (errorID) {
     error_ = true;
   } else {
@@ -673,6 +696,36 @@ const char * ecmcError::convertErrorIdToString(int errorId) {
     return "ERROR_ENC_ASYN_PARAM_NULL";
 
     break;
+
+  case 0x14430:
+    return "ERROR_ENC_LATCH_CAPTURE_SIZE_OUT_OF_RANGE";
+
+    break;
+
+  case 0x14431:
+    return "ERROR_ENC_LATCH_CAPTURE_MODE_OUT_OF_RANGE";
+
+    break;
+
+  case 0x14432:
+    return "ERROR_ENC_LATCH_CAPTURE_ENTRY_NULL";
+
+    break;
+
+  case 0x14433:
+    return "ERROR_ENC_LATCH_CAPTURE_ALREADY_CREATED";
+
+    break;
+
+  case 0x14434:
+    return "ERROR_ENC_LATCH_CAPTURE_ASYN_PARAM_FAIL";
+
+    break;
+
+  case 0x14435:
+    return "ERROR_ENC_LATCH_CAPTURE_NULL";
+
+    break;
     
   case 0x14C00:  // MONITOR
     return "ERROR_MON_ASSIGN_ENTRY_FAILED";
@@ -1107,6 +1160,216 @@ const char * ecmcError::convertErrorIdToString(int errorId) {
 
     break;
 
+  case 0x14F80:    // AXIS GROUP
+    return "ERROR_AXIS_GROUP_AXIS_NULL";
+
+    break;
+
+  case 0x14F81:
+    return "ERROR_AXIS_GROUP_AXIS_COUNT_OUT_OF_RANGE";
+
+    break;
+
+  case 0x14F82:
+    return "ERROR_AXIS_GROUP_AXIS_ALREADY_ADDED";
+
+    break;
+
+  case 0x14F83:
+    return "ERROR_AXIS_GROUP_AXIS_NOT_MEMBER";
+
+    break;
+
+  case 0x14F84:
+    return "ERROR_AXIS_GROUP_LIMIT_OUT_OF_RANGE";
+
+    break;
+
+  case 0x14F85:
+    return "ERROR_AXIS_GROUP_SYNC_TYPE_OUT_OF_RANGE";
+
+    break;
+
+  case 0x14F86:
+    return "ERROR_AXIS_GROUP_AXIS_TRAJ_SOURCE_NOT_EXTERNAL";
+
+    break;
+
+  case 0x14F87:
+    return "ERROR_AXIS_GROUP_AXIS_NOT_READY";
+
+    break;
+
+  case 0x14F88:
+    return "ERROR_AXIS_GROUP_RUCKIG_CALC_FAILED";
+
+    break;
+
+  case 0x14F89:
+    return "ERROR_AXIS_GROUP_ASYN_PARAM_REGISTER_FAIL";
+
+    break;
+
+  case 0x14F8A:
+    return "ERROR_AXIS_GROUP_NOT_VALIDATED";
+
+    break;
+
+  case 0x14F8B:
+    return "ERROR_AXIS_GROUP_TARGET_POS_BUSY";
+
+    break;
+
+  case 0x14F90:    // AXIS SYNC
+    return "ERROR_AXIS_SYNC_MASTER_NULL";
+
+    break;
+
+  case 0x14F91:
+    return "ERROR_AXIS_SYNC_MODE_OUT_OF_RANGE";
+
+    break;
+
+  case 0x14F92:
+    return "ERROR_AXIS_SYNC_SOURCE_OUT_OF_RANGE";
+
+    break;
+
+  case 0x14F93:
+    return "ERROR_AXIS_SYNC_CHANGE_NOT_ALLOWED_WHEN_ACTIVE";
+
+    break;
+
+  case 0x14F94:
+    return "ERROR_AXIS_SYNC_CAM_TABLE_FULL";
+
+    break;
+
+  case 0x14F95:
+    return "ERROR_AXIS_SYNC_CAM_TABLE_INVALID";
+
+    break;
+
+  case 0x14F96:
+    return "ERROR_AXIS_SYNC_ENGAGE_TIME_OUT_OF_RANGE";
+
+    break;
+
+  case 0x14F97:
+    return "ERROR_AXIS_SYNC_TRAJ_SOURCE_NOT_EXTERNAL";
+
+    break;
+
+  case 0x14F98:
+    return "ERROR_AXIS_SYNC_NOT_CONFIGURED";
+
+    break;
+
+  case 0x14F99:
+    return "ERROR_AXIS_SYNC_ASYN_PARAM_REGISTER_FAIL";
+
+    break;
+
+  case 0x14F9A:
+    return "ERROR_AXIS_SYNC_CAM_SWITCH_PENDING";
+
+    break;
+
+  case 0x14FA0:    // AXIS PVT
+    return "ERROR_AXIS_PVT_SIZE_OUT_OF_RANGE";
+
+    break;
+
+  case 0x14FA1:
+    return "ERROR_AXIS_PVT_BUFFER_FULL";
+
+    break;
+
+  case 0x14FA2:
+    return "ERROR_AXIS_PVT_POINT_INVALID";
+
+    break;
+
+  case 0x14FA3:
+    return "ERROR_AXIS_PVT_CHANGE_NOT_ALLOWED_WHEN_ACTIVE";
+
+    break;
+
+  case 0x14FA4:
+    return "ERROR_AXIS_PVT_TRAJ_SOURCE_NOT_EXTERNAL";
+
+    break;
+
+  case 0x14FA5:
+    return "ERROR_AXIS_PVT_BUFFER_EMPTY";
+
+    break;
+
+  case 0x14FA6:
+    return "ERROR_AXIS_PVT_ASYN_PARAM_REGISTER_FAIL";
+
+    break;
+
+  case 0x14FA7:
+    return "ERROR_AXIS_PVT_ALREADY_CREATED";
+
+    break;
+
+  case 0x14FA8:
+    return "ERROR_AXIS_PVT_UNDERRUN";
+
+    break;
+
+  case 0x14FB0:
+    return "ERROR_AXIS_POS_CMP_SIZE_OUT_OF_RANGE";
+
+    break;
+
+  case 0x14FB1:
+    return "ERROR_AXIS_POS_CMP_TABLE_FULL";
+
+    break;
+
+  case 0x14FB2:
+    return "ERROR_AXIS_POS_CMP_TABLE_NOT_SORTED";
+
+    break;
+
+  case 0x14FB3:
+    return "ERROR_AXIS_POS_CMP_CHANGE_NOT_ALLOWED_WHEN_ENABLED";
+
+    break;
+
+  case 0x14FB4:
+    return "ERROR_AXIS_POS_CMP_NO_POSITIONS";
+
+    break;
+
+  case 0x14FB5:
+    return "ERROR_AXIS_POS_CMP_OUTPUT_ENTRY_NULL";
+
+    break;
+
+  case 0x14FB6:
+    return "ERROR_AXIS_POS_CMP_DIRECTION_OUT_OF_RANGE";
+
+    break;
+
+  case 0x14FB7:
+    return "ERROR_AXIS_POS_CMP_PARAMETER_OUT_OF_RANGE";
+
+    break;
+
+  case 0x14FB8:
+    return "ERROR_AXIS_POS_CMP_ALREADY_CREATED";
+
+    break;
+
+  case 0x14FB9:
+    return "ERROR_AXIS_POS_CMP_ASYN_PARAM_REGISTER_FAIL";
+
+    break;
+
   case 0x15000:    // CONTROLLER
     return "ERROR_CNTRL_INVALID_SAMPLE_TIME";
 
@@ -1315,6 +1578,51 @@ const char * ecmcError::convertErrorIdToString(int errorId) {
     return "ERROR_EC_SDO_ASYNC_ASYN_OBJ_FAIL";
 
     break;
+
+  case 0x23600: // ECSDOQUEUE
+    return "ERROR_EC_SDO_QUEUE_FULL";
+
+    break;
+
+  case 0x23601: // ECSDOQUEUE
+    return "ERROR_EC_SDO_QUEUE_POOL_SIZE_OUT_OF_RANGE";
+
+    break;
+
+  case 0x23602: // ECSDOQUEUE
+    return "ERROR_EC_SDO_QUEUE_REQ_CREATE_FAIL";
+
+    break;
+
+  case 0x23603: // ECSDOQUEUE
+    return "ERROR_EC_SDO_QUEUE_BYTE_SIZE_INVALID";
+
+    break;
+
+  case 0x23604: // ECSDOQUEUE
+    return "ERROR_EC_SDO_QUEUE_HANDLE_INVALID";
+
+    break;
+
+  case 0x23605: // ECSDOQUEUE
+    return "ERROR_EC_SDO_QUEUE_NOT_DONE";
+
+    break;
+
+  case 0x23606: // ECSDOQUEUE
+    return "ERROR_EC_SDO_QUEUE_REQUEST_FAIL";
+
+    break;
+
+  case 0x23607: // ECSDOQUEUE
+    return "ERROR_EC_SDO_QUEUE_PRIO_OUT_OF_RANGE";
+
+    break;
+
+  case 0x23608: // ECSDOQUEUE
+    return "ERROR_EC_SDO_QUEUE_BATCH_LIST_INVALID";
+
+    break;
     
   case 0x24000:  // ECSLAVE
     return "ERROR_EC_SLAVE_CONFIG_FAILED";
@@ -1421,6 +1729,16 @@ const char * ecmcError::convertErrorIdToString(int errorId) {
 
     break;
 
+  case 0x24015:
+    return "ERROR_EC_SLAVE_SDO_QUEUE_CREATE_FAIL";
+
+    break;
+
+  case 0x24016:
+    return "ERROR_EC_SLAVE_SDO_QUEUE_ALREADY_CREATED";
+
+    break;
+
   case 0x25000:  // ECSYNCMANAGER
     return "ERROR_EC_SM_PDO_ARRAY_FULL";
 
@@ -1650,6 +1968,146 @@ const char * ecmcError::convertErrorIdToString(int errorId) {
 
     break;
 
+  case 0x26029:
+    return "ERROR_EC_MEM_MAP_MAX_COUNT_OUT_OF_RANGE";
+
+    break;
+
+  case 0x2602A:
+    return "ERROR_EC_MEM_MAP_MAX_COUNT_CHANGE_NOT_ALLOWED";
+
+    break;
+
+  case 0x2602B:
+    return "ERROR_EC_DIAG_THREAD_PERIOD_OUT_OF_RANGE";
+
+    break;
+
+  case 0x2602C:
+    return "ERROR_EC_DIAG_THREAD_CREATE_FAIL";
+
+    break;
+
+  case 0x2602D:
+    return "ERROR_EC_DIAG_THREAD_CHANGE_NOT_ALLOWED";
+
+    break;
+
+  case 0x2602E:
+    return "ERROR_EC_DC_PLL_NOT_CONFIGURED";
+
+    break;
+
+  case 0x2602F:
+    return "ERROR_EC_SDO_QUEUE_NOT_CONFIGURED";
+
+    break;
+
+  case 0x26030:
+    return "ERROR_EC_MEM_MAP_PIPE_INDEX_OUT_OF_RANGE";
+
+    break;
+
+  case 0x26031:
+    return "ERROR_EC_ASYN_WRITE_QUEUE_FULL";
+
+    break;
+
+  case 0x26100:
+    return "ERROR_EC_DC_PLL_MODE_OUT_OF_RANGE";
+
+    break;
+
+  case 0x26101:
+    return "ERROR_EC_DC_PLL_PERIOD_OUT_OF_RANGE";
+
+    break;
+
+  case 0x26102:
+    return "ERROR_EC_DC_PLL_GAIN_OUT_OF_RANGE";
+
+    break;
+
+  case 0x26103:
+    return "ERROR_EC_DC_PLL_ASYN_PARAM_FAIL";
+
+    break;
+
+  case 0x26200:
+    return "ERROR_EC_MEM_MAP_PIPE_MEM_MAP_NULL";
+
+    break;
+
+  case 0x26201:
+    return "ERROR_EC_MEM_MAP_PIPE_DATA_STORAGE_NULL";
+
+    break;
+
+  case 0x26202:
+    return "ERROR_EC_MEM_MAP_PIPE_DECIMATION_OUT_OF_RANGE";
+
+    break;
+
+  case 0x26203:
+    return "ERROR_EC_MEM_MAP_PIPE_FIR_TAPS_OUT_OF_RANGE";
+
+    break;
+
+  case 0x26204:
+    return "ERROR_EC_MEM_MAP_PIPE_DATA_TYPE_INVALID";
+
+    break;
+
+  case 0x26205:
+    return "ERROR_EC_MEM_MAP_PIPE_ASYN_PARAM_FAIL";
+
+    break;
+
+  case 0x26300:
+    return "ERROR_EC_MAILBOX_ENTRY_NULL";
+
+    break;
+
+  case 0x26301:
+    return "ERROR_EC_MAILBOX_ARRAY_FULL";
+
+    break;
+
+  case 0x26302:
+    return "ERROR_EC_MAILBOX_SAME_MASTER";
+
+    break;
+
+  case 0x26400:
+    return "ERROR_EC_MASTER_THREAD_CREATE_FAIL";
+
+    break;
+
+  case 0x26401:
+    return "ERROR_EC_MASTER_THREAD_RUNNING";
+
+    break;
+
+  case 0x26402:
+    return "ERROR_EC_MASTER_THREAD_RATE_OUT_OF_RANGE";
+
+    break;
+
+  case 0x26403:
+    return "ERROR_EC_MASTER_THREAD_PRIO_OUT_OF_RANGE";
+
+    break;
+
+  case 0x26404:
+    return "ERROR_EC_MASTER_THREAD_CPU_OUT_OF_RANGE";
+
+    break;
+
+  case 0x26405:
+    return "ERROR_EC_MASTER_THREAD_ACTIVATE_FAIL";
+
+    break;
+
   case 0x20000:
     return "ERROR_MAIN_DEMO_EC_ACITVATE_FAILED";
 
@@ -2069,6 +2527,71 @@ const char * ecmcError::convertErrorIdToString(int errorId) {
 
     break;
 
+  case 0x20056:
+    return "ERROR_MAIN_OBJECT_LIMIT_OUT_OF_RANGE";
+
+    break;
+
+  case 0x20057:
+    return "ERROR_MAIN_OBJECT_LIMIT_CHANGE_NOT_ALLOWED";
+
+    break;
+
+  case 0x20058:
+    return "ERROR_MAIN_AXIS_GROUP_INDEX_OUT_OF_RANGE";
+
+    break;
+
+  case 0x20059:
+    return "ERROR_MAIN_AXIS_GROUP_OBJECT_NULL";
+
+    break;
+
+  case 0x2005A:
+    return "ERROR_MAIN_AXIS_GROUP_ALREADY_CREATED";
+
+    break;
+
+  case 0x2005B:
+    return "ERROR_MAIN_AXIS_SYNC_OBJECT_NULL";
+
+    break;
+
+  case 0x2005C:
+    return "ERROR_MAIN_AXIS_PVT_OBJECT_NULL";
+
+    break;
+
+  case 0x2005D:
+    return "ERROR_MAIN_AXIS_POS_CMP_OBJECT_NULL";
+
+    break;
+
+  case 0x2005E:
+    return "ERROR_MAIN_RT_GUARD_MODE_OUT_OF_RANGE";
+
+    break;
+
+  case 0x2005F:
+    return "ERROR_MAIN_EC_MASTERS_FULL";
+
+    break;
+
+  case 0x20060:
+    return "ERROR_MAIN_DATA_GROUP_INDEX_OUT_OF_RANGE";
+
+    break;
+
+  case 0x20061:
+    return "ERROR_MAIN_DATA_GROUP_NULL";
+
+    break;
+
+  case 0x20062:
+    return "ERROR_MAIN_RT_GUARD_NOT_BUILT";
+
+    break;
+
   case 0x20100:   // Data Recorder
     return "ERROR_DATA_RECORDER_BUFFER_NULL";
 
@@ -2129,6 +2652,11 @@ const char * ecmcError::convertErrorIdToString(int errorId) {
 
     break;
 
+  case 0x20205:
+    return "ERROR_DATA_STORAGE_SIZE_CHANGE_NOT_ALLOWED";
+
+    break;
+
   case 0x20300:   // Event
     return "ERROR_EVENT_DATA_ECENTRY_NULL";
 
@@ -2403,6 +2931,71 @@ const char * ecmcError::convertErrorIdToString(int errorId) {
 
     break;
 
+  case 0x20900:  // CFG SNAPSHOT
+    return "ERROR_CFG_SNAPSHOT_FILE_OPEN_FAIL";
+
+    break;
+
+  case 0x20901:
+    return "ERROR_CFG_SNAPSHOT_FILE_WRITE_FAIL";
+
+    break;
+
+  case 0x20902:
+    return "ERROR_CFG_SNAPSHOT_FILE_CORRUPT";
+
+    break;
+
+  case 0x20903:
+    return "ERROR_CFG_SNAPSHOT_VERSION_MISMATCH";
+
+    break;
+
+  case 0x20904:
+    return "ERROR_CFG_SNAPSHOT_HW_MISMATCH";
+
+    break;
+
+  case 0x20905:
+    return "ERROR_CFG_SNAPSHOT_REPLAY_FAIL";
+
+    break;
+
+  case 0x20906:
+    return "ERROR_CFG_SNAPSHOT_PLC_FILE_FAIL";
+
+    break;
+
+  case 0x20A00:
+    return "ERROR_DATA_GROUP_FULL";
+
+    break;
+
+  case 0x20A01:
+    return "ERROR_DATA_GROUP_ITEM_NULL";
+
+    break;
+
+  case 0x20A02:
+    return "ERROR_DATA_GROUP_ITEM_NOT_VALID";
+
+    break;
+
+  case 0x20A03:
+    return "ERROR_DATA_GROUP_NAMES_FULL";
+
+    break;
+
+  case 0x20A04:
+    return "ERROR_DATA_GROUP_ASYN_PARAM_REGISTER_FAIL";
+
+    break;
+
+  case 0x20A05:
+    return "ERROR_DATA_GROUP_PERIOD_OUT_OF_RANGE";
+
+    break;
+
   case 0x200000:
     return "ECMC_PARSER_READ_STORAGE_BUFFER_DATA_NULL";
 
@@ -2475,12 +3068,31 @@ const char * ecmcError::convertErrorIdToString(int errorId) {
   case 0x220009:
     return "ERROR_ASYN_CMD_FAIL";
 
+    break;
+  case 0x22000A:
+    return "ERROR_ASYN_ARRAY_BLOCK_COUNT_OUT_OF_RANGE";
+
     break;
 
   case 0x230000:
     return "ERROR_AXIS_FILTER_ALLOC_FAIL";
 
   break;
+
+  case 0x230001:
+    return "ERROR_AXIS_FILTER_TYPE_OUT_OF_RANGE";
+
+  break;
+
+  case 0x230002:
+    return "ERROR_AXIS_FILTER_CUTOFF_OUT_OF_RANGE";
+
+  break;
+
+  case 0x230003:
+    return "ERROR_AXIS_FILTER_ORDER_OUT_OF_RANGE";
+
+  break;
   
   case 0x231000:
     return "ERROR_PLUGIN_FLIE_NOT_FOUND";
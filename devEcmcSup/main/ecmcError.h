@@ -16,6 +16,7 @@
 #include <time.h>
 #include "stdio.h"
 #include "../com/ecmcOctetIF.h"
+#include "ecmcErrorRegistry.h"
 
 enum ecmcAlarmSeverity {
   ECMC_SEVERITY_NONE      = 0,
@@ -61,6 +62,10 @@ class ecmcError {
 
   void setExternalPtrs(int* errorPtr,int* warningPtr);
 
+  // Register in central error registry (top level objects)
+  void registerErrorObject(ecmcErrorObjClass objClass,
+                           int               objIndex);
+
  protected:
   char errorPath_[128];
   bool errorPathValid_;
@@ -74,6 +79,8 @@ class ecmcError {
   ecmcAlarmSeverity currSeverity_;
   int *warningPtr_;
   int *errorPtr_;  
+  ecmcErrorObjClass regClass_;
+  int regIndex_;
 };
 
 #endif  /* ECMCERROR_H_ */
@@ -0,0 +1,227 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcErrorRegistry.cpp
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#include "ecmcErrorRegistry.h"
+#include <string.h>
+#include <time.h>
+#include "ecmcDefinitions.h"
+#include "ecmcError.h"
+
+#define ECMC_ERROR_REG_WORD_BITS 64
+
+// Per object class: bitmap of objects in error and object pointers
+static uint64_t   *regBits[ECMC_ERROR_OBJ_CLASS_COUNT]    = {};
+static ecmcError **regObjects[ECMC_ERROR_OBJ_CLASS_COUNT] = {};
+static int         regActive[ECMC_ERROR_OBJ_CLASS_COUNT]  = {};
+static int         regActiveCount                         = 0;
+static uint64_t    regCycleCounter                        = 0;
+
+// Journal (multiple producers reserve slots with atomic increment)
+static ecmcErrorJournalEntry journal[ECMC_ERROR_JOURNAL_SIZE] = {};
+static uint32_t              journalWriteCount                = 0;
+
+int ecmcErrorRegistry::getCapacity(ecmcErrorObjClass objClass) {
+  switch (objClass) {
+  case ECMC_ERROR_OBJ_EC:
+    return ECMC_MAX_EC_MASTERS;
+
+  case ECMC_ERROR_OBJ_PLC:
+    return 1;
+
+  case ECMC_ERROR_OBJ_EVENT:
+  case ECMC_ERROR_OBJ_DATA_STORAGE:
+    return ECMC_MAX_OBJECTS_LIMIT;
+
+  case ECMC_ERROR_OBJ_DATA_RECORDER:
+    return ECMC_MAX_DATA_RECORDERS_OBJECTS;
+
+  case ECMC_ERROR_OBJ_COMMAND_LIST:
+    return ECMC_MAX_COMMANDS_LISTS;
+
+  case ECMC_ERROR_OBJ_AXIS:
+    return ECMC_MAX_AXES;
+
+  case ECMC_ERROR_OBJ_PLUGIN:
+    return ECMC_MAX_PLUGINS;
+
+  default:
+    return 0;
+  }
+}
+
+/* Called when objects are created (not realtime) */
+void ecmcErrorRegistry::registerObject(ecmcError        *obj,
+                                       ecmcErrorObjClass objClass,
+                                       int               objIndex) {
+  int capacity = getCapacity(objClass);
+
+  if ((objIndex < 0) || (objIndex >= capacity)) {
+    return;
+  }
+
+  if (regObjects[objClass] == NULL) {
+    int words = (capacity + ECMC_ERROR_REG_WORD_BITS - 1) /
+                ECMC_ERROR_REG_WORD_BITS;
+    regBits[objClass]    = new uint64_t[words];
+    regObjects[objClass] = new ecmcError*[capacity];
+    memset(regBits[objClass], 0, words * sizeof(uint64_t));
+    memset(regObjects[objClass], 0, capacity * sizeof(ecmcError *));
+  }
+
+  regObjects[objClass][objIndex] = obj;
+}
+
+void ecmcErrorRegistry::unregisterObject(ecmcErrorObjClass objClass,
+                                         int               objIndex) {
+  if ((objIndex < 0) || (objIndex >= getCapacity(objClass)) ||
+      (regObjects[objClass] == NULL)) {
+    return;
+  }
+
+  // Clear error state of removed object (not logged in journal)
+  setBit(objClass, objIndex, false);
+  regObjects[objClass][objIndex] = NULL;
+}
+
+void ecmcErrorRegistry::setBit(ecmcErrorObjClass objClass,
+                               int               objIndex,
+                               bool              error) {
+  // Only registered objects
+  if ((objIndex < 0) || (objIndex >= getCapacity(objClass)) ||
+      (regBits[objClass] == NULL)) {
+    return;
+  }
+
+  uint64_t *word = &regBits[objClass][objIndex / ECMC_ERROR_REG_WORD_BITS];
+  uint64_t  mask = 1ULL << (objIndex % ECMC_ERROR_REG_WORD_BITS);
+
+  if (error) {
+    if (!(__atomic_fetch_or(word, mask, __ATOMIC_ACQ_REL) & mask)) {
+      __atomic_add_fetch(&regActive[objClass], 1, __ATOMIC_RELAXED);
+      __atomic_add_fetch(&regActiveCount, 1, __ATOMIC_RELAXED);
+    }
+  } else {
+    if (__atomic_fetch_and(word, ~mask, __ATOMIC_ACQ_REL) & mask) {
+      __atomic_sub_fetch(&regActive[objClass], 1, __ATOMIC_RELAXED);
+      __atomic_sub_fetch(&regActiveCount, 1, __ATOMIC_RELAXED);
+    }
+  }
+}
+
+void ecmcErrorRegistry::update(ecmcErrorObjClass objClass,
+                               int               objIndex,
+                               int               errorIdOld,
+                               int               errorIdNew) {
+  if (errorIdOld == errorIdNew) {
+    return;
+  }
+
+  setBit(objClass, objIndex, errorIdNew != 0);
+
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+
+  uint32_t seq = __atomic_fetch_add(&journalWriteCount, 1, __ATOMIC_ACQ_REL);
+  ecmcErrorJournalEntry *entry = &journal[seq % ECMC_ERROR_JOURNAL_SIZE];
+
+  // Invalidate while writing
+  __atomic_store_n(&entry->sequence, 0, __ATOMIC_RELEASE);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  entry->sec      = (int32_t)ts.tv_sec;
+  entry->nsec     = (int32_t)ts.tv_nsec;
+  entry->cycle    = (int32_t)regCycleCounter;
+  entry->objClass = objClass;
+  entry->objIndex = objIndex;
+  entry->errorId  = errorIdNew;
+  __atomic_store_n(&entry->sequence, (int32_t)(seq + 1), __ATOMIC_RELEASE);
+}
+
+int ecmcErrorRegistry::getFirstErrorId(ecmcErrorObjClass startClass,
+                                       ecmcErrorObjClass endClass) {
+  if (__atomic_load_n(&regActiveCount, __ATOMIC_RELAXED) <= 0) {
+    return 0;
+  }
+
+  for (int c = startClass; c <= endClass; c++) {
+    if ((c < 0) || (c >= ECMC_ERROR_OBJ_CLASS_COUNT) ||
+        (__atomic_load_n(&regActive[c], __ATOMIC_RELAXED) <= 0)) {
+      continue;
+    }
+
+    int words = (getCapacity((ecmcErrorObjClass)c) +
+                 ECMC_ERROR_REG_WORD_BITS - 1) / ECMC_ERROR_REG_WORD_BITS;
+
+    for (int w = 0; w < words; w++) {
+      uint64_t bits = __atomic_load_n(&regBits[c][w], __ATOMIC_ACQUIRE);
+
+      while (bits) {
+        int index = w * ECMC_ERROR_REG_WORD_BITS + __builtin_ctzll(bits);
+        ecmcError *obj = regObjects[c][index];
+
+        if (obj) {
+          int errorId = obj->getErrorID();
+
+          if (errorId) {
+            return errorId;
+          }
+        }
+        bits &= bits - 1;
+      }
+    }
+  }
+  return 0;
+}
+
+int ecmcErrorRegistry::getActiveCount() {
+  return __atomic_load_n(&regActiveCount, __ATOMIC_RELAXED);
+}
+
+void ecmcErrorRegistry::incCycleCounter() {
+  regCycleCounter++;
+}
+
+uint64_t ecmcErrorRegistry::getCycleCounter() {
+  return regCycleCounter;
+}
+
+uint32_t ecmcErrorRegistry::getJournalWriteCount() {
+  return __atomic_load_n(&journalWriteCount, __ATOMIC_ACQUIRE);
+}
+
+size_t ecmcErrorRegistry::getJournal(ecmcErrorJournalEntry *buffer,
+                                     size_t                 entries) {
+  uint32_t count = getJournalWriteCount();
+  uint32_t first = 0;
+  size_t   used  = 0;
+
+  if (count > ECMC_ERROR_JOURNAL_SIZE) {
+    first = count - ECMC_ERROR_JOURNAL_SIZE;
+  }
+
+  if (count - first > entries) {
+    first = count - entries;
+  }
+
+  for (uint32_t seq = first; seq != count; seq++) {
+    ecmcErrorJournalEntry *entry = &journal[seq % ECMC_ERROR_JOURNAL_SIZE];
+    buffer[used] = *entry;
+
+    // Skip entries being written or already overwritten
+    if ((buffer[used].sequence != (int32_t)(seq + 1)) ||
+        (__atomic_load_n(&entry->sequence, __ATOMIC_ACQUIRE) !=
+         (int32_t)(seq + 1))) {
+      continue;
+    }
+    used++;
+  }
+  return used;
+}
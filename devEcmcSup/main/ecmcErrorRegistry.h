@@ -0,0 +1,95 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcErrorRegistry.h
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#ifndef ECMCERRORREGISTRY_H_
+#define ECMCERRORREGISTRY_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+class ecmcError;
+
+// Object classes in the order the controller error is evaluated
+enum ecmcErrorObjClass {
+  ECMC_ERROR_OBJ_NONE          = -1,  // Not registered (sub objects)
+  ECMC_ERROR_OBJ_EC            = 0,
+  ECMC_ERROR_OBJ_EVENT         = 1,
+  ECMC_ERROR_OBJ_DATA_RECORDER = 2,
+  ECMC_ERROR_OBJ_DATA_STORAGE  = 3,
+  ECMC_ERROR_OBJ_COMMAND_LIST  = 4,
+  ECMC_ERROR_OBJ_PLC           = 5,
+  ECMC_ERROR_OBJ_AXIS          = 6,
+  ECMC_ERROR_OBJ_PLUGIN        = 7,
+  ECMC_ERROR_OBJ_CLASS_COUNT   = 8,
+};
+
+// Error journal (ring buffer)
+#define ECMC_ERROR_JOURNAL_SIZE 256
+
+// Int32 values per journal entry in asyn waveform
+#define ECMC_ERROR_JOURNAL_ENTRY_INTS 7
+
+typedef struct {
+  int32_t sequence;   // Running number (entry valid if > 0)
+  int32_t sec;        // Timestamp (CLOCK_REALTIME)
+  int32_t nsec;
+  int32_t cycle;      // Realtime cycle counter (lower 32 bits)
+  int32_t objClass;   // ecmcErrorObjClass
+  int32_t objIndex;
+  int32_t errorId;    // 0 = error cleared
+} ecmcErrorJournalEntry;
+
+/**
+ * \class ecmcErrorRegistry
+ *
+ * \brief Central registry of objects in error
+ *
+ * Registered objects (axes, events, PLC, ...) update a bitmap per object
+ * class when entering or leaving error state (from ecmcError::setErrorID()).
+ * The controller error is then found without scanning all objects.
+ *
+ * All error changes (also of sub objects) are logged in a lock free
+ * timestamped journal ring.
+ */
+class ecmcErrorRegistry {
+ public:
+  static void registerObject(ecmcError        *obj,
+                             ecmcErrorObjClass objClass,
+                             int               objIndex);
+  static void unregisterObject(ecmcErrorObjClass objClass,
+                               int               objIndex);
+  static void update(ecmcErrorObjClass objClass,
+                     int               objIndex,
+                     int               errorIdOld,
+                     int               errorIdNew);
+
+  // First error in class order (startClass..endClass)
+  static int  getFirstErrorId(ecmcErrorObjClass startClass,
+                              ecmcErrorObjClass endClass);
+  static int  getActiveCount();
+
+  static void incCycleCounter();
+  static uint64_t getCycleCounter();
+
+  // Copy journal (oldest first) to buffer, returns number of entries
+  static size_t getJournal(ecmcErrorJournalEntry *buffer,
+                           size_t                 entries);
+  static uint32_t getJournalWriteCount();
+
+ private:
+  static int  getCapacity(ecmcErrorObjClass objClass);
+  static void setBit(ecmcErrorObjClass objClass,
+                     int               objIndex,
+                     bool              error);
+};
+
+#endif  /* ECMCERRORREGISTRY_H_ */
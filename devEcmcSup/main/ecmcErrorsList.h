@@ -99,4 +99,17 @@
 #define ERROR_MAIN_AXIS_COM_BLOCKED 0x20053
 #define ERROR_MAIN_EC_SCAN_TIMEOUT 0x20054
 #define ERROR_MAIN_AXIS_ALREADY_CREATED 0x20055
+#define ERROR_MAIN_OBJECT_LIMIT_OUT_OF_RANGE 0x20056
+#define ERROR_MAIN_OBJECT_LIMIT_CHANGE_NOT_ALLOWED 0x20057
+#define ERROR_MAIN_AXIS_GROUP_INDEX_OUT_OF_RANGE 0x20058
+#define ERROR_MAIN_AXIS_GROUP_OBJECT_NULL 0x20059
+#define ERROR_MAIN_AXIS_GROUP_ALREADY_CREATED 0x2005A
+#define ERROR_MAIN_AXIS_SYNC_OBJECT_NULL 0x2005B
+#define ERROR_MAIN_AXIS_PVT_OBJECT_NULL 0x2005C
+#define ERROR_MAIN_AXIS_POS_CMP_OBJECT_NULL 0x2005D
+#define ERROR_MAIN_RT_GUARD_MODE_OUT_OF_RANGE 0x2005E
+#define ERROR_MAIN_EC_MASTERS_FULL 0x2005F
+#define ERROR_MAIN_DATA_GROUP_INDEX_OUT_OF_RANGE 0x20060
+#define ERROR_MAIN_DATA_GROUP_NULL 0x20061
+#define ERROR_MAIN_RT_GUARD_NOT_BUILT 0x20062
 #endif  /* ECMCERRORSLIST_H_ */
@@ -19,75 +19,34 @@
 #include "../com/ecmcOctetIF.h"        // Log Macros
 #include "../main/ecmcErrorsList.h"
 #include "../main/ecmcDefinitions.h"
+#include "../main/ecmcErrorRegistry.h"
 
 int getControllerError() {
+  int errorId = 0;
 
-  // EtherCAT errors
-  if(ec->getInitDone()) {
-    if (ec->getError()) {
-     return ec->getErrorID();
-    }
-  }
-
-  // Event errors
-  for (int i = 0; i < ECMC_MAX_EVENT_OBJECTS; i++) {
-    if (events[i] != NULL) {
-      if (events[i]->getError()) {
-        return events[i]->getErrorID();
-      }
-    }
-  }
-
-  // DataRecorders
-  for (int i = 0; i < ECMC_MAX_DATA_RECORDERS_OBJECTS; i++) {
-    if (dataRecorders[i] != NULL) {
-      if (dataRecorders[i]->getError()) {
-        return dataRecorders[i]->getErrorID();
-      }
-    }
-  }
-
-  // Data Storages
-  for (int i = 0; i < ECMC_MAX_DATA_STORAGE_OBJECTS; i++) {
-    if (dataStorages[i] != NULL) {
-      if (dataStorages[i]->getError()) {
-        return dataStorages[i]->getErrorID();
-      }
-    }
-  }
+  // EtherCAT, events, data recorders, data storages and command lists
+  // (registered objects in error, see ecmcErrorRegistry)
+  errorId = ecmcErrorRegistry::getFirstErrorId(
+    ec->getInitDone() ? ECMC_ERROR_OBJ_EC : ECMC_ERROR_OBJ_EVENT,
+    ECMC_ERROR_OBJ_COMMAND_LIST);
 
-  // CommandLists
-  for (int i = 0; i < ECMC_MAX_COMMANDS_LISTS; i++) {
-    if (commandLists[i] != NULL) {
-      if (commandLists[i]->getError()) {
-        return commandLists[i]->getErrorID();
-      }
-    }
+  if (errorId) {
+    return errorId;
   }
 
-  // PLC:s
+  // PLC:s (plc code errors are not set through setErrorID())
   if (plcs != NULL) {
     if (plcs->getError()) {
       return plcs->getErrorID();
     }
   }
 
-  // Axes
-  for (int i = 0; i < ECMC_MAX_AXES; i++) {
-    if (axes[i] != NULL) {
-      if (axes[i]->getError()) {
-        return axes[i]->getErrorID();
-      }
-    }
-  }
+  // Axes and plugin objects
+  errorId = ecmcErrorRegistry::getFirstErrorId(ECMC_ERROR_OBJ_AXIS,
+                                               ECMC_ERROR_OBJ_PLUGIN);
 
-  // Plugin objects
-  for (int i = 0; i < ECMC_MAX_PLUGINS; i++) {
-    if (plugins[i]) {
-      if (plugins[i]->getError()) {
-        return plugins[i]->getErrorID();
-      }
-    }
+  if (errorId) {
+    return errorId;
   }
 
   // Plugin RTfunc retrun errors
@@ -105,7 +64,7 @@ int controllerErrorReset() {
   ec->errorReset();
 
   // Event errors
-  for (int i = 0; i < ECMC_MAX_EVENT_OBJECTS; i++) {
+  for (int i = 0; i < ecmcMaxEventObjects; i++) {
     if (events[i] != NULL) {
       events[i]->errorReset();
     }
@@ -119,7 +78,7 @@ int controllerErrorReset() {
   }
 
   // Data Storages
-  for (int i = 0; i < ECMC_MAX_DATA_STORAGE_OBJECTS; i++) {
+  for (int i = 0; i < ecmcMaxDataStorageObjects; i++) {
     if (dataStorages[i] != NULL) {
       dataStorages[i]->errorReset();
     }
@@ -190,6 +149,16 @@ int setEnableFunctionCallDiag(int value) {
   return 0;
 }
 
+int setAsynArrayBlockCount(int count) {
+  LOGINFO4("%s/%s:%d count=%d\n", __FILE__, __FUNCTION__, __LINE__, count);
+
+  if (!asynPort) {
+    return ERROR_MAIN_ASYN_PORT_DRIVER_NULL;
+  }
+
+  return asynPort->setDefaultArrayBlockCount(count);
+}
+
 int linkEcEntryToObject(char *ecPath, char *objPath) {
   LOGINFO4("%s/%s:%d ecPath=%s axPath=%s\n",
            __FILE__,
@@ -280,6 +249,12 @@ int linkEcEntryToObject(char *ecPath, char *objPath) {
           if (objFunctionId == ECMC_AXIS_ENTRY_INDEX_HEALTH) {
             return linkEcEntryToAxisStatusOutput(slaveIndex, alias, objIndex);
           }
+          if (objFunctionId == ECMC_AXIS_ENTRY_INDEX_POS_CMP) {
+            return linkEcEntryToAxisPosCompareOutput(slaveIndex,
+                                                     alias,
+                                                     objIndex,
+                                                     bitIndex);
+          }
           return ERROR_MAIN_ECMC_LINK_INVALID;
           break;
       }
@@ -117,6 +117,24 @@ int setEnableTimeDiag(int value);
  *  "Cfg.SetEnableFuncCallDiag(1)" //Command string to ecmcCmdParser.c\n
  */
 int setEnableFunctionCallDiag(int value);
+
+/** \brief Set number of buffers (blocks) used for publishing array
+ * parameters.\n
+ *
+ * Input memmaps and data storages publish arrays through a pool of
+ * buffers. Each published array gets a sequence number (parameter
+ * "<name>.seq") and the EtherCAT time stamp. A buffer that is being read
+ * is never overwritten. Gaps in the sequence number are lost updates.\n
+ * Applies to objects created after this command.\n
+ *
+ * \param[in] count Number of blocks (0=disable, 2..16, default 4).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Use 8 blocks.\n
+ *  "Cfg.SetAsynArrayBlockCount(8)" //Command string to ecmcCmdParser.c\n
+ */
+int setAsynArrayBlockCount(int count);
                        
 # ifdef __cplusplus
 }
@@ -13,11 +13,14 @@
 #ifndef ECMC_GLOBALS_H_
 #define ECMC_GLOBALS_H_
 #include "../ethercat/ecmcEc.h"
+#include "../ethercat/ecmcEcMasterThread.h"
 #include "../motion/ecmcAxisBase.h"
+#include "../motion/ecmcAxisGroup.h"
 #include "../misc/ecmcEvent.h"
 #include "../misc/ecmcDataRecorder.h"
 #include "../misc/ecmcDataStorage.h"
 #include "../misc/ecmcCommandList.h"
+#include "../misc/ecmcDataGroup.h"
 #include "../plc/ecmcPLCMain.h"
 #include "../motion/ecmcMotion.h"
 #include "../com/ecmcAsynDataItem.h"
@@ -26,11 +29,15 @@
 #include "epicsMutex.h"
 
 ecmcAxisBase *axes[ECMC_MAX_AXES];
+ecmcAxisGroup             *axisGroups[ECMC_MAX_AXIS_GROUPS];
 ecmcEc                    *ec;
-ecmcEvent                 *events[ECMC_MAX_EVENT_OBJECTS];
+ecmcEc                    *ecCfg = NULL;  // Master selected for configuration
+ecmcEcMasterThread        *ecMasterThreads[ECMC_MAX_EC_MASTERS] = {};  // Slot 0 unused (ec)
+ecmcEvent                **events = NULL;
 ecmcDataRecorder          *dataRecorders[ECMC_MAX_DATA_RECORDERS_OBJECTS];
-ecmcDataStorage           *dataStorages[ECMC_MAX_DATA_STORAGE_OBJECTS];
+ecmcDataStorage          **dataStorages = NULL;
 ecmcCommandList           *commandLists[ECMC_MAX_COMMANDS_LISTS];
+ecmcDataGroup             *dataGroups[ECMC_MAX_DATA_GROUPS] = {};
 ecmcPLCMain               *plcs;
 ecmcAsynPortDriver        *asynPort = NULL;
 ecmcAsynDataItem          *mainAsynParams[ECMC_ASYN_MAIN_PAR_COUNT];
@@ -55,5 +62,13 @@ double                     mcuFrequency = MCU_FREQUENCY;
 double                     mcuPeriod = MCU_PERIOD_NS;
 int                        sampleRateChangeAllowed = 1;
 int                        pluginsError = 0;
+int                        ecmcMaxEventObjects = ECMC_MAX_EVENT_OBJECTS;
+int                        ecmcMaxDataStorageObjects = ECMC_MAX_DATA_STORAGE_OBJECTS;
+ecmcErrorJournalEntry      errorJournal[ECMC_ERROR_JOURNAL_SIZE];
+uint32_t                   errorJournalWriteCountOld = 0;
+int                        errorActiveCount = 0;
+uint32_t                   asynPublishedCount = 0;
+uint32_t                   asynSuppressedCount = 0;
+uint32_t                   rtGuardCount = 0;
 
 #endif  /* ECMC_GLOBALS_H_ */
@@ -16,11 +16,14 @@
 #define ECMC_GLOBALS_EXTERN_H_
 
 #include "../ethercat/ecmcEc.h"
+#include "../ethercat/ecmcEcMasterThread.h"
 #include "../motion/ecmcAxisBase.h"
+#include "../motion/ecmcAxisGroup.h"
 #include "../misc/ecmcEvent.h"
 #include "../misc/ecmcDataRecorder.h"
 #include "../misc/ecmcDataStorage.h"
 #include "../misc/ecmcCommandList.h"
+#include "../misc/ecmcDataGroup.h"
 #include "../plc/ecmcPLCMain.h"
 #include "../motion/ecmcMotion.h"
 #include "../ethercat/ecmcEthercat.h"
@@ -29,11 +32,15 @@
 #include "epicsMutex.h"
 
 extern ecmcAxisBase              *axes[ECMC_MAX_AXES];
+extern ecmcAxisGroup             *axisGroups[ECMC_MAX_AXIS_GROUPS];
 extern ecmcEc                    *ec;
-extern ecmcEvent                 *events[ECMC_MAX_EVENT_OBJECTS];
+extern ecmcEc                    *ecCfg;
+extern ecmcEcMasterThread        *ecMasterThreads[ECMC_MAX_EC_MASTERS];
+extern ecmcEvent                **events;
 extern ecmcDataRecorder          *dataRecorders[ECMC_MAX_DATA_RECORDERS_OBJECTS];
-extern ecmcDataStorage           *dataStorages[ECMC_MAX_DATA_STORAGE_OBJECTS];
+extern ecmcDataStorage          **dataStorages;
 extern ecmcCommandList           *commandLists[ECMC_MAX_COMMANDS_LISTS];
+extern ecmcDataGroup             *dataGroups[ECMC_MAX_DATA_GROUPS];
 extern ecmcPLCMain               *plcs;
 extern ecmcAsynPortDriver        *asynPort;
 extern ecmcAsynDataItem          *mainAsynParams[ECMC_ASYN_MAIN_PAR_COUNT];
@@ -58,4 +65,12 @@ extern double                     mcuFrequency;
 extern double                     mcuPeriod;
 extern int                        sampleRateChangeAllowed;
 extern int                        pluginsError;
+extern int                        ecmcMaxEventObjects;
+extern int                        ecmcMaxDataStorageObjects;
+extern ecmcErrorJournalEntry      errorJournal[ECMC_ERROR_JOURNAL_SIZE];
+extern uint32_t                   errorJournalWriteCountOld;
+extern int                        errorActiveCount;
+extern uint32_t                   asynPublishedCount;
+extern uint32_t                   asynSuppressedCount;
+extern uint32_t                   rtGuardCount;
 #endif  /* ECMC_GLOBALS_EXTERN_H_ */
@@ -36,6 +36,9 @@
 #include "ecrt.h"
 #include "ecmcDefinitions.h"
 #include "ecmcErrorsList.h"
+#include "ecmcErrorRegistry.h"
+#include "ecmcRtGuard.h"
+#include "ecmcConfigArena.h"
 #include "ecmcGlobals.h"
 #include "../com/ecmcOctetIF.h" 
 #include "../ethercat/ecmcEthercat.h"
@@ -51,6 +54,20 @@ static struct timespec masterActivationTimeMonotonic = {};
 static struct timespec masterActivationTimeOffset    = {};
 static struct timespec masterActivationTimeRealtime  = {};
 
+// Dense execution lists of configured objects (built when entering runtime)
+static ecmcAxisBase   *axesExe[ECMC_MAX_AXES];
+static int             axesExeIds[ECMC_MAX_AXES];
+static int             axesExeCount    = 0;
+static ecmcAxisGroup  *axisGroupsExe[ECMC_MAX_AXIS_GROUPS];
+static int             axisGroupsExeCount = 0;
+static ecmcEvent     **eventsExe       = NULL;
+static int             eventsExeCount  = 0;
+static ecmcPluginLib  *pluginsExe[ECMC_MAX_PLUGINS];
+static int             pluginsExeCount = 0;
+// Batched monitor checks over all axes (see Cfg.SetEnableAxisMonitorBatch())
+static ecmcAxisHotState *axisHotState       = NULL;
+static int               axisHotStateEnable = 0;
+
 /*****************************************************************************/
 
 void printStatus() {
@@ -110,6 +127,32 @@ void updateAsynParams(int force) {
     errorCode=mainAsynParams[ECMC_ASYN_MAIN_PAR_ERROR_MSG_ID]->refreshParamRT(1,(uint8_t*)controllerErrorMsg,strlen(controllerErrorMsg));
   }
 
+  // Error journal (only copy when new entries)
+  uint32_t journalWriteCount = ecmcErrorRegistry::getJournalWriteCount();
+  if(journalWriteCount != errorJournalWriteCountOld || force) {
+    size_t entries = ecmcErrorRegistry::getJournal(errorJournal,
+                                                   ECMC_ERROR_JOURNAL_SIZE);
+    errorJournalWriteCountOld = journalWriteCount;
+    mainAsynParams[ECMC_ASYN_MAIN_PAR_ERROR_JOURNAL_ID]->refreshParamRT(1,
+                          (uint8_t*)errorJournal,
+                          entries * sizeof(ecmcErrorJournalEntry));
+  }
+  errorActiveCount = ecmcErrorRegistry::getActiveCount();
+  mainAsynParams[ECMC_ASYN_MAIN_PAR_ERROR_COUNT_ID]->refreshParamRT(force);
+
+  // Published and suppressed (deadband/on change) asyn updates
+  asynPublishedCount  = asynPort->getPublishedCount();
+  asynSuppressedCount = asynPort->getSuppressedCount();
+  mainAsynParams[ECMC_ASYN_MAIN_PAR_PUBLISHED_ID]->refreshParamRT(force);
+  mainAsynParams[ECMC_ASYN_MAIN_PAR_SUPPRESSED_ID]->refreshParamRT(force);
+
+  // Guarded calls in realtime cycles (see ecmcRtGuard)
+  rtGuardCount = ecmcRtGuard::getTotalCount();
+  mainAsynParams[ECMC_ASYN_MAIN_PAR_RT_GUARD_COUNT_ID]->refreshParamRT(force);
+
+  // Refresh parameters that are due (timing wheel)
+  asynPort->executeRefreshWheel();
+
   // Asyn callbacks for all parameters (except arrays)
   if (asynSkipUpdateCounterFastest && !force) {
     asynSkipUpdateCounterFastest--;
@@ -240,11 +283,26 @@ void cyclic_task(void *usr) {
   // start 100ms + 1 period after  master activate (in setAppMode())
   wakeupTime = timespec_add(masterActivationTimeMonotonic, offsetStartTime);
 
+  // Data items updated in this thread are stamped with the DC cycle time
+  ecmcDataItem::setCycleDcTimeSource(ec->getCycleDcTimeNsPtr());
+
   if(ecmcRTMutex) epicsMutexLock(ecmcRTMutex);
   
   while (appModeCmd == ECMC_MODE_RUNTIME) {
     wakeupTime = timespec_add(wakeupTime, cycletime);
 
+    // Shift wakeup if locked to DC reference clock
+    if (ec->getInitDone()) {
+      int64_t dcAdjustNs = ec->getDcPllAdjustNs();
+      if (dcAdjustNs > 0) {
+        const struct timespec adjust = {0, (long int)dcAdjustNs};
+        wakeupTime = timespec_add(wakeupTime, adjust);
+      } else if (dcAdjustNs < 0) {
+        const struct timespec adjust = {0, (long int)-dcAdjustNs};
+        wakeupTime = timespec_sub(wakeupTime, adjust);
+      }
+    }
+
     /* Only lock asyn port when ec is started
      * otherwise deadlock in stratup phase
      * (sleep in waitforstartup() this is called
@@ -273,6 +331,8 @@ void cyclic_task(void *usr) {
     threadDiag.sendperiod_ns = DIFF_NS(lastSendTime, sendTime);
     lastStartTime = startTime;
     lastSendTime  = sendTime;
+    ecmcErrorRegistry::incCycleCounter();
+    ecmcRtGuard::enterCycle(ecmcErrorRegistry::getCycleCounter());
 
     if (threadDiag.latency_ns > threadDiag.latency_max_ns) {
       threadDiag.latency_max_ns = threadDiag.latency_ns;
@@ -308,28 +368,43 @@ void cyclic_task(void *usr) {
     if(ec->getInitDone()) {
       ec->receive();
       ec->checkDomainState();
+      if(ec->getDiagThreadRunning()) {
+        ec->applyDiagState();
+      }
     }
     ecStat = ec->statusOK() || !ec->getInitDone();
+    // Axis groups (write setpoints to member axes before axes execute)
+    for (i = 0; i < axisGroupsExeCount; i++) {
+      axisGroupsExe[i]->execute(ecStat);
+    }
+
     // Motion
-    for (i = 0; i < ECMC_MAX_AXES; i++) {
-      if (axes[i] != NULL) {
-        plcs->execute(AXIS_PLC_ID_TO_PLC_ID(i),ecStat);
-        axes[i]->execute(ecStat);        
+    if (axisHotState) {
+      // Inputs of all axes, threshold checks of all axes in one pass and
+      // then monitors (using the checks) and outputs
+      for (i = 0; i < axesExeCount; i++) {
+        plcs->execute(AXIS_PLC_ID_TO_PLC_ID(axesExeIds[i]),ecStat);
+        axesExe[i]->executeInputs(ecStat);
+      }
+      axisHotState->executeChecks();
+      for (i = 0; i < axesExeCount; i++) {
+        axesExe[i]->executeOutputs(ecStat);
+      }
+    } else {
+      for (i = 0; i < axesExeCount; i++) {
+        plcs->execute(AXIS_PLC_ID_TO_PLC_ID(axesExeIds[i]),ecStat);
+        axesExe[i]->execute(ecStat);
       }
     }
 
     // Data events
-    for (i = 0; i < ECMC_MAX_EVENT_OBJECTS; i++) {
-      if (events[i] != NULL) {
-        events[i]->execute(ecStat);
-      }
+    for (i = 0; i < eventsExeCount; i++) {
+      eventsExe[i]->execute(ecStat);
     }
 
     // Plugins
-    for (i = 0; i < ECMC_MAX_PLUGINS; i++) {
-      if (plugins[i] != NULL) {
-        pluginsError=plugins[i]->exeRTFunc(controllerError);
-      }
+    for (i = 0; i < pluginsExeCount; i++) {
+      pluginsError=pluginsExe[i]->exeRTFunc(controllerError);
     }
 
     // PLCs
@@ -337,21 +412,27 @@ void cyclic_task(void *usr) {
       plcs->execute(ecStat);
     }
 
+    // Data groups (snapshot and publish)
+    for (i = 0; i < ECMC_MAX_DATA_GROUPS; i++) {
+      if (dataGroups[i]) {
+        dataGroups[i]->execute();
+      }
+    }
+
     if (counter) {
       counter--;
     } else {    // Lower freq      
       if (axisDiagFreq > 0) {
         counter = mcuFrequency / axisDiagFreq;
-        if(ec->getInitDone()) {
+        // State checked in ec diagnostics thread if running
+        if(ec->getInitDone() && !ec->getDiagThreadRunning()) {
           ec->checkState();
           ec->checkSlavesConfState();
         }
         printStatus();
 
-        for (int i = 0; i < ECMC_MAX_AXES; i++) {
-          if (axes[i] != NULL) {
-            axes[i]->slowExecute();
-          }
+        for (int i = 0; i < axesExeCount; i++) {
+          axesExe[i]->slowExecute();
         }
         if(ec->getInitDone()) {
           ec->slowExecute();
@@ -360,6 +441,13 @@ void cyclic_task(void *usr) {
     }
     if(asynPort->getEpicsState()>=14){
       updateAsynParams(0);
+
+      // Masters in own threads (no asyn port lock there)
+      for (i = 1; i < ECMC_MAX_EC_MASTERS; i++) {
+        if (ecMasterThreads[i]) {
+          ecMasterThreads[i]->updateAsyn();
+        }
+      }
     }
     
     clock_gettime(CLOCK_MONOTONIC, &sendTime);
@@ -367,6 +455,7 @@ void cyclic_task(void *usr) {
       ec->send(masterActivationTimeOffset);
     }
     clock_gettime(CLOCK_MONOTONIC, &endTime);
+    ecmcRtGuard::exitCycle();
   }
   appModeStat = ECMC_MODE_CONFIG;
 }
@@ -392,7 +481,13 @@ int ecmcInitThread(void) {
     axes[i] = NULL;
   }
 
-  for (int i = 0; i < ECMC_MAX_EVENT_OBJECTS; i++) {
+  for (int i = 0; i < ECMC_MAX_AXIS_GROUPS; i++) {
+    axisGroups[i] = NULL;
+  }
+
+  delete[] events;
+  events = new ecmcEvent*[ecmcMaxEventObjects];
+  for (int i = 0; i < ecmcMaxEventObjects; i++) {
     events[i] = NULL;
   }
 
@@ -400,7 +495,9 @@ int ecmcInitThread(void) {
     dataRecorders[i] = NULL;
   }
 
-  for (int i = 0; i < ECMC_MAX_DATA_STORAGE_OBJECTS; i++) {
+  delete[] dataStorages;
+  dataStorages = new ecmcDataStorage*[ecmcMaxDataStorageObjects];
+  for (int i = 0; i < ecmcMaxDataStorageObjects; i++) {
     dataStorages[i] = NULL;
   }
 
@@ -495,6 +592,68 @@ int lockMem(int size) {
     return 0;
 }
 
+/* Build compact lists of the configured objects so that the realtime loop
+   only iterates objects that exist (instead of all slots). */
+int buildExecutionLists() {
+  LOGINFO4("%s/%s:%d\n", __FILE__, __FUNCTION__, __LINE__);
+
+  axesExeCount = 0;
+  for (int i = 0; i < ECMC_MAX_AXES; i++) {
+    if (axes[i] != NULL) {
+      axesExe[axesExeCount]    = axes[i];
+      axesExeIds[axesExeCount] = i;
+      axesExeCount++;
+    }
+  }
+
+  // Hot axis state (one slot per executed axis)
+  for (int i = 0; i < axesExeCount; i++) {
+    axesExe[i]->setHotState(NULL, 0);
+  }
+  delete axisHotState;
+  axisHotState = NULL;
+
+  if (axisHotStateEnable) {
+    axisHotState = new ecmcAxisHotState();
+    for (int i = 0; i < axesExeCount; i++) {
+      axesExe[i]->setHotState(axisHotState, axisHotState->addSlot());
+    }
+  }
+
+  axisGroupsExeCount = 0;
+  for (int i = 0; i < ECMC_MAX_AXIS_GROUPS; i++) {
+    if (axisGroups[i] != NULL) {
+      axisGroupsExe[axisGroupsExeCount] = axisGroups[i];
+      axisGroupsExeCount++;
+    }
+  }
+
+  delete[] eventsExe;
+  eventsExe      = new ecmcEvent*[ecmcMaxEventObjects];
+  eventsExeCount = 0;
+  for (int i = 0; i < ecmcMaxEventObjects; i++) {
+    if (events[i] != NULL) {
+      eventsExe[eventsExeCount] = events[i];
+      eventsExeCount++;
+    }
+  }
+
+  pluginsExeCount = 0;
+  for (int i = 0; i < ECMC_MAX_PLUGINS; i++) {
+    if (plugins[i] != NULL) {
+      pluginsExe[pluginsExeCount] = plugins[i];
+      pluginsExeCount++;
+    }
+  }
+
+  LOGINFO4("INFO:\t\tExecution lists: %d axes, %d axis groups, %d events, %d plugins.\n",
+           axesExeCount,
+           axisGroupsExeCount,
+           eventsExeCount,
+           pluginsExeCount);
+  return 0;
+}
+
 int startRTthread() {
   LOGINFO4("%s/%s:%d\n", __FILE__, __FUNCTION__, __LINE__);
   int prio = ECMC_PRIO_HIGH;
@@ -538,6 +697,12 @@ int setAppModeCfg(int mode) {
     asynPort->setAllowRtThreadCom(false);
   }
 
+  for (int i = 1; i < ECMC_MAX_EC_MASTERS; i++) {
+    if (ecMasterThreads[i]) {
+      ecMasterThreads[i]->stop();
+    }
+  }
+
   for (int i = 0; i < ECMC_MAX_AXES; i++) {
     if (axes[i] != NULL) {
       axes[i]->setRealTimeStarted(false);
@@ -565,6 +730,9 @@ int setAppModeRun(int mode) {
   // (since sleep in waitForThreadToStart())
   asynPort->setAllowRtThreadCom(false);
 
+  // Objects created from now on are allocated on heap
+  ecmcConfigArena::seal();
+
   appModeCmdOld = appModeCmd;
   appModeCmd    = (app_mode_type)mode;
 
@@ -586,6 +754,11 @@ int setAppModeRun(int mode) {
     return errorCode;
   }
 
+  errorCode = buildExecutionLists();
+  if (errorCode) {
+    return errorCode;
+  }
+
   // Plugins
   for(int i=0; i < ECMC_MAX_PLUGINS; ++i) {
     if(plugins[i]) {
@@ -617,6 +790,16 @@ int setAppModeRun(int mode) {
   if(errorCode) {
     return errorCode;
   }
+
+  // Additional masters in own threads
+  for (int i = 1; i < ECMC_MAX_EC_MASTERS; i++) {
+    if (ecMasterThreads[i]) {
+      errorCode = ecMasterThreads[i]->start();
+      if(errorCode) {
+        return errorCode;
+      }
+    }
+  }
   
   LOGINFO4("INFO:\t\tApplication in runtime mode.\n");
 
@@ -744,6 +927,142 @@ int setSamplePeriodMs(double samplePeriodMs) {
   return 0;
 }
 
+int setMaxEventObjects(int count) {
+  LOGINFO4("%s/%s:%d count=%d\n", __FILE__, __FUNCTION__, __LINE__, count);
+
+  if(count <= 0 || count > ECMC_MAX_OBJECTS_LIMIT) {
+    LOGERR(
+      "%s/%s:%d: Event object count out of range. Allowed range 1..%d. Count = %d (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      ECMC_MAX_OBJECTS_LIMIT,
+      count,
+      ERROR_MAIN_OBJECT_LIMIT_OUT_OF_RANGE);
+    return ERROR_MAIN_OBJECT_LIMIT_OUT_OF_RANGE;
+  }
+
+  for (int i = 0; i < ecmcMaxEventObjects; i++) {
+    if (events[i] != NULL) {
+      LOGERR(
+        "%s/%s:%d: Error: Change of max event object count is only allowed prior event creation (0x%x).\n",
+        __FILE__,
+        __FUNCTION__,
+        __LINE__,
+        ERROR_MAIN_OBJECT_LIMIT_CHANGE_NOT_ALLOWED);
+      return ERROR_MAIN_OBJECT_LIMIT_CHANGE_NOT_ALLOWED;
+    }
+  }
+
+  delete[] events;
+  ecmcMaxEventObjects = count;
+  events = new ecmcEvent*[ecmcMaxEventObjects];
+  for (int i = 0; i < ecmcMaxEventObjects; i++) {
+    events[i] = NULL;
+  }
+
+  return 0;
+}
+
+int setMaxDataStorageObjects(int count) {
+  LOGINFO4("%s/%s:%d count=%d\n", __FILE__, __FUNCTION__, __LINE__, count);
+
+  if(count <= 0 || count > ECMC_MAX_OBJECTS_LIMIT) {
+    LOGERR(
+      "%s/%s:%d: Data storage object count out of range. Allowed range 1..%d. Count = %d (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      ECMC_MAX_OBJECTS_LIMIT,
+      count,
+      ERROR_MAIN_OBJECT_LIMIT_OUT_OF_RANGE);
+    return ERROR_MAIN_OBJECT_LIMIT_OUT_OF_RANGE;
+  }
+
+  // PLCs keep own copies of the data storage pointers
+  bool changeAllowed = plcs == NULL;
+  for (int i = 0; i < ecmcMaxDataStorageObjects; i++) {
+    if (dataStorages[i] != NULL) {
+      changeAllowed = false;
+    }
+  }
+
+  if (!changeAllowed) {
+    LOGERR(
+      "%s/%s:%d: Error: Change of max data storage object count is only allowed prior data storage and PLC creation (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      ERROR_MAIN_OBJECT_LIMIT_CHANGE_NOT_ALLOWED);
+    return ERROR_MAIN_OBJECT_LIMIT_CHANGE_NOT_ALLOWED;
+  }
+
+  delete[] dataStorages;
+  ecmcMaxDataStorageObjects = count;
+  dataStorages = new ecmcDataStorage*[ecmcMaxDataStorageObjects];
+  for (int i = 0; i < ecmcMaxDataStorageObjects; i++) {
+    dataStorages[i] = NULL;
+  }
+
+  return 0;
+}
+
+int setEnableAxisMonitorBatch(int enable) {
+  LOGINFO4("%s/%s:%d enable=%d\n", __FILE__, __FUNCTION__, __LINE__, enable);
+
+  if (appModeStat == ECMC_MODE_RUNTIME) {
+    return ERROR_MAIN_APP_MODE_ALREADY_RUNTIME;
+  }
+
+  axisHotStateEnable = enable;
+  return 0;
+}
+
+int setRtGuardMode(int mode) {
+  LOGINFO4("%s/%s:%d mode=%d\n", __FILE__, __FUNCTION__, __LINE__, mode);
+
+  return ecmcRtGuard::setMode(mode);
+}
+
+int clearRtGuard() {
+  LOGINFO4("%s/%s:%d\n", __FILE__, __FUNCTION__, __LINE__);
+
+  ecmcRtGuard::clear();
+  return 0;
+}
+
+int reportRtGuard() {
+  LOGINFO4("%s/%s:%d\n", __FILE__, __FUNCTION__, __LINE__);
+
+  ecmcRtGuard::report();
+  return 0;
+}
+
+int setEnableConfigArena(int enable) {
+  LOGINFO4("%s/%s:%d enable=%d\n", __FILE__, __FUNCTION__, __LINE__, enable);
+
+  if (appModeStat == ECMC_MODE_RUNTIME) {
+    return ERROR_MAIN_APP_MODE_ALREADY_RUNTIME;
+  }
+
+  ecmcConfigArena::setEnable(enable);
+  return 0;
+}
+
+int reportConfigArena() {
+  LOGINFO4("%s/%s:%d\n", __FILE__, __FUNCTION__, __LINE__);
+
+  ecmcConfigArena::report();
+  return 0;
+}
+
+int getRtGuardCount(int *count) {
+  LOGINFO4("%s/%s:%d\n", __FILE__, __FUNCTION__, __LINE__);
+
+  *count = (int)ecmcRtGuard::getTotalCount();
+  return 0;
+}
+
 int validateConfig() {
   LOGINFO4("%s/%s:%d\n", __FILE__, __FUNCTION__, __LINE__);
 
@@ -770,7 +1089,20 @@ int validateConfig() {
     }
   }
 
-  for (int i = 0; i < ECMC_MAX_EVENT_OBJECTS; i++) {
+  for (int i = 0; i < ECMC_MAX_AXIS_GROUPS; i++) {
+    if (axisGroups[i] != NULL) {
+      errorCode = axisGroups[i]->validate();
+
+      if (errorCode) {
+        LOGERR("ERROR: Validation failed on axis group %d with error code %x.",
+               i,
+               errorCode);
+        return errorCode;
+      }
+    }
+  }
+
+  for (int i = 0; i < ecmcMaxEventObjects; i++) {
     if (events[i] != NULL) {
       errorCode = events[i]->validate();
 
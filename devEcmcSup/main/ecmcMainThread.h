@@ -97,6 +97,126 @@ int setSampleRate(double sampleRate);
  */
 int setSamplePeriodMs(double samplePeriodMs);
 
+/** \brief Set max number of event objects
+ *  Only allowed to be changed prior any event object creation.\n
+ *
+ * \param[in] count  Max number of event objects (defaults to 10).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Allow 50 event objects.\n
+ * "Cfg.SetMaxEventObjects(50)" //Command string to ecmcCmdParser.c
+ */
+int setMaxEventObjects(int count);
+
+/** \brief Set max number of data storage objects
+ *  Only allowed to be changed prior any data storage or PLC object creation.\n
+ *
+ * \param[in] count  Max number of data storage objects (defaults to 32).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Allow 500 data storage objects.\n
+ * "Cfg.SetMaxDataStorageObjects(500)" //Command string to ecmcCmdParser.c
+ */
+int setMaxDataStorageObjects(int count);
+
+/** \brief Evaluate monitor threshold checks of all axes in one batch
+ *
+ *  The at target, position lag, max velocity, velocity difference and
+ *  controller output checks are evaluated for all axes in one pass over
+ *  contiguous arrays. Axis execution is split: first inputs and setpoints
+ *  of all axes (including axis PLCs), then the batch checks and then
+ *  monitors and outputs of all axes. The monitors use the result in the
+ *  same cycle. Only allowed in configuration mode.\n
+ *
+ * \param[in] enable  Enable batch (defaults to 0).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Enable batched monitor checks.\n
+ * "Cfg.SetEnableAxisMonitorBatch(1)" //Command string to ecmcCmdParser.c
+ */
+int setEnableAxisMonitorBatch(int enable);
+
+/** \brief Set mode of realtime guard
+ *
+ *  Counts calls to malloc(), calloc(), realloc(), free() and selected
+ *  libc functions (open, fopen, read, write, close, printouts and sleeps)
+ *  made by the realtime thread during a cycle. Only takes effect if
+ *  ecmc is built with ECMC_RT_GUARD_INTERPOSE=YES and libecmc is
+ *  preloaded (LD_PRELOAD) or linked into the IOC, see ecmcRtGuard.
+ *  Otherwise modes other than 0 return an error.\n
+ *
+ * \param[in] mode  Guard mode:\n
+ *                    0 = Off (default).\n
+ *                    1 = Count calls.\n
+ *                    2 = Count calls and record backtraces.\n
+ *                    3 = Print backtrace and abort on first call (tests).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Record backtraces of guarded calls.\n
+ * "Cfg.SetRtGuardMode(2)" //Command string to ecmcCmdParser.c
+ */
+int setRtGuardMode(int mode);
+
+/** \brief Clear counters and backtraces of realtime guard
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Clear realtime guard.\n
+ * "Cfg.ClearRtGuard()" //Command string to ecmcCmdParser.c
+ */
+int clearRtGuard();
+
+/** \brief Print counters and recorded backtraces of realtime guard
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Print realtime guard report.\n
+ * "Cfg.ReportRtGuard()" //Command string to ecmcCmdParser.c
+ */
+int reportRtGuard();
+
+/** \brief Get number of guarded calls made in realtime cycles
+ *
+ * \param[out] count  Number of calls.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Get realtime guard count.\n
+ * "GetRtGuardCount()" //Command string to ecmcCmdParser.c
+ */
+int getRtGuardCount(int *count);
+
+/** \brief Enable arena for objects created during configuration
+ *
+ *  EtherCAT slaves, pdos, entries and asyn data items are placed
+ *  contiguously in large chunks in the order they are created (which is
+ *  the order the realtime loop walks them). The arena is released when
+ *  ecmc exits. Objects created after entering runtime are allocated on
+ *  heap. Only allowed in configuration mode, only affects objects created
+ *  after the call.\n
+ *
+ * \param[in] enable  Enable arena (defaults to 1).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Disable arena (for instance for memory debug tools).\n
+ * "Cfg.SetEnableConfigArena(0)" //Command string to ecmcCmdParser.c
+ */
+int setEnableConfigArena(int enable);
+
+/** \brief Print memory footprint of configuration arena
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Print arena footprint.\n
+ * "Cfg.ReportConfigArena()" //Command string to ecmcCmdParser.c
+ */
+int reportConfigArena();
+
 /** \brief Update main asyn parameters
  *
  * \param[in] force Force update\n
@@ -0,0 +1,610 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcRtGuard.cpp
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#include "ecmcRtGuard.h"
+#include <dlfcn.h>
+#include <errno.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ecmcErrorsList.h"
+
+/* Static tls model: dynamic tls access may allocate on first access in
+   a thread which would recurse into malloc() */
+#define ECMC_RT_GUARD_TLS __attribute__((tls_model("initial-exec")))
+
+static int      guardMode                           = ECMC_RT_GUARD_OFF;
+static uint32_t guardCounts[ECMC_RT_GUARD_CALL_COUNT] = {};
+
+// Ring (producers reserve slots with atomic increment)
+static ecmcRtGuardEntry guardRing[ECMC_RT_GUARD_RING_SIZE] = {};
+static uint32_t         guardRingWriteCount                = 0;
+
+// Set while the realtime thread executes a cycle
+static __thread int      guardInCycle ECMC_RT_GUARD_TLS = 0;
+static __thread uint64_t guardCycle ECMC_RT_GUARD_TLS   = 0;
+
+// Set while a hit is handled (calls from backtrace() are not counted)
+static __thread int guardBusy ECMC_RT_GUARD_TLS = 0;
+
+static const char *guardCallNames[ECMC_RT_GUARD_CALL_COUNT] = {
+  "malloc",
+  "calloc",
+  "realloc",
+  "free",
+  "open",
+  "fopen",
+  "read",
+  "write",
+  "close",
+  "printf",
+  "sleep",
+};
+
+int ecmcRtGuard::setMode(int mode) {
+  if ((mode < ECMC_RT_GUARD_OFF) || (mode > ECMC_RT_GUARD_ABORT)) {
+    return ERROR_MAIN_RT_GUARD_MODE_OUT_OF_RANGE;
+  }
+
+#ifndef ECMC_RT_GUARD_INTERPOSE
+  // Nothing would be counted without the interposed functions
+  if (mode != ECMC_RT_GUARD_OFF) {
+    return ERROR_MAIN_RT_GUARD_NOT_BUILT;
+  }
+#endif  // ECMC_RT_GUARD_INTERPOSE
+
+  // First backtrace() loads libgcc, do it here instead of in realtime
+  if (mode >= ECMC_RT_GUARD_BACKTRACE) {
+    void *frame[1];
+    backtrace(frame, 1);
+  }
+
+  __atomic_store_n(&guardMode, mode, __ATOMIC_RELEASE);
+  return 0;
+}
+
+int ecmcRtGuard::getMode() {
+  return __atomic_load_n(&guardMode, __ATOMIC_RELAXED);
+}
+
+/* Not realtime (entries written meanwhile might be lost) */
+void ecmcRtGuard::clear() {
+  for (int i = 0; i < ECMC_RT_GUARD_CALL_COUNT; i++) {
+    __atomic_store_n(&guardCounts[i], 0, __ATOMIC_RELAXED);
+  }
+
+  for (int i = 0; i < ECMC_RT_GUARD_RING_SIZE; i++) {
+    __atomic_store_n(&guardRing[i].sequence, 0, __ATOMIC_RELEASE);
+  }
+  __atomic_store_n(&guardRingWriteCount, 0, __ATOMIC_RELEASE);
+}
+
+void ecmcRtGuard::enterCycle(uint64_t cycle) {
+  guardCycle   = cycle;
+  guardInCycle = 1;
+}
+
+void ecmcRtGuard::exitCycle() {
+  guardInCycle = 0;
+}
+
+bool ecmcRtGuard::active() {
+  return guardInCycle && !guardBusy &&
+         __atomic_load_n(&guardMode, __ATOMIC_RELAXED) != ECMC_RT_GUARD_OFF;
+}
+
+void ecmcRtGuard::hit(ecmcRtGuardCall call) {
+  guardBusy = 1;
+  __atomic_add_fetch(&guardCounts[call], 1, __ATOMIC_RELAXED);
+
+  int mode = getMode();
+
+  if (mode < ECMC_RT_GUARD_BACKTRACE) {
+    guardBusy = 0;
+    return;
+  }
+
+  uint32_t seq = __atomic_fetch_add(&guardRingWriteCount, 1,
+                                    __ATOMIC_ACQ_REL);
+  ecmcRtGuardEntry *entry = &guardRing[seq % ECMC_RT_GUARD_RING_SIZE];
+
+  // Invalidate while writing
+  __atomic_store_n(&entry->sequence, 0, __ATOMIC_RELEASE);
+  entry->call   = call;
+  entry->cycle  = guardCycle;
+  entry->frames = backtrace(entry->frame, ECMC_RT_GUARD_MAX_FRAMES);
+  __atomic_store_n(&entry->sequence, seq + 1, __ATOMIC_RELEASE);
+
+  if (mode == ECMC_RT_GUARD_ABORT) {
+    // Unbuffered (might be inside malloc())
+    const char *name = guardCallNames[call];
+    dprintf(STDERR_FILENO,
+            "ecmcRtGuard: %s() called in realtime cycle. Abort.\n",
+            name);
+    backtrace_symbols_fd(entry->frame, entry->frames, STDERR_FILENO);
+    abort();
+  }
+  guardBusy = 0;
+}
+
+uint32_t ecmcRtGuard::getCount(ecmcRtGuardCall call) {
+  if ((call < 0) || (call >= ECMC_RT_GUARD_CALL_COUNT)) {
+    return 0;
+  }
+  return __atomic_load_n(&guardCounts[call], __ATOMIC_RELAXED);
+}
+
+uint32_t ecmcRtGuard::getTotalCount() {
+  uint32_t total = 0;
+
+  for (int i = 0; i < ECMC_RT_GUARD_CALL_COUNT; i++) {
+    total += __atomic_load_n(&guardCounts[i], __ATOMIC_RELAXED);
+  }
+  return total;
+}
+
+const char * ecmcRtGuard::getCallName(int call) {
+  if ((call < 0) || (call >= ECMC_RT_GUARD_CALL_COUNT)) {
+    return "unknown";
+  }
+  return guardCallNames[call];
+}
+
+size_t ecmcRtGuard::getEntries(ecmcRtGuardEntry *buffer,
+                               size_t            entries) {
+  uint32_t count = __atomic_load_n(&guardRingWriteCount, __ATOMIC_ACQUIRE);
+  uint32_t first = 0;
+  size_t   used  = 0;
+
+  if (count > ECMC_RT_GUARD_RING_SIZE) {
+    first = count - ECMC_RT_GUARD_RING_SIZE;
+  }
+
+  if (count - first > entries) {
+    first = count - entries;
+  }
+
+  for (uint32_t seq = first; seq != count; seq++) {
+    ecmcRtGuardEntry *entry = &guardRing[seq % ECMC_RT_GUARD_RING_SIZE];
+    buffer[used] = *entry;
+
+    // Skip entries being written or already overwritten
+    if ((buffer[used].sequence != seq + 1) ||
+        (__atomic_load_n(&entry->sequence, __ATOMIC_ACQUIRE) != seq + 1)) {
+      continue;
+    }
+    used++;
+  }
+  return used;
+}
+
+void ecmcRtGuard::report() {
+  static ecmcRtGuardEntry entries[ECMC_RT_GUARD_RING_SIZE];
+
+  printf("ecmcRtGuard: mode %d, %u calls in realtime cycles.\n",
+         getMode(),
+         getTotalCount());
+
+  for (int i = 0; i < ECMC_RT_GUARD_CALL_COUNT; i++) {
+    uint32_t count = getCount((ecmcRtGuardCall)i);
+
+    if (count) {
+      printf("  %-8s %u\n", guardCallNames[i], count);
+    }
+  }
+
+  size_t used = getEntries(entries, ECMC_RT_GUARD_RING_SIZE);
+
+  for (size_t i = 0; i < used; i++) {
+    printf("Call %u: %s() in cycle %llu:\n",
+           entries[i].sequence,
+           getCallName(entries[i].call),
+           (unsigned long long)entries[i].cycle);
+    fflush(stdout);
+    backtrace_symbols_fd(entries[i].frame, entries[i].frames, STDOUT_FILENO);
+  }
+  fflush(stdout);
+}
+
+/****************************************************************************/
+// Interposed libc functions (only built with ECMC_RT_GUARD_INTERPOSE=YES,
+// otherwise allocations and io of the process are not affected)
+#ifdef ECMC_RT_GUARD_INTERPOSE
+
+// glibc allocator entry points (no dlsym() needed, no recursion)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t nmemb,
+                    size_t size);
+void* __libc_realloc(void  *ptr,
+                     size_t size);
+void  __libc_free(void *ptr);
+void* __libc_memalign(size_t alignment,
+                      size_t size);
+}
+
+// Real libc functions (resolved on first use)
+typedef int (*ecmcOpenFunc)(const char *,
+                            int,
+                            ...);
+typedef FILE *(*ecmcFopenFunc)(const char *,
+                               const char *);
+typedef ssize_t (*ecmcReadFunc)(int,
+                                void *,
+                                size_t);
+typedef ssize_t (*ecmcWriteFunc)(int,
+                                 const void *,
+                                 size_t);
+typedef int (*ecmcOpenatFunc)(int,
+                              const char *,
+                              int,
+                              ...);
+typedef int (*ecmcCloseFunc)(int);
+typedef size_t (*ecmcFwriteFunc)(const void *,
+                                 size_t,
+                                 size_t,
+                                 FILE *);
+typedef int (*ecmcVfprintfFunc)(FILE *,
+                                const char *,
+                                va_list);
+typedef int (*ecmcVfprintfChkFunc)(FILE *,
+                                   int,
+                                   const char *,
+                                   va_list);
+typedef int (*ecmcPutsFunc)(const char *);
+typedef int (*ecmcFputsFunc)(const char *,
+                             FILE *);
+typedef int (*ecmcNanosleepFunc)(const struct timespec *,
+                                 struct timespec *);
+typedef int (*ecmcUsleepFunc)(useconds_t);
+
+static ecmcOpenFunc        realOpen        = NULL;
+static ecmcOpenFunc        realOpen64      = NULL;
+static ecmcOpenatFunc      realOpenat      = NULL;
+static ecmcFopenFunc       realFopen       = NULL;
+static ecmcFopenFunc       realFopen64     = NULL;
+static ecmcReadFunc        realRead        = NULL;
+static ecmcWriteFunc       realWrite       = NULL;
+static ecmcFwriteFunc      realFwrite      = NULL;
+static ecmcCloseFunc       realClose       = NULL;
+static ecmcVfprintfFunc    realVfprintf    = NULL;
+static ecmcVfprintfChkFunc realVfprintfChk = NULL;
+static ecmcPutsFunc        realPuts        = NULL;
+static ecmcFputsFunc       realFputs       = NULL;
+static ecmcNanosleepFunc   realNanosleep   = NULL;
+static ecmcUsleepFunc      realUsleep      = NULL;
+
+template<typename T>
+static T resolve(T *func, const char *name) {
+  if (*func == NULL) {
+    *func = (T)dlsym(RTLD_NEXT, name);
+  }
+  return *func;
+}
+
+
+extern "C" {
+void* malloc(size_t size) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_MALLOC);
+  }
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t nmemb, size_t size) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_CALLOC);
+  }
+  return __libc_calloc(nmemb, size);
+}
+
+void* realloc(void *ptr, size_t size) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_REALLOC);
+  }
+  return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) {
+  if (ptr && ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_FREE);
+  }
+  __libc_free(ptr);
+}
+
+int posix_memalign(void **memptr, size_t alignment, size_t size) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_MALLOC);
+  }
+
+  if ((alignment % sizeof(void *)) || (alignment & (alignment - 1)) ||
+      (alignment == 0)) {
+    return EINVAL;
+  }
+
+  void *ptr = __libc_memalign(alignment, size);
+
+  if (!ptr) {
+    return ENOMEM;
+  }
+  *memptr = ptr;
+  return 0;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_MALLOC);
+  }
+  return __libc_memalign(alignment, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_MALLOC);
+  }
+  return __libc_memalign(alignment, size);
+}
+
+int open(const char *pathname, int flags, ...) {
+  mode_t mode = 0;
+
+  if (flags & (O_CREAT | O_TMPFILE)) {
+    va_list args;
+    va_start(args, flags);
+    mode = va_arg(args, mode_t);
+    va_end(args);
+  }
+
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_OPEN);
+  }
+
+  if (!resolve(&realOpen, "open")) {
+    errno = ENOSYS;
+    return -1;
+  }
+  return realOpen(pathname, flags, mode);
+}
+
+int open64(const char *pathname, int flags, ...) {
+  mode_t mode = 0;
+
+  if (flags & (O_CREAT | O_TMPFILE)) {
+    va_list args;
+    va_start(args, flags);
+    mode = va_arg(args, mode_t);
+    va_end(args);
+  }
+
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_OPEN);
+  }
+
+  if (!resolve(&realOpen64, "open64")) {
+    errno = ENOSYS;
+    return -1;
+  }
+  return realOpen64(pathname, flags, mode);
+}
+
+int openat(int dirfd, const char *pathname, int flags, ...) {
+  mode_t mode = 0;
+
+  if (flags & (O_CREAT | O_TMPFILE)) {
+    va_list args;
+    va_start(args, flags);
+    mode = va_arg(args, mode_t);
+    va_end(args);
+  }
+
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_OPEN);
+  }
+
+  if (!resolve(&realOpenat, "openat")) {
+    errno = ENOSYS;
+    return -1;
+  }
+  return realOpenat(dirfd, pathname, flags, mode);
+}
+
+FILE* fopen(const char *pathname, const char *mode) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_FOPEN);
+  }
+
+  if (!resolve(&realFopen, "fopen")) {
+    errno = ENOSYS;
+    return NULL;
+  }
+  return realFopen(pathname, mode);
+}
+
+FILE* fopen64(const char *pathname, const char *mode) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_FOPEN);
+  }
+
+  if (!resolve(&realFopen64, "fopen64")) {
+    errno = ENOSYS;
+    return NULL;
+  }
+  return realFopen64(pathname, mode);
+}
+
+ssize_t read(int fd, void *buf, size_t count) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_READ);
+  }
+
+  if (!resolve(&realRead, "read")) {
+    errno = ENOSYS;
+    return -1;
+  }
+  return realRead(fd, buf, count);
+}
+
+ssize_t write(int fd, const void *buf, size_t count) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_WRITE);
+  }
+
+  if (!resolve(&realWrite, "write")) {
+    errno = ENOSYS;
+    return -1;
+  }
+  return realWrite(fd, buf, count);
+}
+
+size_t fwrite(const void *ptr, size_t size, size_t nmemb, FILE *stream) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_WRITE);
+  }
+
+  if (!resolve(&realFwrite, "fwrite")) {
+    errno = ENOSYS;
+    return 0;
+  }
+  return realFwrite(ptr, size, nmemb, stream);
+}
+
+int close(int fd) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_CLOSE);
+  }
+
+  if (!resolve(&realClose, "close")) {
+    errno = ENOSYS;
+    return -1;
+  }
+  return realClose(fd);
+}
+
+int vfprintf(FILE *stream, const char *format, va_list ap) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_PRINTF);
+  }
+
+  if (!resolve(&realVfprintf, "vfprintf")) {
+    errno = ENOSYS;
+    return -1;
+  }
+  return realVfprintf(stream, format, ap);
+}
+
+int fprintf(FILE *stream, const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  int ret = vfprintf(stream, format, args);
+  va_end(args);
+  return ret;
+}
+
+int printf(const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  int ret = vfprintf(stdout, format, args);
+  va_end(args);
+  return ret;
+}
+
+int vprintf(const char *format, va_list ap) {
+  return vfprintf(stdout, format, ap);
+}
+
+// Fortified variants (_FORTIFY_SOURCE)
+int __vfprintf_chk(FILE *stream, int flag, const char *format, va_list ap) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_PRINTF);
+  }
+
+  if (!resolve(&realVfprintfChk, "__vfprintf_chk")) {
+    errno = ENOSYS;
+    return -1;
+  }
+  return realVfprintfChk(stream, flag, format, ap);
+}
+
+int __vprintf_chk(int flag, const char *format, va_list ap) {
+  return __vfprintf_chk(stdout, flag, format, ap);
+}
+
+int __fprintf_chk(FILE *stream, int flag, const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  int ret = __vfprintf_chk(stream, flag, format, args);
+  va_end(args);
+  return ret;
+}
+
+int __printf_chk(int flag, const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  int ret = __vfprintf_chk(stdout, flag, format, args);
+  va_end(args);
+  return ret;
+}
+
+int puts(const char *s) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_PRINTF);
+  }
+
+  if (!resolve(&realPuts, "puts")) {
+    errno = ENOSYS;
+    return EOF;
+  }
+  return realPuts(s);
+}
+
+int fputs(const char *s, FILE *stream) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_PRINTF);
+  }
+
+  if (!resolve(&realFputs, "fputs")) {
+    errno = ENOSYS;
+    return EOF;
+  }
+  return realFputs(s, stream);
+}
+
+int nanosleep(const struct timespec *req, struct timespec *rem) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_SLEEP);
+  }
+
+  if (!resolve(&realNanosleep, "nanosleep")) {
+    errno = ENOSYS;
+    return -1;
+  }
+  return realNanosleep(req, rem);
+}
+
+int usleep(useconds_t usec) {
+  if (ecmcRtGuard::active()) {
+    ecmcRtGuard::hit(ECMC_RT_GUARD_CALL_SLEEP);
+  }
+
+  if (!resolve(&realUsleep, "usleep")) {
+    errno = ENOSYS;
+    return -1;
+  }
+  return realUsleep(usec);
+}
+}
+#endif  // ECMC_RT_GUARD_INTERPOSE
@@ -0,0 +1,111 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcRtGuard.h
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#ifndef ECMCRTGUARD_H_
+#define ECMCRTGUARD_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+enum ecmcRtGuardMode {
+  ECMC_RT_GUARD_OFF       = 0,  // No checks
+  ECMC_RT_GUARD_COUNT     = 1,  // Count calls
+  ECMC_RT_GUARD_BACKTRACE = 2,  // Count calls and record backtraces
+  ECMC_RT_GUARD_ABORT     = 3,  // Print backtrace and abort (tests)
+};
+
+// Guarded calls
+enum ecmcRtGuardCall {
+  ECMC_RT_GUARD_CALL_MALLOC   = 0,   // malloc, posix_memalign,
+                                     // aligned_alloc, memalign
+  ECMC_RT_GUARD_CALL_CALLOC   = 1,
+  ECMC_RT_GUARD_CALL_REALLOC  = 2,
+  ECMC_RT_GUARD_CALL_FREE     = 3,
+  ECMC_RT_GUARD_CALL_OPEN     = 4,   // open, open64, openat
+  ECMC_RT_GUARD_CALL_FOPEN    = 5,   // fopen, fopen64
+  ECMC_RT_GUARD_CALL_READ     = 6,
+  ECMC_RT_GUARD_CALL_WRITE    = 7,   // write, fwrite
+  ECMC_RT_GUARD_CALL_CLOSE    = 8,
+  ECMC_RT_GUARD_CALL_PRINTF   = 9,   // printf, fprintf, vprintf, vfprintf,
+                                     // puts, fputs and the fortified
+                                     // __*printf_chk variants
+  ECMC_RT_GUARD_CALL_SLEEP    = 10,  // nanosleep, usleep
+  ECMC_RT_GUARD_CALL_COUNT    = 11,
+};
+
+// Backtrace ring
+#define ECMC_RT_GUARD_RING_SIZE 64
+#define ECMC_RT_GUARD_MAX_FRAMES 16
+
+typedef struct {
+  uint32_t sequence;  // Running number (entry valid if > 0)
+  int32_t  call;      // ecmcRtGuardCall
+  uint64_t cycle;     // Realtime cycle counter
+  int32_t  frames;
+  void    *frame[ECMC_RT_GUARD_MAX_FRAMES];
+} ecmcRtGuardEntry;
+
+/**
+ * \class ecmcRtGuard
+ *
+ * \brief Detection of allocations and blocking libc calls in the realtime
+ *  loop
+ *
+ * malloc(), calloc(), realloc(), free(), the aligned allocators and a
+ * few libc calls (file io, stdio printouts and sleeps) are interposed.
+ * Only the calls listed in ecmcRtGuardCall are covered, other libc calls
+ * (for instance fread(), mmap(), openat64() or direct syscalls) are not
+ * detected. While the realtime thread is
+ * inside a cycle (between enterCycle() and exitCycle()) and the guard is
+ * enabled, each call is counted per call type. In backtrace mode the call
+ * site backtrace is also stored in a lock free ring that can be printed
+ * later from a non realtime thread (report()). In abort mode the backtrace
+ * is printed and the process is aborted on the first call (for tests).
+ *
+ * All other threads only pay for a thread local flag check.
+ *
+ * The interposed functions are only built with ECMC_RT_GUARD_INTERPOSE=YES
+ * (make option, off by default). Otherwise setMode() only accepts off.
+ *
+ * Note: The interposed symbols only take effect if libecmc is in the
+ * global symbol scope before libc, for instance if preloaded:
+ *  LD_PRELOAD=<path>/libecmc.so
+ * When loaded with dlopen() (require) calls resolve directly to libc and
+ * nothing is counted.
+ */
+class ecmcRtGuard {
+ public:
+  static int  setMode(int mode);
+  static int  getMode();
+  static void clear();
+
+  // Realtime thread only
+  static void enterCycle(uint64_t cycle);
+  static void exitCycle();
+
+  // From interposed functions
+  static bool active();
+  static void hit(ecmcRtGuardCall call);
+
+  static uint32_t getCount(ecmcRtGuardCall call);
+  static uint32_t getTotalCount();
+  static const char* getCallName(int call);
+
+  // Copy ring (oldest first) to buffer, returns number of entries
+  static size_t getEntries(ecmcRtGuardEntry *buffer,
+                           size_t            entries);
+
+  // Print counters and recorded backtraces (non realtime)
+  static void report();
+};
+
+#endif  /* ECMCRTGUARD_H_ */
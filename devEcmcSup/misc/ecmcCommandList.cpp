@@ -16,6 +16,7 @@ ecmcCommandList::ecmcCommandList(int index) {
   PRINT_ERROR_PATH("commandList[%d].error", index);
   initVars();
   index_ = index;
+  registerErrorObject(ECMC_ERROR_OBJ_COMMAND_LIST, index);
   LOGINFO8("%s/%s:%d: commandList[%d]=new;\n",
            __FILE__,
            __FUNCTION__,
@@ -0,0 +1,327 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcDataGroup.cpp
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#include "ecmcDataGroup.h"
+#include "../main/ecmcErrorsList.h"
+#include <string.h>
+#include <stdio.h>
+
+// First element of item converted to double
+static double readItemValue(const ecmcDataItemInfo *item) {
+  if (!item->dataPointerValid || !item->data) {
+    return 0;
+  }
+
+  const uint8_t *data = item->data;
+
+  switch (item->dataType) {
+  case ECMC_EC_B1:
+  case ECMC_EC_B2:
+  case ECMC_EC_B3:
+  case ECMC_EC_B4:
+  case ECMC_EC_U8:
+    return (double)*(const uint8_t *)data;
+
+  case ECMC_EC_S8:
+    return (double)*(const int8_t *)data;
+
+  case ECMC_EC_U16:
+    return (double)*(const uint16_t *)data;
+
+  case ECMC_EC_S16:
+    return (double)*(const int16_t *)data;
+
+  case ECMC_EC_U32:
+    return (double)*(const uint32_t *)data;
+
+  case ECMC_EC_S32:
+    return (double)*(const int32_t *)data;
+
+  case ECMC_EC_U64:
+    return (double)*(const uint64_t *)data;
+
+  case ECMC_EC_S64:
+    return (double)*(const int64_t *)data;
+
+  case ECMC_EC_F32:
+    return (double)*(const float *)data;
+
+  case ECMC_EC_F64:
+    return *(const double *)data;
+
+  default:
+    return 0;
+  }
+}
+
+ecmcDataGroup::ecmcDataGroup(ecmcAsynPortDriver *asynPortDriver,
+                             int                 index,
+                             int                 publishCycles) {
+  asynPortDriver_  = asynPortDriver;
+  index_           = index;
+  publishCycles_   = publishCycles > 0 ? publishCycles : 1;
+  cycleCounter_    = 0;
+  itemCount_       = 0;
+  sequence_        = 0;
+  namesLength_     = 0;
+  namesDirty_      = true;
+  valuesAsynParam_ = NULL;
+  namesAsynParam_  = NULL;
+  countAsynParam_  = NULL;
+  memset(items_, 0, sizeof(items_));
+  values_ = new double[ECMC_DATA_GROUP_MAX_ITEMS];
+  memset(values_, 0, sizeof(double) * ECMC_DATA_GROUP_MAX_ITEMS);
+  names_ = new char[ECMC_DATA_GROUP_NAMES_SIZE];
+  memset(names_, 0, ECMC_DATA_GROUP_NAMES_SIZE);
+
+  int errorCode = initAsyn();
+  if (errorCode) {
+    setErrorID(__FILE__, __FUNCTION__, __LINE__, errorCode);
+  }
+}
+
+ecmcDataGroup::~ecmcDataGroup() {
+  delete[] values_;
+  values_ = NULL;
+  delete[] names_;
+  names_ = NULL;
+}
+
+int ecmcDataGroup::initAsyn() {
+  char buffer[EC_MAX_OBJECT_PATH_CHAR_LENGTH];
+  unsigned int charCount = 0;
+
+  // "dg%d.values"
+  charCount = snprintf(buffer,
+                       sizeof(buffer),
+                       ECMC_DATA_GROUP_STR "%d." ECMC_DATA_GROUP_VALUES_STR,
+                       index_);
+
+  if (charCount >= sizeof(buffer) - 1) {
+    return ERROR_DATA_GROUP_ASYN_PARAM_REGISTER_FAIL;
+  }
+
+  valuesAsynParam_ = asynPortDriver_->addNewAvailParam(buffer,
+                                    asynParamFloat64Array,
+                                    (uint8_t *)values_,
+                                    ECMC_DATA_GROUP_MAX_ITEMS * sizeof(double),
+                                    ECMC_EC_F64,
+                                    0);
+
+  if (!valuesAsynParam_) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      buffer);
+    return ERROR_MAIN_ASYN_CREATE_PARAM_FAIL;
+  }
+  valuesAsynParam_->setAllowWriteToEcmc(false);
+  valuesAsynParam_->refreshParam(1, (size_t)0);
+
+  // "dg%d.names"
+  charCount = snprintf(buffer,
+                       sizeof(buffer),
+                       ECMC_DATA_GROUP_STR "%d." ECMC_DATA_GROUP_NAMES_STR,
+                       index_);
+
+  if (charCount >= sizeof(buffer) - 1) {
+    return ERROR_DATA_GROUP_ASYN_PARAM_REGISTER_FAIL;
+  }
+
+  namesAsynParam_ = asynPortDriver_->addNewAvailParam(buffer,
+                                    asynParamInt8Array,
+                                    (uint8_t *)names_,
+                                    ECMC_DATA_GROUP_NAMES_SIZE,
+                                    ECMC_EC_U8,
+                                    0);
+
+  if (!namesAsynParam_) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      buffer);
+    return ERROR_MAIN_ASYN_CREATE_PARAM_FAIL;
+  }
+  namesAsynParam_->setAllowWriteToEcmc(false);
+  namesAsynParam_->refreshParam(1, (size_t)1);
+
+  // "dg%d.count"
+  charCount = snprintf(buffer,
+                       sizeof(buffer),
+                       ECMC_DATA_GROUP_STR "%d." ECMC_DATA_GROUP_COUNT_STR,
+                       index_);
+
+  if (charCount >= sizeof(buffer) - 1) {
+    return ERROR_DATA_GROUP_ASYN_PARAM_REGISTER_FAIL;
+  }
+
+  countAsynParam_ = asynPortDriver_->addNewAvailParam(buffer,
+                                    asynParamInt32,
+                                    (uint8_t *)&itemCount_,
+                                    sizeof(itemCount_),
+                                    ECMC_EC_S32,
+                                    0);
+
+  if (!countAsynParam_) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      buffer);
+    return ERROR_MAIN_ASYN_CREATE_PARAM_FAIL;
+  }
+  countAsynParam_->setAllowWriteToEcmc(false);
+  countAsynParam_->refreshParam(1);
+  return 0;
+}
+
+int ecmcDataGroup::addItem(const char *name) {
+  if (itemCount_ >= ECMC_DATA_GROUP_MAX_ITEMS) {
+    LOGERR("%s/%s:%d: ERROR: Data group %d full (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           index_,
+           ERROR_DATA_GROUP_FULL);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_DATA_GROUP_FULL);
+  }
+
+  ecmcDataItem *dataItem = asynPortDriver_->findAvailDataItem(name);
+
+  if (!dataItem) {
+    LOGERR("%s/%s:%d: ERROR: Data item %s not found (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           name,
+           ERROR_DATA_GROUP_ITEM_NULL);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_DATA_GROUP_ITEM_NULL);
+  }
+
+  if (dataItem->getEcmcDataType() == ECMC_EC_NONE) {
+    LOGERR("%s/%s:%d: ERROR: Data item %s has no numeric data type (0x%x).\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           name,
+           ERROR_DATA_GROUP_ITEM_NOT_VALID);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_DATA_GROUP_ITEM_NOT_VALID);
+  }
+
+  // Comma separated, same order as values
+  size_t length = strlen(name) + (itemCount_ > 0 ? 1 : 0);
+
+  if (namesLength_ + length >= ECMC_DATA_GROUP_NAMES_SIZE) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_DATA_GROUP_NAMES_FULL);
+  }
+
+  if (itemCount_ > 0) {
+    names_[namesLength_++] = ',';
+  }
+  strcpy(&names_[namesLength_], name);
+  namesLength_ += strlen(name);
+
+  items_[itemCount_++] = dataItem->getDataItemInfo();
+  namesDirty_ = true;
+  return 0;
+}
+
+int ecmcDataGroup::getItemCount() {
+  return itemCount_;
+}
+
+int ecmcDataGroup::setPublishCycles(int cycles) {
+  if (cycles < 1) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_DATA_GROUP_PERIOD_OUT_OF_RANGE);
+  }
+  publishCycles_ = cycles;
+  return 0;
+}
+
+void ecmcDataGroup::takeSnapshot() {
+  uint32_t seq = sequence_;
+
+  __atomic_store_n(&sequence_, seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  for (int i = 0; i < itemCount_; i++) {
+    values_[i] = readItemValue(items_[i]);
+  }
+
+  __atomic_store_n(&sequence_, seq + 2, __ATOMIC_RELEASE);
+}
+
+/* Snapshot and publish once per publish period (one callback for all
+   items of the group) */
+void ecmcDataGroup::execute() {
+  if (++cycleCounter_ < publishCycles_) {
+    return;
+  }
+  cycleCounter_ = 0;
+
+  takeSnapshot();
+  valuesAsynParam_->refreshParamRT(1, itemCount_ * sizeof(double));
+
+  if (namesDirty_) {
+    if (namesAsynParam_->refreshParamRT(1, namesLength_ + 1) == 0) {
+      countAsynParam_->refreshParamRT(1);
+      namesDirty_ = false;
+    }
+  }
+}
+
+int ecmcDataGroup::readSnapshot(double   *buffer,
+                                int       elements,
+                                uint32_t *sequence) {
+  int count = itemCount_ < elements ? itemCount_ : elements;
+  uint32_t seqStart = 0;
+
+  do {
+    seqStart = __atomic_load_n(&sequence_, __ATOMIC_ACQUIRE);
+
+    if (seqStart == 0) {
+      return 0;
+    }
+
+    if (seqStart & 1) {
+      continue;  // Snapshot in progress
+    }
+    memcpy(buffer, values_, count * sizeof(double));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  } while ((seqStart & 1) ||
+           (__atomic_load_n(&sequence_, __ATOMIC_RELAXED) != seqStart));
+
+  if (sequence) {
+    *sequence = seqStart / 2;
+  }
+  return count;
+}
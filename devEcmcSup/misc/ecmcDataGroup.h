@@ -0,0 +1,85 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcDataGroup.h
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#ifndef ECMCDATAGROUP_H_
+#define ECMCDATAGROUP_H_
+
+#include <stdint.h>
+#include "../main/ecmcError.h"
+#include "../main/ecmcDefinitions.h"
+#include "../com/ecmcAsynPortDriver.h"
+
+#define ERROR_DATA_GROUP_FULL 0x20A00
+#define ERROR_DATA_GROUP_ITEM_NULL 0x20A01
+#define ERROR_DATA_GROUP_ITEM_NOT_VALID 0x20A02
+#define ERROR_DATA_GROUP_NAMES_FULL 0x20A03
+#define ERROR_DATA_GROUP_ASYN_PARAM_REGISTER_FAIL 0x20A04
+#define ERROR_DATA_GROUP_PERIOD_OUT_OF_RANGE 0x20A05
+
+/**
+ * \class ecmcDataGroup
+ *
+ * \brief Bulk export of a group of data items in one array
+ *
+ * Values of the data items in the group (any ecmcDataItem, for instance
+ * "ec0.s3.positionActual01" or "ax1.actpos") are converted to double and
+ * copied to a snapshot once per publish period in the realtime thread. The
+ * snapshot is published in one asyn float64 array ("dg<index>.values"), the
+ * item names in one char array ("dg<index>.names", comma separated, same
+ * order). One record update replaces one record per item.
+ *
+ * Other (non realtime) consumers can read the latest consistent snapshot
+ * lock free with readSnapshot().
+ */
+class ecmcDataGroup : public ecmcError {
+ public:
+  ecmcDataGroup(ecmcAsynPortDriver *asynPortDriver,
+                int                 index,
+                int                 publishCycles);
+  ~ecmcDataGroup();
+
+  int      addItem(const char *name);
+  int      getItemCount();
+  int      setPublishCycles(int cycles);
+
+  // Realtime
+  void     execute();
+
+  // Copy of latest snapshot, returns number of values (0 if none yet)
+  int      readSnapshot(double   *buffer,
+                        int       elements,
+                        uint32_t *sequence);
+
+ private:
+  int      initAsyn();
+  void     takeSnapshot();
+
+  ecmcAsynPortDriver *asynPortDriver_;
+  int index_;
+  int publishCycles_;
+  int cycleCounter_;
+  int itemCount_;
+  ecmcDataItemInfo *items_[ECMC_DATA_GROUP_MAX_ITEMS];
+
+  // Odd while snapshot is written
+  uint32_t sequence_;
+  double  *values_;
+  char    *names_;
+  size_t   namesLength_;
+  bool     namesDirty_;
+
+  ecmcAsynDataItem *valuesAsynParam_;
+  ecmcAsynDataItem *namesAsynParam_;
+  ecmcAsynDataItem *countAsynParam_;
+};
+
+#endif  /* ECMCDATAGROUP_H_ */
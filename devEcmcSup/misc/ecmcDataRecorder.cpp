@@ -16,6 +16,7 @@ ecmcDataRecorder::ecmcDataRecorder(int index) : ecmcEcEntryLink() {
   index_ = index;
   PRINT_ERROR_PATH("dataRecorder[%d].error", index_);
   initVars();
+  registerErrorObject(ECMC_ERROR_OBJ_DATA_RECORDER, index_);
   setInStartupPhase(1);
   printCurrentState();
 }
@@ -376,6 +377,9 @@ void ecmcDataRecorder::initVars() {
   axisData_             = NULL;
   axisDataTypeToRecord_ = ECMC_AXIS_DATA_NONE;
   dataSource_           = ECMC_RECORDER_SOURCE_NONE;
+  timeBuffer_           = NULL;
+  cycleDcTimeNs_        = NULL;
+  dcTimeNs_             = 0;
 }
 
 int ecmcDataRecorder::setDataStorage(ecmcDataStorage *buffer) {
@@ -392,6 +396,19 @@ int ecmcDataRecorder::setDataStorage(ecmcDataStorage *buffer) {
   return 0;
 }
 
+int ecmcDataRecorder::setTimeStorage(ecmcDataStorage *buffer) {
+  timeBuffer_ = buffer;
+  return 0;
+}
+
+void ecmcDataRecorder::setCycleDcTimeSource(const uint64_t *dcTimeNs) {
+  cycleDcTimeNs_ = dcTimeNs;
+}
+
+uint64_t ecmcDataRecorder::getLastDcTimeNs() {
+  return dcTimeNs_;
+}
+
 int ecmcDataRecorder::validate() {
   switch (dataSource_) {
   case  ECMC_RECORDER_SOURCE_NONE:
@@ -506,6 +523,19 @@ int ecmcDataRecorder::executeEvent(int masterOK) {
     return setErrorID(__FILE__, __FUNCTION__, __LINE__, errorCode);
   }
 
+  if (cycleDcTimeNs_) {
+    dcTimeNs_ = *cycleDcTimeNs_;
+  }
+
+  // Same index as data (double: 128ns resolution)
+  if (timeBuffer_) {
+    errorCode = timeBuffer_->appendData((double)dcTimeNs_);
+
+    if (errorCode) {
+      return setErrorID(__FILE__, __FUNCTION__, __LINE__, errorCode);
+    }
+  }
+
   printStatus();
 
   return 0;
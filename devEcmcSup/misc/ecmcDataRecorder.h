@@ -40,6 +40,11 @@ class ecmcDataRecorder : public ecmcEventConsumer, public ecmcEcEntryLink {
   int  setEnable(int enable);
   int  getEnabled(int *enabled);
   int  setDataStorage(ecmcDataStorage *buffer);
+  // Optional storage for DC time [ns] of each recorded sample
+  int  setTimeStorage(ecmcDataStorage *buffer);
+  // DC time of current cycle (see ecmcEc::getCycleDcTimeNsPtr())
+  void setCycleDcTimeSource(const uint64_t *dcTimeNs);
+  uint64_t getLastDcTimeNs();
   int  validate();
   int  executeEvent(int masterOK);  // Override ecmcEventConsumer
   int  setAxisDataSource(ecmcAxisStatusType *axisData,
@@ -64,6 +69,9 @@ class ecmcDataRecorder : public ecmcEventConsumer, public ecmcEcEntryLink {
   ecmcAxisStatusType *axisData_;
   ecmcAxisDataType axisDataTypeToRecord_;
   ecmcDataSourceType dataSource_;
+  ecmcDataStorage *timeBuffer_;
+  const uint64_t *cycleDcTimeNs_;
+  uint64_t dcTimeNs_;
 };
 
 #endif  /* ECMCDATARECORDER_H_ */
@@ -12,6 +12,7 @@
 
 #include "ecmcDataStorage.h"
 #include "../main/ecmcErrorsList.h"
+#include "../main/ecmcGlobalsExtern.h"
 
 ecmcDataStorage::ecmcDataStorage(ecmcAsynPortDriver *asynPortDriver,
                                  int index,
@@ -20,6 +21,7 @@ ecmcDataStorage::ecmcDataStorage(ecmcAsynPortDriver *asynPortDriver,
   PRINT_ERROR_PATH("dataStorage[%d].error", index);
   initVars();
   index_=index;
+  registerErrorObject(ECMC_ERROR_OBJ_DATA_STORAGE, index);
   setBufferSize(size);
   bufferSize_ = size;
   bufferType_         = bufferType;
@@ -93,6 +95,7 @@ void ecmcDataStorage::initVars() {
   bufferType_         = ECMC_STORAGE_NORMAL_BUFFER;
   bufferSize_ = ECMC_DEFAULT_DATA_STORAGE_SIZE;
   buffer_             = NULL;
+  bufferCapacity_     = 0;
   currentBufferIndex_ = 0;
   dataCountInBuffer_          = 0;
   index_              = 0;
@@ -125,6 +128,34 @@ int ecmcDataStorage::clearBuffer() {
 }
 
 int ecmcDataStorage::setBufferSize(int elements) {  
+  // Within allocated buffer only the used length is changed (the buffer
+  // and the asyn array blocks are kept, also from the realtime thread)
+  if (buffer_ && (elements <= bufferCapacity_)) {
+    bufferSize_ = elements;
+    dataCountInBuffer_  = 0;
+    isFull_ = 0;
+    if(dataAsynDataItem_){
+      dataAsynDataItem_->setEcmcDataSize(bufferSize_*sizeof(double));
+      updateAsyn(1);
+    }
+    return 0;
+  }
+
+  // Re-allocation frees the buffer and the asyn array blocks
+  if (appModeStat == ECMC_MODE_RUNTIME) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Data storage %d. Size %d larger than allocated %d not allowed in runtime (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      index_,
+      elements,
+      bufferCapacity_,
+      ERROR_DATA_STORAGE_SIZE_CHANGE_NOT_ALLOWED);
+    return setErrorID(__FILE__, __FUNCTION__, __LINE__,
+                      ERROR_DATA_STORAGE_SIZE_CHANGE_NOT_ALLOWED);
+  }
+
   bufferSize_ = elements;
   dataCountInBuffer_  = 0;
   isFull_ = 0;
@@ -140,10 +171,14 @@ int ecmcDataStorage::setBufferSize(int elements) {
   //Set new adress to asyn interface
   if(dataAsynDataItem_){
     dataAsynDataItem_->setEcmcDataPointer((uint8_t*)tempBuffer,bufferSize_*sizeof(double));
+    // Resize blocks
+    dataAsynDataItem_->setArrayBlockCount(
+      dataAsynDataItem_->getArrayBlockCount());
     updateAsyn(1);
   }
   delete buffer_;
   buffer_ = tempBuffer;
+  bufferCapacity_ = elements;
   
   return 0;
 }
@@ -454,6 +489,8 @@ int ecmcDataStorage::initAsyn() {
     return ERROR_MAIN_ASYN_CREATE_PARAM_FAIL;
   }
   dataAsynDataItem_->setAllowWriteToEcmc(true);
+  dataAsynDataItem_->setArrayBlockCount(
+    asynPortDriver_->getDefaultArrayBlockCount());
   dataAsynDataItem_->refreshParam(1);
   
   // "ds%d.index"
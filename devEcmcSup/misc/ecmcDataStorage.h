@@ -25,6 +25,7 @@
 #define ERROR_DATA_STORAGE_SIZE_TO_SMALL 0x20202
 #define ERROR_DATA_STORAGE_POSITION_OUT_OF_RANGE 0x20203
 #define ERROR_DATA_STORAGE_ASYN_PARAM_REGISTER_FAIL 0x20204
+#define ERROR_DATA_STORAGE_SIZE_CHANGE_NOT_ALLOWED 0x20205
 
 enum ecmcDSBufferType {
   // Fill from beginning. Stop when full.
@@ -87,7 +88,8 @@ class ecmcDataStorage : public ecmcError {
   int  initAsyn();
   int currentBufferIndex_;
   double *buffer_;
-  int bufferSize_;
+  int bufferSize_;      // Used elements
+  int bufferCapacity_;  // Allocated elements
   ecmcDSBufferType bufferType_;
   int index_;
   int dataCountInBuffer_;
@@ -17,6 +17,7 @@ ecmcEvent::ecmcEvent(double sampleTime, int index) : ecmcEcEntryLink() {
   initVars();
   sampleTime_ = sampleTime;
   index_      = index;
+  registerErrorObject(ECMC_ERROR_OBJ_EVENT, index);
   LOGINFO10("%s/%s:%d: event[%d]=new;\n",
             __FILE__,
             __FUNCTION__,
@@ -137,6 +138,8 @@ void ecmcEvent::initVars() {
     consumers_[i] = NULL;
   }
   reArm_ = 0;
+  cycleDcTimeNs_   = NULL;
+  triggerDcTimeNs_ = 0;
 }
 
 int ecmcEvent::setEventType(eventType type) {
@@ -481,6 +484,10 @@ void ecmcEvent::printStatus() {
 int ecmcEvent::callConsumers(int masterOK) {
   int errorCode = 0;
 
+  if (cycleDcTimeNs_) {
+    triggerDcTimeNs_ = *cycleDcTimeNs_;
+  }
+
   for (int i = 0; i < ECMC_MAX_EVENT_CONSUMERS; i++) {
     if (consumers_[i] != NULL) {
       LOGINFO10("%s/%s:%d: INFO: Event %d. Calling consumer %d.\n",
@@ -499,6 +506,14 @@ int ecmcEvent::callConsumers(int masterOK) {
   return 0;
 }
 
+void ecmcEvent::setCycleDcTimeSource(const uint64_t *dcTimeNs) {
+  cycleDcTimeNs_ = dcTimeNs;
+}
+
+uint64_t ecmcEvent::getTriggerDcTimeNs() {
+  return triggerDcTimeNs_;
+}
+
 int ecmcEvent::linkEventConsumer(ecmcEventConsumer *consumer, int index) {
   if ((index < 0) || (index >= ECMC_MAX_EVENT_CONSUMERS)) {
     return setErrorID(__FILE__,
@@ -51,6 +51,10 @@ class ecmcEvent : public ecmcEcEntryLink {
   int  triggerEvent(int masterOK);
   int  arm();
   void printCurrentState();
+  // DC time of current cycle (see ecmcEc::getCycleDcTimeNsPtr())
+  void setCycleDcTimeSource(const uint64_t *dcTimeNs);
+  // DC time of cycle of last trigger [ns]
+  uint64_t getTriggerDcTimeNs();
 
  private:
   void initVars();
@@ -72,6 +76,8 @@ class ecmcEvent : public ecmcEcEntryLink {
   bool eventTriggered_;
   ecmcEventConsumer *consumers_[ECMC_MAX_EVENT_CONSUMERS];
   bool reArm_;
+  const uint64_t *cycleDcTimeNs_;
+  uint64_t triggerDcTimeNs_;
 };
 
 #endif  /* ECMCEVENT_H_ */
@@ -26,7 +26,7 @@ int createEvent(int indexEvent) {
            __LINE__,
            indexEvent);
 
-  if ((indexEvent >= ECMC_MAX_EVENT_OBJECTS) || (indexEvent < 0)) {
+  if ((indexEvent >= ecmcMaxEventObjects) || (indexEvent < 0)) {
     return ERROR_MAIN_EVENT_INDEX_OUT_OF_RANGE;
   }
   // Sample rate fixed
@@ -42,6 +42,11 @@ int createEvent(int indexEvent) {
            __LINE__);
     exit(EXIT_FAILURE);
   }
+
+  if (ec) {
+    events[indexEvent]->setCycleDcTimeSource(ec->getCycleDcTimeNsPtr());
+  }
+
   return events[indexEvent]->getErrorID();
 }
 
@@ -54,7 +59,7 @@ int createDataStorage(int index, int elements, int bufferType) {
            index,
            elements);
 
-  if ((index >= ECMC_MAX_DATA_STORAGE_OBJECTS) || (index < 0)) {
+  if ((index >= ecmcMaxDataStorageObjects) || (index < 0)) {
     return ERROR_MAIN_DATA_STORAGE_INDEX_OUT_OF_RANGE;
   }
 
@@ -96,6 +101,21 @@ int linkStorageToRecorder(int indexStorage, int indexRecorder) {
     dataStorages[indexStorage]);
 }
 
+int linkTimeStorageToRecorder(int indexStorage, int indexRecorder) {
+  LOGINFO4("%s/%s:%d indexStorage=%d indexRecorder=%d \n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           indexStorage,
+           indexRecorder);
+
+  CHECK_STORAGE_RETURN_IF_ERROR(indexStorage);
+  CHECK_RECORDER_RETURN_IF_ERROR(indexRecorder);
+
+  return dataRecorders[indexRecorder]->setTimeStorage(
+    dataStorages[indexStorage]);
+}
+
 int linkEcEntryToEvent(int   indexEvent,
                        int   eventEntryIndex,
                        int   slaveIndex,
@@ -186,6 +206,19 @@ int getEventEnabled(int indexEvent, int *enabled) {
   return events[indexEvent]->getEnabled(enabled);
 }
 
+int getEventTriggerDcTime(int indexEvent, uint64_t *dcTimeNs) {
+  LOGINFO4("%s/%s:%d indexEvent=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           indexEvent);
+
+  CHECK_EVENT_RETURN_IF_ERROR(indexEvent);
+
+  *dcTimeNs = events[indexEvent]->getTriggerDcTimeNs();
+  return 0;
+}
+
 int clearStorage(int indexStorage) {
   LOGINFO4("%s/%s:%d indexStorage=%d\n",
            __FILE__,
@@ -376,6 +409,11 @@ int createRecorder(int indexRecorder) {
     exit(EXIT_FAILURE);
   }
 
+  if (ec) {
+    dataRecorders[indexRecorder]->setCycleDcTimeSource(
+      ec->getCycleDcTimeNsPtr());
+  }
+
   return dataRecorders[indexRecorder]->getErrorID();
 }
 
@@ -620,3 +658,55 @@ int triggerCommandList(int indexCommandList) {
   // No need for state of ethercat master
   return commandLists[indexCommandList]->executeEvent(1);
 }
+
+int createDataGroup(int indexDataGroup, double publishPeriodMs) {
+  LOGINFO4("%s/%s:%d indexDataGroup=%d publishPeriodMs=%lf\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           indexDataGroup,
+           publishPeriodMs);
+
+  if ((indexDataGroup >= ECMC_MAX_DATA_GROUPS) || (indexDataGroup < 0)) {
+    return ERROR_MAIN_DATA_GROUP_INDEX_OUT_OF_RANGE;
+  }
+
+  if (appModeStat == ECMC_MODE_RUNTIME) {
+    return ERROR_MAIN_APP_MODE_ALREADY_RUNTIME;
+  }
+
+  // Sample rate fixed
+  sampleRateChangeAllowed = 0;
+
+  int cycles = (int)(publishPeriodMs * 1E6 / mcuPeriod + 0.5);
+
+  delete dataGroups[indexDataGroup];
+  dataGroups[indexDataGroup] = new ecmcDataGroup(asynPort,
+                                                 indexDataGroup,
+                                                 cycles);
+
+  return dataGroups[indexDataGroup]->getErrorID();
+}
+
+int addDataGroupItem(int indexDataGroup, char *itemName) {
+  LOGINFO4("%s/%s:%d indexDataGroup=%d itemName=%s\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           indexDataGroup,
+           itemName);
+
+  if ((indexDataGroup >= ECMC_MAX_DATA_GROUPS) || (indexDataGroup < 0)) {
+    return ERROR_MAIN_DATA_GROUP_INDEX_OUT_OF_RANGE;
+  }
+
+  if (!dataGroups[indexDataGroup]) {
+    return ERROR_MAIN_DATA_GROUP_NULL;
+  }
+
+  if (appModeStat == ECMC_MODE_RUNTIME) {
+    return ERROR_MAIN_APP_MODE_ALREADY_RUNTIME;
+  }
+
+  return dataGroups[indexDataGroup]->addItem(itemName);
+}
@@ -18,6 +18,8 @@
 #ifndef ECMC_MISC_H_
 #define ECMC_MISC_H_
 
+#include <stdint.h>
+
 #define CHECK_COMMAND_LIST_RETURN_IF_ERROR(commandListIndex)                  \
 {                                                                             \
   if (indexCommandList >= ECMC_MAX_COMMANDS_LISTS || indexCommandList < 0) {  \
@@ -32,7 +34,7 @@
 
 #define CHECK_EVENT_RETURN_IF_ERROR(indexEvent)                               \
 {                                                                             \
-  if (indexEvent >= ECMC_MAX_EVENT_OBJECTS || indexEvent < 0) {               \
+  if (indexEvent >= ecmcMaxEventObjects || indexEvent < 0) {                  \
     LOGERR("ERROR: Event index out of range.\n");                             \
     return ERROR_MAIN_EVENT_INDEX_OUT_OF_RANGE;                               \
   }                                                                           \
@@ -44,7 +46,7 @@
 
 #define CHECK_STORAGE_RETURN_IF_ERROR(indexStorage)                           \
 {                                                                             \
-  if (indexStorage >= ECMC_MAX_DATA_STORAGE_OBJECTS || indexStorage < 0) {    \
+  if (indexStorage >= ecmcMaxDataStorageObjects || indexStorage < 0) {        \
     LOGERR("ERROR: Data storage index out of range.\n");                      \
     return ERROR_MAIN_DATA_STORAGE_INDEX_OUT_OF_RANGE;                        \
   }                                                                           \
@@ -214,6 +216,22 @@ int setEventEnable(int indexEvent,
 int getEventEnabled(int  indexEvent,
                     int *enabled);
 
+/** \brief Get DC time of last trigger of event.\n
+ *
+ * DC application time of the cycle in which the event last triggered\n
+ * (same time base as EtherCAT DC, ns since 2000-01-01).\n
+ *
+ * \param[in] indexEvent Index of event to address.\n
+ * \param[out] dcTimeNs DC time [ns].\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Get DC time of last trigger of event 2.\n
+ *  "GetEventTriggerDcTime(2)" //Command string to ecmcCmdParser.c\n
+ */
+int getEventTriggerDcTime(int       indexEvent,
+                          uint64_t *dcTimeNs);
+
 /** \brief Enable arm sequence.\n
  *
  * Some hardware require that the input card is re-armed after each value have
@@ -446,6 +464,23 @@ int createRecorder(int indexRecorder);
 int linkStorageToRecorder(int indexStorage,
                           int indexRecorder);
 
+/** \brief Link time storage object to recorder object.
+ *
+ * For each recorded sample the DC time [ns] of the cycle is appended to the\n
+ * time storage (same index as in the data storage). Optional.\n
+ * Note: Stored as double (about 128ns resolution).\n
+ *
+ * \param[in] indexStorage Index of storage object.\n
+ * \param[in] indexRecorder Index of recorder object.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Link storage object 6 to recorder object 3 as time storage.\n
+ * "Cfg.LinkTimeStorageToRecorder(6,3)" //Command string to ecmcCmdParser.c\n
+ */
+int linkTimeStorageToRecorder(int indexStorage,
+                              int indexRecorder);
+
 /** \brief Links an EtherCAT entry to a recorder object. \n
  *
  *  \param[in] indexRecorder Index of recorder object to link to.\n
@@ -693,6 +728,42 @@ int addCommandListCommand(int   indexCommandList,
  */
 int triggerCommandList(int indexCommandList);
 
+/** \brief Create a data group object.\n
+ *
+ * Values of the data items in a data group are copied to a snapshot once
+ * per publish period and published in one asyn float64 array
+ * ("dg<index>.values"). The item names are published in one char array
+ * ("dg<index>.names", comma separated, same order). One record (waveform)
+ * per group replaces one record per data item.\n
+ *
+ * \param[in] indexDataGroup Index of data group to create.\n
+ * \param[in] publishPeriodMs Publish period in ms (rounded to whole
+ *                             realtime cycles, min one cycle).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Create data group 0 published every 100ms.\n
+ *  "Cfg.CreateDataGroup(0,100)" //Command string to ecmcCmdParser.c\n
+ */
+int createDataGroup(int    indexDataGroup,
+                    double publishPeriodMs);
+
+/** \brief Add data item to data group.\n
+ *
+ * Any data item can be added (ethercat entries, axis, plc and main
+ * parameters). The first element is converted to double.\n
+ *
+ * \param[in] indexDataGroup Index of data group.\n
+ * \param[in] itemName Name of data item.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Add actual position of axis 1 to data group 0.\n
+ *  "Cfg.AddDataGroupItem(0,ax1.actpos)" //Command string to ecmcCmdParser.c\n
+ */
+int addDataGroupItem(int   indexDataGroup,
+                     char *itemName);
+
 # ifdef __cplusplus
 }
 # endif  // ifdef __cplusplus
@@ -99,6 +99,7 @@ ecmcAxisBase::ecmcAxisBase(ecmcAsynPortDriver *asynPortDriver,
   asynPortDriver_                 = asynPortDriver;
   data_.axisId_                   = axisID;
   data_.sampleTime_               = sampleTime;
+  registerErrorObject(ECMC_ERROR_OBJ_AXIS, axisID);
 
   try {
     data_.command_.primaryEncIndex = 0;    
@@ -148,6 +149,12 @@ ecmcAxisBase::~ecmcAxisBase() {
   extTrajVeloFilter_ = NULL;
   delete extEncVeloFilter_;
   extEncVeloFilter_ = NULL;
+  delete sync_;
+  sync_ = NULL;
+  delete pvt_;
+  pvt_ = NULL;
+  delete posCmp_;
+  posCmp_ = NULL;
 //  free(plcExpr_);
 }
 
@@ -188,6 +195,16 @@ void ecmcAxisBase::initVars() {
   memset(diagBuffer_,0,AX_MAX_DIAG_STRING_CHAR_LENGTH);
   extTrajVeloFilter_ = NULL;
   extEncVeloFilter_ = NULL;
+  sync_ = NULL;
+  pvt_ = NULL;
+  posCmp_ = NULL;
+  hotState_ = NULL;
+  hotStateSlot_ = 0;
+  statusChangeCallback_ = NULL;
+  statusChangeUserData_ = NULL;
+  memset(&statusWdNotified_, 0, sizeof(statusWdNotified_));
+  errorNotified_ = 0;
+  commandNotified_ = ECMC_CMD_NOCMD;
   enableExtTrajVeloFilter_ = false;
   enableExtEncVeloFilter_ = false;
   disableAxisAtErrorReset_ = false;
@@ -229,6 +246,7 @@ void ecmcAxisBase::preExecute(bool masterOK) {
     setEnable(false);
     data_.status_.busy       = false;
     data_.status_.distToStop = 0;
+    data_.status_.moveTime   = 0;
 
     if (masterOK) {
       // Auto reset hardware error if starting up
@@ -245,6 +263,7 @@ void ecmcAxisBase::preExecute(bool masterOK) {
   case ECMC_AXIS_STATE_DISABLED:
     data_.status_.busy       = false;
     data_.status_.distToStop = 0;
+    data_.status_.moveTime   = 0;
 
     if (data_.status_.enabled) {
       axisState_ = ECMC_AXIS_STATE_ENABLED;
@@ -264,6 +283,7 @@ void ecmcAxisBase::preExecute(bool masterOK) {
   case ECMC_AXIS_STATE_ENABLED:
     data_.status_.distToStop = traj_->distToStop(
       data_.status_.currentVelocitySetpoint);
+    data_.status_.moveTime   = traj_->getMoveTime();
 
     if (data_.command_.trajSource == ECMC_DATA_SOURCE_INTERNAL) {
       data_.status_.currentTargetPosition = traj_->getTargetPos();
@@ -314,6 +334,11 @@ void ecmcAxisBase::preExecute(bool masterOK) {
     data_.status_.externalEncoderVelocity = (data_.status_.externalEncoderPosition -
       data_.status_.externalEncoderPositionOld) / data_.sampleTime_;
   }
+
+  // Native gear/cam (overrides external trajectory setpoint and velocity)
+  if(sync_) {
+    sync_->execute(getEnabled());
+  }
 }
 
 void ecmcAxisBase::postExecute(bool masterOK) {  
@@ -348,6 +373,8 @@ void ecmcAxisBase::postExecute(bool masterOK) {
   //axAsynParams_[ECMC_ASYN_AX_CMDDATA_ID]->refreshParamRT(0);
   axAsynParams_[ECMC_ASYN_AX_ERROR_ID]->refreshParamRT(0);
   axAsynParams_[ECMC_ASYN_AX_WARNING_ID]->refreshParamRT(0);
+  axAsynParams_[ECMC_ASYN_AX_MOVE_TIME_ID]->refreshParamRT(0);
+  axAsynParams_[ECMC_ASYN_AX_DIST_TO_STOP_ID]->refreshParamRT(0);
 
   if(axAsynParams_[ECMC_ASYN_AX_DIAG_ID]->willRefreshNext() && axAsynParams_[ECMC_ASYN_AX_DIAG_ID]->linkedToAsynClient() ) {    
     int  bytesUsed = 0;
@@ -604,6 +631,11 @@ void ecmcAxisBase::errorReset() {
     seq->errorReset();
   }
 
+  // Streamed setpoints (underrun)
+  if (pvt_) {
+    pvt_->errorReset();
+  }
+
   ecmcError::errorReset();
 }
 
@@ -611,6 +643,108 @@ int ecmcAxisBase::validateBase() {
   return 0;
 }
 
+ecmcAxisSync *ecmcAxisBase::getSync() {
+  return sync_;
+}
+
+int ecmcAxisBase::createSync() {
+  if (sync_) {
+    return 0;
+  }
+  sync_ = new ecmcAxisSync(&data_, asynPortDriver_);
+  return 0;
+}
+
+ecmcAxisPvt *ecmcAxisBase::getPvt() {
+  return pvt_;
+}
+
+int ecmcAxisBase::createPvt(int size) {
+  if (pvt_) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_PVT_ALREADY_CREATED);
+  }
+
+  if ((size < 2) || (size > ECMC_AXIS_PVT_MAX_POINTS)) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_PVT_SIZE_OUT_OF_RANGE);
+  }
+  pvt_ = new ecmcAxisPvt(&data_, asynPortDriver_, size);
+  return pvt_->getErrorID();
+}
+
+void ecmcAxisBase::setHotState(ecmcAxisHotState *hotState, int slot) {
+  hotState_     = hotState;
+  hotStateSlot_ = slot;
+
+  if (mon_) {
+    mon_->setHotState(hotState, slot);
+  }
+}
+
+/* Inputs of the batched monitor checks (end of executeInputs()) */
+void ecmcAxisBase::storeHotState() {
+  if (hotState_) {
+    hotState_->store(hotStateSlot_, &data_.status_);
+  }
+}
+
+void ecmcAxisBase::setStatusChangeCallback(ecmcAxisStatusChangeCallback callback,
+                                           void                        *userData) {
+  statusChangeUserData_ = userData;
+  statusChangeCallback_ = callback;
+}
+
+/* Status bits (limits, enabled, busy, attarget, homed..), error and
+   command are compared with the values at last notification. */
+void ecmcAxisBase::checkStatusChange() {
+  if (!statusChangeCallback_) {
+    return;
+  }
+
+  if ((memcmp(&statusWdNotified_, &statusData_.onChangeData.statusWd,
+              sizeof(statusWdNotified_)) == 0) &&
+      (errorNotified_ == statusData_.onChangeData.error) &&
+      (commandNotified_ == statusData_.onChangeData.command)) {
+    return;
+  }
+
+  statusWdNotified_ = statusData_.onChangeData.statusWd;
+  errorNotified_    = statusData_.onChangeData.error;
+  commandNotified_  = statusData_.onChangeData.command;
+  statusChangeCallback_(statusChangeUserData_);
+}
+
+ecmcAxisPosCompare *ecmcAxisBase::getPosCompare() {
+  return posCmp_;
+}
+
+int ecmcAxisBase::createPosCompare(int tableSize) {
+  if (posCmp_) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_POS_CMP_ALREADY_CREATED);
+  }
+
+  if ((tableSize < 0) || (tableSize > ECMC_AXIS_POS_CMP_MAX_TABLE_SIZE)) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_POS_CMP_SIZE_OUT_OF_RANGE);
+  }
+  posCmp_ = new ecmcAxisPosCompare(&data_, asynPortDriver_, tableSize);
+  return posCmp_->getErrorID();
+}
+
+ecmcAxisData *ecmcAxisBase::getAxisDataRef() {
+  return &data_;
+}
+
 int ecmcAxisBase::getPosAct(double *pos) {
   *pos = data_.status_.currentPositionActual;
   return 0;
@@ -1039,6 +1173,36 @@ int ecmcAxisBase::initAsyn() {
   paramTemp->refreshParam(1);
   axAsynParams_[ECMC_ASYN_AX_WARNING_ID] = paramTemp;
 
+  // Move time (total time of current positioning move)
+  errorCode = createAsynParam(ECMC_AX_STR "%d." ECMC_ASYN_AX_MOVE_TIME_NAME,
+                              asynParamFloat64,
+                              ECMC_EC_F64,
+                              (uint8_t*)&(data_.status_.moveTime),
+                              sizeof(data_.status_.moveTime),
+                              &paramTemp);
+  if(errorCode) {
+    return errorCode;
+  }
+
+  paramTemp->setAllowWriteToEcmc(false);
+  paramTemp->refreshParam(1);
+  axAsynParams_[ECMC_ASYN_AX_MOVE_TIME_ID] = paramTemp;
+
+  // Distance to stop
+  errorCode = createAsynParam(ECMC_AX_STR "%d." ECMC_ASYN_AX_DIST_TO_STOP_NAME,
+                              asynParamFloat64,
+                              ECMC_EC_F64,
+                              (uint8_t*)&(data_.status_.distToStop),
+                              sizeof(data_.status_.distToStop),
+                              &paramTemp);
+  if(errorCode) {
+    return errorCode;
+  }
+
+  paramTemp->setAllowWriteToEcmc(false);
+  paramTemp->refreshParam(1);
+  axAsynParams_[ECMC_ASYN_AX_DIST_TO_STOP_ID] = paramTemp;
+
 
   asynPortDriver_->callParamCallbacks(ECMC_ASYN_DEFAULT_LIST, ECMC_ASYN_DEFAULT_ADDR);
   return 0;
@@ -1326,6 +1490,8 @@ void ecmcAxisBase::refreshDebugInfoStruct() {
     velocityDiffTrajInterlock
     || data_.interlocks_.
     velocityDiffDriveInterlock;
+
+  checkStatusChange();
 }
 
 int ecmcAxisBase::setEnable(bool enable) {
@@ -1445,6 +1611,31 @@ int ecmcAxisBase::setEncPosFiltEnable(bool enable) {
   return encArray_[data_.command_.primaryEncIndex]->setPosFilterEnable(enable);
 }
 
+int ecmcAxisBase::setExtTrajVeloFiltType(ecmcFilterType type) {
+  return extTrajVeloFilter_->setFilterType(type);
+}
+
+int ecmcAxisBase::setExtEncVeloFiltType(ecmcFilterType type) {
+  return extEncVeloFilter_->setFilterType(type);
+}
+
+int ecmcAxisBase::setEncVeloFiltType(ecmcFilterType type) {
+  return encArray_[data_.command_.primaryEncIndex]->setVeloFilterType(type);
+}
+
+int ecmcAxisBase::setExtTrajVeloFiltLowPass(double cutOffHz, int order) {
+  return extTrajVeloFilter_->setLowPassCutOff(cutOffHz, order);
+}
+
+int ecmcAxisBase::setExtEncVeloFiltLowPass(double cutOffHz, int order) {
+  return extEncVeloFilter_->setLowPassCutOff(cutOffHz, order);
+}
+
+int ecmcAxisBase::setEncVeloFiltLowPass(double cutOffHz, int order) {
+  return encArray_[data_.command_.primaryEncIndex]->setVeloFilterLowPass(
+    cutOffHz, order);
+}
+
 int ecmcAxisBase::createAsynParam(const char       *nameFormat,
                                   asynParamType     asynType, 
                                   ecmcEcDataType    ecmcType,
@@ -29,6 +29,9 @@
 #include "ecmcTrajectoryTrapetz.h"
 #include "ecmcAxisData.h"
 #include "ecmcFilter.h"
+#include "ecmcAxisSync.h"
+#include "ecmcAxisPvt.h"
+#include "ecmcAxisPosCompare.h"
 #include "ecmcMotionUtils.h"
 
 // AXIS ERRORS
@@ -158,6 +161,9 @@ typedef struct {
   int                        spareBitsCmd       : 22;
  } ecmcAsynAxisControlType;
 
+// Called from realtime thread (keep short, no blocking)
+typedef void (*ecmcAxisStatusChangeCallback)(void *userData);
+
 class ecmcAxisBase : public ecmcError {
  public:
   ecmcAxisBase(ecmcAsynPortDriver *asynPortDriver,
@@ -169,6 +175,9 @@ class ecmcAxisBase : public ecmcError {
   virtual ecmcPIDController* getCntrl()             = 0;
   virtual int                validate()             = 0;
   virtual void               execute(bool masterOK) = 0;
+  // execute() split at the monitor (batched monitor checks in between)
+  virtual void               executeInputs(bool masterOK)  = 0;
+  virtual void               executeOutputs(bool masterOK) = 0;
   int                        getCntrlError(double *error);
   int                        setEnable(bool enable);
   bool                       getEnable();
@@ -195,6 +204,19 @@ class ecmcAxisBase : public ecmcError {
   ecmcEncoder              * getEnc(int encIndex, int* error);
   ecmcEncoder              * getConfigEnc();  // get current encoder being configured
   ecmcAxisSequencer        * getSeq();
+  ecmcAxisSync             * getSync();
+  int                        createSync();
+  ecmcAxisPvt              * getPvt();
+  int                        createPvt(int size);
+  ecmcAxisPosCompare       * getPosCompare();
+  int                        createPosCompare(int tableSize);
+  // Store hot state in slot each cycle before monitoring (NULL to disable)
+  void                       setHotState(ecmcAxisHotState *hotState,
+                                         int               slot);
+  // Notify on change of status word, error or command (NULL to disable)
+  void                       setStatusChangeCallback(ecmcAxisStatusChangeCallback callback,
+                                                     void                        *userData);
+  ecmcAxisData             * getAxisDataRef();
   int                        getPosAct(double *pos);
   int                        getPosSet(double *pos);
   int                        getVelAct(double *vel);
@@ -244,6 +266,15 @@ class ecmcAxisBase : public ecmcError {
   int                        setEncVeloFiltSize(size_t size);
   int                        setEncPosFiltSize(size_t size);
   int                        setEncPosFiltEnable(bool enable);
+  int                        setExtTrajVeloFiltType(ecmcFilterType type);
+  int                        setExtEncVeloFiltType(ecmcFilterType type);
+  int                        setEncVeloFiltType(ecmcFilterType type);
+  int                        setExtTrajVeloFiltLowPass(double cutOffHz,
+                                                       int    order);
+  int                        setExtEncVeloFiltLowPass(double cutOffHz,
+                                                      int    order);
+  int                        setEncVeloFiltLowPass(double cutOffHz,
+                                                   int    order);
   int                        setDisableAxisAtErrorReset(bool disable);
   int                        moveAbsolutePosition(double positionSet,
                                                   double velocitySet,
@@ -290,6 +321,7 @@ class ecmcAxisBase : public ecmcError {
  protected:
   void                       initVars();
   void                       refreshDebugInfoStruct();
+  void                       storeHotState();
   //double                     getPosErrorMod();
   int                        createAsynParam(const char        *nameFormat,
                                              asynParamType      asynType,
@@ -298,6 +330,7 @@ class ecmcAxisBase : public ecmcError {
                                              size_t             bytes,                   
                                              ecmcAsynDataItem **asynParamOut);
   void                       refreshStatusWd();
+  void                       checkStatusChange();
   void                       initControlWord();
   void                       initEncoders();
 
@@ -315,6 +348,16 @@ class ecmcAxisBase : public ecmcError {
   ecmcEcEntry            *statusOutputEntry_;
   ecmcFilter             *extTrajVeloFilter_;
   ecmcFilter             *extEncVeloFilter_;
+  ecmcAxisSync           *sync_;
+  ecmcAxisPvt            *pvt_;
+  ecmcAxisPosCompare     *posCmp_;
+  ecmcAxisHotState       *hotState_;
+  int                     hotStateSlot_;
+  ecmcAxisStatusChangeCallback statusChangeCallback_;
+  void                   *statusChangeUserData_;
+  ecmcAxisStatusWordType  statusWdNotified_;
+  int                     errorNotified_;
+  motionCommandTypes      commandNotified_;
   bool                    allowCmdFromOtherPLC_;
   bool                    executeCmdOld_;
   bool                    enableExtTrajVeloFilter_;
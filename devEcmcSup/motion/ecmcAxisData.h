@@ -79,6 +79,7 @@ typedef struct {
   bool   inStartupPhase;
   bool   inRealtime;
   double distToStop;
+  double moveTime;
   int errorCode;
   int warningCode;
 } ecmcAxisDataStatus;  
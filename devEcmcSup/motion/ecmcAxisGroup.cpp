@@ -0,0 +1,588 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcAxisGroup.cpp
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#include "ecmcAxisGroup.h"
+#include "../main/ecmcErrorsList.h"
+
+/**
+ * Callback function for asynWrites (execute)
+ * userObj = axis group object
+ *
+ * */
+asynStatus asynWriteGroupExecute(void* data, size_t bytes, asynParamType asynParType,void *userObj) {
+  if (!userObj) {
+    return asynError;
+  }
+  return ((ecmcAxisGroup*)userObj)->groupAsynWriteExecute(data, bytes, asynParType);
+}
+
+asynStatus asynWriteGroupTargetPos(void* data, size_t bytes, asynParamType asynParType,void *userObj) {
+  if (!userObj) {
+    return asynError;
+  }
+  return ((ecmcAxisGroup*)userObj)->groupAsynWriteTargetPos(data, bytes, asynParType);
+}
+
+ecmcAxisGroup::ecmcAxisGroup(ecmcAsynPortDriver *asynPortDriver,
+                             int                 index,
+                             double              sampleTime) {
+  PRINT_ERROR_PATH("axisGroup[%d].error", index);
+  initVars();
+  asynPortDriver_ = asynPortDriver;
+  index_          = index;
+  sampleTime_     = sampleTime;
+  LOGINFO9("%s/%s:%d: axisGroup[%d]=new;\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           index);
+  initAsyn();
+}
+
+ecmcAxisGroup::~ecmcAxisGroup() {
+  delete otg_;
+  otg_ = NULL;
+  delete input_;
+  input_ = NULL;
+  delete traj_;
+  traj_ = NULL;
+}
+
+void ecmcAxisGroup::initVars() {
+  errorReset();
+  asynPortDriver_ = NULL;
+  index_          = 0;
+  sampleTime_     = 1;
+  axesCount_      = 0;
+  dofs_           = 0;
+  for (int i = 0; i < ECMC_AXIS_GROUP_MAX_AXES; i++) {
+    axes_[i]         = NULL;
+    velocity_[i]     = 0;
+    acceleration_[i] = 0;
+    jerk_[i]         = 0;
+    targetPos_[i]    = 0;
+    targetPosCmd_[i] = 0;
+  }
+  targetPosSeq_      = 0;
+  syncType_          = ECMC_AXIS_GROUP_SYNC_TIME;
+  validated_         = false;
+  executeCmd_        = 0;
+  executeCmdOld_     = 0;
+  busy_              = 0;
+  errorCode_         = 0;
+  moveTime_          = 0;
+  time_              = 0;
+  otg_               = NULL;
+  input_             = NULL;
+  traj_              = NULL;
+  targPosAsynParam_  = NULL;
+  executeAsynParam_  = NULL;
+  busyAsynParam_     = NULL;
+  moveTimeAsynParam_ = NULL;
+  errorAsynParam_    = NULL;
+}
+
+int ecmcAxisGroup::addAxis(ecmcAxisBase *axis,
+                           double        velocity,
+                           double        acceleration,
+                           double        jerk) {
+  if (axis == NULL) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_GROUP_AXIS_NULL);
+  }
+
+  if (axesCount_ >= ECMC_AXIS_GROUP_MAX_AXES) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_GROUP_AXIS_COUNT_OUT_OF_RANGE);
+  }
+
+  if (memberIndex(axis->getAxisID()) >= 0) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_GROUP_AXIS_ALREADY_ADDED);
+  }
+
+  if ((velocity <= 0) || (acceleration <= 0) || (jerk <= 0)) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_GROUP_LIMIT_OUT_OF_RANGE);
+  }
+
+  axes_[axesCount_]         = axis;
+  velocity_[axesCount_]     = velocity;
+  acceleration_[axesCount_] = acceleration;
+  jerk_[axesCount_]         = jerk;
+  axesCount_++;
+
+  // Planner must be re-allocated for the new number of axes
+  validated_ = false;
+  return 0;
+}
+
+int ecmcAxisGroup::setSyncType(ecmcAxisGroupSyncType syncType) {
+  switch (syncType) {
+  case ECMC_AXIS_GROUP_SYNC_TIME:
+  case ECMC_AXIS_GROUP_SYNC_TIME_IF_NECESSARY:
+  case ECMC_AXIS_GROUP_SYNC_PHASE:
+  case ECMC_AXIS_GROUP_SYNC_NONE:
+    syncType_ = syncType;
+    break;
+
+  default:
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_GROUP_SYNC_TYPE_OUT_OF_RANGE);
+  }
+  return 0;
+}
+
+int ecmcAxisGroup::setTargetPos(int axisIndex, double position) {
+  int member = memberIndex(axisIndex);
+
+  if (member < 0) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_GROUP_AXIS_NOT_MEMBER);
+  }
+  stageTargetPos(member, &position, 1);
+  return 0;
+}
+
+/* Sequence lock writer (command and asyn threads, serialized by the asyn
+   port lock). The realtime thread never waits for the writer. */
+void ecmcAxisGroup::stageTargetPos(int           first,
+                                   const double *position,
+                                   int           count) {
+  uint32_t seq = targetPosSeq_;
+
+  __atomic_store_n(&targetPosSeq_, seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  for (int i = 0; i < count; i++) {
+    double value = position[i];
+    __atomic_store(&targetPosCmd_[first + i], &value, __ATOMIC_RELAXED);
+  }
+  __atomic_store_n(&targetPosSeq_, seq + 2, __ATOMIC_RELEASE);
+}
+
+// Copy staged target positions to targetPos_ (realtime)
+bool ecmcAxisGroup::readTargetPos() {
+  for (int retry = 0; retry < ECMC_AXIS_GROUP_TARG_POS_READ_RETRIES; retry++) {
+    uint32_t seqStart = __atomic_load_n(&targetPosSeq_, __ATOMIC_ACQUIRE);
+
+    if (seqStart & 1) {  // Write in progress
+      continue;
+    }
+
+    for (int i = 0; i < dofs_; i++) {
+      __atomic_load(&targetPosCmd_[i], &targetPos_[i], __ATOMIC_RELAXED);
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    if (__atomic_load_n(&targetPosSeq_, __ATOMIC_RELAXED) == seqStart) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int ecmcAxisGroup::setExecute(bool execute) {
+  // Edge is handled in the realtime loop
+  executeCmd_ = execute;
+  return 0;
+}
+
+bool ecmcAxisGroup::getBusy() {
+  return busy_;
+}
+
+double ecmcAxisGroup::getMoveTime() {
+  return moveTime_;
+}
+
+int ecmcAxisGroup::getAxisCount() {
+  return axesCount_;
+}
+
+int ecmcAxisGroup::memberIndex(int axisId) {
+  for (int i = 0; i < axesCount_; i++) {
+    if (axes_[i]->getAxisID() == axisId) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int ecmcAxisGroup::validate() {
+  if (axesCount_ <= 0) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_GROUP_AXIS_COUNT_OUT_OF_RANGE);
+  }
+
+  if (validated_) {
+    return 0;
+  }
+
+  // Allocate planner here (not in realtime)
+  delete otg_;
+  delete input_;
+  delete traj_;
+  otg_   = new Ruckig<DynamicDOFs>(axesCount_, sampleTime_);
+  input_ = new InputParameter<DynamicDOFs>(axesCount_);
+  traj_  = new Trajectory<DynamicDOFs>(axesCount_);
+  pos_.assign(axesCount_, 0);
+  vel_.assign(axesCount_, 0);
+  acc_.assign(axesCount_, 0);
+  dofs_ = axesCount_;
+
+  for (int i = 0; i < dofs_; i++) {
+    input_->max_velocity[i]         = velocity_[i];
+    input_->max_acceleration[i]     = acceleration_[i];
+    input_->max_jerk[i]             = jerk_[i];
+    input_->target_velocity[i]      = 0;
+    input_->target_acceleration[i]  = 0;
+  }
+
+  validated_ = true;
+  return 0;
+}
+
+bool ecmcAxisGroup::membersReady() {
+  for (int i = 0; i < dofs_; i++) {
+    if (!axes_[i]->getEnabled() || axes_[i]->getError() ||
+        (axes_[i]->getTrajDataSourceType() == ECMC_DATA_SOURCE_INTERNAL)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int ecmcAxisGroup::startMove() {
+  if (!validated_) {
+    abortMove(ERROR_AXIS_GROUP_NOT_VALIDATED);
+    return ERROR_AXIS_GROUP_NOT_VALIDATED;
+  }
+
+  for (int i = 0; i < dofs_; i++) {
+    if (axes_[i]->getTrajDataSourceType() == ECMC_DATA_SOURCE_INTERNAL) {
+      abortMove(ERROR_AXIS_GROUP_AXIS_TRAJ_SOURCE_NOT_EXTERNAL);
+      return ERROR_AXIS_GROUP_AXIS_TRAJ_SOURCE_NOT_EXTERNAL;
+    }
+  }
+
+  if (!membersReady()) {
+    abortMove(ERROR_AXIS_GROUP_AXIS_NOT_READY);
+    return ERROR_AXIS_GROUP_AXIS_NOT_READY;
+  }
+
+  if (!readTargetPos()) {
+    abortMove(ERROR_AXIS_GROUP_TARGET_POS_BUSY);
+    return ERROR_AXIS_GROUP_TARGET_POS_BUSY;
+  }
+
+  errorReset();
+
+  // Start from current setpoints (or from current state if already moving)
+  if (!busy_) {
+    for (int i = 0; i < dofs_; i++) {
+      axes_[i]->getPosSet(&pos_[i]);
+      vel_[i] = 0;
+      acc_[i] = 0;
+    }
+  }
+
+  switch (syncType_) {
+  case ECMC_AXIS_GROUP_SYNC_TIME_IF_NECESSARY:
+    input_->synchronization = Synchronization::TimeIfNecessary;
+    break;
+
+  case ECMC_AXIS_GROUP_SYNC_PHASE:
+    input_->synchronization = Synchronization::Phase;
+    break;
+
+  case ECMC_AXIS_GROUP_SYNC_NONE:
+    input_->synchronization = Synchronization::None;
+    break;
+
+  default:
+    input_->synchronization = Synchronization::Time;
+    break;
+  }
+
+  input_->control_interface = ControlInterface::Position;
+
+  for (int i = 0; i < dofs_; i++) {
+    input_->current_position[i]     = pos_[i];
+    input_->current_velocity[i]     = vel_[i];
+    input_->current_acceleration[i] = acc_[i];
+    input_->target_position[i]      = targetPos_[i];
+  }
+
+  Result res = otg_->calculate(*input_, *traj_);
+
+  if (res < 0) {
+    abortMove(ERROR_AXIS_GROUP_RUCKIG_CALC_FAILED);
+    return ERROR_AXIS_GROUP_RUCKIG_CALC_FAILED;
+  }
+
+  time_     = 0;
+  moveTime_ = traj_->get_duration();
+  busy_     = 1;
+  return 0;
+}
+
+int ecmcAxisGroup::startStop() {
+  // Ramp all axes down to zero velocity with the same synchronization
+  input_->control_interface = ControlInterface::Velocity;
+
+  for (int i = 0; i < dofs_; i++) {
+    input_->current_position[i]     = pos_[i];
+    input_->current_velocity[i]     = vel_[i];
+    input_->current_acceleration[i] = acc_[i];
+  }
+
+  Result res = otg_->calculate(*input_, *traj_);
+
+  if (res < 0) {
+    abortMove(ERROR_AXIS_GROUP_RUCKIG_CALC_FAILED);
+    return ERROR_AXIS_GROUP_RUCKIG_CALC_FAILED;
+  }
+
+  time_     = 0;
+  moveTime_ = traj_->get_duration();
+  return 0;
+}
+
+void ecmcAxisGroup::abortMove(int errorCode) {
+  // Member axes keep last setpoint (and handle their own errors)
+  busy_ = 0;
+  for (size_t i = 0; i < vel_.size(); i++) {
+    vel_[i] = 0;
+    acc_[i] = 0;
+  }
+  setErrorID(__FILE__, __FUNCTION__, __LINE__, errorCode);
+}
+
+int ecmcAxisGroup::execute(bool masterOK) {
+  if (executeCmd_ && !executeCmdOld_) {
+    startMove();
+  } else if (!executeCmd_ && executeCmdOld_ && busy_) {
+    startStop();
+  }
+  executeCmdOld_ = executeCmd_;
+
+  if (busy_) {
+    if (!masterOK || !membersReady()) {
+      abortMove(ERROR_AXIS_GROUP_AXIS_NOT_READY);
+    } else {
+      time_ += sampleTime_;
+
+      if (time_ >= moveTime_) {
+        time_ = moveTime_;
+        busy_ = 0;
+      }
+
+      traj_->at_time(time_, pos_, vel_, acc_);
+
+      for (int i = 0; i < dofs_; i++) {
+        axes_[i]->setExtSetPos(pos_[i]);
+      }
+    }
+  }
+
+  refreshAsyn();
+  return 0;
+}
+
+void ecmcAxisGroup::refreshAsyn() {
+  errorCode_ = getErrorID();
+
+  if (busyAsynParam_) {
+    busyAsynParam_->refreshParamRT(0);
+  }
+
+  if (moveTimeAsynParam_) {
+    moveTimeAsynParam_->refreshParamRT(0);
+  }
+
+  if (errorAsynParam_) {
+    errorAsynParam_->refreshParamRT(0);
+  }
+}
+
+asynStatus ecmcAxisGroup::groupAsynWriteExecute(void         *data,
+                                                size_t        bytes,
+                                                asynParamType asynParType) {
+  if ((bytes != sizeof(int)) || (asynParType != asynParamInt32)) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis group %d): Execute size or datatype missmatch.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      index_);
+    return asynError;
+  }
+  int execute = 0;
+  memcpy(&execute, data, bytes);
+  setExecute(execute);
+  return asynSuccess;
+}
+
+asynStatus ecmcAxisGroup::groupAsynWriteTargetPos(void         *data,
+                                                  size_t        bytes,
+                                                  asynParamType asynParType) {
+  if (asynParType != asynParamFloat64Array) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis group %d): Target position datatype missmatch.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      index_);
+    return asynError;
+  }
+
+  int count = (int)(bytes / sizeof(double));
+
+  if (count > ECMC_AXIS_GROUP_MAX_AXES) {
+    count = ECMC_AXIS_GROUP_MAX_AXES;
+  }
+  stageTargetPos(0, (const double *)data, count);
+  return asynSuccess;
+}
+
+int ecmcAxisGroup::createAsynParam(const char        *nameFormat,
+                                   asynParamType      asynType,
+                                   ecmcEcDataType     ecmcType,
+                                   uint8_t           *data,
+                                   size_t             bytes,
+                                   bool               allowWrite,
+                                   ecmcAsynDataItem **asynParamOut) {
+  char buffer[EC_MAX_OBJECT_PATH_CHAR_LENGTH];
+  unsigned int charCount = 0;
+
+  *asynParamOut = NULL;
+  charCount     = snprintf(buffer, sizeof(buffer), nameFormat, index_);
+
+  if (charCount >= sizeof(buffer) - 1) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis group %d): Failed to generate (%s). Buffer to small (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      index_,
+      nameFormat,
+      ERROR_AXIS_GROUP_ASYN_PARAM_REGISTER_FAIL);
+    return ERROR_AXIS_GROUP_ASYN_PARAM_REGISTER_FAIL;
+  }
+
+  ecmcAsynDataItem *paramTemp = asynPortDriver_->addNewAvailParam(buffer,
+                                                                  asynType,
+                                                                  data,
+                                                                  bytes,
+                                                                  ecmcType,
+                                                                  0);
+  if (!paramTemp) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis group %d): Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      index_,
+      buffer);
+    return ERROR_MAIN_ASYN_CREATE_PARAM_FAIL;
+  }
+  paramTemp->setAllowWriteToEcmc(allowWrite);
+  paramTemp->refreshParam(1);
+  *asynParamOut = paramTemp;
+  return 0;
+}
+
+int ecmcAxisGroup::initAsyn() {
+  if (asynPortDriver_ == NULL) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_GROUP_ASYN_PARAM_REGISTER_FAIL);
+  }
+
+  int errorCode = 0;
+
+  // Target positions (one element per member axis, in order added)
+  errorCode = createAsynParam(ECMC_AXIS_GROUP_STR "%d." ECMC_AXIS_GROUP_TARG_POS_STR,
+                              asynParamFloat64Array,
+                              ECMC_EC_F64,
+                              (uint8_t *)targetPosCmd_,
+                              sizeof(targetPosCmd_),
+                              true,
+                              &targPosAsynParam_);
+  if (errorCode) {
+    return errorCode;
+  }
+  targPosAsynParam_->setExeCmdFunctPtr(asynWriteGroupTargetPos, this);
+
+  // Execute (rising edge starts move, falling edge stops)
+  errorCode = createAsynParam(ECMC_AXIS_GROUP_STR "%d." ECMC_AXIS_GROUP_EXECUTE_STR,
+                              asynParamInt32,
+                              ECMC_EC_S32,
+                              (uint8_t *)&executeCmd_,
+                              sizeof(executeCmd_),
+                              true,
+                              &executeAsynParam_);
+  if (errorCode) {
+    return errorCode;
+  }
+  executeAsynParam_->setExeCmdFunctPtr(asynWriteGroupExecute, this);
+
+  // Busy
+  errorCode = createAsynParam(ECMC_AXIS_GROUP_STR "%d." ECMC_AXIS_GROUP_BUSY_STR,
+                              asynParamInt32,
+                              ECMC_EC_S32,
+                              (uint8_t *)&busy_,
+                              sizeof(busy_),
+                              false,
+                              &busyAsynParam_);
+  if (errorCode) {
+    return errorCode;
+  }
+
+  // Move time of current profile
+  errorCode = createAsynParam(ECMC_AXIS_GROUP_STR "%d." ECMC_AXIS_GROUP_MOVE_TIME_STR,
+                              asynParamFloat64,
+                              ECMC_EC_F64,
+                              (uint8_t *)&moveTime_,
+                              sizeof(moveTime_),
+                              false,
+                              &moveTimeAsynParam_);
+  if (errorCode) {
+    return errorCode;
+  }
+
+  // Error code
+  errorCode = createAsynParam(ECMC_AXIS_GROUP_STR "%d." ECMC_AXIS_GROUP_ERROR_STR,
+                              asynParamInt32,
+                              ECMC_EC_S32,
+                              (uint8_t *)&errorCode_,
+                              sizeof(errorCode_),
+                              false,
+                              &errorAsynParam_);
+  return errorCode;
+}
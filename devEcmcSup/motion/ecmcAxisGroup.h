@@ -0,0 +1,151 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcAxisGroup.h
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#ifndef ECMCAXISGROUP_H_
+#define ECMCAXISGROUP_H_
+
+#include <vector>
+#include "ecmcAxisBase.h"
+#include "../main/ecmcError.h"
+#include "../com/ecmcAsynPortDriver.h"
+#include <ruckig.hpp>
+
+#define ERROR_AXIS_GROUP_AXIS_NULL 0x14F80
+#define ERROR_AXIS_GROUP_AXIS_COUNT_OUT_OF_RANGE 0x14F81
+#define ERROR_AXIS_GROUP_AXIS_ALREADY_ADDED 0x14F82
+#define ERROR_AXIS_GROUP_AXIS_NOT_MEMBER 0x14F83
+#define ERROR_AXIS_GROUP_LIMIT_OUT_OF_RANGE 0x14F84
+#define ERROR_AXIS_GROUP_SYNC_TYPE_OUT_OF_RANGE 0x14F85
+#define ERROR_AXIS_GROUP_AXIS_TRAJ_SOURCE_NOT_EXTERNAL 0x14F86
+#define ERROR_AXIS_GROUP_AXIS_NOT_READY 0x14F87
+#define ERROR_AXIS_GROUP_RUCKIG_CALC_FAILED 0x14F88
+#define ERROR_AXIS_GROUP_ASYN_PARAM_REGISTER_FAIL 0x14F89
+#define ERROR_AXIS_GROUP_NOT_VALIDATED 0x14F8A
+#define ERROR_AXIS_GROUP_TARGET_POS_BUSY 0x14F8B
+
+// Attempts to read a consistent set of staged target positions
+#define ECMC_AXIS_GROUP_TARG_POS_READ_RETRIES 4
+
+enum ecmcAxisGroupSyncType {
+  ECMC_AXIS_GROUP_SYNC_TIME              = 0,
+  ECMC_AXIS_GROUP_SYNC_TIME_IF_NECESSARY = 1,
+  ECMC_AXIS_GROUP_SYNC_PHASE             = 2,
+  ECMC_AXIS_GROUP_SYNC_NONE              = 3,
+};
+
+using namespace ruckig;
+
+/**
+ * \class ecmcAxisGroup
+ *
+ * \ingroup ecmc
+ *
+ * \brief Coordinated positioning of a group of axes
+ *
+ * All member axes are planned in one multi-DOF ruckig instance so that
+ * the axes start and stop at the same time (time synchronization) or also
+ * follow a straight line (phase synchronization). The profile is calculated
+ * once when the move is executed and then sampled each cycle. The sampled
+ * setpoints are written directly to the member axes external trajectory
+ * setpoint (the member axes must use external trajectory source).
+ *
+ * Setting execute low during a move stops all member axes synchronized.
+ */
+class ecmcAxisGroup : public ecmcError {
+ public:
+  ecmcAxisGroup(ecmcAsynPortDriver *asynPortDriver,
+                int                 index,
+                double              sampleTime);
+  ~ecmcAxisGroup();
+  int    addAxis(ecmcAxisBase *axis,
+                 double        velocity,
+                 double        acceleration,
+                 double        jerk);
+  int    setSyncType(ecmcAxisGroupSyncType syncType);
+  int    setTargetPos(int    axisIndex,
+                      double position);
+  int    setExecute(bool execute);
+  bool   getBusy();
+  double getMoveTime();
+  int    getAxisCount();
+  int    validate();
+  int    execute(bool masterOK);
+
+  // Asyn write of execute
+  asynStatus groupAsynWriteExecute(void         *data,
+                                   size_t        bytes,
+                                   asynParamType asynParType);
+  // Asyn write of target positions
+  asynStatus groupAsynWriteTargetPos(void         *data,
+                                     size_t        bytes,
+                                     asynParamType asynParType);
+
+ private:
+  void   initVars();
+  int    initAsyn();
+  int    createAsynParam(const char        *nameFormat,
+                         asynParamType      asynType,
+                         ecmcEcDataType     ecmcType,
+                         uint8_t           *data,
+                         size_t             bytes,
+                         bool               allowWrite,
+                         ecmcAsynDataItem **asynParamOut);
+  int    memberIndex(int axisId);
+  bool   membersReady();
+  int    startMove();
+  int    startStop();
+  void   abortMove(int errorCode);
+  void   refreshAsyn();
+  void   stageTargetPos(int           first,
+                        const double *position,
+                        int           count);
+  bool   readTargetPos();
+
+  ecmcAsynPortDriver *asynPortDriver_;
+  int index_;
+  double sampleTime_;
+  int axesCount_;
+  int dofs_;  // Axes of allocated planner (set in validate(), used in realtime)
+  ecmcAxisBase *axes_[ECMC_AXIS_GROUP_MAX_AXES];
+  double velocity_[ECMC_AXIS_GROUP_MAX_AXES];
+  double acceleration_[ECMC_AXIS_GROUP_MAX_AXES];
+  double jerk_[ECMC_AXIS_GROUP_MAX_AXES];
+  double targetPos_[ECMC_AXIS_GROUP_MAX_AXES];  // Copied at start of move (RT)
+  // Staged by command and asyn threads (both hold the asyn port lock),
+  // read in realtime under sequence lock
+  double targetPosCmd_[ECMC_AXIS_GROUP_MAX_AXES];
+  uint32_t targetPosSeq_;
+  ecmcAxisGroupSyncType syncType_;
+  bool validated_;
+  int executeCmd_;
+  int executeCmdOld_;
+  int busy_;
+  int errorCode_;
+  double moveTime_;
+  double time_;
+
+  // Ruckig (allocated in validate() when member count is known)
+  Ruckig<DynamicDOFs>          *otg_;
+  InputParameter<DynamicDOFs>  *input_;
+  Trajectory<DynamicDOFs>      *traj_;
+  std::vector<double>           pos_;
+  std::vector<double>           vel_;
+  std::vector<double>           acc_;
+
+  ecmcAsynDataItem *targPosAsynParam_;
+  ecmcAsynDataItem *executeAsynParam_;
+  ecmcAsynDataItem *busyAsynParam_;
+  ecmcAsynDataItem *moveTimeAsynParam_;
+  ecmcAsynDataItem *errorAsynParam_;
+};
+
+#endif  /* ECMCAXISGROUP_H_ */
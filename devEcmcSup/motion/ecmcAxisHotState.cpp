@@ -0,0 +1,108 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcAxisHotState.cpp
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#include "ecmcAxisHotState.h"
+#include <cmath>
+#include <string.h>
+
+ecmcAxisHotState::ecmcAxisHotState() {
+  slotCount_ = 0;
+  memset(posAct_, 0, sizeof(posAct_));
+  memset(posSet_, 0, sizeof(posSet_));
+  memset(velAct_, 0, sizeof(velAct_));
+  memset(velSet_, 0, sizeof(velSet_));
+  memset(cntrlError_, 0, sizeof(cntrlError_));
+  memset(cntrlOutput_, 0, sizeof(cntrlOutput_));
+  memset(atTargetPos_, 0, sizeof(atTargetPos_));
+  memset(atTargetTol_, 0, sizeof(atTargetTol_));
+  memset(posLagTol_, 0, sizeof(posLagTol_));
+  memset(maxVel_, 0, sizeof(maxVel_));
+  memset(velDiffMax_, 0, sizeof(velDiffMax_));
+  memset(cntrlOutputHL_, 0, sizeof(cntrlOutputHL_));
+  memset(inAtTargetTol_, 0, sizeof(inAtTargetTol_));
+  memset(posLagExceeded_, 0, sizeof(posLagExceeded_));
+  memset(maxVelExceeded_, 0, sizeof(maxVelExceeded_));
+  memset(velDiffExceeded_, 0, sizeof(velDiffExceeded_));
+  memset(cntrlOutputHLExceeded_, 0, sizeof(cntrlOutputHLExceeded_));
+}
+
+ecmcAxisHotState::~ecmcAxisHotState() {}
+
+// Returns slot index or -1 if full
+int ecmcAxisHotState::addSlot() {
+  if (slotCount_ >= ECMC_MAX_AXES) {
+    return -1;
+  }
+  return slotCount_++;
+}
+
+int ecmcAxisHotState::getSlotCount() {
+  return slotCount_;
+}
+
+void ecmcAxisHotState::setLimits(int    slot,
+                                 double atTargetTol,
+                                 double posLagTol,
+                                 double maxVel,
+                                 double velDiffMax,
+                                 double cntrlOutputHL) {
+  if ((slot < 0) || (slot >= slotCount_)) {
+    return;
+  }
+  atTargetTol_[slot]   = atTargetTol;
+  posLagTol_[slot]     = posLagTol;
+  maxVel_[slot]        = maxVel;
+  velDiffMax_[slot]    = velDiffMax;
+  cntrlOutputHL_[slot] = cntrlOutputHL;
+}
+
+void ecmcAxisHotState::store(int                       slot,
+                             const ecmcAxisDataStatus *status) {
+  posAct_[slot]      = status->currentPositionActual;
+  posSet_[slot]      = status->currentPositionSetpoint;
+  velAct_[slot]      = status->currentVelocityActual;
+  velSet_[slot]      = status->currentVelocitySetpoint;
+  cntrlError_[slot]  = status->cntrlError;
+  cntrlOutput_[slot] = status->cntrlOutput;
+  atTargetPos_[slot] = status->currentTargetPositionModulo ==
+                       status->currentPositionSetpoint;
+}
+
+/* One loop per check over all slots. Comparisons are combined with
+   bitwise operators (no branches) so the loops can be vectorized. */
+void ecmcAxisHotState::executeChecks() {
+  const int n = slotCount_;
+
+  for (int i = 0; i < n; i++) {
+    inAtTargetTol_[i] = (std::fabs(cntrlError_[i]) < atTargetTol_[i]) &
+                        atTargetPos_[i];
+  }
+
+  for (int i = 0; i < n; i++) {
+    posLagExceeded_[i] = std::fabs(cntrlError_[i]) > posLagTol_[i];
+  }
+
+  for (int i = 0; i < n; i++) {
+    maxVelExceeded_[i] = (std::fabs(velAct_[i]) > maxVel_[i]) |
+                         (std::fabs(velSet_[i]) > maxVel_[i]);
+  }
+
+  for (int i = 0; i < n; i++) {
+    velDiffExceeded_[i] = std::fabs(cntrlOutput_[i] - velAct_[i]) >
+                          velDiffMax_[i];
+  }
+
+  for (int i = 0; i < n; i++) {
+    cntrlOutputHLExceeded_[i] = std::fabs(cntrlOutput_[i]) >
+                                cntrlOutputHL_[i];
+  }
+}
@@ -0,0 +1,108 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcAxisHotState.h
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#ifndef ECMCAXISHOTSTATE_H_
+#define ECMCAXISHOTSTATE_H_
+
+#include <stdint.h>
+#include "../main/ecmcDefinitions.h"
+#include "ecmcAxisData.h"
+
+#define ECMC_AXIS_HOT_STATE_ALIGN __attribute__((aligned(64)))
+
+/**
+ * \class ecmcAxisHotState
+ *
+ * \ingroup ecmc
+ *
+ * \brief Hot per cycle axis state of all axes as structure of arrays
+ *
+ * Each axis stores the fields used by the monitor checks in its own slot
+ * after reading inputs and setpoints (end of executeInputs()). When the
+ * inputs of all axes are read, the threshold checks (at target tolerance,
+ * position lag, max velocity, velocity difference and controller output
+ * high limit) are evaluated for all axes in one pass over contiguous
+ * arrays. The loops are branch free so the compiler can vectorize them.
+ *
+ * The monitors then use the results in the same cycle (executeOutputs()),
+ * instead of their own comparisons. Filter counters, enable conditions and
+ * errors are still handled per axis.
+ */
+class ecmcAxisHotState {
+ public:
+  ecmcAxisHotState();
+  ~ecmcAxisHotState();
+
+  int  addSlot();
+  int  getSlotCount();
+
+  // Non realtime (limits are pushed by the monitor when changed)
+  void setLimits(int    slot,
+                 double atTargetTol,
+                 double posLagTol,
+                 double maxVel,
+                 double velDiffMax,
+                 double cntrlOutputHL);
+
+  // Realtime
+  void store(int                       slot,
+             const ecmcAxisDataStatus *status);
+  void executeChecks();
+
+  bool getInAtTargetTol(int slot) {
+    return inAtTargetTol_[slot];
+  }
+
+  bool getPosLagExceeded(int slot) {
+    return posLagExceeded_[slot];
+  }
+
+  bool getMaxVelExceeded(int slot) {
+    return maxVelExceeded_[slot];
+  }
+
+  bool getVelDiffExceeded(int slot) {
+    return velDiffExceeded_[slot];
+  }
+
+  bool getCntrlOutputHLExceeded(int slot) {
+    return cntrlOutputHLExceeded_[slot];
+  }
+
+ private:
+  int slotCount_;
+
+  // Inputs (stored by axes)
+  double posAct_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+  double posSet_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+  double velAct_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+  double velSet_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+  double cntrlError_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+  double cntrlOutput_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+  uint8_t atTargetPos_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+
+  // Limits
+  double atTargetTol_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+  double posLagTol_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+  double maxVel_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+  double velDiffMax_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+  double cntrlOutputHL_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+
+  // Results
+  uint8_t inAtTargetTol_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+  uint8_t posLagExceeded_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+  uint8_t maxVelExceeded_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+  uint8_t velDiffExceeded_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+  uint8_t cntrlOutputHLExceeded_[ECMC_MAX_AXES] ECMC_AXIS_HOT_STATE_ALIGN;
+};
+
+#endif  /* ECMCAXISHOTSTATE_H_ */
@@ -0,0 +1,474 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcAxisPosCompare.cpp
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#include "ecmcAxisPosCompare.h"
+#include <cmath>
+#include <stdlib.h>
+#include <cstring>
+#include <new>
+#include "../main/ecmcErrorsList.h"
+
+/**
+ * Callback function for asynWrites (position compare enable)
+ * userObj = axis position compare object
+ *
+ * */
+asynStatus asynWritePosCmpEnable(void* data, size_t bytes, asynParamType asynParType,void *userObj) {
+  if (!userObj) {
+    return asynError;
+  }
+  return ((ecmcAxisPosCompare*)userObj)->posCmpAsynWriteEnable(data, bytes, asynParType);
+}
+
+ecmcAxisPosCompare::ecmcAxisPosCompare(ecmcAxisData       *data,
+                                       ecmcAsynPortDriver *asynPortDriver,
+                                       int                 tableSize)
+  : ecmcEcEntryLink(&(data->status_.errorCode), &(data->status_.warningCode)) {
+  initVars();
+  data_           = data;
+  asynPortDriver_ = asynPortDriver;
+
+  if ((tableSize < 0) || (tableSize > ECMC_AXIS_POS_CMP_MAX_TABLE_SIZE)) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis %d): Compare table size %d out of range (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      data_->axisId_,
+      tableSize,
+      ERROR_AXIS_POS_CMP_SIZE_OUT_OF_RANGE);
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_AXIS_POS_CMP_SIZE_OUT_OF_RANGE);
+    return;
+  }
+
+  if (tableSize > 0) {
+    try {
+      table_ = new double[tableSize];
+    } catch(std::bad_alloc& ex) {
+      LOGERR(
+        "%s/%s:%d: ERROR (axis %d): Mem alloc error.\n",
+        __FILE__,
+        __FUNCTION__,
+        __LINE__,
+        data_->axisId_);
+      exit(1);
+    }
+    memset(table_, 0, tableSize * sizeof(double));
+  }
+  tableSize_ = tableSize;
+  initAsyn();
+}
+
+ecmcAxisPosCompare::~ecmcAxisPosCompare() {
+  delete[] table_;
+  table_ = NULL;
+}
+
+void ecmcAxisPosCompare::initVars() {
+  data_            = NULL;
+  asynPortDriver_  = NULL;
+  mode_            = ECMC_AXIS_POS_CMP_MODE_EQUIDISTANT;
+  direction_       = ECMC_AXIS_POS_CMP_DIR_BOTH;
+  pulseCycles_     = 1;
+  start_           = 0;
+  step_            = 0;
+  count_           = 0;
+  table_           = NULL;
+  tableSize_       = 0;
+  tableCount_      = 0;
+  index_           = 0;
+  lastPos_         = 0;
+  indexValid_      = false;
+  pulseCounter_    = 0;
+  outputValue_     = false;
+  enableCmd_       = 0;
+  active_          = false;
+  triggerCount_    = 0;
+  nextPos_         = 0;
+  enableAsynParam_ = NULL;
+  countAsynParam_  = NULL;
+  nextAsynParam_   = NULL;
+}
+
+int ecmcAxisPosCompare::setEquidistant(double start, double step, int count) {
+  if (enableCmd_ || active_) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_POS_CMP_CHANGE_NOT_ALLOWED_WHEN_ENABLED);
+  }
+
+  if (!(step > 0) || !std::isfinite(step) || !std::isfinite(start) ||
+      (count < 1)) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_POS_CMP_PARAMETER_OUT_OF_RANGE);
+  }
+
+  start_ = start;
+  step_  = step;
+  count_ = count;
+  mode_  = ECMC_AXIS_POS_CMP_MODE_EQUIDISTANT;
+  return 0;
+}
+
+// Positions must be appended in ascending order
+int ecmcAxisPosCompare::appendTablePos(double pos) {
+  if (enableCmd_ || active_) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_POS_CMP_CHANGE_NOT_ALLOWED_WHEN_ENABLED);
+  }
+
+  if (tableCount_ >= tableSize_) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_POS_CMP_TABLE_FULL);
+  }
+
+  if (!std::isfinite(pos) ||
+      ((tableCount_ > 0) && !(pos > table_[tableCount_ - 1]))) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_POS_CMP_TABLE_NOT_SORTED);
+  }
+
+  table_[tableCount_++] = pos;
+  mode_                 = ECMC_AXIS_POS_CMP_MODE_TABLE;
+  return 0;
+}
+
+int ecmcAxisPosCompare::clear() {
+  if (enableCmd_ || active_) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_POS_CMP_CHANGE_NOT_ALLOWED_WHEN_ENABLED);
+  }
+
+  tableCount_   = 0;
+  count_        = 0;
+  triggerCount_ = 0;
+  mode_         = ECMC_AXIS_POS_CMP_MODE_EQUIDISTANT;
+  return 0;
+}
+
+int ecmcAxisPosCompare::setDirection(int direction) {
+  if ((direction < ECMC_AXIS_POS_CMP_DIR_BOTH) ||
+      (direction > ECMC_AXIS_POS_CMP_DIR_NEGATIVE)) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_POS_CMP_DIRECTION_OUT_OF_RANGE);
+  }
+  direction_ = direction;
+  return 0;
+}
+
+// Pulse width is rounded up to whole cycles (min one cycle)
+int ecmcAxisPosCompare::setPulseWidth(double seconds) {
+  if (!(seconds > 0) || !std::isfinite(seconds) ||
+      !(data_->sampleTime_ > 0)) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_POS_CMP_PARAMETER_OUT_OF_RANGE);
+  }
+
+  int cycles = (int)std::ceil(seconds / data_->sampleTime_ - 1e-9);
+  pulseCycles_ = cycles < 1 ? 1 : cycles;
+  return 0;
+}
+
+int ecmcAxisPosCompare::setEnable(bool enable) {
+  if (enable) {
+    if (getPosCount() == 0) {
+      return setErrorID(__FILE__,
+                        __FUNCTION__,
+                        __LINE__,
+                        ERROR_AXIS_POS_CMP_NO_POSITIONS);
+    }
+
+    if (!checkEntryExist(ECMC_AXIS_POS_CMP_ENTRY_INDEX_OUTPUT)) {
+      return setErrorID(__FILE__,
+                        __FUNCTION__,
+                        __LINE__,
+                        ERROR_AXIS_POS_CMP_OUTPUT_ENTRY_NULL);
+    }
+  }
+
+  // Start and stop is handled in execute()
+  enableCmd_ = enable;
+  return 0;
+}
+
+bool ecmcAxisPosCompare::getEnable() {
+  return enableCmd_;
+}
+
+int ecmcAxisPosCompare::getTriggerCount() {
+  return triggerCount_;
+}
+
+int ecmcAxisPosCompare::validate() {
+  if (!checkEntryExist(ECMC_AXIS_POS_CMP_ENTRY_INDEX_OUTPUT)) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_POS_CMP_OUTPUT_ENTRY_NULL);
+  }
+
+  int errorCode = validateEntry(ECMC_AXIS_POS_CMP_ENTRY_INDEX_OUTPUT);
+
+  if (errorCode) {
+    return setErrorID(__FILE__, __FUNCTION__, __LINE__, errorCode);
+  }
+  return 0;
+}
+
+int ecmcAxisPosCompare::getPosCount() {
+  return mode_ == ECMC_AXIS_POS_CMP_MODE_TABLE ? tableCount_ : count_;
+}
+
+double ecmcAxisPosCompare::getPos(int index) {
+  if (mode_ == ECMC_AXIS_POS_CMP_MODE_TABLE) {
+    return table_[index];
+  }
+  return start_ + step_ * index;
+}
+
+// Number of compare positions <= actPos (binary search for table)
+int ecmcAxisPosCompare::findIndex(double actPos) {
+  if (mode_ == ECMC_AXIS_POS_CMP_MODE_EQUIDISTANT) {
+    if (actPos < start_) {
+      return 0;
+    }
+    double index = std::floor((actPos - start_) / step_) + 1;
+    return index > count_ ? count_ : (int)index;
+  }
+
+  int low  = 0;
+  int high = tableCount_;
+
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+
+    if (table_[mid] <= actPos) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+// Move index from last cycle (only neighbouring positions are checked)
+int ecmcAxisPosCompare::updateIndex(double actPos) {
+  if (mode_ == ECMC_AXIS_POS_CMP_MODE_EQUIDISTANT) {
+    return findIndex(actPos);
+  }
+
+  int index = index_;
+
+  while ((index < tableCount_) && (actPos >= table_[index])) {
+    index++;
+  }
+
+  while ((index > 0) && (actPos < table_[index - 1])) {
+    index--;
+  }
+  return index;
+}
+
+void ecmcAxisPosCompare::updateNextPos() {
+  if (direction_ == ECMC_AXIS_POS_CMP_DIR_NEGATIVE) {
+    if (index_ > 0) {
+      nextPos_ = getPos(index_ - 1);
+    }
+    return;
+  }
+
+  if (index_ < getPosCount()) {
+    nextPos_ = getPos(index_);
+  }
+}
+
+void ecmcAxisPosCompare::writeOutput(bool value) {
+  outputValue_ = value;
+  writeEcEntryValue(ECMC_AXIS_POS_CMP_ENTRY_INDEX_OUTPUT, (uint64_t)value);
+}
+
+void ecmcAxisPosCompare::execute(bool masterOK) {
+  if (!enableCmd_ || !masterOK) {
+    if (active_) {
+      pulseCounter_ = 0;
+      indexValid_   = false;
+      writeOutput(false);
+      refreshAsyn();
+      active_ = false;
+    }
+    return;
+  }
+
+  active_ = true;
+  double actPos = data_->status_.currentPositionActual;
+
+  // Modulo wrap is not a crossing
+  bool wrapped = (data_->command_.moduloRange > 0) &&
+                 (std::fabs(actPos - lastPos_) >
+                  data_->command_.moduloRange / 2);
+
+  if (!indexValid_ || wrapped) {
+    index_      = findIndex(actPos);
+    indexValid_ = true;
+    updateNextPos();
+  } else {
+    int oldIndex = index_;
+    index_ = updateIndex(actPos);
+    int passed = index_ - oldIndex;
+
+    if (passed != 0) {
+      if (((passed > 0) && (direction_ != ECMC_AXIS_POS_CMP_DIR_NEGATIVE)) ||
+          ((passed < 0) && (direction_ != ECMC_AXIS_POS_CMP_DIR_POSITIVE))) {
+        // One pulse even if several positions passed in this cycle
+        triggerCount_ += abs(passed);
+        pulseCounter_  = pulseCycles_;
+      }
+      updateNextPos();
+    }
+  }
+  lastPos_ = actPos;
+
+  if (pulseCounter_ > 0) {
+    pulseCounter_--;
+    writeOutput(true);
+  } else {
+    writeOutput(false);
+  }
+  refreshAsyn();
+}
+
+void ecmcAxisPosCompare::refreshAsyn() {
+  if (enableAsynParam_) {
+    enableAsynParam_->refreshParamRT(0);
+  }
+
+  if (countAsynParam_) {
+    countAsynParam_->refreshParamRT(0);
+  }
+
+  if (nextAsynParam_) {
+    nextAsynParam_->refreshParamRT(0);
+  }
+}
+
+asynStatus ecmcAxisPosCompare::posCmpAsynWriteEnable(void         *data,
+                                                     size_t        bytes,
+                                                     asynParamType asynParType) {
+  if ((bytes != sizeof(int)) || (asynParType != asynParamInt32)) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis %d): Position compare enable size or datatype missmatch.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      data_->axisId_);
+    return asynError;
+  }
+  int enable = 0;
+  memcpy(&enable, data, bytes);
+  return setEnable(enable) ? asynError : asynSuccess;
+}
+
+ecmcAsynDataItem * ecmcAxisPosCompare::addParam(const char    *name,
+                                                asynParamType  type,
+                                                uint8_t       *buffer,
+                                                size_t         bytes,
+                                                ecmcEcDataType dataType) {
+  char nameBuffer[EC_MAX_OBJECT_PATH_CHAR_LENGTH];
+
+  // "ax%d.<name>"
+  unsigned int charCount = snprintf(nameBuffer,
+                                    sizeof(nameBuffer),
+                                    ECMC_AX_STR "%d.%s",
+                                    data_->axisId_,
+                                    name);
+
+  if (charCount >= sizeof(nameBuffer) - 1) {
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_AXIS_POS_CMP_ASYN_PARAM_REGISTER_FAIL);
+    return NULL;
+  }
+
+  ecmcAsynDataItem *param = asynPortDriver_->addNewAvailParam(nameBuffer,
+                                                              type,
+                                                              buffer,
+                                                              bytes,
+                                                              dataType,
+                                                              0);
+  if (!param) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      nameBuffer);
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_MAIN_ASYN_CREATE_PARAM_FAIL);
+    return NULL;
+  }
+  param->setAllowWriteToEcmc(false);
+  param->refreshParam(1);
+  return param;
+}
+
+int ecmcAxisPosCompare::initAsyn() {
+  if (asynPortDriver_ == NULL) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_POS_CMP_ASYN_PARAM_REGISTER_FAIL);
+  }
+
+  enableAsynParam_ = addParam(ECMC_ASYN_AX_POS_CMP_ENABLE_NAME,
+                              asynParamInt32,
+                              (uint8_t *)&enableCmd_,
+                              sizeof(enableCmd_),
+                              ECMC_EC_S32);
+  if (enableAsynParam_) {
+    enableAsynParam_->setAllowWriteToEcmc(true);
+    enableAsynParam_->setExeCmdFunctPtr(asynWritePosCmpEnable, this);
+  }
+
+  countAsynParam_ = addParam(ECMC_ASYN_AX_POS_CMP_COUNT_NAME,
+                             asynParamInt32,
+                             (uint8_t *)&triggerCount_,
+                             sizeof(triggerCount_),
+                             ECMC_EC_S32);
+
+  nextAsynParam_ = addParam(ECMC_ASYN_AX_POS_CMP_NEXT_NAME,
+                            asynParamFloat64,
+                            (uint8_t *)&nextPos_,
+                            sizeof(nextPos_),
+                            ECMC_EC_F64);
+  return getErrorID();
+}
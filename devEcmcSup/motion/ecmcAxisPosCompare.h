@@ -0,0 +1,150 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcAxisPosCompare.h
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#ifndef ECMCAXISPOSCOMPARE_H_
+#define ECMCAXISPOSCOMPARE_H_
+
+#include <stdint.h>
+#include "ecmcAxisData.h"
+#include "../ethercat/ecmcEcEntryLink.h"
+#include "../com/ecmcAsynPortDriver.h"
+
+#define ERROR_AXIS_POS_CMP_SIZE_OUT_OF_RANGE 0x14FB0
+#define ERROR_AXIS_POS_CMP_TABLE_FULL 0x14FB1
+#define ERROR_AXIS_POS_CMP_TABLE_NOT_SORTED 0x14FB2
+#define ERROR_AXIS_POS_CMP_CHANGE_NOT_ALLOWED_WHEN_ENABLED 0x14FB3
+#define ERROR_AXIS_POS_CMP_NO_POSITIONS 0x14FB4
+#define ERROR_AXIS_POS_CMP_OUTPUT_ENTRY_NULL 0x14FB5
+#define ERROR_AXIS_POS_CMP_DIRECTION_OUT_OF_RANGE 0x14FB6
+#define ERROR_AXIS_POS_CMP_PARAMETER_OUT_OF_RANGE 0x14FB7
+#define ERROR_AXIS_POS_CMP_ALREADY_CREATED 0x14FB8
+#define ERROR_AXIS_POS_CMP_ASYN_PARAM_REGISTER_FAIL 0x14FB9
+
+// Max number of table positions
+#define ECMC_AXIS_POS_CMP_MAX_TABLE_SIZE (1 << 20)
+
+// Entry index of trigger output
+#define ECMC_AXIS_POS_CMP_ENTRY_INDEX_OUTPUT 0
+
+enum ecmcAxisPosCmpMode {
+  ECMC_AXIS_POS_CMP_MODE_EQUIDISTANT = 0,
+  ECMC_AXIS_POS_CMP_MODE_TABLE       = 1,
+};
+
+enum ecmcAxisPosCmpDirection {
+  ECMC_AXIS_POS_CMP_DIR_BOTH     = 0,
+  ECMC_AXIS_POS_CMP_DIR_POSITIVE = 1,
+  ECMC_AXIS_POS_CMP_DIR_NEGATIVE = 2,
+};
+
+/**
+ * \class ecmcAxisPosCompare
+ *
+ * \ingroup ecmc
+ *
+ * \brief Position compare trigger output (detector triggering)
+ *
+ * Compares the actual position of the axis with a sorted list of compare
+ * positions, either equidistant (start, step, count) or a table. The
+ * number of compare positions below the actual position is kept as an
+ * index so each cycle only checks the neighbouring positions (or
+ * calculates the index directly for equidistant positions). When one or
+ * more positions are passed in an allowed direction a pulse is written to
+ * the linked output entry for the configured number of cycles.
+ *
+ * For modulo axes a jump of more than half the modulo range is treated
+ * as a wrap and does not trigger.
+ *
+ * Asyn parameters:
+ *  ax<id>.poscmpenable
+ *  ax<id>.poscmpcount  (number of triggers)
+ *  ax<id>.poscmpnext   (next compare position, negative side if only
+ *                       negative direction is allowed)
+ */
+class ecmcAxisPosCompare : public ecmcEcEntryLink {
+ public:
+  ecmcAxisPosCompare(ecmcAxisData       *data,
+                     ecmcAsynPortDriver *asynPortDriver,
+                     int                 tableSize);
+  ~ecmcAxisPosCompare();
+
+  // Configuration (non realtime)
+  int  setEquidistant(double start,
+                      double step,
+                      int    count);
+  int  appendTablePos(double pos);
+  int  clear();
+  int  setDirection(int direction);
+  int  setPulseWidth(double seconds);
+  int  setEnable(bool enable);
+  bool getEnable();
+  int  getTriggerCount();
+  int  validate();
+
+  // Realtime
+  void execute(bool masterOK);
+
+  asynStatus posCmpAsynWriteEnable(void         *data,
+                                   size_t        bytes,
+                                   asynParamType asynParType);
+
+ private:
+  void   initVars();
+  int    initAsyn();
+  ecmcAsynDataItem* addParam(const char   *name,
+                             asynParamType type,
+                             uint8_t      *buffer,
+                             size_t        bytes,
+                             ecmcEcDataType dataType);
+  int    getPosCount();
+  double getPos(int index);
+  int    findIndex(double actPos);
+  int    updateIndex(double actPos);
+  void   updateNextPos();
+  void   writeOutput(bool value);
+  void   refreshAsyn();
+
+  ecmcAxisData *data_;
+  ecmcAsynPortDriver *asynPortDriver_;
+
+  int mode_;
+  int direction_;
+  int pulseCycles_;
+
+  // Equidistant
+  double start_;
+  double step_;
+  int count_;
+
+  // Table (sorted ascending)
+  double *table_;
+  int tableSize_;
+  int tableCount_;
+
+  // Number of compare positions <= last position
+  int index_;
+  double lastPos_;
+  bool indexValid_;
+  int pulseCounter_;
+  bool outputValue_;
+
+  int enableCmd_;
+  bool active_;  // Written by realtime only
+  int32_t triggerCount_;
+  double nextPos_;
+
+  ecmcAsynDataItem *enableAsynParam_;
+  ecmcAsynDataItem *countAsynParam_;
+  ecmcAsynDataItem *nextAsynParam_;
+};
+
+#endif  /* ECMCAXISPOSCOMPARE_H_ */
@@ -0,0 +1,542 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcAxisPvt.cpp
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#include "ecmcAxisPvt.h"
+#include <cmath>
+#include <stdlib.h>
+#include <cstring>
+#include <new>
+#include "../main/ecmcErrorsList.h"
+
+/**
+ * Callback function for asynWrites (pvt enable)
+ * userObj = axis pvt object
+ *
+ * */
+asynStatus asynWritePvtEnable(void* data, size_t bytes, asynParamType asynParType,void *userObj) {
+  if (!userObj) {
+    return asynError;
+  }
+  return ((ecmcAxisPvt*)userObj)->pvtAsynWriteEnable(data, bytes, asynParType);
+}
+
+/**
+ * Callback function for asynWrites (pvt points)
+ * userObj = axis pvt object
+ *
+ * */
+asynStatus asynWritePvtPoints(void* data, size_t bytes, asynParamType asynParType,void *userObj) {
+  if (!userObj) {
+    return asynError;
+  }
+  return ((ecmcAxisPvt*)userObj)->pvtAsynWritePoints(data, bytes, asynParType);
+}
+
+ecmcAxisPvt::ecmcAxisPvt(ecmcAxisData       *data,
+                         ecmcAsynPortDriver *asynPortDriver,
+                         int                 size) {
+  initVars();
+  data_           = data;
+  asynPortDriver_ = asynPortDriver;
+
+  if ((size < 2) || (size > ECMC_AXIS_PVT_MAX_POINTS)) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis %d): PVT buffer size %d out of range (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      data_->axisId_,
+      size,
+      ERROR_AXIS_PVT_SIZE_OUT_OF_RANGE);
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_AXIS_PVT_SIZE_OUT_OF_RANGE);
+    return;
+  }
+
+  // Power of two for cheap index masking
+  size_ = 2;
+  while (size_ < (uint32_t)size) {
+    size_ <<= 1;
+  }
+  mask_ = size_ - 1;
+
+  try {
+    ring_      = new ecmcAxisPvtPoint[size_];
+    pointsRaw_ = new double[3 * ECMC_AXIS_PVT_BLOCK_MAX_POINTS];
+  } catch(std::bad_alloc& ex) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis %d): Mem alloc error.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      data_->axisId_);
+    exit(1);
+  }
+
+  memset(ring_, 0, size_ * sizeof(ecmcAxisPvtPoint));
+  memset(pointsRaw_, 0, 3 * ECMC_AXIS_PVT_BLOCK_MAX_POINTS * sizeof(double));
+  initAsyn();
+}
+
+ecmcAxisPvt::~ecmcAxisPvt() {
+  delete[] ring_;
+  ring_ = NULL;
+  delete[] pointsRaw_;
+  pointsRaw_ = NULL;
+}
+
+void ecmcAxisPvt::initVars() {
+  errorReset();
+  data_               = NULL;
+  asynPortDriver_     = NULL;
+  ring_               = NULL;
+  size_               = 0;
+  mask_               = 0;
+  head_               = 0;
+  tail_               = 0;
+  enableCmd_          = 0;
+  state_              = ECMC_AXIS_PVT_STATE_IDLE;
+  segValid_           = false;
+  segTime_            = 0;
+  startPos_           = 0;
+  startVel_           = 0;
+  outPos_             = 0;
+  outVel_             = 0;
+  stopping_           = false;
+  fillLevel_          = 0;
+  underruns_          = 0;
+  pointsRaw_          = NULL;
+  pointsAsynParam_    = NULL;
+  enableAsynParam_    = NULL;
+  stateAsynParam_     = NULL;
+  fillAsynParam_      = NULL;
+  underrunsAsynParam_ = NULL;
+  memset(&seg_, 0, sizeof(seg_));
+}
+
+int ecmcAxisPvt::getFillLevel() {
+  uint32_t head = __atomic_load_n(&head_, __ATOMIC_ACQUIRE);
+  uint32_t tail = __atomic_load_n(&tail_, __ATOMIC_ACQUIRE);
+
+  return (int)(head - tail);
+}
+
+int ecmcAxisPvt::getFreeCount() {
+  return (int)size_ - getFillLevel();
+}
+
+/* Append triplets (time, position, velocity). All points or none are
+   appended. Single producer (config and asyn writes, serialized by the
+   asyn port lock). */
+int ecmcAxisPvt::appendPoints(const double *triplets, int count) {
+  if (!ring_) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_PVT_SIZE_OUT_OF_RANGE);
+  }
+
+  if (count > getFreeCount()) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_PVT_BUFFER_FULL);
+  }
+
+  for (int i = 0; i < count; i++) {
+    if (!(triplets[3 * i] > 0) || !std::isfinite(triplets[3 * i]) ||
+        !std::isfinite(triplets[3 * i + 1]) ||
+        !std::isfinite(triplets[3 * i + 2])) {
+      return setErrorID(__FILE__,
+                        __FUNCTION__,
+                        __LINE__,
+                        ERROR_AXIS_PVT_POINT_INVALID);
+    }
+  }
+
+  // Only the producer writes head
+  uint32_t head = head_;
+
+  for (int i = 0; i < count; i++) {
+    ecmcAxisPvtPoint *point = &ring_[(head + i) & mask_];
+    point->time = triplets[3 * i];
+    point->pos  = triplets[3 * i + 1];
+    point->vel  = triplets[3 * i + 2];
+  }
+
+  // Publish all points at once
+  __atomic_store_n(&head_, head + count, __ATOMIC_RELEASE);
+  return 0;
+}
+
+int ecmcAxisPvt::appendPoint(double time, double pos, double vel) {
+  double triplet[3] = { time, pos, vel };
+
+  return appendPoints(triplet, 1);
+}
+
+int ecmcAxisPvt::clear() {
+  if (state_ == ECMC_AXIS_PVT_STATE_RUNNING) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_PVT_CHANGE_NOT_ALLOWED_WHEN_ACTIVE);
+  }
+
+  // Consumer is stopped so the producer may move tail
+  __atomic_store_n(&tail_, __atomic_load_n(&head_, __ATOMIC_ACQUIRE),
+                   __ATOMIC_RELEASE);
+  underruns_ = 0;
+  return 0;
+}
+
+int ecmcAxisPvt::setEnable(bool enable) {
+  if (enable) {
+    if (data_->command_.trajSource == ECMC_DATA_SOURCE_INTERNAL) {
+      return setErrorID(__FILE__,
+                        __FUNCTION__,
+                        __LINE__,
+                        ERROR_AXIS_PVT_TRAJ_SOURCE_NOT_EXTERNAL);
+    }
+
+    if ((state_ == ECMC_AXIS_PVT_STATE_IDLE) && (getFillLevel() == 0)) {
+      return setErrorID(__FILE__,
+                        __FUNCTION__,
+                        __LINE__,
+                        ERROR_AXIS_PVT_BUFFER_EMPTY);
+    }
+  }
+
+  // Start and stop is handled in execute()
+  enableCmd_ = enable;
+  return 0;
+}
+
+bool ecmcAxisPvt::getEnable() {
+  return enableCmd_;
+}
+
+int ecmcAxisPvt::getUnderruns() {
+  return underruns_;
+}
+
+ecmcAxisPvtState ecmcAxisPvt::getState() {
+  return (ecmcAxisPvtState)state_;
+}
+
+bool ecmcAxisPvt::pop(ecmcAxisPvtPoint *point) {
+  // Only the consumer writes tail
+  uint32_t tail = tail_;
+
+  if (__atomic_load_n(&head_, __ATOMIC_ACQUIRE) == tail) {
+    return false;
+  }
+
+  *point = ring_[tail & mask_];
+  __atomic_store_n(&tail_, tail + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+// Cubic Hermite between segment start and end point
+void ecmcAxisPvt::interpolate(double *pos, double *vel) {
+  double T  = seg_.time;
+  double s  = segTime_ / T;
+  double s2 = s * s;
+  double s3 = s2 * s;
+
+  *pos = (2 * s3 - 3 * s2 + 1) * startPos_ +
+         (s3 - 2 * s2 + s) * T * startVel_ +
+         (-2 * s3 + 3 * s2) * seg_.pos +
+         (s3 - s2) * T * seg_.vel;
+
+  *vel = ((6 * s2 - 6 * s) * (startPos_ - seg_.pos)) / T +
+         (3 * s2 - 4 * s + 1) * startVel_ +
+         (3 * s2 - 2 * s) * seg_.vel;
+}
+
+// Ramp velocity to zero with constant deceleration (true while moving)
+bool ecmcAxisPvt::decelerate(double deceleration) {
+  double dt  = data_->sampleTime_;
+  double dv  = deceleration > 0 ? deceleration * dt : std::fabs(outVel_);
+  double vel = 0;
+
+  if (std::fabs(outVel_) > dv) {
+    vel = outVel_ - std::copysign(dv, outVel_);
+  }
+  outPos_ += (outVel_ + vel) / 2 * dt;
+  outVel_  = vel;
+  return outVel_ != 0;
+}
+
+void ecmcAxisPvt::execute(bool enabled, double deceleration) {
+  if (!ring_) {
+    return;
+  }
+
+  // Stream only when enabled and using external trajectory source
+  if (!enabled || (data_->command_.trajSource == ECMC_DATA_SOURCE_INTERNAL)) {
+    enableCmd_ = 0;
+    state_     = ECMC_AXIS_PVT_STATE_IDLE;
+    stopping_  = false;
+    refreshAsyn();
+    return;
+  }
+
+  if (enableCmd_ && (state_ == ECMC_AXIS_PVT_STATE_IDLE)) {
+    startPos_ = data_->status_.currentPositionSetpoint;
+    startVel_ = data_->status_.currentVelocitySetpoint;
+    outPos_   = startPos_;
+    outVel_   = startVel_;
+    segTime_  = 0;
+    segValid_ = false;
+    stopping_ = false;
+    state_    = ECMC_AXIS_PVT_STATE_RUNNING;
+  } else if (!enableCmd_) {
+    // Stop (or acknowledge done/underrun), ramp down if moving
+    if (state_ == ECMC_AXIS_PVT_STATE_RUNNING) {
+      stopping_ = true;
+    }
+    state_ = ECMC_AXIS_PVT_STATE_IDLE;
+  }
+
+  if (state_ == ECMC_AXIS_PVT_STATE_RUNNING) {
+    segTime_ += data_->sampleTime_;
+
+    // Step to next segment(s)
+    while (!segValid_ || (segTime_ >= seg_.time)) {
+      if (segValid_) {
+        segTime_ -= seg_.time;
+        startPos_ = seg_.pos;
+        startVel_ = seg_.vel;
+        segValid_ = false;
+      }
+
+      if (!pop(&seg_)) {
+        outPos_ = startPos_;
+        outVel_ = startVel_;
+
+        if (startVel_ != 0) {
+          underruns_++;
+          state_    = ECMC_AXIS_PVT_STATE_UNDERRUN;
+          stopping_ = true;
+          setErrorID(__FILE__,
+                     __FUNCTION__,
+                     __LINE__,
+                     ERROR_AXIS_PVT_UNDERRUN);
+        } else {
+          state_ = ECMC_AXIS_PVT_STATE_DONE;
+        }
+        break;
+      }
+      segValid_ = true;
+    }
+
+    if (segValid_) {
+      interpolate(&outPos_, &outVel_);
+    }
+  }
+
+  if (stopping_) {
+    stopping_ = decelerate(deceleration);
+  }
+
+  if ((state_ != ECMC_AXIS_PVT_STATE_IDLE) || stopping_) {
+    double mod = data_->command_.moduloRange;
+    double pos = outPos_;
+
+    if (mod > 0) {
+      pos = std::fmod(pos, mod);
+
+      if (pos < 0) {
+        pos += mod;
+      }
+    }
+    data_->status_.externalTrajectoryPosition = pos;
+    data_->status_.externalTrajectoryVelocity = outVel_;
+  }
+
+  refreshAsyn();
+}
+
+void ecmcAxisPvt::refreshAsyn() {
+  fillLevel_ = getFillLevel();
+
+  if (stateAsynParam_) {
+    stateAsynParam_->refreshParamRT(0);
+  }
+
+  if (fillAsynParam_) {
+    fillAsynParam_->refreshParamRT(0);
+  }
+
+  if (underrunsAsynParam_) {
+    underrunsAsynParam_->refreshParamRT(0);
+  }
+}
+
+asynStatus ecmcAxisPvt::pvtAsynWriteEnable(void         *data,
+                                           size_t        bytes,
+                                           asynParamType asynParType) {
+  if ((bytes != sizeof(int)) || (asynParType != asynParamInt32)) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis %d): PVT enable size or datatype missmatch.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      data_->axisId_);
+    return asynError;
+  }
+  int enable = 0;
+  memcpy(&enable, data, bytes);
+  return setEnable(enable) ? asynError : asynSuccess;
+}
+
+/* Points as triplets: time0, pos0, vel0, time1, pos1, vel1, ...
+   Appended to the ring (all or none). */
+asynStatus ecmcAxisPvt::pvtAsynWritePoints(void         *data,
+                                           size_t        bytes,
+                                           asynParamType asynParType) {
+  if (asynParType != asynParamFloat64Array) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis %d): PVT points datatype missmatch.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      data_->axisId_);
+    return asynError;
+  }
+
+  size_t points = bytes / (3 * sizeof(double));
+
+  if (points > ECMC_AXIS_PVT_BLOCK_MAX_POINTS) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis %d): PVT block too large (max %d points).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      data_->axisId_,
+      ECMC_AXIS_PVT_BLOCK_MAX_POINTS);
+    return asynError;
+  }
+
+  memcpy(pointsRaw_, data, points * 3 * sizeof(double));
+
+  if (appendPoints(pointsRaw_, (int)points)) {
+    return asynError;
+  }
+
+  if (pointsAsynParam_) {
+    pointsAsynParam_->refreshParamRT(1, points * 3 * sizeof(double));
+  }
+  fillLevel_ = getFillLevel();
+
+  if (fillAsynParam_) {
+    fillAsynParam_->refreshParamRT(1);
+  }
+  return asynSuccess;
+}
+
+ecmcAsynDataItem * ecmcAxisPvt::addParam(const char    *name,
+                                         asynParamType  type,
+                                         uint8_t       *buffer,
+                                         size_t         bytes,
+                                         ecmcEcDataType dataType) {
+  char nameBuffer[EC_MAX_OBJECT_PATH_CHAR_LENGTH];
+
+  // "ax%d.<name>"
+  unsigned int charCount = snprintf(nameBuffer,
+                                    sizeof(nameBuffer),
+                                    ECMC_AX_STR "%d.%s",
+                                    data_->axisId_,
+                                    name);
+
+  if (charCount >= sizeof(nameBuffer) - 1) {
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_AXIS_PVT_ASYN_PARAM_REGISTER_FAIL);
+    return NULL;
+  }
+
+  ecmcAsynDataItem *param = asynPortDriver_->addNewAvailParam(nameBuffer,
+                                                              type,
+                                                              buffer,
+                                                              bytes,
+                                                              dataType,
+                                                              0);
+  if (!param) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      nameBuffer);
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_MAIN_ASYN_CREATE_PARAM_FAIL);
+    return NULL;
+  }
+  param->setAllowWriteToEcmc(false);
+  param->refreshParam(1);
+  return param;
+}
+
+int ecmcAxisPvt::initAsyn() {
+  if (asynPortDriver_ == NULL) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_PVT_ASYN_PARAM_REGISTER_FAIL);
+  }
+
+  pointsAsynParam_ = addParam(ECMC_ASYN_AX_PVT_POINTS_NAME,
+                              asynParamFloat64Array,
+                              (uint8_t *)pointsRaw_,
+                              3 * ECMC_AXIS_PVT_BLOCK_MAX_POINTS * sizeof(double),
+                              ECMC_EC_F64);
+  if (pointsAsynParam_) {
+    pointsAsynParam_->setAllowWriteToEcmc(true);
+    pointsAsynParam_->setExeCmdFunctPtr(asynWritePvtPoints, this);
+  }
+
+  enableAsynParam_ = addParam(ECMC_ASYN_AX_PVT_ENABLE_NAME,
+                              asynParamInt32,
+                              (uint8_t *)&enableCmd_,
+                              sizeof(enableCmd_),
+                              ECMC_EC_S32);
+  if (enableAsynParam_) {
+    enableAsynParam_->setAllowWriteToEcmc(true);
+    enableAsynParam_->setExeCmdFunctPtr(asynWritePvtEnable, this);
+  }
+
+  stateAsynParam_ = addParam(ECMC_ASYN_AX_PVT_STATE_NAME,
+                             asynParamInt32,
+                             (uint8_t *)&state_,
+                             sizeof(state_),
+                             ECMC_EC_S32);
+
+  fillAsynParam_ = addParam(ECMC_ASYN_AX_PVT_FILL_NAME,
+                            asynParamInt32,
+                            (uint8_t *)&fillLevel_,
+                            sizeof(fillLevel_),
+                            ECMC_EC_S32);
+
+  underrunsAsynParam_ = addParam(ECMC_ASYN_AX_PVT_UNDERRUNS_NAME,
+                                 asynParamInt32,
+                                 (uint8_t *)&underruns_,
+                                 sizeof(underruns_),
+                                 ECMC_EC_S32);
+  return getErrorID();
+}
@@ -0,0 +1,161 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcAxisPvt.h
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#ifndef ECMCAXISPVT_H_
+#define ECMCAXISPVT_H_
+
+#include <stdint.h>
+#include "ecmcAxisData.h"
+#include "../main/ecmcError.h"
+#include "../com/ecmcAsynPortDriver.h"
+
+#define ERROR_AXIS_PVT_SIZE_OUT_OF_RANGE 0x14FA0
+#define ERROR_AXIS_PVT_BUFFER_FULL 0x14FA1
+#define ERROR_AXIS_PVT_POINT_INVALID 0x14FA2
+#define ERROR_AXIS_PVT_CHANGE_NOT_ALLOWED_WHEN_ACTIVE 0x14FA3
+#define ERROR_AXIS_PVT_TRAJ_SOURCE_NOT_EXTERNAL 0x14FA4
+#define ERROR_AXIS_PVT_BUFFER_EMPTY 0x14FA5
+#define ERROR_AXIS_PVT_ASYN_PARAM_REGISTER_FAIL 0x14FA6
+#define ERROR_AXIS_PVT_ALREADY_CREATED 0x14FA7
+#define ERROR_AXIS_PVT_UNDERRUN 0x14FA8
+
+// Ring size is rounded up to a power of two
+#define ECMC_AXIS_PVT_MAX_POINTS (1 << 20)
+
+// Max points in one write to the ax<id>.pvtpoints waveform
+#define ECMC_AXIS_PVT_BLOCK_MAX_POINTS 4096
+
+enum ecmcAxisPvtState {
+  ECMC_AXIS_PVT_STATE_IDLE     = 0,
+  ECMC_AXIS_PVT_STATE_RUNNING  = 1,
+  ECMC_AXIS_PVT_STATE_DONE     = 2,
+  ECMC_AXIS_PVT_STATE_UNDERRUN = 3,
+};
+
+// Time is the duration of the segment from the previous point
+typedef struct {
+  double time;
+  double pos;
+  double vel;
+} ecmcAxisPvtPoint;
+
+/**
+ * \class ecmcAxisPvt
+ *
+ * \ingroup ecmc
+ *
+ * \brief Streamed position-velocity-time setpoints (fly scans)
+ *
+ * Points are appended in bulk by non realtime clients (config commands or
+ * the ax<id>.pvtpoints waveform) to a single producer/single consumer ring.
+ * The realtime loop consumes the ring in ecmcAxisReal::execute() and
+ * calculates the external trajectory setpoint with cubic Hermite
+ * interpolation between the points (position and velocity continuous).
+ * Head and tail are only accessed with atomic load/store, no locking per
+ * point is needed.
+ *
+ * The stream starts from the current setpoint when enabled. If the ring is
+ * empty at the end of a segment the stream stops. A stop with non zero
+ * velocity is counted as an underrun: the setpoint decelerates to standstill
+ * with the axis deceleration and ERROR_AXIS_PVT_UNDERRUN is set (also on the
+ * axis). The stream should therefore end with a zero velocity point. A
+ * stream disabled while running also decelerates to standstill.
+ *
+ * Asyn parameters:
+ *  ax<id>.pvtpoints    (write triplets: time, position, velocity)
+ *  ax<id>.pvtenable
+ *  ax<id>.pvtstate
+ *  ax<id>.pvtfill      (points in ring)
+ *  ax<id>.pvtunderruns
+ */
+class ecmcAxisPvt : public ecmcError {
+ public:
+  ecmcAxisPvt(ecmcAxisData       *data,
+              ecmcAsynPortDriver *asynPortDriver,
+              int                 size);
+  ~ecmcAxisPvt();
+
+  // Producer (non realtime)
+  int  appendPoints(const double *triplets,
+                    int           count);
+  int  appendPoint(double time,
+                   double pos,
+                   double vel);
+  int  clear();
+  int  setEnable(bool enable);
+  bool getEnable();
+  int  getFillLevel();
+  int  getFreeCount();
+  int  getUnderruns();
+  ecmcAxisPvtState getState();
+
+  // Consumer (realtime)
+  void execute(bool   enabled,
+               double deceleration);
+
+  // Asyn writes
+  asynStatus pvtAsynWriteEnable(void         *data,
+                                size_t        bytes,
+                                asynParamType asynParType);
+  asynStatus pvtAsynWritePoints(void         *data,
+                                size_t        bytes,
+                                asynParamType asynParType);
+
+ private:
+  void initVars();
+  int  initAsyn();
+  ecmcAsynDataItem* addParam(const char   *name,
+                             asynParamType type,
+                             uint8_t      *buffer,
+                             size_t        bytes,
+                             ecmcEcDataType dataType);
+  bool pop(ecmcAxisPvtPoint *point);
+  void interpolate(double *pos,
+                   double *vel);
+  bool decelerate(double deceleration);
+  void refreshAsyn();
+
+  ecmcAxisData *data_;
+  ecmcAsynPortDriver *asynPortDriver_;
+
+  // Ring (head written by producer, tail written by consumer)
+  ecmcAxisPvtPoint *ring_;
+  uint32_t size_;
+  uint32_t mask_;
+  uint32_t head_;
+  uint32_t tail_;
+
+  int enableCmd_;
+  int state_;
+
+  // Current segment
+  ecmcAxisPvtPoint seg_;
+  bool segValid_;
+  double segTime_;
+  double startPos_;
+  double startVel_;
+  double outPos_;
+  double outVel_;
+  bool stopping_;  // Ramp down to standstill (underrun or disable)
+
+  int32_t fillLevel_;
+  int32_t underruns_;
+  double *pointsRaw_;
+
+  ecmcAsynDataItem *pointsAsynParam_;
+  ecmcAsynDataItem *enableAsynParam_;
+  ecmcAsynDataItem *stateAsynParam_;
+  ecmcAsynDataItem *fillAsynParam_;
+  ecmcAsynDataItem *underrunsAsynParam_;
+};
+
+#endif  /* ECMCAXISPVT_H_ */
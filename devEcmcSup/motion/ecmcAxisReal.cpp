@@ -68,9 +68,24 @@ void ecmcAxisReal::initVars() {
 }
 
 void ecmcAxisReal::execute(bool masterOK) {
+  executeInputs(masterOK);
+  executeOutputs(masterOK);
+}
+
+/* Read inputs and update setpoints (everything before monitoring) */
+void ecmcAxisReal::executeInputs(bool masterOK) {
 
   ecmcAxisBase::preExecute(masterOK);
 
+  // Streamed PVT setpoints (overrides external trajectory setpoint)
+  if (pvt_) {
+    pvt_->execute(getEnabled(), traj_->getDec());
+
+    if (pvt_->getErrorID() == ERROR_AXIS_PVT_UNDERRUN) {
+      setErrorID(__FILE__, __FUNCTION__, __LINE__, ERROR_AXIS_PVT_UNDERRUN);
+    }
+  }
+
   drv_->readEntries();
   // Trajectory (External or internal)
   if (data_.command_.trajSource == ECMC_DATA_SOURCE_INTERNAL) {
@@ -90,7 +105,17 @@ void ecmcAxisReal::execute(bool masterOK) {
 
   traj_->setStartPos(data_.status_.currentPositionSetpoint);
   seq_.execute();
+  storeHotState();
+}
+
+/* Monitoring, control and write of outputs */
+void ecmcAxisReal::executeOutputs(bool masterOK) {
   mon_->execute();
+
+  // Position compare triggers (on actual position of primary encoder)
+  if (posCmp_) {
+    posCmp_->execute(masterOK);
+  }
   // Switch to internal trajectory temporary if interlock
   bool trajLock =
     ((data_.interlocks_.trajSummaryInterlockFWD &&
@@ -299,6 +324,14 @@ int ecmcAxisReal::validate() {
     return setErrorID(__FILE__, __FUNCTION__, __LINE__, error);
   }
 
+  if (posCmp_) {
+    error = posCmp_->validate();
+
+    if (error) {
+      return setErrorID(__FILE__, __FUNCTION__, __LINE__, error);
+    }
+  }
+
   error = seq_.validate();
 
   if (error) {
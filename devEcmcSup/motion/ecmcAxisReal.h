@@ -27,6 +27,8 @@ class ecmcAxisReal : public ecmcAxisBase {
                ecmcTrajTypes  trajType);
   ~ecmcAxisReal();
   void               execute(bool masterOK);
+  void               executeInputs(bool masterOK);
+  void               executeOutputs(bool masterOK);
   ecmcDriveBase    * getDrv();
   ecmcPIDController* getCntrl();
   int                validate();
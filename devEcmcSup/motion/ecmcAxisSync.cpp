@@ -0,0 +1,719 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcAxisSync.cpp
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#include "ecmcAxisSync.h"
+#include <cmath>
+#include <stdlib.h>
+#include <cstring>
+#include <new>
+#include "../main/ecmcErrorsList.h"
+
+/**
+ * Callback function for asynWrites (sync enable)
+ * userObj = axis sync object
+ *
+ * */
+asynStatus asynWriteSyncEnable(void* data, size_t bytes, asynParamType asynParType,void *userObj) {
+  if (!userObj) {
+    return asynError;
+  }
+  return ((ecmcAxisSync*)userObj)->syncAsynWriteEnable(data, bytes, asynParType);
+}
+
+/**
+ * Callback function for asynWrites (cam table)
+ * userObj = axis sync object
+ *
+ * */
+asynStatus asynWriteSyncCamTable(void* data, size_t bytes, asynParamType asynParType,void *userObj) {
+  if (!userObj) {
+    return asynError;
+  }
+  return ((ecmcAxisSync*)userObj)->syncAsynWriteCamTable(data, bytes, asynParType);
+}
+
+ecmcAxisSync::ecmcAxisSync(ecmcAxisData       *data,
+                           ecmcAsynPortDriver *asynPortDriver) {
+  initVars();
+  data_           = data;
+  asynPortDriver_ = asynPortDriver;
+
+  try {
+    cam_[0]      = new ecmcAxisSyncCamTable;
+    cam_[1]      = new ecmcAxisSyncCamTable;
+    camTableRaw_ = new double[2 * ECMC_AXIS_SYNC_CAM_MAX_POINTS];
+    splineTmp_   = new double[ECMC_AXIS_SYNC_CAM_MAX_POINTS];
+  } catch(std::bad_alloc& ex) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis %d): Mem alloc error.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      data_->axisId_);
+    exit(1);
+  }
+
+  memset(cam_[0], 0, sizeof(ecmcAxisSyncCamTable));
+  memset(cam_[1], 0, sizeof(ecmcAxisSyncCamTable));
+  memset(camTableRaw_, 0, 2 * ECMC_AXIS_SYNC_CAM_MAX_POINTS * sizeof(double));
+  initAsyn();
+}
+
+ecmcAxisSync::~ecmcAxisSync() {
+  delete cam_[0];
+  cam_[0] = NULL;
+  delete cam_[1];
+  cam_[1] = NULL;
+  delete[] camTableRaw_;
+  camTableRaw_ = NULL;
+  delete[] splineTmp_;
+  splineTmp_ = NULL;
+}
+
+void ecmcAxisSync::initVars() {
+  errorReset();
+  data_              = NULL;
+  masterData_        = NULL;
+  asynPortDriver_    = NULL;
+  source_            = ECMC_AXIS_SYNC_SOURCE_SETPOINT;
+  mode_              = ECMC_AXIS_SYNC_MODE_NONE;
+  state_             = ECMC_AXIS_SYNC_STATE_IDLE;
+  enableCmd_         = 0;
+  ratio_             = 1;
+  offset_            = 0;
+  engageTime_        = 0;
+  timer_             = 0;
+  camModulo_         = false;
+  masterInit_        = false;
+  masterRawOld_      = 0;
+  masterPos_         = 0;
+  masterVel_         = 0;
+  holdPos_           = 0;
+  outPos_            = 0;
+  outVel_            = 0;
+  disengageVel_      = 0;
+  cam_[0]            = NULL;
+  cam_[1]            = NULL;
+  camActive_         = 0;
+  camInUse_          = 0;
+  rtStarted_         = false;
+  camTableRaw_       = NULL;
+  splineTmp_         = NULL;
+  camTableAsynParam_ = NULL;
+  enableAsynParam_   = NULL;
+  stateAsynParam_    = NULL;
+}
+
+int ecmcAxisSync::setMaster(ecmcAxisData      *masterData,
+                            ecmcAxisSyncSource source) {
+  if (masterData == NULL) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_SYNC_MASTER_NULL);
+  }
+
+  if ((source != ECMC_AXIS_SYNC_SOURCE_SETPOINT) &&
+      (source != ECMC_AXIS_SYNC_SOURCE_ACTUAL)) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_SYNC_SOURCE_OUT_OF_RANGE);
+  }
+
+  if (state_ != ECMC_AXIS_SYNC_STATE_IDLE) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_SYNC_CHANGE_NOT_ALLOWED_WHEN_ACTIVE);
+  }
+
+  masterData_ = masterData;
+  source_     = source;
+  masterInit_ = false;
+  return 0;
+}
+
+int ecmcAxisSync::setMode(ecmcAxisSyncMode mode) {
+  if ((mode != ECMC_AXIS_SYNC_MODE_NONE) &&
+      (mode != ECMC_AXIS_SYNC_MODE_GEAR) &&
+      (mode != ECMC_AXIS_SYNC_MODE_CAM)) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_SYNC_MODE_OUT_OF_RANGE);
+  }
+
+  if (state_ != ECMC_AXIS_SYNC_STATE_IDLE) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_SYNC_CHANGE_NOT_ALLOWED_WHEN_ACTIVE);
+  }
+  mode_ = mode;
+  return 0;
+}
+
+int ecmcAxisSync::setGear(double ratio, double offset) {
+  // Ratio and offset are read in realtime while engaged
+  if (state_ != ECMC_AXIS_SYNC_STATE_IDLE) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_SYNC_CHANGE_NOT_ALLOWED_WHEN_ACTIVE);
+  }
+  ratio_  = ratio;
+  offset_ = offset;
+  return 0;
+}
+
+int ecmcAxisSync::setEngageTime(double time) {
+  if (time < 0) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_SYNC_ENGAGE_TIME_OUT_OF_RANGE);
+  }
+  engageTime_ = time;
+  return 0;
+}
+
+int ecmcAxisSync::setCamModulo(bool modulo) {
+  camModulo_ = modulo;
+  return 0;
+}
+
+/* True until the realtime thread has switched to the last activated table
+   (it may still read the staging table) */
+bool ecmcAxisSync::camSwitchPending() {
+  int active = __atomic_load_n(&camActive_, __ATOMIC_SEQ_CST);
+
+  if (!__atomic_load_n(&rtStarted_, __ATOMIC_SEQ_CST)) {
+    // No realtime reader yet (configuration)
+    __atomic_store_n(&camInUse_, active, __ATOMIC_SEQ_CST);
+    return false;
+  }
+  return __atomic_load_n(&camInUse_, __ATOMIC_ACQUIRE) != active;
+}
+
+int ecmcAxisSync::clearCam() {
+  if (camSwitchPending()) {
+    // Not latched (realtime acknowledges within one cycle, retry)
+    return ERROR_AXIS_SYNC_CAM_SWITCH_PENDING;
+  }
+  cam_[1 - camActive_]->count = 0;
+  return 0;
+}
+
+int ecmcAxisSync::appendCamPoint(double master, double slave) {
+  if (camSwitchPending()) {
+    // Not latched (realtime acknowledges within one cycle, retry)
+    return ERROR_AXIS_SYNC_CAM_SWITCH_PENDING;
+  }
+
+  ecmcAxisSyncCamTable *staging = cam_[1 - camActive_];
+
+  if (staging->count >= ECMC_AXIS_SYNC_CAM_MAX_POINTS) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_SYNC_CAM_TABLE_FULL);
+  }
+
+  staging->x[staging->count] = master;
+  staging->y[staging->count] = slave;
+  staging->count++;
+  return 0;
+}
+
+/* Calculate spline of staging table and make it active.
+   Not realtime (called from config or asyn thread). */
+int ecmcAxisSync::activateCam() {
+  if (camSwitchPending()) {
+    // Not latched (realtime acknowledges within one cycle, retry)
+    return ERROR_AXIS_SYNC_CAM_SWITCH_PENDING;
+  }
+
+  ecmcAxisSyncCamTable *staging = cam_[1 - camActive_];
+  int n = staging->count;
+
+  if (n < 2) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_SYNC_CAM_TABLE_INVALID);
+  }
+
+  // Master positions must be strictly increasing
+  for (int i = 1; i < n; i++) {
+    if (staging->x[i] <= staging->x[i - 1]) {
+      return setErrorID(__FILE__,
+                        __FUNCTION__,
+                        __LINE__,
+                        ERROR_AXIS_SYNC_CAM_TABLE_INVALID);
+    }
+  }
+
+  // Uniform grid allows direct index calculation
+  staging->dx      = (staging->x[n - 1] - staging->x[0]) / (n - 1);
+  staging->uniform = true;
+
+  for (int i = 1; i < n; i++) {
+    if (std::abs(staging->x[i] - staging->x[i - 1] - staging->dx) >
+        1e-9 * staging->dx) {
+      staging->uniform = false;
+      break;
+    }
+  }
+
+  // Natural cubic spline (tridiagonal system, Thomas algorithm)
+  double *m = staging->m;
+  double *u = splineTmp_;
+  m[0] = 0;
+  u[0] = 0;
+
+  for (int i = 1; i < n - 1; i++) {
+    double sig = (staging->x[i] - staging->x[i - 1]) /
+                 (staging->x[i + 1] - staging->x[i - 1]);
+    double p   = sig * m[i - 1] + 2.0;
+    m[i] = (sig - 1.0) / p;
+    u[i] = (staging->y[i + 1] - staging->y[i]) /
+           (staging->x[i + 1] - staging->x[i]) -
+           (staging->y[i] - staging->y[i - 1]) /
+           (staging->x[i] - staging->x[i - 1]);
+    u[i] = (6.0 * u[i] / (staging->x[i + 1] - staging->x[i - 1]) -
+            sig * u[i - 1]) / p;
+  }
+  m[n - 1] = 0;
+
+  for (int i = n - 2; i >= 0; i--) {
+    m[i] = m[i] * m[i + 1] + u[i];
+  }
+
+  // Publish table (realtime acknowledges by setting camInUse_)
+  __atomic_store_n(&camActive_, 1 - camActive_, __ATOMIC_SEQ_CST);
+  camSwitchPending();  // Acknowledge directly if no realtime reader
+  return 0;
+}
+
+int ecmcAxisSync::setEnable(bool enable) {
+  if (enable) {
+    if ((masterData_ == NULL) || (mode_ == ECMC_AXIS_SYNC_MODE_NONE)) {
+      return setErrorID(__FILE__,
+                        __FUNCTION__,
+                        __LINE__,
+                        ERROR_AXIS_SYNC_NOT_CONFIGURED);
+    }
+
+    if ((mode_ == ECMC_AXIS_SYNC_MODE_CAM) && (cam_[camActive_]->count < 2)) {
+      return setErrorID(__FILE__,
+                        __FUNCTION__,
+                        __LINE__,
+                        ERROR_AXIS_SYNC_CAM_TABLE_INVALID);
+    }
+
+    if (data_->command_.trajSource == ECMC_DATA_SOURCE_INTERNAL) {
+      return setErrorID(__FILE__,
+                        __FUNCTION__,
+                        __LINE__,
+                        ERROR_AXIS_SYNC_TRAJ_SOURCE_NOT_EXTERNAL);
+    }
+  }
+
+  // Edge is handled in execute()
+  enableCmd_ = enable;
+  return 0;
+}
+
+bool ecmcAxisSync::getEnable() {
+  return enableCmd_;
+}
+
+ecmcAxisSyncState ecmcAxisSync::getState() {
+  return (ecmcAxisSyncState)state_;
+}
+
+double ecmcAxisSync::wrapDiff(double diff, double range) {
+  if (range <= 0) {
+    return diff;
+  }
+
+  diff = std::fmod(diff, range);
+
+  if (diff > range / 2) {
+    diff -= range;
+  } else if (diff < -range / 2) {
+    diff += range;
+  }
+  return diff;
+}
+
+void ecmcAxisSync::readMaster() {
+  double raw = 0;
+
+  if (source_ == ECMC_AXIS_SYNC_SOURCE_ACTUAL) {
+    raw        = masterData_->status_.currentPositionActual;
+    masterVel_ = masterData_->status_.currentVelocityActual;
+  } else {
+    raw        = masterData_->status_.currentPositionSetpoint;
+    masterVel_ = masterData_->status_.currentVelocitySetpoint;
+  }
+
+  // Unwrap master modulo
+  if (!masterInit_) {
+    masterPos_  = raw;
+    masterInit_ = true;
+  } else {
+    masterPos_ += wrapDiff(raw - masterRawOld_,
+                           masterData_->command_.moduloRange);
+  }
+  masterRawOld_ = raw;
+}
+
+void ecmcAxisSync::camLookup(ecmcAxisSyncCamTable *table,
+                             double                master,
+                             double               *pos,
+                             double               *slope) {
+  int    n     = table->count;
+  double first = table->x[0];
+  double last  = table->x[n - 1];
+
+  if (camModulo_) {
+    double period = last - first;
+    master = std::fmod(master - first, period);
+
+    if (master < 0) {
+      master += period;
+    }
+    master += first;
+  } else if (master <= first) {
+    *pos   = table->y[0];
+    *slope = 0;
+    return;
+  } else if (master >= last) {
+    *pos   = table->y[n - 1];
+    *slope = 0;
+    return;
+  }
+
+  // Find interval
+  int i = 0;
+
+  if (table->uniform) {
+    i = (int)((master - first) / table->dx);
+  } else {
+    int lo = 0;
+    int hi = n - 1;
+
+    while (hi - lo > 1) {
+      int mid = (lo + hi) >> 1;
+
+      if (table->x[mid] > master) {
+        hi = mid;
+      } else {
+        lo = mid;
+      }
+    }
+    i = lo;
+  }
+
+  if (i < 0) {
+    i = 0;
+  } else if (i > n - 2) {
+    i = n - 2;
+  }
+
+  double h = table->x[i + 1] - table->x[i];
+  double a = (table->x[i + 1] - master) / h;
+  double b = (master - table->x[i]) / h;
+
+  *pos = a * table->y[i] + b * table->y[i + 1] +
+         ((a * a * a - a) * table->m[i] +
+          (b * b * b - b) * table->m[i + 1]) * h * h / 6.0;
+
+  *slope = (table->y[i + 1] - table->y[i]) / h -
+           (3.0 * a * a - 1.0) / 6.0 * h * table->m[i] +
+           (3.0 * b * b - 1.0) / 6.0 * h * table->m[i + 1];
+}
+
+void ecmcAxisSync::calcTarget(double *pos, double *vel) {
+  if (mode_ == ECMC_AXIS_SYNC_MODE_CAM) {
+    double slope = 0;
+    camLookup(cam_[camInUse_], masterPos_, pos, &slope);
+    *vel = slope * masterVel_;
+    return;
+  }
+
+  // Gear
+  *pos = ratio_ * masterPos_ + offset_;
+  *vel = ratio_ * masterVel_;
+}
+
+void ecmcAxisSync::execute(bool enabled) {
+  // Switch to last activated cam table (acknowledge to activateCam())
+  __atomic_store_n(&rtStarted_, true, __ATOMIC_SEQ_CST);
+  __atomic_store_n(&camInUse_,
+                   __atomic_load_n(&camActive_, __ATOMIC_SEQ_CST),
+                   __ATOMIC_SEQ_CST);
+
+  if (masterData_ == NULL) {
+    return;
+  }
+
+  readMaster();
+
+  // Sync only when enabled and using external trajectory source
+  if (!enabled || (data_->command_.trajSource == ECMC_DATA_SOURCE_INTERNAL)) {
+    enableCmd_ = 0;
+    state_     = ECMC_AXIS_SYNC_STATE_IDLE;
+
+    if (stateAsynParam_) {
+      stateAsynParam_->refreshParamRT(0);
+    }
+    return;
+  }
+
+  if (enableCmd_ && ((state_ == ECMC_AXIS_SYNC_STATE_IDLE) ||
+                     (state_ == ECMC_AXIS_SYNC_STATE_DISENGAGING))) {
+    holdPos_ = data_->status_.currentPositionSetpoint;
+    timer_   = 0;
+    state_   = ECMC_AXIS_SYNC_STATE_ENGAGING;
+  } else if (!enableCmd_ && ((state_ == ECMC_AXIS_SYNC_STATE_ENGAGING) ||
+                             (state_ == ECMC_AXIS_SYNC_STATE_ENGAGED))) {
+    disengageVel_ = outVel_;
+    timer_        = 0;
+    state_        = ECMC_AXIS_SYNC_STATE_DISENGAGING;
+  }
+
+  double targetPos = 0;
+  double targetVel = 0;
+  double slaveMod  = data_->command_.moduloRange;
+
+  switch (state_) {
+  case ECMC_AXIS_SYNC_STATE_ENGAGING:
+    calcTarget(&targetPos, &targetVel);
+    timer_ += data_->sampleTime_;
+
+    if (timer_ >= engageTime_) {
+      state_  = ECMC_AXIS_SYNC_STATE_ENGAGED;
+      outPos_ = targetPos;
+      outVel_ = targetVel;
+    } else {
+      // Smooth step blend from hold position to synchronized position
+      double t    = timer_ / engageTime_;
+      double w    = t * t * (3.0 - 2.0 * t);
+      double dw   = 6.0 * t * (1.0 - t) / engageTime_;
+      double diff = wrapDiff(targetPos - holdPos_, slaveMod);
+      outPos_ = holdPos_ + w * diff;
+      outVel_ = w * targetVel + dw * diff;
+    }
+    break;
+
+  case ECMC_AXIS_SYNC_STATE_ENGAGED:
+    calcTarget(&outPos_, &outVel_);
+    break;
+
+  case ECMC_AXIS_SYNC_STATE_DISENGAGING:
+    timer_ += data_->sampleTime_;
+
+    if (timer_ >= engageTime_) {
+      outVel_ = 0;
+      state_  = ECMC_AXIS_SYNC_STATE_IDLE;
+    } else {
+      outVel_ = disengageVel_ * (1.0 - timer_ / engageTime_);
+    }
+    outPos_ += outVel_ * data_->sampleTime_;
+    break;
+
+  default:
+    if (stateAsynParam_) {
+      stateAsynParam_->refreshParamRT(0);
+    }
+    return;
+  }
+
+  if (slaveMod > 0) {
+    outPos_ = std::fmod(outPos_, slaveMod);
+
+    if (outPos_ < 0) {
+      outPos_ += slaveMod;
+    }
+  }
+
+  data_->status_.externalTrajectoryPosition = outPos_;
+  data_->status_.externalTrajectoryVelocity = outVel_;
+
+  if (stateAsynParam_) {
+    stateAsynParam_->refreshParamRT(0);
+  }
+}
+
+asynStatus ecmcAxisSync::syncAsynWriteEnable(void         *data,
+                                             size_t        bytes,
+                                             asynParamType asynParType) {
+  if ((bytes != sizeof(int)) || (asynParType != asynParamInt32)) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis %d): Sync enable size or datatype missmatch.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      data_->axisId_);
+    return asynError;
+  }
+  int enable = 0;
+  memcpy(&enable, data, bytes);
+  return setEnable(enable) ? asynError : asynSuccess;
+}
+
+/* Cam table as pairs: master0, slave0, master1, slave1, ... */
+asynStatus ecmcAxisSync::syncAsynWriteCamTable(void         *data,
+                                               size_t        bytes,
+                                               asynParamType asynParType) {
+  if (asynParType != asynParamFloat64Array) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis %d): Cam table datatype missmatch.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      data_->axisId_);
+    return asynError;
+  }
+
+  size_t values = bytes / sizeof(double);
+
+  if (values > 2 * ECMC_AXIS_SYNC_CAM_MAX_POINTS) {
+    values = 2 * ECMC_AXIS_SYNC_CAM_MAX_POINTS;
+  }
+  memset(camTableRaw_, 0, 2 * ECMC_AXIS_SYNC_CAM_MAX_POINTS * sizeof(double));
+  memcpy(camTableRaw_, data, values * sizeof(double));
+
+  // Refused if realtime has not yet switched to the previous upload
+  if (clearCam()) {
+    return asynError;
+  }
+
+  for (size_t i = 0; i + 1 < values; i += 2) {
+    appendCamPoint(camTableRaw_[i], camTableRaw_[i + 1]);
+  }
+
+  if (activateCam()) {
+    return asynError;
+  }
+
+  camTableAsynParam_->refreshParamRT(1, values * sizeof(double));
+  return asynSuccess;
+}
+
+int ecmcAxisSync::initAsyn() {
+  if (asynPortDriver_ == NULL) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_SYNC_ASYN_PARAM_REGISTER_FAIL);
+  }
+
+  char buffer[EC_MAX_OBJECT_PATH_CHAR_LENGTH];
+  unsigned int charCount = 0;
+
+  // "ax%d.camtable"
+  charCount = snprintf(buffer,
+                       sizeof(buffer),
+                       ECMC_AX_STR "%d." ECMC_ASYN_AX_CAM_TABLE_NAME,
+                       data_->axisId_);
+
+  if (charCount >= sizeof(buffer) - 1) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_SYNC_ASYN_PARAM_REGISTER_FAIL);
+  }
+  camTableAsynParam_ = asynPortDriver_->addNewAvailParam(buffer,
+                                    asynParamFloat64Array,
+                                    (uint8_t *)camTableRaw_,
+                                    2 * ECMC_AXIS_SYNC_CAM_MAX_POINTS * sizeof(double),
+                                    ECMC_EC_F64,
+                                    0);
+  if (!camTableAsynParam_) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      buffer);
+    return ERROR_MAIN_ASYN_CREATE_PARAM_FAIL;
+  }
+  camTableAsynParam_->setAllowWriteToEcmc(true);
+  camTableAsynParam_->setExeCmdFunctPtr(asynWriteSyncCamTable, this);
+  camTableAsynParam_->refreshParam(1);
+
+  // "ax%d.syncenable"
+  charCount = snprintf(buffer,
+                       sizeof(buffer),
+                       ECMC_AX_STR "%d." ECMC_ASYN_AX_SYNC_ENABLE_NAME,
+                       data_->axisId_);
+
+  if (charCount >= sizeof(buffer) - 1) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_SYNC_ASYN_PARAM_REGISTER_FAIL);
+  }
+  enableAsynParam_ = asynPortDriver_->addNewAvailParam(buffer,
+                                    asynParamInt32,
+                                    (uint8_t *)&enableCmd_,
+                                    sizeof(enableCmd_),
+                                    ECMC_EC_S32,
+                                    0);
+  if (!enableAsynParam_) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      buffer);
+    return ERROR_MAIN_ASYN_CREATE_PARAM_FAIL;
+  }
+  enableAsynParam_->setAllowWriteToEcmc(true);
+  enableAsynParam_->setExeCmdFunctPtr(asynWriteSyncEnable, this);
+  enableAsynParam_->refreshParam(1);
+
+  // "ax%d.syncstate"
+  charCount = snprintf(buffer,
+                       sizeof(buffer),
+                       ECMC_AX_STR "%d." ECMC_ASYN_AX_SYNC_STATE_NAME,
+                       data_->axisId_);
+
+  if (charCount >= sizeof(buffer) - 1) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_SYNC_ASYN_PARAM_REGISTER_FAIL);
+  }
+  stateAsynParam_ = asynPortDriver_->addNewAvailParam(buffer,
+                                    asynParamInt32,
+                                    (uint8_t *)&state_,
+                                    sizeof(state_),
+                                    ECMC_EC_S32,
+                                    0);
+  if (!stateAsynParam_) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      buffer);
+    return ERROR_MAIN_ASYN_CREATE_PARAM_FAIL;
+  }
+  stateAsynParam_->setAllowWriteToEcmc(false);
+  stateAsynParam_->refreshParam(1);
+  return 0;
+}
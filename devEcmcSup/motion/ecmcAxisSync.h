@@ -0,0 +1,166 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcAxisSync.h
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#ifndef ECMCAXISSYNC_H_
+#define ECMCAXISSYNC_H_
+
+#include "ecmcAxisData.h"
+#include "../main/ecmcError.h"
+#include "../com/ecmcAsynPortDriver.h"
+
+#define ERROR_AXIS_SYNC_MASTER_NULL 0x14F90
+#define ERROR_AXIS_SYNC_MODE_OUT_OF_RANGE 0x14F91
+#define ERROR_AXIS_SYNC_SOURCE_OUT_OF_RANGE 0x14F92
+#define ERROR_AXIS_SYNC_CHANGE_NOT_ALLOWED_WHEN_ACTIVE 0x14F93
+#define ERROR_AXIS_SYNC_CAM_TABLE_FULL 0x14F94
+#define ERROR_AXIS_SYNC_CAM_TABLE_INVALID 0x14F95
+#define ERROR_AXIS_SYNC_ENGAGE_TIME_OUT_OF_RANGE 0x14F96
+#define ERROR_AXIS_SYNC_TRAJ_SOURCE_NOT_EXTERNAL 0x14F97
+#define ERROR_AXIS_SYNC_NOT_CONFIGURED 0x14F98
+#define ERROR_AXIS_SYNC_ASYN_PARAM_REGISTER_FAIL 0x14F99
+#define ERROR_AXIS_SYNC_CAM_SWITCH_PENDING 0x14F9A
+
+#define ECMC_AXIS_SYNC_CAM_MAX_POINTS 2048
+
+enum ecmcAxisSyncMode {
+  ECMC_AXIS_SYNC_MODE_NONE = 0,
+  ECMC_AXIS_SYNC_MODE_GEAR = 1,
+  ECMC_AXIS_SYNC_MODE_CAM  = 2,
+};
+
+enum ecmcAxisSyncSource {
+  ECMC_AXIS_SYNC_SOURCE_SETPOINT = 0,
+  ECMC_AXIS_SYNC_SOURCE_ACTUAL   = 1,
+};
+
+enum ecmcAxisSyncState {
+  ECMC_AXIS_SYNC_STATE_IDLE        = 0,
+  ECMC_AXIS_SYNC_STATE_ENGAGING    = 1,
+  ECMC_AXIS_SYNC_STATE_ENGAGED     = 2,
+  ECMC_AXIS_SYNC_STATE_DISENGAGING = 3,
+};
+
+// Cam table with natural cubic spline second derivatives
+typedef struct {
+  double x[ECMC_AXIS_SYNC_CAM_MAX_POINTS];
+  double y[ECMC_AXIS_SYNC_CAM_MAX_POINTS];
+  double m[ECMC_AXIS_SYNC_CAM_MAX_POINTS];
+  int    count;
+  bool   uniform;
+  double dx;
+} ecmcAxisSyncCamTable;
+
+/**
+ * \class ecmcAxisSync
+ *
+ * \ingroup ecmc
+ *
+ * \brief Native master/slave synchronization (gearing and cam)
+ *
+ * Calculates the external trajectory setpoint of a slave axis directly
+ * from a master axis position (setpoint or actual) each cycle:
+ * 1. Gear: slave = ratio * master + offset
+ * 2. Cam:  slave = f(master), cubic spline interpolation in a table
+ *    (O(1) lookup for uniform master grid, binary search otherwise).
+ *    Optionally the master position is wrapped over the table range.
+ *
+ * The velocity setpoint is calculated analytically (no velocity filter).
+ * Engage blends from the current setpoint to the synchronized setpoint over
+ * the engage time. Disengage ramps the velocity down to zero over the same
+ * time.
+ *
+ * For no lag the master axis should have a lower index than the slave
+ * (axes are executed in index order).
+ */
+class ecmcAxisSync : public ecmcError {
+ public:
+  ecmcAxisSync(ecmcAxisData       *data,
+               ecmcAsynPortDriver *asynPortDriver);
+  ~ecmcAxisSync();
+  int    setMaster(ecmcAxisData      *masterData,
+                   ecmcAxisSyncSource source);
+  int    setMode(ecmcAxisSyncMode mode);
+  int    setGear(double ratio,
+                 double offset);
+  int    setEngageTime(double time);
+  int    setCamModulo(bool modulo);
+  int    clearCam();
+  int    appendCamPoint(double master,
+                        double slave);
+  int    activateCam();
+  int    setEnable(bool enable);
+  bool   getEnable();
+  ecmcAxisSyncState getState();
+  void   execute(bool enabled);
+
+  // Asyn writes
+  asynStatus syncAsynWriteEnable(void         *data,
+                                 size_t        bytes,
+                                 asynParamType asynParType);
+  asynStatus syncAsynWriteCamTable(void         *data,
+                                   size_t        bytes,
+                                   asynParamType asynParType);
+
+ private:
+  void   initVars();
+  int    initAsyn();
+  void   readMaster();
+  bool   camSwitchPending();
+  void   calcTarget(double *pos,
+                    double *vel);
+  void   camLookup(ecmcAxisSyncCamTable *table,
+                   double                master,
+                   double               *pos,
+                   double               *slope);
+  double wrapDiff(double diff, double range);
+
+  ecmcAxisData *data_;
+  ecmcAxisData *masterData_;
+  ecmcAsynPortDriver *asynPortDriver_;
+  ecmcAxisSyncSource source_;
+  ecmcAxisSyncMode mode_;
+  int state_;
+  int enableCmd_;
+  double ratio_;
+  double offset_;
+  double engageTime_;
+  double timer_;
+  bool camModulo_;
+
+  // Master unwrapped (master modulo)
+  bool masterInit_;
+  double masterRawOld_;
+  double masterPos_;
+  double masterVel_;
+
+  // Engage/disengage
+  double holdPos_;
+  double outPos_;
+  double outVel_;
+  double disengageVel_;
+
+  // Double buffered cam (staging is the inactive table). camActive_ is
+  // published by activateCam(), camInUse_ is the table the realtime thread
+  // reads (acknowledge). Staging is refused until both are equal.
+  ecmcAxisSyncCamTable *cam_[2];
+  int camActive_;
+  int camInUse_;
+  bool rtStarted_;
+  double *camTableRaw_;
+  double *splineTmp_;
+
+  ecmcAsynDataItem *camTableAsynParam_;
+  ecmcAsynDataItem *enableAsynParam_;
+  ecmcAsynDataItem *stateAsynParam_;
+};
+
+#endif  /* ECMCAXISSYNC_H_ */
@@ -35,6 +35,12 @@ void ecmcAxisVirt::initVars() {
 }
 
 void ecmcAxisVirt::execute(bool masterOK) {
+  executeInputs(masterOK);
+  executeOutputs(masterOK);
+}
+
+/* Read inputs and update setpoints (everything before monitoring) */
+void ecmcAxisVirt::executeInputs(bool masterOK) {
 
   ecmcAxisBase::preExecute(masterOK);
 
@@ -58,6 +64,14 @@ void ecmcAxisVirt::execute(bool masterOK) {
     traj_->setStartPos(data_.status_.currentPositionSetpoint);
     seq_.execute();
     data_.status_.cntrlOutput = 0;
+  }
+  storeHotState();
+}
+
+/* Monitoring and status update */
+void ecmcAxisVirt::executeOutputs(bool masterOK) {
+
+  if (masterOK) {
     mon_->execute();
 
     // Switch to internal trajectory if interlock temporary
@@ -31,6 +31,8 @@ public:
                ecmcTrajTypes  trajType);
   ~ecmcAxisVirt();
   void execute(bool masterOK);
+  void executeInputs(bool masterOK);
+  void executeOutputs(bool masterOK);
   ecmcDriveBase *getDrv();
   ecmcPIDController *getCntrl();
   int validate();  
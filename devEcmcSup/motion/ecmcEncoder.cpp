@@ -51,6 +51,9 @@ ecmcEncoder::~ecmcEncoder() {
 
   delete positionFilter_;
   positionFilter_ = NULL;
+
+  delete latchCapture_;
+  latchCapture_ = NULL;
 }
 
 void ecmcEncoder::initVars() {
@@ -113,6 +116,13 @@ void ecmcEncoder::initVars() {
   encVelAct_            = NULL;
   asynPortDriver_       = NULL;
   maxPosDiffToPrimEnc_  = 0;
+  latchCapture_         = NULL;
+  hwLatchStatusDefined_ = false;
+  hwLatchValueDefined_  = false;
+  hwLatchTimeDefined_   = false;
+  hwLatchTimeBits_      = 0;
+  rawEncLatchValueOld_  = 0;
+  latchCaptureInit_     = false;
 }
 
 int64_t ecmcEncoder::getRawPosMultiTurn() {
@@ -423,41 +433,155 @@ int  ecmcEncoder::readHwActPos(bool masterOK) {
 
 int ecmcEncoder::readHwLatch() {
   // Encoder latch entries (status and position)
-  if (!encLatchFunctEnabled_) {
+  if (!encLatchFunctEnabled_ && !latchCapture_) {
     return 0;
   }
 
   uint64_t tempRaw = 0;
 
-  if (readEcEntryValue(ECMC_ENCODER_ENTRY_INDEX_LATCH_STATUS, &tempRaw)) {
-    return ERROR_ENC_ENTRY_READ_FAIL;
+  if (hwLatchStatusDefined_) {
+    if (readEcEntryValue(ECMC_ENCODER_ENTRY_INDEX_LATCH_STATUS, &tempRaw)) {
+      return ERROR_ENC_ENTRY_READ_FAIL;
+    }
+    encLatchStatusOld_ = encLatchStatus_;
+    encLatchStatus_    = tempRaw > 0;
   }
-  encLatchStatusOld_ = encLatchStatus_;
-  encLatchStatus_    = tempRaw > 0;
-   if (readEcEntryValue(ECMC_ENCODER_ENTRY_INDEX_LATCH_VALUE, &tempRaw)) {
+
+  if (readEcEntryValue(ECMC_ENCODER_ENTRY_INDEX_LATCH_VALUE, &tempRaw)) {
     return ERROR_ENC_ENTRY_READ_FAIL;
   }
-   // Also treat latched position as actual position (same mask and shift)
+
+  if (latchCapture_) {
+    int errorCode = captureHwLatch(tempRaw);
+    if (errorCode) {
+      return errorCode;
+    }
+  }
+
+  if (!encLatchFunctEnabled_) {
+    return 0;
+  }
+
+  // Also treat latched position as actual position (same mask and shift)
   rawEncLatchPos_ = (totalRawMask_ & tempRaw) - totalRawRegShift_;
    // if new latched value then calculate latched value in engineering units
   if (encLatchStatus_ > encLatchStatusOld_) {
-    // Calculate multiturn latch value position (raw)
-    // Use rawTurnsOld_ since over/under flow might have occured after
-    // value was latched in hardware
-    int64_t turns = handleOverUnderFlow(rawPosUintOld_,
-                                        rawEncLatchPos_,
-                                        rawTurnsOld_,
-                                        rawLimit_,
-                                        bits_);
-    rawEncLatchPosMultiTurn_ = turns * rawRange_ + rawEncLatchPos_ +
-                               rawPosOffset_;
-    actEncLatchPos_ = scale_ * rawEncLatchPosMultiTurn_ +
-                      engOffset_;
+    actEncLatchPos_ = latchRawToEng(tempRaw, &rawEncLatchPosMultiTurn_);
   }
 
   return 0;
 }
 
+double ecmcEncoder::latchRawToEng(uint64_t rawLatch, int64_t *rawMultiTurn) {
+  // Same mask and shift as actual position
+  uint64_t rawLatchPos = (totalRawMask_ & rawLatch) - totalRawRegShift_;
+
+  // Calculate multiturn latch value position (raw)
+  // Use rawTurnsOld_ since over/under flow might have occured after
+  // value was latched in hardware
+  int64_t turns = handleOverUnderFlow(rawPosUintOld_,
+                                      rawLatchPos,
+                                      rawTurnsOld_,
+                                      rawLimit_,
+                                      bits_);
+  *rawMultiTurn = turns * rawRange_ + rawLatchPos + rawPosOffset_;
+  return scale_ * (*rawMultiTurn) + engOffset_;
+}
+
+// Detect new latch events and push them to the capture ring
+int ecmcEncoder::captureHwLatch(uint64_t rawLatch) {
+  bool newEvent = false;
+
+  switch (latchCapture_->getMode()) {
+  case ECMC_ENC_LATCH_CAPTURE_RISING:
+    newEvent = encLatchStatus_ > encLatchStatusOld_;
+    break;
+
+  case ECMC_ENC_LATCH_CAPTURE_TOGGLE:
+    newEvent = encLatchStatus_ != encLatchStatusOld_;
+    break;
+
+  case ECMC_ENC_LATCH_CAPTURE_VALUE:
+    newEvent = latchCaptureInit_ && (rawLatch != rawEncLatchValueOld_);
+    break;
+  }
+
+  // Ignore old state at first cycle
+  if (!latchCaptureInit_) {
+    newEvent          = false;
+    latchCaptureInit_ = true;
+  }
+  rawEncLatchValueOld_ = rawLatch;
+
+  if (newEvent) {
+    uint64_t cycleTime = latchCapture_->getCycleDcTimeNs();
+    uint64_t dcTime    = cycleTime;
+
+    if (hwLatchTimeDefined_) {
+      uint64_t hwTime = 0;
+
+      if (readEcEntryValue(ECMC_ENCODER_ENTRY_INDEX_LATCH_TIME, &hwTime)) {
+        return ERROR_ENC_ENTRY_READ_FAIL;
+      }
+
+      // Extend 32bit DC time with upper bits of cycle time (latch is older)
+      if (hwLatchTimeBits_ < 64) {
+        dcTime = (cycleTime & 0xFFFFFFFF00000000ULL) | (hwTime & 0xFFFFFFFFULL);
+
+        if ((dcTime > cycleTime) && (dcTime >= 0x100000000ULL)) {
+          dcTime -= 0x100000000ULL;
+        }
+      } else {
+        dcTime = hwTime;
+      }
+    }
+
+    int64_t rawMultiTurn = 0;
+    double  pos          = latchRawToEng(rawLatch, &rawMultiTurn);
+    latchCapture_->push(encLatchStatus_, rawMultiTurn, pos, dcTime);
+  }
+  latchCapture_->publish();
+  return 0;
+}
+
+int ecmcEncoder::createLatchCapture(int             size,
+                                    int             mode,
+                                    const uint64_t *dcTimeSource) {
+  if (latchCapture_) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_ENC_LATCH_CAPTURE_ALREADY_CREATED);
+  }
+
+  if ((size < 1) || (size > ECMC_ENC_LATCH_CAPTURE_MAX_SIZE)) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_ENC_LATCH_CAPTURE_SIZE_OUT_OF_RANGE);
+  }
+
+  if ((mode < ECMC_ENC_LATCH_CAPTURE_RISING) ||
+      (mode > ECMC_ENC_LATCH_CAPTURE_VALUE)) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_ENC_LATCH_CAPTURE_MODE_OUT_OF_RANGE);
+  }
+
+  latchCapture_ = new ecmcEncoderLatchCapture(asynPortDriver_,
+                                              data_->axisId_,
+                                              index_,
+                                              size,
+                                              mode,
+                                              dcTimeSource);
+  return latchCapture_->getErrorID();
+}
+
+ecmcEncoderLatchCapture *ecmcEncoder::getLatchCapture() {
+  return latchCapture_;
+}
+
 int ecmcEncoder::readHwWarningError() {
   int errorLocal = 0;
   // Check warning link. Think about forwarding warning info to motor record somehow
@@ -649,6 +773,31 @@ int ecmcEncoder::validate() {
     encLatchFunctEnabled_ = false;
   }
 
+  // Latch capture (status not needed when capturing on value change)
+  hwLatchStatusDefined_ = checkEntryExist(ECMC_ENCODER_ENTRY_INDEX_LATCH_STATUS) &&
+                          !validateEntry(ECMC_ENCODER_ENTRY_INDEX_LATCH_STATUS);
+  hwLatchValueDefined_  = checkEntryExist(ECMC_ENCODER_ENTRY_INDEX_LATCH_VALUE) &&
+                          !validateEntry(ECMC_ENCODER_ENTRY_INDEX_LATCH_VALUE);
+  hwLatchTimeDefined_   = false;
+
+  if (checkEntryExist(ECMC_ENCODER_ENTRY_INDEX_LATCH_TIME)) {
+    errorCode = validateEntry(ECMC_ENCODER_ENTRY_INDEX_LATCH_TIME);
+    if (errorCode) {
+      return setErrorID(__FILE__, __FUNCTION__, __LINE__, errorCode);
+    }
+    getEntryBitCount(ECMC_ENCODER_ENTRY_INDEX_LATCH_TIME, &hwLatchTimeBits_);
+    hwLatchTimeDefined_ = true;
+  }
+
+  if (latchCapture_) {
+    if (!hwLatchValueDefined_ ||
+        (!hwLatchStatusDefined_ &&
+         (latchCapture_->getMode() != ECMC_ENC_LATCH_CAPTURE_VALUE))) {
+      return setErrorID(__FILE__, __FUNCTION__, __LINE__,
+                        ERROR_ENC_LATCH_CAPTURE_ENTRY_NULL);
+    }
+  }
+
   // Check reset link
   if (checkEntryExist(ECMC_ENCODER_ENTRY_INDEX_RESET)) {
     errorCode = validateEntry(ECMC_ENCODER_ENTRY_INDEX_RESET);
@@ -860,6 +1009,20 @@ int ecmcEncoder::setPosFilterEnable(bool enable) {
   return 0;
 }
 
+/*
+* Set velocity filter type (moving average or IIR low pass)
+*/
+int ecmcEncoder::setVeloFilterType(ecmcFilterType type) {
+  return velocityFilter_->setFilterType(type);
+}
+
+/*
+* Set velocity IIR low pass filter cut off frequency [Hz] and order
+*/
+int ecmcEncoder::setVeloFilterLowPass(double cutOffHz, int order) {
+  return velocityFilter_->setLowPassCutOff(cutOffHz, order);
+}
+
 void ecmcEncoder::errorReset() {
   
   // Reset hardware if needed
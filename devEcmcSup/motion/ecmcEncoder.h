@@ -29,6 +29,7 @@
 #include "ecmcFilter.h"
 #include "ecmcAxisData.h"
 #include "ecmcMotionUtils.h"
+#include "ecmcEncoderLatchCapture.h"
 
 // ENCODER ERRORS
 #define ERROR_ENC_ASSIGN_ENTRY_FAILED 0x14400
@@ -115,6 +116,8 @@ class ecmcEncoder : public ecmcEcEntryLink {
   int                   setVeloFilterSize(size_t size);
   int                   setPosFilterSize(size_t size);
   int                   setPosFilterEnable(bool enable);
+  int                   setVeloFilterType(ecmcFilterType type);
+  int                   setVeloFilterLowPass(double cutOffHz, int order);
   // Ref this encoder to other encoder at startup (i.e ref relative encoder to abs at startup)
   int                   setRefToOtherEncAtStartup(int encIndex);
   int                   getRefToOtherEncAtStartup();
@@ -125,6 +128,10 @@ class ecmcEncoder : public ecmcEcEntryLink {
 
   void                  setMaxPosDiffToPrimEnc(double distance);
   double                getMaxPosDiffToPrimEnc();
+  int                   createLatchCapture(int             size,
+                                           int             mode,
+                                           const uint64_t *dcTimeSource);
+  ecmcEncoderLatchCapture *getLatchCapture();
 
  protected:
   void                  initVars();
@@ -142,6 +149,9 @@ class ecmcEncoder : public ecmcEcEntryLink {
   int                  readHwActPos(bool masterOK);
   int                  readHwWarningError();
   int                  readHwLatch();
+  int                  captureHwLatch(uint64_t rawLatch);
+  double               latchRawToEng(uint64_t rawLatch,
+                                     int64_t *rawMultiTurn);
   
   encoderType encType_;
   ecmcFilter *velocityFilter_;
@@ -204,6 +214,15 @@ class ecmcEncoder : public ecmcEcEntryLink {
   int homeLatchCountOffset_;
   double maxPosDiffToPrimEnc_;
 
+  // Latch capture (touch probe)
+  ecmcEncoderLatchCapture *latchCapture_;
+  bool hwLatchStatusDefined_;
+  bool hwLatchValueDefined_;
+  bool hwLatchTimeDefined_;
+  int hwLatchTimeBits_;
+  uint64_t rawEncLatchValueOld_;
+  bool latchCaptureInit_;
+
   // Asyn
   ecmcAsynPortDriver     *asynPortDriver_;
   ecmcAsynDataItem       *encPosAct_;
@@ -0,0 +1,300 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcEncoderLatchCapture.cpp
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#include "ecmcEncoderLatchCapture.h"
+#include <stdlib.h>
+#include <cstring>
+#include <new>
+#include "../main/ecmcErrorsList.h"
+
+ecmcEncoderLatchCapture::ecmcEncoderLatchCapture(
+  ecmcAsynPortDriver *asynPortDriver,
+  int                 axisId,
+  int                 encIndex,
+  int                 size,
+  int                 mode,
+  const uint64_t     *dcTimeSource) {
+  initVars();
+  asynPortDriver_ = asynPortDriver;
+  axisId_         = axisId;
+  encIndex_       = encIndex;
+  mode_           = mode;
+  dcTimeSource_   = dcTimeSource;
+
+  if ((size < 1) || (size > ECMC_ENC_LATCH_CAPTURE_MAX_SIZE)) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis %d): Latch capture size %d out of range (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      axisId_,
+      size,
+      ERROR_ENC_LATCH_CAPTURE_SIZE_OUT_OF_RANGE);
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_ENC_LATCH_CAPTURE_SIZE_OUT_OF_RANGE);
+    return;
+  }
+
+  if ((mode < ECMC_ENC_LATCH_CAPTURE_RISING) ||
+      (mode > ECMC_ENC_LATCH_CAPTURE_VALUE)) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis %d): Latch capture mode %d out of range (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      axisId_,
+      mode,
+      ERROR_ENC_LATCH_CAPTURE_MODE_OUT_OF_RANGE);
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_ENC_LATCH_CAPTURE_MODE_OUT_OF_RANGE);
+    return;
+  }
+
+  // Power of two for cheap index masking
+  size_ = 1;
+  while (size_ < (uint32_t)size) {
+    size_ <<= 1;
+  }
+  mask_ = size_ - 1;
+
+  try {
+    ring_     = new ecmcEncLatchEvent[size_];
+    waveform_ = new double[size_ * ECMC_ENC_LATCH_CAPTURE_WF_EVENT_DOUBLES];
+  } catch(std::bad_alloc& ex) {
+    LOGERR(
+      "%s/%s:%d: ERROR (axis %d): Mem alloc error.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      axisId_);
+    exit(1);
+  }
+
+  memset(ring_, 0, size_ * sizeof(ecmcEncLatchEvent));
+  memset(waveform_, 0,
+         size_ * ECMC_ENC_LATCH_CAPTURE_WF_EVENT_DOUBLES * sizeof(double));
+  initAsyn();
+}
+
+ecmcEncoderLatchCapture::~ecmcEncoderLatchCapture() {
+  delete[] ring_;
+  ring_ = NULL;
+  delete[] waveform_;
+  waveform_ = NULL;
+}
+
+void ecmcEncoderLatchCapture::initVars() {
+  errorReset();
+  asynPortDriver_  = NULL;
+  axisId_          = 0;
+  encIndex_        = 0;
+  mode_            = ECMC_ENC_LATCH_CAPTURE_RISING;
+  dcTimeSource_    = NULL;
+  ring_            = NULL;
+  size_            = 0;
+  mask_            = 0;
+  writeCount_      = 0;
+  publishedCount_  = 0;
+  eventCount_      = 0;
+  waveform_        = NULL;
+  eventsAsynParam_ = NULL;
+  countAsynParam_  = NULL;
+}
+
+ecmcEncLatchCaptureMode ecmcEncoderLatchCapture::getMode() {
+  return (ecmcEncLatchCaptureMode)mode_;
+}
+
+// Application time of the frame processed in this cycle
+uint64_t ecmcEncoderLatchCapture::getCycleDcTimeNs() {
+  return dcTimeSource_ ? *dcTimeSource_ : 0;
+}
+
+void ecmcEncoderLatchCapture::push(int      status,
+                                   int64_t  rawPos,
+                                   double   pos,
+                                   uint64_t dcTimeNs) {
+  if (!ring_) {
+    return;
+  }
+
+  // Only the realtime thread writes
+  uint32_t seq = writeCount_;
+  ecmcEncLatchEvent *entry = &ring_[seq & mask_];
+
+  // Invalidate while writing
+  __atomic_store_n(&entry->sequence, 0, __ATOMIC_RELEASE);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  entry->status   = status;
+  entry->dcTimeNs = dcTimeNs;
+  entry->rawPos   = rawPos;
+  entry->pos      = pos;
+  __atomic_store_n(&entry->sequence, seq + 1, __ATOMIC_RELEASE);
+  __atomic_store_n(&writeCount_, seq + 1, __ATOMIC_RELEASE);
+  eventCount_++;
+}
+
+uint32_t ecmcEncoderLatchCapture::getWriteCount() {
+  return __atomic_load_n(&writeCount_, __ATOMIC_ACQUIRE);
+}
+
+/* Copy events from *nextSequence (0 = oldest in ring). Events already
+   overwritten are skipped (detect by gap in sequence). Returns number of
+   copied events and updates *nextSequence. */
+int ecmcEncoderLatchCapture::read(uint32_t          *nextSequence,
+                                  ecmcEncLatchEvent *buffer,
+                                  int                maxEvents) {
+  if (!ring_ || (maxEvents <= 0)) {
+    return 0;
+  }
+
+  uint32_t count = getWriteCount();
+  uint32_t first = *nextSequence;
+
+  // Reader ahead of writer (wrapped or reset)
+  if ((int32_t)(count - first) < 0) {
+    first = count;
+  }
+
+  if (count - first > size_) {
+    first = count - size_;
+  }
+
+  int      used = 0;
+  uint32_t seq  = first;
+
+  for (; (seq != count) && (used < maxEvents); seq++) {
+    ecmcEncLatchEvent *entry = &ring_[seq & mask_];
+    buffer[used] = *entry;
+
+    // Skip entries being written or already overwritten
+    if ((buffer[used].sequence != seq + 1) ||
+        (__atomic_load_n(&entry->sequence, __ATOMIC_ACQUIRE) != seq + 1)) {
+      continue;
+    }
+    used++;
+  }
+  *nextSequence = seq;
+  return used;
+}
+
+// Realtime: refresh counter and (at asyn rate) the waveform of last events
+void ecmcEncoderLatchCapture::publish() {
+  if (countAsynParam_) {
+    countAsynParam_->refreshParamRT(0);
+  }
+
+  if (!eventsAsynParam_ || (publishedCount_ == writeCount_) ||
+      !eventsAsynParam_->willRefreshNext() ||
+      !eventsAsynParam_->linkedToAsynClient()) {
+    return;
+  }
+
+  // Oldest first
+  uint32_t count = writeCount_;
+  uint32_t first = count > size_ ? count - size_ : 0;
+  size_t   index = 0;
+
+  for (uint32_t seq = first; seq != count; seq++) {
+    ecmcEncLatchEvent *entry = &ring_[seq & mask_];
+    waveform_[index++] = (double)entry->sequence;
+    waveform_[index++] = (double)(entry->dcTimeNs / 1000000000ULL);
+    waveform_[index++] = (double)(entry->dcTimeNs % 1000000000ULL);
+    waveform_[index++] = entry->pos;
+  }
+  eventsAsynParam_->refreshParamRT(1, index * sizeof(double));
+  publishedCount_ = count;
+}
+
+ecmcAsynDataItem * ecmcEncoderLatchCapture::addParam(
+  const char    *name,
+  asynParamType  type,
+  uint8_t       *buffer,
+  size_t         bytes,
+  ecmcEcDataType dataType) {
+  char nameBuffer[EC_MAX_OBJECT_PATH_CHAR_LENGTH];
+  unsigned int charCount = 0;
+
+  // First encoder without index (same as actpos)
+  if (encIndex_ == 0) {
+    charCount = snprintf(nameBuffer,
+                         sizeof(nameBuffer),
+                         ECMC_AX_STR "%d.%s",
+                         axisId_,
+                         name);
+  } else {
+    charCount = snprintf(nameBuffer,
+                         sizeof(nameBuffer),
+                         ECMC_AX_STR "%d.%s%d",
+                         axisId_,
+                         name,
+                         encIndex_);
+  }
+
+  if (charCount >= sizeof(nameBuffer) - 1) {
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_ENC_LATCH_CAPTURE_ASYN_PARAM_FAIL);
+    return NULL;
+  }
+
+  ecmcAsynDataItem *param = asynPortDriver_->addNewAvailParam(nameBuffer,
+                                                              type,
+                                                              buffer,
+                                                              bytes,
+                                                              dataType,
+                                                              0);
+  if (!param) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Add create default parameter for %s failed.\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      nameBuffer);
+    setErrorID(__FILE__,
+               __FUNCTION__,
+               __LINE__,
+               ERROR_MAIN_ASYN_CREATE_PARAM_FAIL);
+    return NULL;
+  }
+  param->setAllowWriteToEcmc(false);
+  param->refreshParam(1);
+  return param;
+}
+
+int ecmcEncoderLatchCapture::initAsyn() {
+  if (asynPortDriver_ == NULL) {
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_ENC_LATCH_CAPTURE_ASYN_PARAM_FAIL);
+  }
+
+  eventsAsynParam_ = addParam(ECMC_ASYN_ENC_LATCH_EVENTS_NAME,
+                              asynParamFloat64Array,
+                              (uint8_t *)waveform_,
+                              size_ * ECMC_ENC_LATCH_CAPTURE_WF_EVENT_DOUBLES *
+                              sizeof(double),
+                              ECMC_EC_F64);
+
+  countAsynParam_ = addParam(ECMC_ASYN_ENC_LATCH_COUNT_NAME,
+                             asynParamInt32,
+                             (uint8_t *)&eventCount_,
+                             sizeof(eventCount_),
+                             ECMC_EC_S32);
+  return getErrorID();
+}
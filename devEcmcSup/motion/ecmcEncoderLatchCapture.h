@@ -0,0 +1,121 @@
+/*************************************************************************\
+* Copyright (c) 2019 European Spallation Source ERIC
+* ecmc is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution. 
+*
+*  ecmcEncoderLatchCapture.h
+*
+*  Created on: Oct 19, 2026
+*      Author: anderssandstrom
+*
+\*************************************************************************/
+
+#ifndef ECMCENCODERLATCHCAPTURE_H_
+#define ECMCENCODERLATCHCAPTURE_H_
+
+#include <stdint.h>
+#include "../main/ecmcDefinitions.h"
+#include "../main/ecmcError.h"
+#include "../com/ecmcAsynPortDriver.h"
+
+#define ERROR_ENC_LATCH_CAPTURE_SIZE_OUT_OF_RANGE 0x14430
+#define ERROR_ENC_LATCH_CAPTURE_MODE_OUT_OF_RANGE 0x14431
+#define ERROR_ENC_LATCH_CAPTURE_ENTRY_NULL 0x14432
+#define ERROR_ENC_LATCH_CAPTURE_ALREADY_CREATED 0x14433
+#define ERROR_ENC_LATCH_CAPTURE_ASYN_PARAM_FAIL 0x14434
+#define ERROR_ENC_LATCH_CAPTURE_NULL 0x14435
+
+// Ring size is rounded up to a power of two
+#define ECMC_ENC_LATCH_CAPTURE_MAX_SIZE 4096
+
+// Doubles per event in asyn waveform (sequence, sec, nsec, position)
+#define ECMC_ENC_LATCH_CAPTURE_WF_EVENT_DOUBLES 4
+
+enum ecmcEncLatchCaptureMode {
+  ECMC_ENC_LATCH_CAPTURE_RISING = 0,  // Latch status rising edge
+  ECMC_ENC_LATCH_CAPTURE_TOGGLE = 1,  // Any change of latch status
+  ECMC_ENC_LATCH_CAPTURE_VALUE  = 2,  // Any change of latch value
+};
+
+typedef struct {
+  uint32_t sequence;  // Running number (entry valid if > 0)
+  int32_t  status;    // Latch status after event
+  uint64_t dcTimeNs;  // DC time [ns] (same base as application time)
+  int64_t  rawPos;    // Multiturn raw latch position
+  double   pos;       // Latch position [eng. units]
+} ecmcEncLatchEvent;
+
+/**
+ * \class ecmcEncoderLatchCapture
+ *
+ * \ingroup ecmc
+ *
+ * \brief Lossless capture of encoder (touch probe) latch events
+ *
+ * The encoder checks for new latch events each cycle and pushes them to a
+ * fixed size ring together with the DC time. The DC time is the hardware
+ * latch time if a "latchtime" entry is linked, otherwise the application
+ * time of the EtherCAT frame that carried the latch value.
+ *
+ * The ring is written by the realtime thread only. Readers are non
+ * destructive (each reader keeps its own next sequence number), so the
+ * same events can be read by the asyn waveform and plugins. Overwritten
+ * events are detected by the sequence number of the entry.
+ *
+ * Asyn parameters (encoder index > 0 adds the index as suffix):
+ *  ax<id>.latchevents  (last events: sequence, sec, nsec, position)
+ *  ax<id>.latchcount   (total number of events)
+ */
+class ecmcEncoderLatchCapture : public ecmcError {
+ public:
+  ecmcEncoderLatchCapture(ecmcAsynPortDriver *asynPortDriver,
+                          int                 axisId,
+                          int                 encIndex,
+                          int                 size,
+                          int                 mode,
+                          const uint64_t     *dcTimeSource);
+  ~ecmcEncoderLatchCapture();
+  ecmcEncLatchCaptureMode getMode();
+  uint64_t getCycleDcTimeNs();
+
+  // Realtime
+  void     push(int      status,
+                int64_t  rawPos,
+                double   pos,
+                uint64_t dcTimeNs);
+  void     publish();
+
+  // Non realtime (any number of readers)
+  uint32_t getWriteCount();
+  int      read(uint32_t          *nextSequence,
+                ecmcEncLatchEvent *buffer,
+                int                maxEvents);
+
+ private:
+  void initVars();
+  int  initAsyn();
+  ecmcAsynDataItem* addParam(const char   *name,
+                             asynParamType type,
+                             uint8_t      *buffer,
+                             size_t        bytes,
+                             ecmcEcDataType dataType);
+
+  ecmcAsynPortDriver *asynPortDriver_;
+  int axisId_;
+  int encIndex_;
+  int mode_;
+  const uint64_t *dcTimeSource_;
+
+  ecmcEncLatchEvent *ring_;
+  uint32_t size_;
+  uint32_t mask_;
+  uint32_t writeCount_;
+  uint32_t publishedCount_;
+
+  int32_t eventCount_;
+  double *waveform_;
+  ecmcAsynDataItem *eventsAsynParam_;
+  ecmcAsynDataItem *countAsynParam_;
+};
+
+#endif  /* ECMCENCODERLATCHCAPTURE_H_ */
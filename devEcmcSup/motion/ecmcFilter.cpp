@@ -11,15 +11,14 @@
 \*************************************************************************/
 
 #include "ecmcFilter.h"
+#include <cmath>
 
 ecmcFilter::ecmcFilter(double sampleTime) {
   initVars();
   sampleTime_ = sampleTime;
   filterSize_ = FILTER_BUFFER_SIZE_DEF;
   bufferVel_ = new double[filterSize_];
-  for (int i = 0; i < (int)filterSize_; i++) {
-    bufferVel_[i] = 0;
-  }
+  clearBuffer();
 }
 
 ecmcFilter::ecmcFilter(double sampleTime, size_t size) {
@@ -27,101 +26,212 @@ ecmcFilter::ecmcFilter(double sampleTime, size_t size) {
   sampleTime_ = sampleTime;
   filterSize_ = size;
   bufferVel_ = new double[filterSize_];
-  for (int i = 0; i < (int)filterSize_; i++) {
-    bufferVel_[i] = 0;
-  }
+  clearBuffer();
 }
 
-ecmcFilter::~ecmcFilter() {}
+ecmcFilter::~ecmcFilter() {
+  delete[] bufferVel_;
+  bufferVel_ = NULL;
+}
 
 void ecmcFilter::initVars() {
   errorReset();
-  indexVel_    = 0;
+  indexVel_      = 0;
+  bufferVel_     = NULL;
+  filterSize_    = 0;
+  my_            = 0;
+  last_          = 0;
+  lastOutput_    = 0;
+  sampleTime_    = 1;
+  sum_           = 0;
+  sumComp_       = 0;
+  lastUnwrapped_ = 0;
+  filterType_    = ECMC_FILTER_TYPE_MOVING_AVG;
+  cutOffHz_      = 0;
+  sections_      = 1;
+  memset(&sos_, 0, sizeof(sos_));
 }
 
-double ecmcFilter::getFiltVelo(double distSinceLastScan) {
-  double sum = 0;
+void ecmcFilter::clearBuffer() {
+  for (int i = 0; i < (int)filterSize_; i++) {
+    bufferVel_[i] = 0;
+  }
+  indexVel_ = 0;
+  sum_      = 0;
+  sumComp_  = 0;
+
+  for (int i = 0; i < FILTER_IIR_MAX_SECTIONS; i++) {
+    sos_[i].x1 = 0;
+    sos_[i].x2 = 0;
+    sos_[i].y1 = 0;
+    sos_[i].y2 = 0;
+  }
+}
+
+/*
+* Running sum (O(1)). Kahan compensated add of new value and
+* subtract of oldest value. Sum is recalculated from buffer once
+* per buffer turn to remove any accumulated rounding errors.
+*/
+double ecmcFilter::movingAvg(double value) {
+  double y = value - bufferVel_[indexVel_] - sumComp_;
+  double t = sum_ + y;
+  sumComp_ = (t - sum_) - y;
+  sum_     = t;
 
-  bufferVel_[indexVel_] = distSinceLastScan;
+  bufferVel_[indexVel_] = value;
   indexVel_++;
 
   if (indexVel_ >= filterSize_) {
     indexVel_ = 0;
   }
 
+  return sum_ / (static_cast<double>(filterSize_));
+}
+
+/*
+* Cascaded second order sections (direct form 1)
+*/
+double ecmcFilter::lowPass(double value) {
+  double x = value;
+  double y = 0;
+
+  for (int i = 0; i < sections_; i++) {
+    ecmcFilterSOS *s = &sos_[i];
+    y = s->b0 * x + s->b1 * s->x1 + s->b2 * s->x2 - s->a1 * s->y1 -
+        s->a2 * s->y2;
+    s->x2 = s->x1;
+    s->x1 = x;
+    s->y2 = s->y1;
+    s->y1 = y;
+    x     = y;
+  }
+  return y;
+}
+
+double ecmcFilter::addSample(double value) {
+  if (filterType_ == ECMC_FILTER_TYPE_IIR_LP) {
+    return lowPass(value);
+  }
+  return movingAvg(value);
+}
+
+/*
+* Recalculate sum from buffer (once per buffer turn)
+*/
+void ecmcFilter::renormalize() {
+  double sum  = 0;
+  double comp = 0;
+
   for (int i = 0; i < (int)filterSize_; i++) {
-    sum = sum + bufferVel_[i];
+    double y = bufferVel_[i] - comp;
+    double t = sum + y;
+    comp = (t - sum) - y;
+    sum  = t;
   }
+  sum_     = sum;
+  sumComp_ = comp;
+}
+
+/*
+* Shift all filter states (used to keep unwrapped modulo position
+* within range)
+*/
+void ecmcFilter::offsetStates(double offset) {
+  if (filterType_ == ECMC_FILTER_TYPE_IIR_LP) {
+    for (int i = 0; i < sections_; i++) {
+      sos_[i].x1 += offset;
+      sos_[i].x2 += offset;
+      sos_[i].y1 += offset;
+      sos_[i].y2 += offset;
+    }
+  } else {
+    for (int i = 0; i < (int)filterSize_; i++) {
+      bufferVel_[i] += offset;
+    }
+    renormalize();
+  }
+  lastUnwrapped_ += offset;
+}
+
+double ecmcFilter::getFiltVelo(double distSinceLastScan) {
+  lastOutput_ = addSample(distSinceLastScan) / sampleTime_;
 
-  lastOutput_ = sum / (static_cast<double>(filterSize_))/sampleTime_;
+  if ((filterType_ == ECMC_FILTER_TYPE_MOVING_AVG) && (indexVel_ == 0)) {
+    renormalize();
+  }
 
   return lastOutput_;
 }
 
 double ecmcFilter::getFiltPos(double pos, double modRange) {
-  double sum = 0;
+  double unwrapped = pos;
 
-  bufferVel_[indexVel_] = pos;
-  indexVel_++;
+  if (modRange > 0) {
+    // Unwrap relative last input
+    double modThreshold = FILTER_POS_MODULO_OVER_UNDER_FLOW_LIMIT * modRange;
+    double diff         = pos - last_;
 
-  if (indexVel_ >= filterSize_) {
-    indexVel_ = 0;
+    if (diff > modThreshold) {
+      diff = diff - modRange;
+    } else if (diff < -modThreshold) {
+      diff = diff + modRange;
+    }
+    unwrapped = lastUnwrapped_ + diff;
   }
 
-  double modThreshold = FILTER_POS_MODULO_OVER_UNDER_FLOW_LIMIT * modRange;
+  last_          = pos;
+  lastUnwrapped_ = unwrapped;
+  lastOutput_    = addSample(unwrapped);
 
-  for (int i = 0; i < (int)filterSize_; i++) {
-    // check if value over/under flow mod range compared to latest value
-    if((pos-bufferVel_[i]) > modThreshold) {
-      sum = sum + bufferVel_[i] + modRange;
-    }
-    else if ((pos-bufferVel_[i]) < -modThreshold){
-      sum = sum + bufferVel_[i] - modRange;
-    }
-    else {
-      sum = sum + bufferVel_[i];
+  if (modRange > 0) {
+    // Keep states close to the modulo range (IIR each cycle, buffer once per turn)
+    bool renormNow = filterType_ == ECMC_FILTER_TYPE_IIR_LP || indexVel_ == 0;
+
+    if (renormNow && (lastUnwrapped_ >= modRange || lastUnwrapped_ < 0)) {
+      double offset = -std::floor(lastUnwrapped_ / modRange) * modRange;
+      offsetStates(offset);
+      lastOutput_ = lastOutput_ + offset;
+    } else if (filterType_ == ECMC_FILTER_TYPE_MOVING_AVG && indexVel_ == 0) {
+      renormalize();
     }
-  }
-  
-  lastOutput_ = sum / (static_cast<double>(filterSize_));
-  
-  // Ensure result is within modrange
-  if(modRange > 0) {
-    if(lastOutput_ >= modRange) {
-      lastOutput_ = lastOutput_ - modRange;
+
+    // Ensure result is within modrange
+    if (lastOutput_ >= modRange || lastOutput_ < 0) {
+      lastOutput_ = lastOutput_ - std::floor(lastOutput_ / modRange) * modRange;
     }
-    else if(lastOutput_ < 0){
-      lastOutput_ = lastOutput_ + modRange;
-    }    
+  } else if ((filterType_ == ECMC_FILTER_TYPE_MOVING_AVG) && (indexVel_ == 0)) {
+    renormalize();
   }
-  
+
   return lastOutput_;
 }
 
 int ecmcFilter::reset() {
-  initVars();
+  errorReset();
+  indexVel_ = 0;
   return 0;
 }
 
 int ecmcFilter::initFilter(double pos) {
-
-  for (int i = 0; i < (int)filterSize_; i++) {
-    bufferVel_[i] = 0;
-  }
-
-  indexVel_ = 0;
+  clearBuffer();
+  last_          = 0;
+  lastUnwrapped_ = 0;
   return 0;
 }
 
 void ecmcFilter::setSampleTime(double sampleTime) {
   sampleTime_ = sampleTime;
+  if (cutOffHz_ > 0) {
+    calcLowPassCoeffs();
+  }
 }
 
 int ecmcFilter::setFilterSize(size_t size) {
-  
+
   double * tempBuffer=NULL;
   try {
-    tempBuffer = new double[size];  
+    tempBuffer = new double[size];
   } catch(std::bad_alloc& ex) {
       LOGERR(
         "%s/%s:%d: ERROR: Filter Mem Alloc Error. Old filter settings still valid (size=%zu)\n",
@@ -132,12 +242,130 @@ int ecmcFilter::setFilterSize(size_t size) {
         );
       return ERROR_AXIS_FILTER_ALLOC_FAIL;
   }
-  delete bufferVel_;
-  bufferVel_= tempBuffer;  
+  delete[] bufferVel_;
+  bufferVel_= tempBuffer;
   filterSize_=size;
   for (int i = 0; i < (int)filterSize_; i++) {
     bufferVel_[i] = 0;
-  }  
+  }
   indexVel_=0;
+  sum_     = 0;
+  sumComp_ = 0;
+  return 0;
+}
+
+int ecmcFilter::setFilterType(ecmcFilterType type) {
+  if (type != ECMC_FILTER_TYPE_MOVING_AVG && type != ECMC_FILTER_TYPE_IIR_LP) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Filter type %d invalid (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      type,
+      ERROR_AXIS_FILTER_TYPE_OUT_OF_RANGE);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_FILTER_TYPE_OUT_OF_RANGE);
+  }
+
+  if (type == filterType_) {
+    return 0;
+  }
+
+  if (type == ECMC_FILTER_TYPE_IIR_LP) {
+    if (cutOffHz_ <= 0) {
+      LOGERR(
+        "%s/%s:%d: ERROR: Cut off frequency not set (0x%x).\n",
+        __FILE__,
+        __FUNCTION__,
+        __LINE__,
+        ERROR_AXIS_FILTER_CUTOFF_OUT_OF_RANGE);
+      return setErrorID(__FILE__,
+                        __FUNCTION__,
+                        __LINE__,
+                        ERROR_AXIS_FILTER_CUTOFF_OUT_OF_RANGE);
+    }
+    // Start from steady state at current mean value
+    double mean = sum_ / (static_cast<double>(filterSize_));
+    for (int i = 0; i < FILTER_IIR_MAX_SECTIONS; i++) {
+      sos_[i].x1 = mean;
+      sos_[i].x2 = mean;
+      sos_[i].y1 = mean;
+      sos_[i].y2 = mean;
+    }
+  } else {
+    // Start from last IIR output
+    double value = sos_[sections_ - 1].y1;
+    for (int i = 0; i < (int)filterSize_; i++) {
+      bufferVel_[i] = value;
+    }
+    indexVel_ = 0;
+    renormalize();
+  }
+
+  filterType_ = type;
+  return 0;
+}
+
+ecmcFilterType ecmcFilter::getFilterType() {
+  return filterType_;
+}
+
+int ecmcFilter::setLowPassCutOff(double cutOffHz, int order) {
+  // Must be below nyquist
+  if (cutOffHz <= 0 || cutOffHz >= 0.5 / sampleTime_) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Cut off frequency %lfHz out of range (0..%lfHz) (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      cutOffHz,
+      0.5 / sampleTime_,
+      ERROR_AXIS_FILTER_CUTOFF_OUT_OF_RANGE);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_FILTER_CUTOFF_OUT_OF_RANGE);
+  }
+
+  if (order < 2 || order > 2 * FILTER_IIR_MAX_SECTIONS || order % 2) {
+    LOGERR(
+      "%s/%s:%d: ERROR: Filter order %d invalid (even number 2..%d) (0x%x).\n",
+      __FILE__,
+      __FUNCTION__,
+      __LINE__,
+      order,
+      2 * FILTER_IIR_MAX_SECTIONS,
+      ERROR_AXIS_FILTER_ORDER_OUT_OF_RANGE);
+    return setErrorID(__FILE__,
+                      __FUNCTION__,
+                      __LINE__,
+                      ERROR_AXIS_FILTER_ORDER_OUT_OF_RANGE);
+  }
+
+  cutOffHz_ = cutOffHz;
+  sections_ = order / 2;
+  calcLowPassCoeffs();
   return 0;
 }
+
+/*
+* Butterworth low pass as cascaded second order sections
+* (bilinear transform with prewarp)
+*/
+void ecmcFilter::calcLowPassCoeffs() {
+  int    order = 2 * sections_;
+  double k     = std::tan(M_PI * cutOffHz_ * sampleTime_);
+  double k2    = k * k;
+
+  for (int i = 0; i < sections_; i++) {
+    double q    = 1.0 / (2.0 * std::sin((2.0 * i + 1.0) * M_PI / (2.0 * order)));
+    double norm = 1.0 / (1.0 + k / q + k2);
+    sos_[i].b0 = k2 * norm;
+    sos_[i].b1 = 2.0 * sos_[i].b0;
+    sos_[i].b2 = sos_[i].b0;
+    sos_[i].a1 = 2.0 * (k2 - 1.0) * norm;
+    sos_[i].a2 = (1.0 - k / q + k2) * norm;
+  }
+}
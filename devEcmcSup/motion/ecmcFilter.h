@@ -19,17 +19,46 @@
 #include "../com/ecmcOctetIF.h"
 
 #define ERROR_AXIS_FILTER_ALLOC_FAIL 0x230000
+#define ERROR_AXIS_FILTER_TYPE_OUT_OF_RANGE 0x230001
+#define ERROR_AXIS_FILTER_CUTOFF_OUT_OF_RANGE 0x230002
+#define ERROR_AXIS_FILTER_ORDER_OUT_OF_RANGE 0x230003
 
 #define FILTER_BUFFER_SIZE_DEF 100
 #define FILTER_POS_MODULO_OVER_UNDER_FLOW_LIMIT 0.7
 
+// Max number of cascaded second order sections (max order 2 * sections)
+#define FILTER_IIR_MAX_SECTIONS 4
+
+enum ecmcFilterType {
+  ECMC_FILTER_TYPE_MOVING_AVG = 0,
+  ECMC_FILTER_TYPE_IIR_LP     = 1,
+};
+
+/* One second order section (biquad), direct form 1
+   (direct form 1 allows simple offset of all states for modulo) */
+typedef struct {
+  double b0;
+  double b1;
+  double b2;
+  double a1;
+  double a2;
+  double x1;
+  double x2;
+  double y1;
+  double y2;
+} ecmcFilterSOS;
+
 class ecmcFilter : public ecmcError {
  public:
-  explicit ecmcFilter(double sampleTime); 
+  explicit ecmcFilter(double sampleTime);
   explicit ecmcFilter(double sampleTime, size_t size);
   ~ecmcFilter();
   void   setSampleTime(double sampleTime);
   int    setFilterSize(size_t size);
+  int    setFilterType(ecmcFilterType type);
+  ecmcFilterType getFilterType();
+  // Butterworth low pass (order = 2 * number of second order sections)
+  int    setLowPassCutOff(double cutOffHz, int order);
   int    reset();
   // Init filter to certain position
   int    initFilter(double pos);
@@ -39,6 +68,13 @@ class ecmcFilter : public ecmcError {
 
  private:
   void   initVars();
+  void   clearBuffer();
+  double addSample(double value);
+  double movingAvg(double value);
+  double lowPass(double value);
+  void   offsetStates(double offset);
+  void   renormalize();
+  void   calcLowPassCoeffs();
   double *bufferVel_;
   double my_;
   double last_;
@@ -46,7 +82,15 @@ class ecmcFilter : public ecmcError {
   double sampleTime_;
   size_t indexVel_;
   size_t filterSize_;
-
+  // Running sum with Kahan compensation
+  double sum_;
+  double sumComp_;
+  // Unwrapped position (modulo)
+  double lastUnwrapped_;
+  ecmcFilterType filterType_;
+  double cutOffHz_;
+  int    sections_;
+  ecmcFilterSOS sos_[FILTER_IIR_MAX_SECTIONS];
 };
 
 #endif  /* ECMCFILTER_H_ */
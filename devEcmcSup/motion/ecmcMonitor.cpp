@@ -69,6 +69,8 @@ void ecmcMonitor::initVars() {
   encArray_                  = NULL;
   enableAlarmOnSofLimits_    = 1;
   enableDiffEncsMon_         = 1;  // If a tolerance is set then default check
+  hotState_                  = NULL;
+  hotStateSlot_              = 0;
 }
 
 ecmcMonitor::~ecmcMonitor()
@@ -131,6 +133,7 @@ int ecmcMonitor::setAtTargetTol(double tol) {
   }
 
   atTargetTol_ = tol;
+  refreshHotStateLimits();
   return 0;
 }
 
@@ -172,6 +175,7 @@ int ecmcMonitor::setPosLagTol(double tol) {
   }
 
   posLagTol_ = tol;
+  refreshHotStateLimits();
   return 0;
 }
 
@@ -353,6 +357,7 @@ int ecmcMonitor::validate() {
 
 int ecmcMonitor::setMaxVel(double vel) {
   maxVel_ = vel;
+  refreshHotStateLimits();
   return 0;
 }
 
@@ -429,6 +434,7 @@ int ecmcMonitor::setEnableHardwareInterlock(bool enable) {
 
 int ecmcMonitor::setCntrlOutputHL(double outputHL) {
   cntrlOutputHL_ = outputHL;
+  refreshHotStateLimits();
   return 0;
 }
 
@@ -608,9 +614,11 @@ int ecmcMonitor::checkAtTarget() {
   if (enableAtTargetMon_ && data_->status_.enabled) {
     /*if (std::abs(data_->status_.currentTargetPosition -
                  data_->status_.currentPositionActual) < atTargetTol_) {*/    
-    if (std::abs(data_->status_.cntrlError) < atTargetTol_ && 
-        data_->status_.currentTargetPositionModulo == 
-        data_->status_.currentPositionSetpoint) {
+    bool inTol = hotState_ ? hotState_->getInAtTargetTol(hotStateSlot_) :
+                 (std::abs(data_->status_.cntrlError) < atTargetTol_ &&
+                  data_->status_.currentTargetPositionModulo ==
+                  data_->status_.currentPositionSetpoint);
+    if (inTol) {
       if (atTargetCounter_ <= atTargetTime_) {
         atTargetCounter_++;
       }
@@ -635,7 +643,10 @@ int ecmcMonitor::checkPositionLag() {
 
   if (enableLagMon_ && !lagErrorDrive) {
 
-    if ((std::abs(data_->status_.cntrlError) > posLagTol_) && data_->status_.enabled &&
+    bool lagExceeded = hotState_ ?
+                       hotState_->getPosLagExceeded(hotStateSlot_) :
+                       std::abs(data_->status_.cntrlError) > posLagTol_;
+    if (lagExceeded && data_->status_.enabled &&
         data_->status_.enabledOld) {
       if (lagMonCounter_ <= posLagTime_ * 2) {
         lagMonCounter_++;
@@ -720,8 +731,13 @@ int ecmcMonitor::checkVelocityDiff() {
     velocityDiffCounter_ = 0;
   }
 
-  if (std::abs(currentSetVelocityToDrive -
-               data_->status_.currentVelocityActual) > velDiffMaxDiff_) {
+  bool velDiffExceeded = hotState_ ?
+                         hotState_->getVelDiffExceeded(hotStateSlot_) :
+                         std::abs(currentSetVelocityToDrive -
+                                  data_->status_.currentVelocityActual) >
+                         velDiffMaxDiff_;
+
+  if (velDiffExceeded) {
     velocityDiffCounter_++;
   } else {
     velocityDiffCounter_ = 0;
@@ -757,9 +773,12 @@ int ecmcMonitor::checkMaxVelocity() {
     return 0;
   }
 
-  if (((std::abs(data_->status_.currentVelocityActual) > maxVel_) ||
-       (std::abs(data_->status_.currentVelocitySetpoint) > maxVel_)) &&
-      enableMaxVelMon_) {
+  bool maxVelExceeded = hotState_ ?
+                        hotState_->getMaxVelExceeded(hotStateSlot_) :
+                        ((std::abs(data_->status_.currentVelocityActual) > maxVel_) ||
+                         (std::abs(data_->status_.currentVelocitySetpoint) > maxVel_));
+
+  if (maxVelExceeded && enableMaxVelMon_) {
     if (maxVelCounterTraj_ <= maxVelTrajILDelay_) {
       maxVelCounterTraj_++;
     }
@@ -800,8 +819,11 @@ int ecmcMonitor::checkCntrlMaxOutput() {
     return 0;
   }
 
-  if (enableCntrlHLMon_ &&
-      (std::abs(data_->status_.cntrlOutput) > cntrlOutputHL_)) {
+  bool cntrlHLExceeded = hotState_ ?
+                         hotState_->getCntrlOutputHLExceeded(hotStateSlot_) :
+                         std::abs(data_->status_.cntrlOutput) > cntrlOutputHL_;
+
+  if (enableCntrlHLMon_ && cntrlHLExceeded) {
     data_->interlocks_.cntrlOutputHLDriveInterlock = true;
     data_->interlocks_.cntrlOutputHLTrajInterlock  = true;
     return setErrorID(__FILE__,
@@ -846,6 +868,7 @@ bool ecmcMonitor::getAtSoftLimitFwd() {
 
 int ecmcMonitor::setVelDiffMaxDifference(double velo) {
   velDiffMaxDiff_ = std::abs(velo);
+  refreshHotStateLimits();
   return 0;
 }
 
@@ -988,3 +1011,20 @@ int ecmcMonitor::setEnableCheckEncsDiff(bool enable) {
   return 0;
 }
 
+void ecmcMonitor::setHotState(ecmcAxisHotState *hotState, int slot) {
+  hotState_     = hotState;
+  hotStateSlot_ = slot;
+  refreshHotStateLimits();
+}
+
+void ecmcMonitor::refreshHotStateLimits() {
+  if (!hotState_) {
+    return;
+  }
+  hotState_->setLimits(hotStateSlot_,
+                       atTargetTol_,
+                       posLagTol_,
+                       maxVel_,
+                       velDiffMaxDiff_,
+                       cntrlOutputHL_);
+}
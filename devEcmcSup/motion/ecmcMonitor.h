@@ -17,6 +17,7 @@
 #include "../main/ecmcError.h"
 #include "ecmcTrajectoryTrapetz.h"
 #include "ecmcAxisData.h"
+#include "ecmcAxisHotState.h"
 
 // MONITOR ERRORS
 #define ERROR_MON_ASSIGN_ENTRY_FAILED 0x14C00
@@ -132,6 +133,9 @@ class ecmcMonitor : public ecmcEcEntryLink {
   bool   getAtSoftLimitFwd();
   int    setEnableSoftLimitAlarm(bool enable);
   int    setEnableCheckEncsDiff(bool enable);
+  // Use threshold checks evaluated in batch for all axes (NULL to disable)
+  void   setHotState(ecmcAxisHotState *hotState,
+                     int               slot);
 
  private:
   int    checkLimits();
@@ -143,6 +147,7 @@ class ecmcMonitor : public ecmcEcEntryLink {
   int    checkCntrlMaxOutput();
   int    filterSwitches();
   int    checkPolarity(ecmcSwitchPolarity pol);
+  void   refreshHotStateLimits();
   bool enable_;
   // Tolnoerance for reached target. Example 0.1 deg
   double atTargetTol_;
@@ -192,5 +197,7 @@ class ecmcMonitor : public ecmcEcEntryLink {
   ecmcSwitchPolarity homePolarity_;
   ecmcEncoder **encArray_;
   int enableDiffEncsMon_;
+  ecmcAxisHotState *hotState_;
+  int hotStateSlot_;
 };
 #endif  // ifndef MOTIONMONITOR_H
@@ -26,6 +26,7 @@
 #include "ecmcAxisBase.h"      // Abstract class for all axis types
 #include "ecmcAxisReal.h"      // Normal axis (cntr,drv, enc, traj, mon, seq)
 #include "ecmcAxisVirt.h"      // Axis without drive and controller
+#include "ecmcAxisGroup.h"     // Coordinated moves of several axes
 #include "ecmcDriveBase.h"     // Abstract drive base class
 #include "ecmcTrajectoryBase.h"
 #include "ecmcPIDController.h"
@@ -837,6 +838,21 @@ int setAxisJerk(int axisIndex, double value) {
   return 0;
 }
 
+int setAxisTrajPreCalc(int axisIndex, int enable) {
+  LOGINFO4("%s/%s:%d axisIndex=%d value=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           enable);
+
+  CHECK_AXIS_RETURN_IF_ERROR_AND_BLOCK_COM(axisIndex)
+  CHECK_AXIS_TRAJ_RETURN_IF_ERROR(axisIndex)
+
+  axes[axisIndex]->getTraj()->setPreCalcEnable(enable);
+  return 0;
+}
+
 int setAxisTargetPos(int axisIndex, double value) {
   LOGINFO4("%s/%s:%d axisIndex=%d value=%f\n",
            __FILE__,
@@ -1176,6 +1192,84 @@ int setAxisEncPosFilterEnable(int axisIndex,
   return axes[axisIndex]->setEncPosFiltEnable(enable);
 }
 
+int setAxisEncVelFilterType(int axisIndex,
+                            int type) {
+  LOGINFO4("%s/%s:%d axisIndex=%d type=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           type);
+  CHECK_AXIS_RETURN_IF_ERROR_AND_BLOCK_COM(axisIndex)
+  return axes[axisIndex]->setEncVeloFiltType((ecmcFilterType)type);
+}
+
+int setAxisPLCTrajVelFilterType(int axisIndex,
+                                int type) {
+  LOGINFO4("%s/%s:%d axisIndex=%d type=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           type);
+  CHECK_AXIS_RETURN_IF_ERROR_AND_BLOCK_COM(axisIndex)
+  return axes[axisIndex]->setExtTrajVeloFiltType((ecmcFilterType)type);
+}
+
+int setAxisPLCEncVelFilterType(int axisIndex,
+                               int type) {
+  LOGINFO4("%s/%s:%d axisIndex=%d type=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           type);
+  CHECK_AXIS_RETURN_IF_ERROR_AND_BLOCK_COM(axisIndex)
+  return axes[axisIndex]->setExtEncVeloFiltType((ecmcFilterType)type);
+}
+
+int setAxisEncVelFilterLowPass(int    axisIndex,
+                               double cutOffHz,
+                               int    order) {
+  LOGINFO4("%s/%s:%d axisIndex=%d cutOffHz=%lf order=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           cutOffHz,
+           order);
+  CHECK_AXIS_RETURN_IF_ERROR_AND_BLOCK_COM(axisIndex)
+  return axes[axisIndex]->setEncVeloFiltLowPass(cutOffHz, order);
+}
+
+int setAxisPLCTrajVelFilterLowPass(int    axisIndex,
+                                   double cutOffHz,
+                                   int    order) {
+  LOGINFO4("%s/%s:%d axisIndex=%d cutOffHz=%lf order=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           cutOffHz,
+           order);
+  CHECK_AXIS_RETURN_IF_ERROR_AND_BLOCK_COM(axisIndex)
+  return axes[axisIndex]->setExtTrajVeloFiltLowPass(cutOffHz, order);
+}
+
+int setAxisPLCEncVelFilterLowPass(int    axisIndex,
+                                  double cutOffHz,
+                                  int    order) {
+  LOGINFO4("%s/%s:%d axisIndex=%d cutOffHz=%lf order=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           cutOffHz,
+           order);
+  CHECK_AXIS_RETURN_IF_ERROR_AND_BLOCK_COM(axisIndex)
+  return axes[axisIndex]->setExtEncVeloFiltLowPass(cutOffHz, order);
+}
+
 const char* getAxisPLCExpr(int axisIndex, int *error) {
   LOGINFO4("%s/%s:%d axisIndex=%d\n",
            __FILE__,
@@ -2935,3 +3029,544 @@ int setAxisAllowSourceChangeWhenEnabled(int axisIndex,
 
   return axes[axisIndex]->setAllowSourceChangeWhenEnabled(allow);
 }
+
+int createAxisGroup(int groupIndex) {
+  LOGINFO4("%s/%s:%d groupIndex=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           groupIndex);
+
+  if ((groupIndex < 0) || (groupIndex >= ECMC_MAX_AXIS_GROUPS)) {
+    return ERROR_MAIN_AXIS_GROUP_INDEX_OUT_OF_RANGE;
+  }
+
+  if (axisGroups[groupIndex] != NULL) {
+    return ERROR_MAIN_AXIS_GROUP_ALREADY_CREATED;
+  }
+
+  try {
+    axisGroups[groupIndex] = new ecmcAxisGroup(asynPort,
+                                               groupIndex,
+                                               1 / mcuFrequency);
+  }
+  catch (std::exception& e) {
+    delete axisGroups[groupIndex];
+    axisGroups[groupIndex] = NULL;
+    LOGERR("%s/%s:%d: EXCEPTION %s WHEN ALLOCATE MEMORY FOR AXIS GROUP OBJECT.\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           e.what());
+    return ERROR_MAIN_EXCEPTION;
+  }
+
+  // Sample rate fixed
+  sampleRateChangeAllowed = 0;
+  return axisGroups[groupIndex]->getErrorID();
+}
+
+int addAxisToGroup(int    groupIndex,
+                   int    axisIndex,
+                   double velocity,
+                   double acceleration,
+                   double jerk) {
+  LOGINFO4("%s/%s:%d groupIndex=%d axisIndex=%d velo=%lf acc=%lf jerk=%lf\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           groupIndex,
+           axisIndex,
+           velocity,
+           acceleration,
+           jerk);
+
+  CHECK_AXIS_GROUP_RETURN_IF_ERROR(groupIndex);
+  CHECK_AXIS_RETURN_IF_ERROR(axisIndex);
+
+  // Planner is sized in validate() (before runtime)
+  if (appModeStat == ECMC_MODE_RUNTIME) {
+    return ERROR_MAIN_APP_MODE_ALREADY_RUNTIME;
+  }
+
+  return axisGroups[groupIndex]->addAxis(axes[axisIndex],
+                                         velocity,
+                                         acceleration,
+                                         jerk);
+}
+
+int setAxisGroupSyncType(int groupIndex,
+                         int syncType) {
+  LOGINFO4("%s/%s:%d groupIndex=%d syncType=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           groupIndex,
+           syncType);
+
+  CHECK_AXIS_GROUP_RETURN_IF_ERROR(groupIndex);
+
+  return axisGroups[groupIndex]->setSyncType((ecmcAxisGroupSyncType)syncType);
+}
+
+int setAxisGroupTargetPos(int    groupIndex,
+                          int    axisIndex,
+                          double position) {
+  LOGINFO4("%s/%s:%d groupIndex=%d axisIndex=%d position=%lf\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           groupIndex,
+           axisIndex,
+           position);
+
+  CHECK_AXIS_GROUP_RETURN_IF_ERROR(groupIndex);
+
+  return axisGroups[groupIndex]->setTargetPos(axisIndex, position);
+}
+
+int setAxisGroupExecute(int groupIndex,
+                        int execute) {
+  LOGINFO4("%s/%s:%d groupIndex=%d execute=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           groupIndex,
+           execute);
+
+  CHECK_AXIS_GROUP_RETURN_IF_ERROR(groupIndex);
+
+  return axisGroups[groupIndex]->setExecute(execute);
+}
+
+int setAxisSyncMaster(int axisIndex,
+                      int masterAxisIndex,
+                      int source) {
+  LOGINFO4("%s/%s:%d axisIndex=%d masterAxisIndex=%d source=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           masterAxisIndex,
+           source);
+
+  CHECK_AXIS_RETURN_IF_ERROR(axisIndex);
+  CHECK_AXIS_RETURN_IF_ERROR(masterAxisIndex);
+
+  int errorCode = axes[axisIndex]->createSync();
+  if (errorCode) {
+    return errorCode;
+  }
+
+  return axes[axisIndex]->getSync()->setMaster(
+    axes[masterAxisIndex]->getAxisDataRef(),
+    (ecmcAxisSyncSource)source);
+}
+
+int setAxisSyncMode(int axisIndex,
+                    int mode) {
+  LOGINFO4("%s/%s:%d axisIndex=%d mode=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           mode);
+
+  CHECK_AXIS_SYNC_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getSync()->setMode((ecmcAxisSyncMode)mode);
+}
+
+int setAxisSyncGear(int    axisIndex,
+                    double ratio,
+                    double offset) {
+  LOGINFO4("%s/%s:%d axisIndex=%d ratio=%lf offset=%lf\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           ratio,
+           offset);
+
+  CHECK_AXIS_SYNC_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getSync()->setGear(ratio, offset);
+}
+
+int setAxisSyncEngageTime(int    axisIndex,
+                          double time) {
+  LOGINFO4("%s/%s:%d axisIndex=%d time=%lf\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           time);
+
+  CHECK_AXIS_SYNC_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getSync()->setEngageTime(time);
+}
+
+int setAxisSyncCamModulo(int axisIndex,
+                         int enable) {
+  LOGINFO4("%s/%s:%d axisIndex=%d enable=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           enable);
+
+  CHECK_AXIS_SYNC_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getSync()->setCamModulo(enable);
+}
+
+int clearAxisSyncCam(int axisIndex) {
+  LOGINFO4("%s/%s:%d axisIndex=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex);
+
+  CHECK_AXIS_SYNC_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getSync()->clearCam();
+}
+
+int appendAxisSyncCamPoint(int    axisIndex,
+                           double master,
+                           double slave) {
+  LOGINFO4("%s/%s:%d axisIndex=%d master=%lf slave=%lf\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           master,
+           slave);
+
+  CHECK_AXIS_SYNC_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getSync()->appendCamPoint(master, slave);
+}
+
+int activateAxisSyncCam(int axisIndex) {
+  LOGINFO4("%s/%s:%d axisIndex=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex);
+
+  CHECK_AXIS_SYNC_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getSync()->activateCam();
+}
+
+int setAxisSyncEnable(int axisIndex,
+                      int enable) {
+  LOGINFO4("%s/%s:%d axisIndex=%d enable=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           enable);
+
+  CHECK_AXIS_SYNC_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getSync()->setEnable(enable);
+}
+
+int createAxisPvt(int axisIndex,
+                  int size) {
+  LOGINFO4("%s/%s:%d axisIndex=%d size=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           size);
+
+  CHECK_AXIS_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->createPvt(size);
+}
+
+int appendAxisPvtPoint(int    axisIndex,
+                       double time,
+                       double pos,
+                       double vel) {
+  LOGINFO4("%s/%s:%d axisIndex=%d time=%lf pos=%lf vel=%lf\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           time,
+           pos,
+           vel);
+
+  CHECK_AXIS_PVT_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getPvt()->appendPoint(time, pos, vel);
+}
+
+int clearAxisPvt(int axisIndex) {
+  LOGINFO4("%s/%s:%d axisIndex=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex);
+
+  CHECK_AXIS_PVT_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getPvt()->clear();
+}
+
+int setAxisPvtEnable(int axisIndex,
+                     int enable) {
+  LOGINFO4("%s/%s:%d axisIndex=%d enable=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           enable);
+
+  CHECK_AXIS_PVT_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getPvt()->setEnable(enable);
+}
+
+int getAxisPvtFillLevel(int  axisIndex,
+                        int *value) {
+  LOGINFO4("%s/%s:%d axisIndex=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex);
+
+  CHECK_AXIS_PVT_RETURN_IF_ERROR(axisIndex);
+
+  *value = axes[axisIndex]->getPvt()->getFillLevel();
+  return 0;
+}
+
+int getAxisPvtUnderruns(int  axisIndex,
+                        int *value) {
+  LOGINFO4("%s/%s:%d axisIndex=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex);
+
+  CHECK_AXIS_PVT_RETURN_IF_ERROR(axisIndex);
+
+  *value = axes[axisIndex]->getPvt()->getUnderruns();
+  return 0;
+}
+
+int getAxisPvtState(int  axisIndex,
+                    int *value) {
+  LOGINFO4("%s/%s:%d axisIndex=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex);
+
+  CHECK_AXIS_PVT_RETURN_IF_ERROR(axisIndex);
+
+  *value = (int)axes[axisIndex]->getPvt()->getState();
+  return 0;
+}
+
+int createAxisEncLatchCapture(int axisIndex,
+                              int size,
+                              int mode) {
+  LOGINFO4("%s/%s:%d axisIndex=%d size=%d mode=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           size,
+           mode);
+
+  if (!ec) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  CHECK_AXIS_ENCODER_CFG_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getConfigEnc()->createLatchCapture(
+    size,
+    mode,
+    ec->getCycleDcTimeNsPtr());
+}
+
+int getAxisEncLatchCount(int  axisIndex,
+                         int *value) {
+  LOGINFO4("%s/%s:%d axisIndex=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex);
+
+  CHECK_AXIS_ENCODER_CFG_RETURN_IF_ERROR(axisIndex);
+
+  ecmcEncoderLatchCapture *capture =
+    axes[axisIndex]->getConfigEnc()->getLatchCapture();
+
+  if (!capture) {
+    return ERROR_ENC_LATCH_CAPTURE_NULL;
+  }
+
+  *value = (int)capture->getWriteCount();
+  return 0;
+}
+
+int createAxisPosCompare(int axisIndex,
+                         int tableSize) {
+  LOGINFO4("%s/%s:%d axisIndex=%d tableSize=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           tableSize);
+
+  CHECK_AXIS_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->createPosCompare(tableSize);
+}
+
+int linkEcEntryToAxisPosCompareOutput(int   slaveIndex,
+                                      char *entryIDString,
+                                      int   axisIndex,
+                                      int   entryBitIndex) {
+  LOGINFO4("%s/%s:%d slave_index=%d entry=%s, axisId=%d bit_index=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           slaveIndex,
+           entryIDString,
+           axisIndex,
+           entryBitIndex);
+
+  if (!ec) return ERROR_MAIN_EC_NOT_INITIALIZED;
+
+  ecmcEcSlave *slave = NULL;
+
+  if (slaveIndex >= 0) {
+    slave = ec->findSlave(slaveIndex);
+  } else {
+    slave = ec->getSlave(slaveIndex);
+  }
+
+  if (slave == NULL) return ERROR_MAIN_EC_SLAVE_NULL;
+
+  std::string sEntryID = entryIDString;
+
+  ecmcEcEntry *entry = slave->findEntry(sEntryID);
+
+  if (entry == NULL) return ERROR_MAIN_EC_ENTRY_NULL;
+
+  CHECK_AXIS_RETURN_IF_ERROR_AND_BLOCK_COM(axisIndex);
+  CHECK_AXIS_POS_CMP_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getPosCompare()->setEntryAtIndex(
+    entry,
+    ECMC_AXIS_POS_CMP_ENTRY_INDEX_OUTPUT,
+    entryBitIndex);
+}
+
+int setAxisPosCompareEquidistant(int    axisIndex,
+                                 double start,
+                                 double step,
+                                 int    count) {
+  LOGINFO4("%s/%s:%d axisIndex=%d start=%lf step=%lf count=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           start,
+           step,
+           count);
+
+  CHECK_AXIS_POS_CMP_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getPosCompare()->setEquidistant(start, step, count);
+}
+
+int appendAxisPosCompareTablePos(int    axisIndex,
+                                 double pos) {
+  LOGINFO4("%s/%s:%d axisIndex=%d pos=%lf\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           pos);
+
+  CHECK_AXIS_POS_CMP_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getPosCompare()->appendTablePos(pos);
+}
+
+int clearAxisPosCompare(int axisIndex) {
+  LOGINFO4("%s/%s:%d axisIndex=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex);
+
+  CHECK_AXIS_POS_CMP_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getPosCompare()->clear();
+}
+
+int setAxisPosCompareDirection(int axisIndex,
+                               int direction) {
+  LOGINFO4("%s/%s:%d axisIndex=%d direction=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           direction);
+
+  CHECK_AXIS_POS_CMP_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getPosCompare()->setDirection(direction);
+}
+
+int setAxisPosComparePulseWidth(int    axisIndex,
+                                double seconds) {
+  LOGINFO4("%s/%s:%d axisIndex=%d seconds=%lf\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           seconds);
+
+  CHECK_AXIS_POS_CMP_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getPosCompare()->setPulseWidth(seconds);
+}
+
+int setAxisPosCompareEnable(int axisIndex,
+                            int enable) {
+  LOGINFO4("%s/%s:%d axisIndex=%d enable=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex,
+           enable);
+
+  CHECK_AXIS_POS_CMP_RETURN_IF_ERROR(axisIndex);
+
+  return axes[axisIndex]->getPosCompare()->setEnable(enable);
+}
+
+int getAxisPosCompareCount(int  axisIndex,
+                           int *value) {
+  LOGINFO4("%s/%s:%d axisIndex=%d\n",
+           __FILE__,
+           __FUNCTION__,
+           __LINE__,
+           axisIndex);
+
+  CHECK_AXIS_POS_CMP_RETURN_IF_ERROR(axisIndex);
+
+  *value = axes[axisIndex]->getPosCompare()->getTriggerCount();
+  return 0;
+}
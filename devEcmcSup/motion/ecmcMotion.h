@@ -35,6 +35,18 @@ extern "C" {
     }                                                                         \
   }                                                                           \
 
+#define CHECK_AXIS_GROUP_RETURN_IF_ERROR(groupIndex)                          \
+  {                                                                           \
+    if (groupIndex >= ECMC_MAX_AXIS_GROUPS || groupIndex < 0) {               \
+      LOGERR("ERROR: Axis group index out of range.\n");                      \
+      return ERROR_MAIN_AXIS_GROUP_INDEX_OUT_OF_RANGE;                        \
+    }                                                                         \
+    if (axisGroups[groupIndex] == NULL) {                                     \
+      LOGERR("ERROR: Axis group object NULL\n");                              \
+      return ERROR_MAIN_AXIS_GROUP_OBJECT_NULL;                               \
+    }                                                                         \
+  }                                                                           \
+
 #define CHECK_AXIS_RETURN_IF_ERROR_AND_BLOCK_COM(axisIndex)                   \
 {                                                                             \
   CHECK_AXIS_RETURN_IF_ERROR(axisIndex);                                      \
@@ -82,6 +94,33 @@ extern "C" {
   }                                                                           \
 }                                                                             \
 
+#define CHECK_AXIS_SYNC_RETURN_IF_ERROR(axisIndex)                            \
+{                                                                             \
+  CHECK_AXIS_RETURN_IF_ERROR(axisIndex);                                      \
+  if (axes[axisIndex]->getSync() == NULL) {                                   \
+    LOGERR("ERROR: Axis sync object NULL.\n");                                \
+    return ERROR_MAIN_AXIS_SYNC_OBJECT_NULL;                                  \
+  }                                                                           \
+}                                                                             \
+
+#define CHECK_AXIS_PVT_RETURN_IF_ERROR(axisIndex)                             \
+{                                                                             \
+  CHECK_AXIS_RETURN_IF_ERROR(axisIndex);                                      \
+  if (axes[axisIndex]->getPvt() == NULL) {                                    \
+    LOGERR("ERROR: Axis PVT object NULL.\n");                                 \
+    return ERROR_MAIN_AXIS_PVT_OBJECT_NULL;                                   \
+  }                                                                           \
+}                                                                             \
+
+#define CHECK_AXIS_POS_CMP_RETURN_IF_ERROR(axisIndex)                         \
+{                                                                             \
+  CHECK_AXIS_RETURN_IF_ERROR(axisIndex);                                      \
+  if (axes[axisIndex]->getPosCompare() == NULL) {                             \
+    LOGERR("ERROR: Axis position compare object NULL.\n");                    \
+    return ERROR_MAIN_AXIS_POS_CMP_OBJECT_NULL;                               \
+  }                                                                           \
+}                                                                             \
+
 #define CHECK_AXIS_TRAJ_RETURN_IF_ERROR(axisIndex)                            \
 {                                                                             \
   CHECK_AXIS_RETURN_IF_ERROR(axisIndex);                                      \
@@ -1368,6 +1407,25 @@ int setAxisEmergDeceleration(int    axisIndex,
 int setAxisJerk(int    axisIndex,
                 double value);
 
+/** \brief Use pre calculated trajectory for positioning.\n
+ *
+ * The full trajectory is calculated once when a move is commanded (or the
+ * target/limits are changed) and then sampled each cycle. The total move
+ * time is available in the asyn parameter ax<id>.movetime.\n
+ *
+ * \note Only used for ruckig trajectories (traj type 1).\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] enable Enable pre calculated trajectory.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Enable pre calculated trajectory for axis 3.\n
+ * "Cfg.SetAxisTrajPreCalc(3,1)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisTrajPreCalc(int axisIndex,
+                       int enable);
+
 /** \brief Set axis target position setpoint.\n
  *
  * The target position is the desired end setpoint of a motion.
@@ -1722,6 +1780,108 @@ int setAxisEncPosFilterSize(int axisIndex,
 int setAxisEncPosFilterEnable(int axisIndex,
                               int enable);
 
+/** \brief Set type of encoder velocity filter.\n
+ *
+ *  Filter types:\n
+ *    type = 0 : Moving average (size set by Cfg.SetAxisEncVelFilterSize()).\n
+ *    type = 1 : IIR Butterworth low pass (set by Cfg.SetAxisEncVelFilterLowPass()).\n
+ *
+ * \note The low pass filter must be configured before type 1 is selected.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] type       Filter type.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Use IIR low pass filter for axis 7.\n
+ * "Cfg.SetAxisEncVelFilterType(7,1)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisEncVelFilterType(int axisIndex,
+                            int type);
+
+/** \brief Configure IIR low pass encoder velocity filter.\n
+ *
+ *  Butterworth low pass filter implemented as cascaded second order\n
+ *  sections. The cut off frequency must be lower than half the sample\n
+ *  rate.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] cutOffHz   Cut off frequency [Hz].\n
+ * \param[in] order      Filter order (2,4,6 or 8).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: 4th order low pass with cut off at 50Hz for axis 7.\n
+ * "Cfg.SetAxisEncVelFilterLowPass(7,50,4)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisEncVelFilterLowPass(int    axisIndex,
+                               double cutOffHz,
+                               int    order);
+
+/** \brief Set type of external trajectory velocity filter.\n
+ *
+ *  Filter types:\n
+ *    type = 0 : Moving average (size set by Cfg.SetAxisPLCTrajVelFilterSize()).\n
+ *    type = 1 : IIR Butterworth low pass (set by Cfg.SetAxisPLCTrajVelFilterLowPass()).\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] type       Filter type.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Use IIR low pass filter for axis 7.\n
+ * "Cfg.SetAxisPLCTrajVelFilterType(7,1)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisPLCTrajVelFilterType(int axisIndex,
+                                int type);
+
+/** \brief Configure IIR low pass external trajectory velocity filter.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] cutOffHz   Cut off frequency [Hz].\n
+ * \param[in] order      Filter order (2,4,6 or 8).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: 2nd order low pass with cut off at 20Hz for axis 7.\n
+ * "Cfg.SetAxisPLCTrajVelFilterLowPass(7,20,2)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisPLCTrajVelFilterLowPass(int    axisIndex,
+                                   double cutOffHz,
+                                   int    order);
+
+/** \brief Set type of external encoder velocity filter.\n
+ *
+ *  Filter types:\n
+ *    type = 0 : Moving average (size set by Cfg.SetAxisPLCEncVelFilterSize()).\n
+ *    type = 1 : IIR Butterworth low pass (set by Cfg.SetAxisPLCEncVelFilterLowPass()).\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] type       Filter type.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Use IIR low pass filter for axis 7.\n
+ * "Cfg.SetAxisPLCEncVelFilterType(7,1)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisPLCEncVelFilterType(int axisIndex,
+                               int type);
+
+/** \brief Configure IIR low pass external encoder velocity filter.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] cutOffHz   Cut off frequency [Hz].\n
+ * \param[in] order      Filter order (2,4,6 or 8).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: 2nd order low pass with cut off at 20Hz for axis 7.\n
+ * "Cfg.SetAxisPLCEncVelFilterLowPass(7,20,2)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisPLCEncVelFilterLowPass(int    axisIndex,
+                                  double cutOffHz,
+                                  int    order);
+
 /** \brief Set axis trajectory data source.\n
  *
  * An axis trajectory generator can get position setpoints from different
@@ -3286,6 +3446,536 @@ int setAxisDisableAtErrorReset(int axisIndex,
 int setAxisAllowSourceChangeWhenEnabled(int axisIndex,
                                         int allow);
 
+/** \brief Create an axis group for coordinated (synchronized) positioning.\n
+ *
+ * All member axes of a group are planned in one multi axis ruckig
+ * trajectory. The sampled setpoints are written to the external
+ * trajectory setpoint of the member axes in the realtime loop, before the
+ * axes are executed. The member axes therefore need to use external
+ * trajectory source ("Cfg.SetAxisTrajSourceType(<axis>,1)").\n
+ *
+ * Asyn parameters:\n
+ *   grp<id>.targpos  : Target positions (array, one element per member
+ *                      axis, in the order added to the group).\n
+ *   grp<id>.execute  : Rising edge starts move, falling edge stops.\n
+ *   grp<id>.busy     : Group move busy.\n
+ *   grp<id>.movetime : Total time of current profile [s].\n
+ *   grp<id>.error    : Group error code.\n
+ *
+ * \param[in] groupIndex  Index of axis group to create.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Create axis group 0.\n
+ * "Cfg.CreateAxisGroup(0)" //Command string to ecmcCmdParser.c.\n
+ */
+int createAxisGroup(int groupIndex);
+
+/** \brief Add an axis to an axis group.\n
+ *
+ * \param[in] groupIndex  Axis group index.\n
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] velocity  Max velocity of axis in group moves.\n
+ * \param[in] acceleration  Max acceleration of axis in group moves.\n
+ * \param[in] jerk  Max jerk of axis in group moves.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Add axis 3 to axis group 0.\n
+ * "Cfg.AddAxisToGroup(0,3,10,100,1000)" //Command string to ecmcCmdParser.c.\n
+ */
+int addAxisToGroup(int    groupIndex,
+                   int    axisIndex,
+                   double velocity,
+                   double acceleration,
+                   double jerk);
+
+/** \brief Set synchronization type of an axis group.\n
+ *
+ * \param[in] groupIndex  Axis group index.\n
+ * \param[in] syncType  Synchronization type:\n
+ *   syncType = 0: All axes reach target at the same time (default).\n
+ *   syncType = 1: Time synchronization only if necessary.\n
+ *   syncType = 2: Phase synchronization (straight line in position space).\n
+ *   syncType = 3: No synchronization.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Use phase synchronization for axis group 0.\n
+ * "Cfg.SetAxisGroupSyncType(0,2)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisGroupSyncType(int groupIndex,
+                         int syncType);
+
+/** \brief Set target position of a member axis of an axis group.\n
+ *
+ * \param[in] groupIndex  Axis group index.\n
+ * \param[in] axisIndex  Axis index (must be a member of the group).\n
+ * \param[in] position  Target position.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Set target position of axis 3 in axis group 0 to 10.\n
+ * "Cfg.SetAxisGroupTargetPos(0,3,10)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisGroupTargetPos(int    groupIndex,
+                          int    axisIndex,
+                          double position);
+
+/** \brief Execute axis group move.\n
+ *
+ * Rising edge starts a synchronized move of all member axes to the target
+ * positions. Falling edge during a move stops all member axes synchronized.\n
+ *
+ * \param[in] groupIndex  Axis group index.\n
+ * \param[in] execute  Execute.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Execute move of axis group 0.\n
+ * "Cfg.SetAxisGroupExecute(0,1)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisGroupExecute(int groupIndex,
+                        int execute);
+
+/** \brief Set master axis for native synchronization (gear or cam).\n
+ *
+ * Creates the sync object of the slave axis (if needed). The slave axis
+ * trajectory setpoint is then calculated directly from the master position
+ * in the realtime loop (no PLC needed). The slave axis must use external
+ * trajectory source ("Cfg.SetAxisTrajSourceType(<axis>,1)").\n
+ *
+ * Asyn parameters:\n
+ *   ax<id>.camtable   : Cam table as pairs (master0, slave0, master1, ...).\n
+ *   ax<id>.syncenable : Engage (1) or disengage (0).\n
+ *   ax<id>.syncstate  : 0=idle, 1=engaging, 2=engaged, 3=disengaging.\n
+ *
+ * \param[in] axisIndex  Slave axis index.\n
+ * \param[in] masterAxisIndex  Master axis index.\n
+ * \param[in] source  Master position source:\n
+ *   source = 0: Master setpoint.\n
+ *   source = 1: Master actual position.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Sync axis 3 to setpoint of axis 1.\n
+ * "Cfg.SetAxisSyncMaster(3,1,0)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisSyncMaster(int axisIndex,
+                      int masterAxisIndex,
+                      int source);
+
+/** \brief Set native synchronization mode.\n
+ *
+ * \param[in] axisIndex  Slave axis index.\n
+ * \param[in] mode  Sync mode:\n
+ *   mode = 0: None.\n
+ *   mode = 1: Gear (slave = ratio * master + offset).\n
+ *   mode = 2: Cam (cubic spline interpolation in cam table).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Use gearing for axis 3.\n
+ * "Cfg.SetAxisSyncMode(3,1)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisSyncMode(int axisIndex,
+                    int mode);
+
+/** \brief Set gear ratio and offset.\n
+ *
+ * \param[in] axisIndex  Slave axis index.\n
+ * \param[in] ratio  Gear ratio.\n
+ * \param[in] offset  Offset.\n
+ *
+ * Not allowed while synchronization is active (disengage first).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Gear ratio 0.5 and offset 10 for axis 3.\n
+ * "Cfg.SetAxisSyncGear(3,0.5,10)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisSyncGear(int    axisIndex,
+                    double ratio,
+                    double offset);
+
+/** \brief Set engage/disengage time.\n
+ *
+ * Engage blends from the current setpoint to the synchronized setpoint.
+ * Disengage ramps velocity down to zero.\n
+ *
+ * \param[in] axisIndex  Slave axis index.\n
+ * \param[in] time  Engage time [s] (0 = direct).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Engage time 0.5s for axis 3.\n
+ * "Cfg.SetAxisSyncEngageTime(3,0.5)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisSyncEngageTime(int    axisIndex,
+                          double time);
+
+/** \brief Wrap master position over cam table range (cyclic cam).\n
+ *
+ * \param[in] axisIndex  Slave axis index.\n
+ * \param[in] enable  Enable modulo.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Cyclic cam for axis 3.\n
+ * "Cfg.SetAxisSyncCamModulo(3,1)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisSyncCamModulo(int axisIndex,
+                         int enable);
+
+/** \brief Clear staging cam table.\n
+ *
+ * \param[in] axisIndex  Slave axis index.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Clear staging cam table for axis 3.\n
+ * "Cfg.ClearAxisSyncCam(3)" //Command string to ecmcCmdParser.c.\n
+ */
+int clearAxisSyncCam(int axisIndex);
+
+/** \brief Append point to staging cam table.\n
+ *
+ * Master positions must be strictly increasing.\n
+ *
+ * \param[in] axisIndex  Slave axis index.\n
+ * \param[in] master  Master position.\n
+ * \param[in] slave  Slave position.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Add point (10,2) to cam table of axis 3.\n
+ * "Cfg.AppendAxisSyncCamPoint(3,10,2)" //Command string to ecmcCmdParser.c.\n
+ */
+int appendAxisSyncCamPoint(int    axisIndex,
+                           double master,
+                           double slave);
+
+/** \brief Activate staging cam table.\n
+ *
+ * Calculates the spline and switches the realtime loop to the new table.\n
+ *
+ * \param[in] axisIndex  Slave axis index.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Activate cam table for axis 3.\n
+ * "Cfg.ActivateAxisSyncCam(3)" //Command string to ecmcCmdParser.c.\n
+ */
+int activateAxisSyncCam(int axisIndex);
+
+/** \brief Engage or disengage native synchronization.\n
+ *
+ * \param[in] axisIndex  Slave axis index.\n
+ * \param[in] enable  Engage (1) or disengage (0).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Engage sync for axis 3.\n
+ * "Cfg.SetAxisSyncEnable(3,1)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisSyncEnable(int axisIndex,
+                      int enable);
+
+/** \brief Create PVT setpoint streaming buffer for an axis.\n
+ *
+ * Position-velocity-time points are streamed to a ring buffer by non
+ * realtime clients and consumed by the realtime loop. The setpoint is
+ * calculated with cubic (Hermite) interpolation between the points. The
+ * axis must use external trajectory source
+ * ("Cfg.SetAxisTrajSourceType(<axis>,1)"). If the buffer runs empty while
+ * moving, the setpoint decelerates to standstill with the axis
+ * deceleration and an underrun error is set.\n
+ *
+ * Asyn parameters:\n
+ *   ax<id>.pvtpoints    : Append points as triplets (time, pos, vel).\n
+ *   ax<id>.pvtenable    : Start (1) or stop (0) streaming.\n
+ *   ax<id>.pvtstate     : 0=idle, 1=running, 2=done, 3=underrun.\n
+ *   ax<id>.pvtfill      : Number of points in buffer.\n
+ *   ax<id>.pvtunderruns : Number of underruns.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] size  Buffer size in points (rounded up to power of two).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Create a 65536 point PVT buffer for axis 3.\n
+ * "Cfg.CreateAxisPvt(3,65536)" //Command string to ecmcCmdParser.c.\n
+ */
+int createAxisPvt(int axisIndex,
+                  int size);
+
+/** \brief Append point to PVT buffer.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] time  Time from previous point [s] (> 0).\n
+ * \param[in] pos  Position at end of segment.\n
+ * \param[in] vel  Velocity at end of segment.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Reach position 10 with velocity 5 after 0.1s for axis 3.\n
+ * "Cfg.AppendAxisPvtPoint(3,0.1,10,5)" //Command string to ecmcCmdParser.c.\n
+ */
+int appendAxisPvtPoint(int    axisIndex,
+                       double time,
+                       double pos,
+                       double vel);
+
+/** \brief Clear PVT buffer.\n
+ *
+ * Not allowed while streaming. Also resets the underrun counter.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Clear PVT buffer of axis 3.\n
+ * "Cfg.ClearAxisPvt(3)" //Command string to ecmcCmdParser.c.\n
+ */
+int clearAxisPvt(int axisIndex);
+
+/** \brief Start or stop PVT streaming.\n
+ *
+ * Streaming starts from the current setpoint. A stop holds the current
+ * setpoint.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] enable  Start (1) or stop (0).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Start PVT streaming for axis 3.\n
+ * "Cfg.SetAxisPvtEnable(3,1)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisPvtEnable(int axisIndex,
+                     int enable);
+
+/** \brief Get number of points in PVT buffer.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[out] value  Fill level.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Get PVT fill level of axis 3.\n
+ * "GetAxisPvtFillLevel(3)" //Command string to ecmcCmdParser.c.\n
+ */
+int getAxisPvtFillLevel(int  axisIndex,
+                        int *value);
+
+/** \brief Get number of PVT underruns.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[out] value  Underruns.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Get PVT underruns of axis 3.\n
+ * "GetAxisPvtUnderruns(3)" //Command string to ecmcCmdParser.c.\n
+ */
+int getAxisPvtUnderruns(int  axisIndex,
+                        int *value);
+
+/** \brief Get PVT streaming state.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[out] value  State (0=idle, 1=running, 2=done, 3=underrun).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Get PVT state of axis 3.\n
+ * "GetAxisPvtState(3)" //Command string to ecmcCmdParser.c.\n
+ */
+int getAxisPvtState(int  axisIndex,
+                    int *value);
+
+/** \brief Create latch capture for the current configuration encoder.\n
+ *
+ * New latch (touch probe) events are detected each cycle and stored with
+ * the DC time in a ring buffer. The DC time is taken from the
+ * "latchtime" entry if linked, otherwise the application time of the
+ * EtherCAT frame that carried the latch value is used.\n
+ * The "latchvalue" entry must be linked. Modes 0 and 1 also need the
+ * "latchstatus" entry.\n
+ *
+ * Asyn parameters (encoder index > 0 adds index as suffix):\n
+ *   ax<id>.latchevents : Last events (sequence, sec, nsec, position).\n
+ *   ax<id>.latchcount  : Total number of events.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] size  Number of events (rounded up to power of two).\n
+ * \param[in] mode  0=latch status rising edge, 1=latch status change,
+ *                  2=latch value change.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Capture 256 events on rising latch status for axis 3.\n
+ * "Cfg.CreateAxisEncLatchCapture(3,256,0)" //Command string to ecmcCmdParser.c.\n
+ */
+int createAxisEncLatchCapture(int axisIndex,
+                              int size,
+                              int mode);
+
+/** \brief Get number of captured latch events of configuration encoder.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[out] value  Number of events.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Get latch event count of axis 3.\n
+ * "GetAxisEncLatchCount(3)" //Command string to ecmcCmdParser.c.\n
+ */
+int getAxisEncLatchCount(int  axisIndex,
+                         int *value);
+
+/** \brief Create position compare trigger for axis.\n
+ *
+ * Compares the actual position with equidistant or table compare
+ * positions each cycle and writes a pulse to a linked output when a
+ * position is passed. Link the output with
+ * Cfg.LinkEcEntryToObject(<entry>,"ax<id>.poscmp") or
+ * Cfg.LinkEcEntryToAxisPosCompareOutput().\n
+ *
+ * Asyn parameters:\n
+ *   ax<id>.poscmpenable : Enable (1) or disable (0).\n
+ *   ax<id>.poscmpcount  : Number of passed compare positions.\n
+ *   ax<id>.poscmpnext   : Next compare position.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] tableSize  Max number of table positions (0 for only
+ *                       equidistant positions).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Create position compare with table of 1000 positions
+ * for axis 3.\n
+ * "Cfg.CreateAxisPosCompare(3,1000)" //Command string to ecmcCmdParser.c.\n
+ */
+int createAxisPosCompare(int axisIndex,
+                         int tableSize);
+
+/** \brief Links an EtherCAT entry to position compare output of axis.\n
+ *
+ *  \param[in] slaveIndex Position of the EtherCAT slave on the bus.\n
+ *  \param[in] entryIdString String for addressing purpose (see command
+ *                      "Cfg.EcAddEntryComplete() for more information").\n
+ *  \param[in] axisIndex Index of axis.\n
+ *  \param[in] entryBitIndex Bit index of entry (-1 for whole entry).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ *  \note Example: Link entry "OUTPUT_0" in slave 1 as position compare
+ *  output for axis 2.\n
+ *   "Cfg.LinkEcEntryToAxisPosCompareOutput(1,"OUTPUT_0",2,-1)" //Command string to ecmcCmdParser.c\n
+ */
+int linkEcEntryToAxisPosCompareOutput(int   slaveIndex,
+                                      char *entryIDString,
+                                      int   axisIndex,
+                                      int   entryBitIndex);
+
+/** \brief Set equidistant compare positions.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] start  First compare position.\n
+ * \param[in] step  Distance between positions (> 0).\n
+ * \param[in] count  Number of positions.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: 100 positions from 10 every 0.5 for axis 3.\n
+ * "Cfg.SetAxisPosCompareEquidistant(3,10,0.5,100)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisPosCompareEquidistant(int    axisIndex,
+                                 double start,
+                                 double step,
+                                 int    count);
+
+/** \brief Append position to compare table.\n
+ *
+ * Positions must be appended in ascending order. Switches to table mode.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] pos  Compare position.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Append position 12.5 for axis 3.\n
+ * "Cfg.AppendAxisPosCompareTablePos(3,12.5)" //Command string to ecmcCmdParser.c.\n
+ */
+int appendAxisPosCompareTablePos(int    axisIndex,
+                                 double pos);
+
+/** \brief Clear compare positions and trigger counter.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Clear position compare of axis 3.\n
+ * "Cfg.ClearAxisPosCompare(3)" //Command string to ecmcCmdParser.c.\n
+ */
+int clearAxisPosCompare(int axisIndex);
+
+/** \brief Set direction filter of position compare.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] direction  0=both, 1=positive, 2=negative.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Only trigger in positive direction for axis 3.\n
+ * "Cfg.SetAxisPosCompareDirection(3,1)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisPosCompareDirection(int axisIndex,
+                               int direction);
+
+/** \brief Set pulse width of position compare output.\n
+ *
+ * Rounded up to whole cycles (default one cycle).\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] seconds  Pulse width [s].\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: 2ms pulse for axis 3.\n
+ * "Cfg.SetAxisPosComparePulseWidth(3,0.002)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisPosComparePulseWidth(int    axisIndex,
+                                double seconds);
+
+/** \brief Enable position compare.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[in] enable  Enable (1) or disable (0).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Enable position compare for axis 3.\n
+ * "Cfg.SetAxisPosCompareEnable(3,1)" //Command string to ecmcCmdParser.c.\n
+ */
+int setAxisPosCompareEnable(int axisIndex,
+                            int enable);
+
+/** \brief Get number of passed compare positions.\n
+ *
+ * \param[in] axisIndex  Axis index.\n
+ * \param[out] value  Trigger count.\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ *
+ * \note Example: Get trigger count of axis 3.\n
+ * "GetAxisPosCompareCount(3)" //Command string to ecmcCmdParser.c.\n
+ */
+int getAxisPosCompareCount(int  axisIndex,
+                           int *value);
+
 # ifdef __cplusplus
 }
 # endif  // ifdef __cplusplus
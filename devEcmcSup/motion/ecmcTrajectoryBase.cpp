@@ -380,6 +380,14 @@ void ecmcTrajectoryBase::setJerk(double jerk) {
   initTraj();
 }
 
+double ecmcTrajectoryBase::getMoveTime() {
+  return 0;
+}
+
+void ecmcTrajectoryBase::setPreCalcEnable(bool /*enable*/) {
+  // Only used for s-shaped trajectory
+}
+
 int ecmcTrajectoryBase::initStopRamp(double currentPos,
                                      double currentVel,
                                      double currentAcc) {
@@ -131,6 +131,16 @@ class ecmcTrajectoryBase : public ecmcError {
 
   /// How long diatnce until stop
   virtual double  distToStop(double vel) = 0;
+
+  /** Total time of current positioning move.
+   *  Only used for s-shaped trajectory.
+   */
+  virtual double  getMoveTime();
+
+  /** Use pre calculated profile for positioning.
+   *  Only used for s-shaped trajectory.
+   */
+  virtual void    setPreCalcEnable(bool enable);
   
   /// init stop ramp for when in external traj and need to stop
   virtual int     initStopRamp(double currentPos,
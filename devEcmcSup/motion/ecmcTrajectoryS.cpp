@@ -15,7 +15,8 @@
 
 ecmcTrajectoryS::ecmcTrajectoryS(ecmcAxisData *axisData,
                                  double        sampleTime) : 
-                 ecmcTrajectoryBase(axisData, sampleTime) {  
+                 ecmcTrajectoryBase(axisData, sampleTime),
+                 otgPreCalc_(sampleTime) {  
   initVars();
   initTraj();
 }
@@ -38,6 +39,10 @@ void ecmcTrajectoryS::initVars() {
   localBusy_                    = false;
   targetVelocityLocal_          = 0;
   trajMaxVelo_                  = 0;
+  moveTime_                     = 0;
+  preCalcEnable_                = false;
+  preCalcValid_                 = false;
+  preCalcTime_                  = 0;
 }
 
 void ecmcTrajectoryS::setCurrentPosSet(double posSet) {
@@ -53,7 +58,11 @@ double ecmcTrajectoryS::internalTraj(double *actVelocity,
   
   switch (motionMode_) {
   case ECMC_MOVE_MODE_POS:
-    posSetTemp = movePos(actVelocity, actAcceleration, &localBusy_);
+    if(preCalcEnable_) {
+      posSetTemp = movePosPreCalc(actVelocity, actAcceleration, &localBusy_);
+    } else {
+      posSetTemp = movePos(actVelocity, actAcceleration, &localBusy_);
+    }
     break;
   
   case ECMC_MOVE_MODE_VEL:
@@ -85,6 +94,8 @@ double ecmcTrajectoryS::internalTraj(double *actVelocity,
                           actVelocity,
                           actAcceleration,
                           &stopped);
+    // Stop ramp is not part of pre calculated profile
+    preCalcValid_ = false;
     localBusy_ = !stopped;
     if (stopped) {
       *actVelocity     = 0;
@@ -123,15 +134,40 @@ bool ecmcTrajectoryS::updateRuckig() {
   Result res = otg_->update(*input_, *output_);
   
   if(res<0) {
+    int errorOld = getErrorID();
+    setRuckigErrorID(res);
+    // Log input once (not each cycle while in error)
+    if(res == Result::ErrorInvalidInput && getErrorID() != errorOld) {
+      LOGERR("%s/%s:%d: ERROR: Ruckig invalid input (0x%x): "
+             "pos %lf, vel %lf, acc %lf, "
+             "target pos %lf, vel %lf, acc %lf, "
+             "max vel %lf, acc %lf, jerk %lf.\n",
+             __FILE__,
+             __FUNCTION__,
+             __LINE__,
+             getErrorID(),
+             input_->current_position[0],
+             input_->current_velocity[0],
+             input_->current_acceleration[0],
+             input_->target_position[0],
+             input_->target_velocity[0],
+             input_->target_acceleration[0],
+             input_->max_velocity[0],
+             input_->max_acceleration[0],
+             input_->max_jerk[0]);
+    }
+  }
+  
+  return res == Result::Working;
+}
+
+void ecmcTrajectoryS::setRuckigErrorID(Result res) {
     switch(res) {
       case Result::Error:
         setErrorID(__FILE__, __FUNCTION__, __LINE__,ERROR_TRAJ_RUCKIG_ERROR);
         break;
       case Result::ErrorInvalidInput:
         setErrorID(__FILE__, __FUNCTION__, __LINE__,ERROR_TRAJ_RUCKIG_INVALID_INPUT);
-        printf("Input pos %lf, vel %lf, acc %lf\n",input_->current_position[0],input_->current_velocity[0],input_->current_acceleration[0]);
-        printf("Target pos %lf, vel %lf, acc %lf\n",input_->target_position[0],input_->target_velocity[0],input_->target_acceleration[0]);
-        printf("Max vel %lf, acc %lf, jerk %lf\n",input_->max_velocity[0],input_->max_acceleration[0],input_->max_jerk[0]);
         break;
       case Result::ErrorTrajectoryDuration:
         setErrorID(__FILE__, __FUNCTION__, __LINE__,ERROR_TRAJ_RUCKIG_TRAJ_DURATION);
@@ -152,15 +188,6 @@ bool ecmcTrajectoryS::updateRuckig() {
         setErrorID(__FILE__, __FUNCTION__, __LINE__,ERROR_TRAJ_RUCKIG_ERROR);
         break;        
     }
-    //LOGERR("%s/%s:%d: ERROR: Ruckig error  %d (0x%x).\n",
-    //    __FILE__,
-    //    __FUNCTION__,
-    //    __LINE__,
-    //    res,
-    //    getErrorID());
-  }
-  
-  return res == Result::Working;
 }
 
 double ecmcTrajectoryS::moveVel(double *actVelocity,
@@ -217,6 +244,10 @@ double ecmcTrajectoryS::movePos(double *actVelocity,
   *actVelocity                   = output_->new_velocity[0];
   *actAcceleration               = output_->new_acceleration[0];
 
+  if(output_->new_calculation) {
+    moveTime_ = output_->trajectory.get_duration();
+  }
+
   if(*trajBusy) {
     return output_->new_position[0];
   } else {
@@ -224,6 +255,72 @@ double ecmcTrajectoryS::movePos(double *actVelocity,
   }
 }
 
+/* Same as movePos() but the full profile is only calculated when target or
+ * limits change. Each cycle the profile is just sampled at current time.
+ */
+double ecmcTrajectoryS::movePosPreCalc(double *actVelocity,
+                                       double *actAcceleration,
+                                       bool   *trajBusy){
+  if(!preCalcValid_ ||
+     inputPreCalc_.target_position[0]  != targetPositionLocal_ ||
+     inputPreCalc_.max_velocity[0]     != std::abs(targetVelocityLocal_) ||
+     inputPreCalc_.max_acceleration[0] != std::abs(targetAcceleration_) ||
+     inputPreCalc_.max_jerk[0]         != std::abs(targetJerk_)) {
+
+    // Start from current setpoint state
+    inputPreCalc_.current_position[0]     = localCurrentPositionSetpoint_;
+    inputPreCalc_.current_velocity[0]     = input_->current_velocity[0];
+    inputPreCalc_.current_acceleration[0] = input_->current_acceleration[0];
+    inputPreCalc_.target_position[0]      = targetPositionLocal_;
+    inputPreCalc_.target_velocity[0]      = 0;
+    inputPreCalc_.target_acceleration[0]  = 0;
+    inputPreCalc_.max_velocity[0]         = std::abs(targetVelocityLocal_);
+    inputPreCalc_.max_acceleration[0]     = std::abs(targetAcceleration_);
+    inputPreCalc_.max_jerk[0]             = std::abs(targetJerk_);
+
+    Result res = otgPreCalc_.calculate(inputPreCalc_, trajPreCalc_);
+    if(res < 0) {
+      setRuckigErrorID(res);
+      preCalcValid_    = false;
+      *trajBusy        = false;
+      *actVelocity     = 0;
+      *actAcceleration = 0;
+      return localCurrentPositionSetpoint_;
+    }
+    preCalcValid_ = true;
+    preCalcTime_  = 0;
+    moveTime_     = trajPreCalc_.get_duration();
+  }
+
+  preCalcTime_ += sampleTime_;
+  *trajBusy = preCalcTime_ < moveTime_;
+
+  if(!*trajBusy) {
+    preCalcTime_ = moveTime_;
+  }
+
+  std::array<double, 1> pos, vel, acc;
+  trajPreCalc_.at_time(preCalcTime_, pos, vel, acc);
+
+  // Keep dynamic ruckig in sync (used for stop and velocity mode)
+  output_->new_position[0]     = pos[0];
+  output_->new_velocity[0]     = vel[0];
+  output_->new_acceleration[0] = acc[0];
+
+  *actVelocity     = vel[0];
+  *actAcceleration = acc[0];
+
+  if(*trajBusy) {
+    return pos[0];
+  } else {
+    *actVelocity     = 0;
+    *actAcceleration = 0;
+    output_->new_velocity[0]     = 0;
+    output_->new_acceleration[0] = 0;
+    return targetPositionLocal_;
+  }
+}
+
 double ecmcTrajectoryS::moveStop(stopMode stopMode,
                                  double *actVelocity, 
                                  double *actAcceleration,                                 
@@ -256,14 +353,46 @@ double ecmcTrajectoryS::moveStop(stopMode stopMode,
   return output_->new_position[0];
 }
 
+/* Distance of a jerk limited stop from vel (assuming zero acceleration).
+ * The velocity profile of the stop is point symmetric so the distance is
+ * vel * stopTime / 2.
+ */
 double ecmcTrajectoryS::distToStop(double vel) {
-  return 0;  // No nice way to calculate with ruckig
+  double v = std::abs(vel);
+  double d = std::abs(targetDeceleration_);
+  double j = std::abs(targetJerk_);
+
+  if(v == 0 || d == 0) {
+    return 0;
+  }
+
+  if(j == 0) {
+    return v * v / (2 * d);
+  }
+
+  if(v >= d * d / j) {
+    // Max deceleration reached (constant deceleration phase)
+    return v / 2 * (v / d + d / j);
+  }
+
+  // Max deceleration not reached
+  return v * std::sqrt(v / j);
+}
+
+double ecmcTrajectoryS::getMoveTime() {
+  return moveTime_;
+}
+
+void ecmcTrajectoryS::setPreCalcEnable(bool enable) {
+  preCalcEnable_ = enable;
+  preCalcValid_  = false;
 }
 
 void ecmcTrajectoryS::setTargetPosLocal(double pos) {
   localCurrentPositionSetpoint_ = currentPositionSetpoint_;
   targetPositionLocal_ = pos;
   input_->target_position[0] = pos;
+  preCalcValid_ = false;
 }
 
 void ecmcTrajectoryS::setTargetVel(double velTarget) {
@@ -293,6 +422,7 @@ int ecmcTrajectoryS::initStopRamp(double currentPos,
 
   targetVelocityLocal_ = targetVelocity_;  
   initRuckig();
+  preCalcValid_ = false;
   return 0;
 }
 
@@ -300,6 +430,8 @@ int ecmcTrajectoryS::setExecute(bool execute) {
    if(execute && !execute_) {     
      targetVelocityLocal_ = targetVelocity_;
      initRuckig();
+     preCalcValid_ = false;
+     moveTime_     = 0;
    }
 
    return ecmcTrajectoryBase::setExecute(execute);
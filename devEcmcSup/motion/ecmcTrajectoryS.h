@@ -31,6 +31,10 @@
  * 3. Absolute positioning
  * 4. Interlocks (hard limits, soft limits, external interlocks)
  *
+ * Positioning can optionally use a pre-calculated profile (setPreCalcEnable()).
+ * The full ruckig trajectory is then only calculated when a move is commanded
+ * or changed and sampled at the current time each cycle.
+ *
  * Contact: anders.sandstrom@esss.se
  *
  * Created on: 2021-11-26
@@ -66,6 +70,8 @@ class ecmcTrajectoryS : public ecmcTrajectoryBase {
   void            setCurrentPosSet(double posSet);
 
   double          distToStop(double vel);
+  double          getMoveTime();
+  void            setPreCalcEnable(bool enable);
   int             initStopRamp(double   currentPos,
                                double   currentVel,
                                double   currentAcc);
@@ -74,6 +80,7 @@ class ecmcTrajectoryS : public ecmcTrajectoryBase {
  private:
   void            initRuckig();
   bool            updateRuckig();
+  void            setRuckigErrorID(Result res);
   double          internalTraj(double  *actVelocity,
                                double  *actAcceleration,
                                bool    *trajBusy);
@@ -83,6 +90,9 @@ class ecmcTrajectoryS : public ecmcTrajectoryBase {
   double          movePos(double       *actVelocity,
                           double       *actAcceleration,
                           bool         *trajBusy);
+  double          movePosPreCalc(double       *actVelocity,
+                                 double       *actAcceleration,
+                                 bool         *trajBusy);
   double          moveStop(stopMode     stopMode,
                            double      *actVelocity,
                            double      *actAcceleration,
@@ -99,5 +109,13 @@ class ecmcTrajectoryS : public ecmcTrajectoryBase {
   double                        targetVelocityLocal_;
   bool                          localBusy_;
   double                        trajMaxVelo_;
+  double                        moveTime_;
+  // Pre calculated position trajectory (fixed DOF, no heap)
+  Ruckig<1>                     otgPreCalc_;
+  InputParameter<1>             inputPreCalc_;
+  Trajectory<1>                 trajPreCalc_;
+  bool                          preCalcEnable_;
+  bool                          preCalcValid_;
+  double                        preCalcTime_;
 };
 #endif  // ifndef SRC_ECMCTRAJECTORYS_H_
@@ -42,6 +42,11 @@ extern asynUser *pPrintOutAsynUser;
 #define ECMC_AXIS_ENABLE_MAX_SLEEP_TIME 3.0
 
 
+/* Status change callback (realtime thread) */
+static void ecmcMotorRecordAxisStatusChanged(void *userData) {
+  ((ecmcMotorRecordAxis *)userData)->statusChanged();
+}
+
 /** Creates a new ecmcMotorRecordAxis object.
  * \param[in] pC Pointer to the ecmcMotorRecordController to which this axis belongs.
  * \param[in] axisNo Index number of this axis, range 1 to pC->numAxes_. (0 is not used)
@@ -172,6 +177,21 @@ ecmcMotorRecordAxis::ecmcMotorRecordAxis(ecmcMotorRecordController *pC,
   if (pasynTrace->getTraceInfoMask(pPrintOutAsynUser) & ASYN_TRACEINFO_SOURCE) modNamEMC = "";
   
   initialPoll();
+
+  /* Wake poller on status changes in realtime instead of waiting
+     for next poll period */
+  if(ecmcRTMutex) epicsMutexLock(ecmcRTMutex);
+  drvlocal.ecmcAxis->setStatusChangeCallback(ecmcMotorRecordAxisStatusChanged,
+                                             this);
+  if(ecmcRTMutex) epicsMutexUnlock(ecmcRTMutex);
+}
+
+void ecmcMotorRecordAxis::statusChanged() {
+  /* Only one wakeup per poll */
+  if (__atomic_exchange_n(&drvlocal.wakeupPending, 1, __ATOMIC_ACQ_REL)) {
+    return;
+  }
+  pC_->wakeupPoller();
 }
 
 extern "C" int ecmcMotorRecordCreateAxis(const char *controllerPortName, 
@@ -1052,6 +1072,8 @@ asynStatus ecmcMotorRecordAxis::readEcmcAxisStatusData() {
       __FUNCTION__,
       __LINE__);
 
+    /* Push all status fields when data is available again */
+    drvlocal.dirty.statusPushAll = 1;
     return asynError;
   }
   // copy data locally
@@ -1073,11 +1095,22 @@ asynStatus ecmcMotorRecordAxis::poll(bool *moving)
   int waitNumPollsBeforeReady_ = drvlocal.waitNumPollsBeforeReady;
 #endif
 
+  /* Changes from now on wake the poller again */
+  __atomic_store_n(&drvlocal.wakeupPending, 0, __ATOMIC_RELEASE);
+
   asynStatus status = readEcmcAxisStatusData();
   if(status) {    
     return status;
   }
 
+  /* Only push fields that changed since last poll */
+  const ecmcAxisStatusOnChangeType *newData = &drvlocal.statusBinData.onChangeData;
+  const ecmcAxisStatusOnChangeType *oldData = &drvlocal.statusBinDataOld.onChangeData;
+  bool pushAll    = drvlocal.dirty.statusPushAll;
+  bool wdChanged  = pushAll || memcmp(&newData->statusWd, &oldData->statusWd,
+                                      sizeof(newData->statusWd)) != 0;
+  bool posChanged = pushAll || newData->positionActual != oldData->positionActual;
+
   if(drvlocal.ecmcAxis) {
     drvlocal.moveNotReadyNext= drvlocal.ecmcAxis->getBusy() || !drvlocal.statusBinData.onChangeData.statusWd.attarget;
   }
@@ -1085,15 +1118,23 @@ asynStatus ecmcMotorRecordAxis::poll(bool *moving)
     drvlocal.moveNotReadyNext= false;
   }
   
-  setIntegerParam(pC_->motorStatusHomed_, (drvlocal.statusBinData.onChangeData.statusWd.homed > 0));
   drvlocal.homed = drvlocal.statusBinData.onChangeData.statusWd.homed > 0;
-  setIntegerParam(pC_->motorStatusCommsError_, 0);
-  setIntegerParam(pC_->motorStatusAtHome_, (drvlocal.statusBinData.onChangeData.statusWd.homeswitch > 0));
-  setIntegerParam(pC_->motorStatusLowLimit_, ((!drvlocal.statusBinData.onChangeData.statusWd.limitbwd) > 0));
-  setIntegerParam(pC_->motorStatusHighLimit_,((!drvlocal.statusBinData.onChangeData.statusWd.limitfwd) > 0));
-  setIntegerParam(pC_->motorStatusPowerOn_, (drvlocal.statusBinData.onChangeData.statusWd.enabled > 0));
-  setDoubleParam(pC_->ecmcMotorRecordVelAct_, drvlocal.statusBinData.onChangeData.velocityActual);
-  setDoubleParam(pC_->ecmcMotorRecordAcc_RB_, drvlocal.statusBinData.acceleration);
+  if (pushAll) {
+    setIntegerParam(pC_->motorStatusCommsError_, 0);
+  }
+  if (wdChanged) {
+    setIntegerParam(pC_->motorStatusHomed_, (drvlocal.statusBinData.onChangeData.statusWd.homed > 0));
+    setIntegerParam(pC_->motorStatusAtHome_, (drvlocal.statusBinData.onChangeData.statusWd.homeswitch > 0));
+    setIntegerParam(pC_->motorStatusLowLimit_, ((!drvlocal.statusBinData.onChangeData.statusWd.limitbwd) > 0));
+    setIntegerParam(pC_->motorStatusHighLimit_,((!drvlocal.statusBinData.onChangeData.statusWd.limitfwd) > 0));
+    setIntegerParam(pC_->motorStatusPowerOn_, (drvlocal.statusBinData.onChangeData.statusWd.enabled > 0));
+  }
+  if (pushAll || newData->velocityActual != oldData->velocityActual) {
+    setDoubleParam(pC_->ecmcMotorRecordVelAct_, drvlocal.statusBinData.onChangeData.velocityActual);
+  }
+  if (pushAll || drvlocal.statusBinData.acceleration != drvlocal.statusBinDataOld.acceleration) {
+    setDoubleParam(pC_->ecmcMotorRecordAcc_RB_, drvlocal.statusBinData.acceleration);
+  }
 
 #ifndef motorWaitPollsBeforeReadyString
   if (drvlocal.waitNumPollsBeforeReady) {
@@ -1115,14 +1156,19 @@ asynStatus ecmcMotorRecordAxis::poll(bool *moving)
   }
   
   //if (drvlocal.nCommandActive != ECMC_CMD_HOMING) {
-  
+  if (posChanged) {
     setDoubleParam(pC_->motorPosition_,
                    drvlocal.statusBinData.onChangeData.positionActual);
     setDoubleParam(pC_->motorEncoderPosition_,
                    drvlocal.statusBinData.onChangeData.positionActual);
+  }
+  if (pushAll || newData->velocitySetpoint != oldData->velocitySetpoint) {
     setDoubleParam(pC_->ecmcMotorRecordVel_RB_, drvlocal.statusBinData.onChangeData.velocitySetpoint);
+  }
   //}
-  setDoubleParam(pC_->ecmcMotorRecordEncAct_, (double)drvlocal.statusBinData.onChangeData.positionRaw);
+  if (pushAll || newData->positionRaw != oldData->positionRaw) {
+    setDoubleParam(pC_->ecmcMotorRecordEncAct_, (double)drvlocal.statusBinData.onChangeData.positionRaw);
+  }
 
   if (drvlocal.statusBinDataOld.onChangeData.statusWd.homed != drvlocal.statusBinData.onChangeData.statusWd.homed) {
     asynPrint(pPrintOutAsynUser, ASYN_TRACE_INFO,
@@ -1175,8 +1221,10 @@ asynStatus ecmcMotorRecordAxis::poll(bool *moving)
   setIntegerParam(pC_->motorStatusDirection_, 
                   drvlocal.statusBinData.onChangeData.positionActual > 
                   drvlocal.statusBinDataOld.onChangeData.positionActual ? 1:0);
-  setIntegerParam(pC_->motorStatusMoving_, drvlocal.moveNotReadyNext);
-  setIntegerParam(pC_->motorStatusDone_, !drvlocal.moveNotReadyNext);
+  if (pushAll || drvlocal.moveNotReadyNextOld != drvlocal.moveNotReadyNext) {
+    setIntegerParam(pC_->motorStatusMoving_, drvlocal.moveNotReadyNext);
+    setIntegerParam(pC_->motorStatusDone_, !drvlocal.moveNotReadyNext);
+  }
 
   drvlocal.nErrorIdMcu = drvlocal.statusBinData.onChangeData.error;
 
@@ -1229,6 +1277,7 @@ asynStatus ecmcMotorRecordAxis::poll(bool *moving)
   callParamCallbacksUpdateError();
 
   drvlocal.moveNotReadyNextOld = drvlocal.moveNotReadyNext;
+  drvlocal.dirty.statusPushAll = 0;
   memcpy(&drvlocal.statusBinDataOld, &drvlocal.statusBinData,
          sizeof(drvlocal.statusBinDataOld));
   return asynSuccess;
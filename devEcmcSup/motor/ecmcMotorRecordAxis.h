@@ -57,6 +57,9 @@ public:
 
   asynStatus poll(bool *moving);
 
+  // From realtime thread on status change (wakes poller)
+  void       statusChanged();
+
 private:
   typedef enum
   {
@@ -114,11 +117,13 @@ private:
       unsigned int     statusDisconnectedOld : 1;
       unsigned int     sErrorMessage         : 1; /* From MCU */
       unsigned int     initialPollNeeded     : 1;
+      unsigned int     statusPushAll         : 1; /* Push all status fields */
     }  dirty;
     int                moveNotReadyNext;
     int                moveNotReadyNextOld;
     char               cmdErrorMessage[80]; /* From driver */
     char               sErrorMessage[80]; /* From controller */
+    int                wakeupPending;     /* Set from realtime thread */
   } drvlocal;
 
   asynStatus readBackAllConfig(int axisID);
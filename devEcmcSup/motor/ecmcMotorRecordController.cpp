@@ -343,9 +343,11 @@ void ecmcMotorRecordController::handleStatusChange(asynStatus status)
       features_ &= ~reportedFeatureBits;
       setMCUErrMsg("MCU Disconnected");
       for (i=0; i<numAxes_; i++) {
-        asynMotorAxis *pAxis=getAxis(i);
+        ecmcMotorRecordAxis *pAxis=getAxis(i);
         if (!pAxis) continue;
         pAxis->setIntegerParam(motorStatusCommsError_, 1);
+        /* Clear comms error and push all status fields after reconnect */
+        pAxis->drvlocal.dirty.statusPushAll = 1;
         pAxis->callParamCallbacks();
       }
     } else {
@@ -25,12 +25,14 @@
 
 extern ecmcAxisBase       *axes[ECMC_MAX_AXES];
 extern ecmcEc             *ec;
-extern ecmcDataStorage    *dataStorages[ECMC_MAX_DATA_STORAGE_OBJECTS];
+extern ecmcDataStorage   **dataStorages;
+extern int                 ecmcMaxDataStorageObjects;
 extern ecmcPLCMain        *plcs;
 extern ecmcAsynPortDriver *asynPort;
 extern double              mcuFrequency;
 extern int                 sampleRateChangeAllowed;
 extern ecmcPluginLib      *plugins[ECMC_MAX_PLUGINS];
+extern app_mode_type       appModeStat;
 
 
 int createPLC(int index,  double cycleTimeMs, int axisPLC) {
@@ -63,7 +65,7 @@ int createPLC(int index,  double cycleTimeMs, int axisPLC) {
   sampleRateChangeAllowed = 0;
 
   if (!plcs) {
-    plcs = new ecmcPLCMain(ec,mcuFrequency,asynPort);
+    plcs = new ecmcPLCMain(ec,mcuFrequency,asynPort,ecmcMaxDataStorageObjects);
   }
 
   if (axisPLC) {
@@ -84,7 +86,7 @@ int createPLC(int index,  double cycleTimeMs, int axisPLC) {
   }
 
   // Set data storage pointers
-  for (int i = 0; i < ECMC_MAX_DATA_STORAGE_OBJECTS; i++) {
+  for (int i = 0; i < ecmcMaxDataStorageObjects; i++) {
     plcs->setDataStoragePointer(dataStorages[i], i);
   }
 
@@ -104,6 +106,11 @@ int createPLC(int index,  double cycleTimeMs, int axisPLC) {
 int deletePLC(int index) {
   LOGINFO4("%s/%s:%d index=%d\n", __FILE__, __FUNCTION__, __LINE__, index);
   CHECK_PLCS_RETURN_IF_ERROR();
+
+  // Execution list is used by the realtime thread
+  if (appModeStat == ECMC_MODE_RUNTIME) {
+    return ERROR_MAIN_APP_MODE_ALREADY_RUNTIME;
+  }
   return plcs->deletePLC(index);
 }
 
@@ -140,6 +147,12 @@ int loadPLCFile(int index, char *fileName) {
   return plcs->loadPLCFile(index, fileName);
 }
 
+int loadPLCSource(int index, const char *source) {
+  LOGINFO4("%s/%s:%d index=%d\n", __FILE__, __FUNCTION__, __LINE__, index);
+  CHECK_PLCS_RETURN_IF_ERROR();
+  return plcs->loadPLCSource(index, source);
+}
+
 int clearPLCExpr(int index) {
   LOGINFO4("%s/%s:%d index=%d\n", __FILE__, __FUNCTION__, __LINE__, index);
   CHECK_PLCS_RETURN_IF_ERROR();
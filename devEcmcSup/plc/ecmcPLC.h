@@ -428,6 +428,19 @@ int appendPLCExpr(int   index,
 int loadPLCFile(int   index,
                 char *fileName);
 
+/** \brief Load PLC code from memory.\n
+ *
+ * Same as loadPLCFile() but the code is already in memory (used when
+ * replaying a configuration snapshot).\n
+ *
+ * \param[in] index     PLC index.\n
+ * \param[in] source    PLC code (lines separated by newline).\n
+ *
+ * \return 0 if success or otherwise an error code.\n
+ */
+int loadPLCSource(int         index,
+                  const char *source);
+
 /** \brief Write to PLC variable.\n
  * \note: Only static variables are supported.\n
  *
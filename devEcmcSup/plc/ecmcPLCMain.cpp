@@ -14,11 +14,19 @@
 
 ecmcPLCMain::ecmcPLCMain(ecmcEc *ec,
                          double mcuFreq,
-                         ecmcAsynPortDriver *asynPortDriver) {
+                         ecmcAsynPortDriver *asynPortDriver,
+                         int dsCount) {
   initVars();
   asynPortDriver_ = asynPortDriver;
   ec_ = ec;
   mcuFreq_ = mcuFreq;
+  dsCount_ = dsCount;
+  registerErrorObject(ECMC_ERROR_OBJ_PLC, 0);
+  ds_ = new ecmcDataStorage*[dsCount_];
+  for (int i = 0; i < dsCount_; i++) {
+    ds_[i] = NULL;
+  }
+  ecmcPLCTask::setDataStorageCount(dsCount_);
   addMainDefaultVariables();  
 }
 
@@ -27,6 +35,8 @@ ecmcPLCMain::~ecmcPLCMain() {
     delete plcs_[i];
     plcs_[i] = NULL;
   }
+  delete[] ds_;
+  ds_ = NULL;
 }
 
 void ecmcPLCMain::initVars() {
@@ -42,9 +52,13 @@ void ecmcPLCMain::initVars() {
     axes_[i] = NULL;
   }
 
-  for (int i = 0; i < ECMC_MAX_DATA_STORAGE_OBJECTS; i++) {
-    ds_[i] = NULL;
+  ds_      = NULL;
+  dsCount_ = 0;
+
+  for (int i = 0; i < ECMC_MAX_PLCS; i++) {
+    plcsExe_[i] = -1;
   }
+  plcsExeCount_ = 0;
 
   for (int i = 0; i < ECMC_MAX_PLC_VARIABLES; i++) {
     globalDataArray_[i] = 0;
@@ -89,7 +103,7 @@ int ecmcPLCMain::createPLC(int plcIndex, int skipCycles) {
   }
 
   // Set data storage pointers
-  for (int i = 0; i < ECMC_MAX_DATA_STORAGE_OBJECTS; i++) {
+  for (int i = 0; i < dsCount_; i++) {
     plcs_[plcIndex]->setDataStoragePointer(ds_[i], i);
   }
 
@@ -107,6 +121,8 @@ int ecmcPLCMain::createPLC(int plcIndex, int skipCycles) {
     return setErrorID(__FILE__, __FUNCTION__, __LINE__, errorCode);
   }
 
+  buildExecutionList();
+
   return 0;
 }
 
@@ -122,7 +138,7 @@ int ecmcPLCMain::setAxisArrayPointer(ecmcAxisBase *axis, int index) {
 }
 
 int ecmcPLCMain::setDataStoragePointer(ecmcDataStorage *ds, int index) {
-  if ((index >= ECMC_MAX_DATA_STORAGE_OBJECTS) || (index < 0)) {
+  if ((index >= dsCount_) || (index < 0)) {
     return setErrorID(__FILE__,
                       __FUNCTION__,
                       __LINE__,
@@ -175,9 +191,22 @@ int ecmcPLCMain::validate() {
     }
   }
 
+  buildExecutionList();
+
   return 0;
 }
 
+void ecmcPLCMain::buildExecutionList() {
+  // Only normal PLCs (axis PLCs are executed from main thread)
+  plcsExeCount_ = 0;
+  for (int i = 0; i < ECMC_MAX_PLCS; i++) {
+    if (plcs_[i] != NULL) {
+      plcsExe_[plcsExeCount_] = i;
+      plcsExeCount_++;
+    }
+  }
+}
+
 int ecmcPLCMain::execute(bool ecOK) {
   //refresh ec<id>.masterstatus
   if(ecStatus_){
@@ -185,15 +214,14 @@ int ecmcPLCMain::execute(bool ecOK) {
   }
 
   // ONLY EXECUTE NORMAL PLCS (AXIS PLCs are executed from main thread)
-  for (int plcIndex = 0; plcIndex < ECMC_MAX_PLCS; plcIndex++) {
-    if (plcs_[plcIndex] != NULL) {
-      if (plcEnable_[plcIndex]) {
-        if (plcEnable_[plcIndex]->getData()) {
-          plcs_[plcIndex]->execute(ecOK);
-          if (ecOK) {
-            if (plcFirstScan_[plcIndex]) {
-              plcFirstScan_[plcIndex]->setData(plcs_[plcIndex]->getFirstScanDone()==0); // First scan
-            }
+  for (int i = 0; i < plcsExeCount_; i++) {
+    int plcIndex = plcsExe_[i];
+    if (plcs_[plcIndex] != NULL && plcEnable_[plcIndex]) {
+      if (plcEnable_[plcIndex]->getData()) {
+        plcs_[plcIndex]->execute(ecOK);
+        if (ecOK) {
+          if (plcFirstScan_[plcIndex]) {
+            plcFirstScan_[plcIndex]->setData(plcs_[plcIndex]->getFirstScanDone()==0); // First scan
           }
         }
       }
@@ -327,11 +355,24 @@ int ecmcPLCMain::loadPLCFile(int plcIndex, char *fileName) {
                       ERROR_PLCS_FILE_NOT_FOUND);
   }
 
+  return loadPLCStream(plcIndex, plcFile, fileName);
+}
+
+// PLC code already in memory (from configuration snapshot)
+int ecmcPLCMain::loadPLCSource(int plcIndex, const char *source) {
+  CHECK_PLC_RETURN_IF_ERROR(plcIndex)
+  std::istringstream plcSource(source);
+  return loadPLCStream(plcIndex, plcSource, "<source>");
+}
+
+int ecmcPLCMain::loadPLCStream(int           plcIndex,
+                               std::istream &stream,
+                               const char   *name) {
   std::string line, lineNoComments;
   int lineNumber = 1;
   int errorCode  = 0;
 
-  while (std::getline(plcFile, line)) {
+  while (std::getline(stream, line)) {
     // Remove Comments (everything after #)
     lineNoComments = line.substr(0, line.find(ECMC_PLC_FILE_COMMENT_CHAR));
 
@@ -364,7 +405,7 @@ int ecmcPLCMain::loadPLCFile(int plcIndex, char *fileName) {
            __FUNCTION__,
            __LINE__,
            plcIndex,
-           fileName,
+           name,
            errorCode);
     return setErrorID(__FILE__, __FUNCTION__, __LINE__, errorCode);
   }
@@ -411,6 +452,7 @@ int ecmcPLCMain::deletePLC(int plcIndex) {
   CHECK_PLC_RETURN_IF_ERROR(plcIndex);
   delete plcs_[plcIndex];
   plcs_[plcIndex] = NULL;
+  buildExecutionList();
   return 0;
 }
 
@@ -611,7 +653,7 @@ int ecmcPLCMain::createNewGlobalDataIF(char              *varName,
   case ECMC_RECORDER_SOURCE_DATA_STORAGE:
     dsId = getDsIndex(varName);
 
-    if ((dsId >= ECMC_MAX_DATA_RECORDERS_OBJECTS) || (dsId < 0)) {
+    if ((dsId >= dsCount_) || (dsId < 0)) {
       return setErrorID(__FILE__,
                         __FUNCTION__,
                         __LINE__,
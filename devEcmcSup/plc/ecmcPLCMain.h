@@ -16,6 +16,7 @@
 #include "exprtkWrap.h"
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
 #include "../com/ecmcAsynPortDriver.h"
 #include "../main/ecmcDefinitions.h"
@@ -53,7 +54,8 @@ class ecmcPLCMain : public ecmcError {
  public:
   explicit ecmcPLCMain(ecmcEc *ec,
                        double mcuFreq,
-                       ecmcAsynPortDriver *asynPortDriver);
+                       ecmcAsynPortDriver *asynPortDriver,
+                       int dsCount);
   ~ecmcPLCMain();
   int  createPLC(int plcIndex,
                  int skipCycles);
@@ -78,6 +80,8 @@ class ecmcPLCMain : public ecmcError {
                     const char *expr);
   int  loadPLCFile(int   plcIndex,
                    char *fileName);
+  int  loadPLCSource(int         plcIndex,
+                     const char *source);
   int  clearExpr(int plcIndex);
   int  compileExpr(int plcIndex);
   int  setEnable(int plcIndex,
@@ -103,6 +107,10 @@ class ecmcPLCMain : public ecmcError {
 
  private:
   void initVars();
+  int  loadPLCStream(int           plcIndex,
+                     std::istream &stream,
+                     const char   *name);
+  void buildExecutionList();
   int  createNewGlobalDataIF(char              *varName,
                              ecmcDataSourceType dataSource,
                              ecmcPLCDataIF    **outDataIF);
@@ -141,7 +149,11 @@ class ecmcPLCMain : public ecmcError {
   //Dedicateed plcs then one per axis
   ecmcPLCTask        *plcs_[ECMC_MAX_PLCS + ECMC_MAX_AXES];
   ecmcAxisBase       *axes_[ECMC_MAX_AXES];
-  ecmcDataStorage    *ds_[ECMC_MAX_DATA_STORAGE_OBJECTS];
+  ecmcDataStorage   **ds_;
+  int                 dsCount_;
+  // Dense list of created (normal) PLCs, executed in execute(bool ecOK)
+  int                 plcsExe_[ECMC_MAX_PLCS];
+  int                 plcsExeCount_;
   ecmcEc             *ec_;
   ecmcAsynPortDriver *asynPortDriver_;
   ecmcPLCDataIF      *plcEnable_[ECMC_MAX_PLCS + ECMC_MAX_AXES];
@@ -465,8 +465,18 @@ int ecmcPLCTask::setAxisArrayPointer(ecmcAxisBase *axis, int index) {
   return 0;
 }
 
+int ecmcPLCTask::setDataStorageCount(int count) {
+  delete[] ecmcPLCTask::statDs_;
+  ecmcPLCTask::statDs_      = new ecmcDataStorage*[count];
+  ecmcPLCTask::statDsCount_ = count;
+  for (int i = 0; i < count; i++) {
+    ecmcPLCTask::statDs_[i] = NULL;
+  }
+  return 0;
+}
+
 int ecmcPLCTask::setDataStoragePointer(ecmcDataStorage *ds, int index) {
-  if ((index >= ECMC_MAX_DATA_STORAGE_OBJECTS) || (index < 0)) {
+  if ((index >= ecmcPLCTask::statDsCount_) || (index < 0)) {
     return setErrorID(__FILE__,
                       __FUNCTION__,
                       __LINE__,
@@ -82,7 +82,9 @@ class ecmcPLCTask : public ecmcError {
   double       getSampleTime();
   int          getNewExpr();
   static ecmcAxisBase    *statAxes_[ECMC_MAX_AXES];
-  static ecmcDataStorage *statDs_[ECMC_MAX_DATA_STORAGE_OBJECTS];
+  static int             setDataStorageCount(int count);
+  static ecmcDataStorage **statDs_;
+  static int              statDsCount_;
   static ecmcEc          *statEc_;
 
  private:
@@ -71,4 +71,26 @@ int getEcmcEpicsIOCState() {
   }
   return asynPort->getEpicsState();
 }
- 
\ No newline at end of file
+ 
+
+int getEcmcEncLatchEvents(int       axisIndex,
+                          int       encIndex,
+                          uint32_t *nextSequence,
+                          void     *events,
+                          int       maxEvents) {
+  if ((axisIndex < 0) || (axisIndex >= ECMC_MAX_AXES) || !axes[axisIndex] ||
+      (encIndex < 0) || !nextSequence || !events) {
+    return -1;
+  }
+
+  int errorCode = 0;
+  ecmcEncoder *enc = axes[axisIndex]->getEnc(encIndex, &errorCode);
+
+  if (errorCode || !enc || !enc->getLatchCapture()) {
+    return -1;
+  }
+
+  return enc->getLatchCapture()->read(nextSequence,
+                                      (ecmcEncLatchEvent *)events,
+                                      maxEvents);
+}
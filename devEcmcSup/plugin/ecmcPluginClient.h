@@ -15,6 +15,8 @@
 #ifndef ECMC_PLUGIN_H_
 #define ECMC_PLUGIN_H_
 
+#include <stdint.h>
+
 # ifdef __cplusplus
 extern "C" {
 # endif  // ifdef __cplusplus
@@ -92,6 +94,31 @@ double getEcmcSampleTimeMS();
  */
 int getEcmcEpicsIOCState();
 
+/** \brief Read latch (touch probe) events of an encoder
+ *
+ *  Reads events from the latch capture ring of an encoder (see
+ *  Cfg.CreateAxisEncLatchCapture()). Reading is non destructive, each
+ *  reader keeps its own nextSequence (start with 0). Events overwritten
+ *  before read are skipped.\n
+ *
+ *  \param[in] axisIndex Axis index.\n
+ *  \param[in] encIndex Encoder index (0..ECMC_MAX_ENCODERS-1).\n
+ *  \param[in,out] nextSequence Sequence number of next event to read.\n
+ *  \param[out] events Buffer of ecmcEncLatchEvent (ecmcEncoderLatchCapture.h).\n
+ *  \param[in] maxEvents Size of buffer in events.\n
+ *
+ * \return Number of read events or -1 if no latch capture.\n
+ *
+ * \note Can be called from plugin realtime or non realtime functions.\n
+ *
+ * \note There's no ascii command in ecmcCmdParser.c for this method.\n
+ */
+int getEcmcEncLatchEvents(int       axisIndex,
+                          int       encIndex,
+                          uint32_t *nextSequence,
+                          void     *events,
+                          int       maxEvents);
+
 # ifdef __cplusplus
 }
 # endif  // ifdef __cplusplus
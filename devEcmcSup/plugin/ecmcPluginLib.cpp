@@ -21,6 +21,7 @@
 ecmcPluginLib::ecmcPluginLib(int index) {
   initVars();
   index_ = index;
+  registerErrorObject(ECMC_ERROR_OBJ_PLUGIN, index);
 }
 
 ecmcPluginLib::~ecmcPluginLib() {